@@ -301,6 +301,10 @@ struct ExecutionPolicy {
     //! INVALID_ALGO_TYPE algo_type means using heuristic
     Algorithm::Info::Desc algo;
     std::vector<ExecutionPolicy> sub_policy;
+    //! require the result to be bitwise identical regardless of the number
+    //! of threads; multi-threaded cpu kernels then split the work into a
+    //! fixed number of tiles instead of one adapted to the thread count
+    bool deterministic = false;
 };
 
 /*!
@@ -1431,6 +1431,102 @@ protected:
     void backward_check_exec(const TensorLayout& src, const TensorLayout& dst);
 };
 
+class EmbeddingBagBase : public OperatorBase {
+    DEF_OPR_IMPL_CTOR(EmbeddingBagBase, OperatorBase);
+    DEF_OPR_PARAM(EmbeddingBag);
+
+public:
+    using Mode = Param::Mode;
+    using OffsetMode = Param::OffsetMode;
+
+protected:
+    void check_layout_inp(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& bags, const TensorLayout& per_sample_weights);
+    void deduce_layout_out(
+            const TensorLayout& weight, const TensorLayout& rows, TensorLayout& dst);
+};
+
+/*!
+ * \brief reduce the rows of an embedding table gathered by bags of indices
+ *
+ * The indices are divided into consecutive bags described by *bags*, either as
+ * the start offset or as the length of each bag (see Param::OffsetMode). For
+ * bag b containing indices[s:e]:
+ *
+ * dst[b] = reduce_{s <= i < e}(weight[indices[i]] * per_sample_weights[i])
+ *
+ * where reduce is sum, mean or max; dst[b] is zero for an empty bag.
+ *
+ * \param[in] weight (num_embeddings, dim) embedding table
+ * \param[in] indices (num_indices, ) int32 row indices
+ * \param[in] bags (num_bags, ) int32 offsets or lengths of the bags
+ * \param[in] per_sample_weights (num_indices, ) weight of each index, or an
+ *      empty layout if not given; must be empty in MAX mode
+ * \param[out] dst (num_bags, dim)
+ */
+class EmbeddingBagForward : public EmbeddingBagBase {
+    DEF_OPR_IMPL(EmbeddingBagForward, EmbeddingBagBase, 4, 1);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+            _megdnn_tensor_in per_sample_weights, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) = 0;
+    void deduce_layout(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& bags, const TensorLayout& per_sample_weights,
+            TensorLayout& dst);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& bags, const TensorLayout& per_sample_weights,
+            const TensorLayout& dst) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& bags, const TensorLayout& per_sample_weights,
+            const TensorLayout& dst, size_t workspace_in_bytes);
+};
+using EmbeddingBag = EmbeddingBagForward;
+
+/*!
+ * \brief gradient of EmbeddingBagForward w.r.t. the gathered rows
+ *
+ * grad[i] is the gradient contributed by indices[i] to weight[indices[i]], so
+ * the gradient of weight is the row-sparse tensor (indices, grad) and is never
+ * materialized as a dense table.
+ *
+ * \param[in] weight, indices, bags, per_sample_weights the same as forward;
+ *      weight is only read in MAX mode
+ * \param[in] diff (num_bags, dim) gradient of forward dst
+ * \param[out] grad (num_indices, dim)
+ */
+class EmbeddingBagBackward : public EmbeddingBagBase {
+    DEF_OPR_IMPL(EmbeddingBagBackward, EmbeddingBagBase, 5, 1);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+            _megdnn_tensor_in per_sample_weights, _megdnn_tensor_in diff,
+            _megdnn_tensor_out grad, _megdnn_workspace workspace) = 0;
+    void deduce_layout(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& bags, const TensorLayout& per_sample_weights,
+            const TensorLayout& diff, TensorLayout& grad);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& bags, const TensorLayout& per_sample_weights,
+            const TensorLayout& diff, const TensorLayout& grad) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& bags, const TensorLayout& per_sample_weights,
+            const TensorLayout& diff, const TensorLayout& grad,
+            size_t workspace_in_bytes);
+};
+
 }  // namespace megdnn
 
 #include "megdnn/internal/opr_header_epilogue.h"
@@ -514,6 +514,12 @@ public:
             const ConvBiasForward::BiasMode bias_mode,
             const param::ConvBias::NonlineMode nonline_mode);
 
+    /**
+     * @brief whether there are qint8 nchw88 conv kernels for the host cpu,
+     * which need AVX512-VNNI
+     */
+    static bool is_nchw88_int8_optimized();
+
     static Algorithm::OprType get_opr_type() {
         return Algorithm::OprType::CONVBIAS_FORWARD;
     }
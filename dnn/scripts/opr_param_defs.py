@@ -1212,3 +1212,17 @@ PADDING_MODES = [Doc('REPLICATE = 0', 'aaaaaa|abcdefgh|hhhhhhh'),
           member_alias=[(i, 'PADDING_{}'.format(i)) for i in PADDING_MODES]
           )
 )
+
+(pdef('EmbeddingBag', 'reduce the embedding rows gathered by each bag of indices').
+ add_enum('Mode',
+          Doc('SUM = 0', 'sum of the rows in the bag'),
+          Doc('MEAN = 1', 'sum of the rows divided by the number of indices in '
+              'the bag'),
+          Doc('MAX = 2', 'elementwise max of the rows in the bag')).
+ add_enum('OffsetMode',
+          Doc('OFFSETS = 0', 'the bags input gives the start position of each '
+              'bag in the indices, and the last bag ends at the end of indices'),
+          Doc('LENGTHS = 1', 'the bags input gives the number of indices in '
+              'each bag'),
+          name_field='offset_mode')
+ )
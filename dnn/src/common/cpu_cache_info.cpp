@@ -0,0 +1,233 @@
+/**
+ * \file dnn/src/common/cpu_cache_info.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#include "src/common/cpu_cache_info.h"
+#include "src/common/utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if MEGDNN_X86 && defined(_WIN32)
+// For __cpuidex
+#include <intrin.h>
+#endif
+
+using namespace megdnn;
+
+namespace {
+
+constexpr size_t DEFAULT_L1D_SIZE = 32 * 1024;
+constexpr size_t DEFAULT_L2_SIZE = 256 * 1024;
+//! the share of one core in a 4M last level cache shared by 4 cores
+constexpr size_t DEFAULT_L3_SIZE = 1024 * 1024;
+
+//! \p nr_sharing_cpus is the number of cpus sharing the cache, the l3 size is
+//! divided by it to get the share of one core
+void set_level(CpuCacheInfo& info, size_t level, size_t size, size_t nr_sharing_cpus) {
+    if (level == 1) {
+        info.l1d = size;
+    } else if (level == 2) {
+        info.l2 = size;
+    } else if (level == 3) {
+        info.l3 = size / std::max<size_t>(nr_sharing_cpus, 1);
+    }
+}
+
+#if defined(__linux__) || defined(__ANDROID__)
+//! parse the size in sysfs, such as "32K" or "8M"
+size_t parse_sysfs_size(const std::string& str) {
+    size_t pos = 0;
+    size_t size = 0;
+    while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+        size = size * 10 + (str[pos] - '0');
+        ++pos;
+    }
+    if (pos < str.size()) {
+        if (str[pos] == 'K') {
+            size *= 1024;
+        } else if (str[pos] == 'M') {
+            size *= 1024 * 1024;
+        }
+    }
+    return size;
+}
+
+//! count the cpus in a sysfs cpu list, such as "0-3,8-11"
+size_t parse_sysfs_cpu_list(const std::string& str) {
+    size_t count = 0, pos = 0;
+    auto parse_int = [&]() {
+        size_t ret = 0;
+        while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+            ret = ret * 10 + (str[pos++] - '0');
+        }
+        return ret;
+    };
+    while (pos < str.size()) {
+        size_t first = parse_int(), last = first;
+        if (pos < str.size() && str[pos] == '-') {
+            ++pos;
+            last = parse_int();
+        }
+        count += last >= first ? last - first + 1 : 0;
+        if (pos < str.size() && str[pos] != ',') {
+            break;
+        }
+        ++pos;
+    }
+    return count;
+}
+
+bool detect_by_sysfs(CpuCacheInfo& info) {
+    bool found = false;
+    for (int index = 0;; ++index) {
+        auto dir = ssprintf("/sys/devices/system/cpu/cpu0/cache/index%d/", index);
+        std::ifstream level_file(dir + "level"), type_file(dir + "type"),
+                size_file(dir + "size"), shared_file(dir + "shared_cpu_list");
+        if (!level_file || !type_file || !size_file) {
+            break;
+        }
+        size_t level = 0;
+        std::string type, size, shared;
+        level_file >> level;
+        type_file >> type;
+        size_file >> size;
+        shared_file >> shared;
+        if (type == "Instruction") {
+            continue;
+        }
+        set_level(
+                info, level, parse_sysfs_size(size), parse_sysfs_cpu_list(shared));
+        found = true;
+    }
+    return found;
+}
+#endif
+
+#if MEGDNN_X86
+void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_WIN32)
+    int cpu_info[4];
+    __cpuidex(cpu_info, leaf, subleaf);
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = cpu_info[i];
+    }
+#else
+    asm volatile("cpuid\n"
+                 : "=a"(regs[0]), "=b"(regs[1]), "=c"(regs[2]), "=d"(regs[3])
+                 : "a"(leaf), "c"(subleaf)
+                 : "cc");
+#endif
+}
+
+//! walk the deterministic cache parameters, leaf 4 on intel and 0x8000001d
+//! on amd, both in the same layout
+bool detect_by_cpuid_leaf(CpuCacheInfo& info, uint32_t leaf) {
+    bool found = false;
+    for (uint32_t subleaf = 0; subleaf < 16; ++subleaf) {
+        uint32_t regs[4];
+        cpuid(leaf, subleaf, regs);
+        uint32_t type = regs[0] & 0x1f;
+        if (type == 0) {
+            break;
+        }
+        //! 2 is instruction cache
+        if (type == 2) {
+            continue;
+        }
+        size_t level = (regs[0] >> 5) & 0x7;
+        size_t ways = ((regs[1] >> 22) & 0x3ff) + 1;
+        size_t partitions = ((regs[1] >> 12) & 0x3ff) + 1;
+        size_t line_size = (regs[1] & 0xfff) + 1;
+        size_t sets = static_cast<size_t>(regs[2]) + 1;
+        size_t nr_sharing_cpus = ((regs[0] >> 14) & 0xfff) + 1;
+        set_level(info, level, ways * partitions * line_size * sets, nr_sharing_cpus);
+        found = true;
+    }
+    return found;
+}
+
+bool detect_by_cpuid(CpuCacheInfo& info) {
+    uint32_t regs[4];
+    cpuid(0, 0, regs);
+    if (regs[0] >= 4 && detect_by_cpuid_leaf(info, 4)) {
+        return true;
+    }
+    cpuid(0x80000000, 0, regs);
+    if (regs[0] >= 0x8000001d) {
+        return detect_by_cpuid_leaf(info, 0x8000001d);
+    }
+    return false;
+}
+#endif
+
+CpuCacheInfo detect_cpu_cache_info() {
+    CpuCacheInfo info;
+    bool found = false;
+#if defined(__linux__) || defined(__ANDROID__)
+    found = detect_by_sysfs(info);
+#endif
+#if MEGDNN_X86
+    if (!found) {
+        found = detect_by_cpuid(info);
+    }
+#endif
+    MEGDNN_MARK_USED_VAR(found);
+    if (!info.l1d) {
+        info.l1d = DEFAULT_L1D_SIZE;
+    }
+    if (!info.l2) {
+        info.l2 = std::max(DEFAULT_L2_SIZE, info.l1d);
+    }
+    if (!info.l3) {
+        info.l3 = std::max(DEFAULT_L3_SIZE, info.l2);
+    }
+    return info;
+}
+
+//! the override is read without locking by every cpu_cache_info() call, so
+//! it is published through an atomic ptr; the overridden values are never
+//! freed before exit, as a reader may still be copying a replaced one
+struct CacheInfoOverride {
+    DNN_MUTEX mtx;
+    std::vector<std::unique_ptr<const CpuCacheInfo>> storage;
+    std::atomic<const CpuCacheInfo*> info{nullptr};
+};
+
+CacheInfoOverride& cache_info_override() {
+    static CacheInfoOverride ret;
+    return ret;
+}
+
+}  // anonymous namespace
+
+CpuCacheInfo megdnn::cpu_cache_info() {
+    static const CpuCacheInfo detected = detect_cpu_cache_info();
+    auto info = cache_info_override().info.load(std::memory_order_acquire);
+    return info ? *info : detected;
+}
+
+void megdnn::set_cpu_cache_info(const CpuCacheInfo* info) {
+    auto&& override_info = cache_info_override();
+    MEGDNN_LOCK_GUARD(override_info.mtx);
+    const CpuCacheInfo* ptr = nullptr;
+    if (info) {
+        override_info.storage.emplace_back(new CpuCacheInfo(*info));
+        ptr = override_info.storage.back().get();
+    }
+    override_info.info.store(ptr, std::memory_order_release);
+}
+
+// vim: syntax=cpp.doxygen
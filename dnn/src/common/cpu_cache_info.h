@@ -0,0 +1,46 @@
+/**
+ * \file dnn/src/common/cpu_cache_info.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace megdnn {
+
+/*!
+ * \brief data cache sizes in bytes available to one core, 0 if the level is
+ *      absent
+ *
+ * l1d and l2 are the sizes of the caches of a core. l3 is usually shared by
+ * several cores, so it is the size of the cache divided by the number of cpus
+ * sharing it.
+ */
+struct CpuCacheInfo {
+    size_t l1d = 0;
+    size_t l2 = 0;
+    size_t l3 = 0;
+};
+
+/*!
+ * \brief the cache sizes of the host cpu
+ *
+ * They are read from sysfs on linux, and from cpuid on x86 when sysfs is
+ * unavailable. The levels failed to detect are filled by conservative
+ * defaults, so all the returned sizes are non-zero.
+ */
+CpuCacheInfo cpu_cache_info();
+
+//! override the detected cache sizes, for testing; nullptr to restore
+void set_cpu_cache_info(const CpuCacheInfo* info);
+
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
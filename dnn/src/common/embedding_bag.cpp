@@ -0,0 +1,101 @@
+/**
+ * \file dnn/src/common/embedding_bag.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "megdnn/oprs.h"
+
+#include "src/common/utils.h"
+
+using namespace megdnn;
+
+void EmbeddingBagBase::check_layout_inp(
+        const TensorLayout& weight, const TensorLayout& indices,
+        const TensorLayout& bags, const TensorLayout& per_sample_weights) {
+    auto errmsg = [&]() -> std::string {
+        return ssprintf(
+                "bad layout for EmbeddingBag: weight=%s indices=%s bags=%s "
+                "per_sample_weights=%s",
+                weight.to_string().c_str(), indices.to_string().c_str(),
+                bags.to_string().c_str(), per_sample_weights.to_string().c_str());
+    };
+    MEGDNN_MARK_USED_VAR(errmsg);
+    megdnn_assert(
+            weight.ndim == 2 && weight.is_contiguous() &&
+                    weight.dtype.category() == DTypeCategory::FLOAT,
+            "%s", errmsg().c_str());
+    megdnn_assert(
+            indices.ndim == 1 && indices.is_contiguous() &&
+                    indices.dtype == dtype::Int32(),
+            "%s", errmsg().c_str());
+    megdnn_assert(
+            bags.ndim == 1 && bags.is_contiguous() && bags.dtype == dtype::Int32(),
+            "%s", errmsg().c_str());
+    if (per_sample_weights.ndim) {
+        megdnn_assert(
+                param().mode != Mode::MAX,
+                "per_sample_weights is not supported in MAX mode of EmbeddingBag");
+        megdnn_assert(
+                per_sample_weights.is_contiguous() &&
+                        per_sample_weights.eq_shape(indices),
+                "%s", errmsg().c_str());
+        megdnn_assert_eq_dtype(weight, per_sample_weights);
+    }
+}
+
+void EmbeddingBagBase::deduce_layout_out(
+        const TensorLayout& weight, const TensorLayout& rows, TensorLayout& dst) {
+    dst = TensorLayout{{rows.shape[0], weight.shape[1]}, weight.dtype};
+}
+
+void EmbeddingBagForward::deduce_layout(
+        const TensorLayout& weight, const TensorLayout& indices,
+        const TensorLayout& bags, const TensorLayout& per_sample_weights,
+        TensorLayout& dst) {
+    check_layout_inp(weight, indices, bags, per_sample_weights);
+    deduce_layout_out(weight, bags, dst);
+}
+
+void EmbeddingBagForward::check_exec(
+        const TensorLayout& weight, const TensorLayout& indices,
+        const TensorLayout& bags, const TensorLayout& per_sample_weights,
+        const TensorLayout& dst, size_t workspace_in_bytes) {
+    TensorLayout dst_expected;
+    deduce_layout(weight, indices, bags, per_sample_weights, dst_expected);
+    megdnn_assert_eq_layout(dst_expected, dst);
+    auto required_workspace_in_bytes =
+            get_workspace_in_bytes(weight, indices, bags, per_sample_weights, dst);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+void EmbeddingBagBackward::deduce_layout(
+        const TensorLayout& weight, const TensorLayout& indices,
+        const TensorLayout& bags, const TensorLayout& per_sample_weights,
+        const TensorLayout& diff, TensorLayout& grad) {
+    check_layout_inp(weight, indices, bags, per_sample_weights);
+    TensorLayout diff_expected;
+    deduce_layout_out(weight, bags, diff_expected);
+    megdnn_assert_eq_layout(diff_expected, diff);
+    deduce_layout_out(weight, indices, grad);
+}
+
+void EmbeddingBagBackward::check_exec(
+        const TensorLayout& weight, const TensorLayout& indices,
+        const TensorLayout& bags, const TensorLayout& per_sample_weights,
+        const TensorLayout& diff, const TensorLayout& grad,
+        size_t workspace_in_bytes) {
+    TensorLayout grad_expected;
+    deduce_layout(weight, indices, bags, per_sample_weights, diff, grad_expected);
+    megdnn_assert_eq_layout(grad_expected, grad);
+    auto required_workspace_in_bytes = get_workspace_in_bytes(
+            weight, indices, bags, per_sample_weights, diff, grad);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+// vim: syntax=cpp.doxygen
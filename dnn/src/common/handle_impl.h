@@ -209,7 +209,9 @@ private:
     cb(LSQBackward) \
     cb(Fill) \
     cb(PaddingForward) \
-    cb(PaddingBackward)
+    cb(PaddingBackward) \
+    cb(EmbeddingBagForward) \
+    cb(EmbeddingBagBackward)
 // clang-format on
 
 /*!
@@ -11,6 +11,9 @@
  */
 #include "src/common/nchw_nchwxx_valid.h"
 #include "megdnn/oprs/nn.h"
+#if MEGDNN_X86
+#include "src/x86/utils.h"
+#endif
 using namespace megdnn;
 namespace {
 using NchwNchwxxFuncInterface = std::function<bool(
@@ -25,6 +28,7 @@ static SmallVector<NchwNchwxxFuncInterface> g_func_vec{
         nchw_nchwxx_valid<NchwNchwxxType::NCHW44_INT8_INT8_INT16>,
         nchw_nchwxx_valid<NchwNchwxxType::NCHW44_INT8_DOT>,
         nchw_nchwxx_valid<NchwNchwxxType::NCHW88>,
+        nchw_nchwxx_valid<NchwNchwxxType::NCHW88_INT8>,
 };
 }  // namespace
 bool ConvBiasForward::is_nchw_nchwxx_optimized(
@@ -39,4 +43,12 @@ bool ConvBiasForward::is_nchw_nchwxx_optimized(
         }
     }
     return false;
+}
+
+bool ConvBiasForward::is_nchw88_int8_optimized() {
+#if MEGDNN_X86
+    return x86::is_supported(x86::SIMDType::VNNI);
+#else
+    return false;
+#endif
 }
\ No newline at end of file
@@ -21,6 +21,7 @@ enum NchwNchwxxType {
     NCHW44_INT8_INT8_INT16,
     NCHW44_INT8_DOT,
     NCHW88,
+    NCHW88_INT8,
 };
 template <NchwNchwxxType T>
 static inline bool nchw_nchwxx_valid(
@@ -152,5 +153,31 @@ inline bool nchw_nchwxx_valid<NCHW88>(
     return avaible;
 }
 
+template <>
+inline bool nchw_nchwxx_valid<NCHW88_INT8>(
+        const DTypeEnum src_dtype, const DTypeEnum filter_dtype,
+        const DTypeEnum dst_dtype,
+        const ConvolutionBase<param::Convolution>::CanonizedFilterMeta& fm,
+        const BiasMode bias_mode, const param::ConvBias::NonlineMode nonline_mode) {
+    bool ok_type = ((src_dtype == DTypeEnum::QuantizedS8 &&
+                     filter_dtype == DTypeEnum::QuantizedS8 &&
+                     (dst_dtype == DTypeEnum::QuantizedS8))) &&
+                   (fm.format == param::Convolution::Format::NCHW88);
+    bool ok_nonline = nonline_mode == param::ConvBias::NonlineMode::IDENTITY ||
+                      nonline_mode == param::ConvBias::NonlineMode::RELU ||
+                      nonline_mode == param::ConvBias::NonlineMode::H_SWISH;
+    bool ok_src_dst =
+            fm.icpg < 8 && (fm.ocpg % 8 == 0 && fm.ocpg >= 8) && fm.group == 1;
+    bool ok_slide = fm.dilation[0] == 1 && fm.dilation[1] == 1 &&
+                    fm.stride[0] == fm.stride[1] &&
+                    (fm.stride[0] == 1 || fm.stride[0] == 2);
+    bool ok_conv = !fm.should_flip && bias_mode != BiasMode::BIAS;
+    //! the int8 nchw88 kernels are built on vpdpbusd
+    bool ok_isa = ConvBiasForward::is_nchw88_int8_optimized();
+    bool avaible =
+            ok_type && ok_nonline && ok_src_dst && ok_slide && ok_conv && ok_isa;
+    return avaible;
+}
+
 }  // namespace
 }  // namespace megdnn
\ No newline at end of file
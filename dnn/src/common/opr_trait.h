@@ -29,6 +29,8 @@ struct OprTrait {};
 
 DEF(Padding, 2, false, true);
 DEF(PaddingBackward, 2, false, false);
+DEF(EmbeddingBagForward, 5, true, true);
+DEF(EmbeddingBagBackward, 6, true, true);
 DEF(ConvolutionForward, 3, true, true);
 DEF(Convolution3DForward, 3, true, true);
 DEF(ConvolutionBackwardData, 3, true, false);
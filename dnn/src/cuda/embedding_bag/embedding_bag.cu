@@ -0,0 +1,197 @@
+/**
+ * \file dnn/src/cuda/embedding_bag/embedding_bag.cu
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#include "./embedding_bag.cuh"
+#include "src/cuda/cub/device/device_scan.cuh"
+
+#include <algorithm>
+
+using namespace megdnn;
+using namespace cuda;
+using namespace embedding_bag;
+
+namespace {
+
+constexpr uint32_t MODE_MEAN = 1, MODE_MAX = 2;
+
+__device__ __forceinline__ void get_bag_range(
+        const dt_int32* offsets, uint32_t bag, const KernParam& param, int& begin,
+        int& end) {
+    begin = offsets[bag];
+    end = bag + 1 < param.nr_bags ? offsets[bag + 1]
+                                  : static_cast<int>(param.nr_indices);
+    //! the first bag starts at 0 and, in LENGTHS mode, the last one ends at
+    //! nr_indices only if the lengths sum up to nr_indices
+    bool bad_bound = (!bag && begin) ||
+                     (param.lengths && end - begin != param.lengths[bag]);
+    if (bad_bound || begin < 0 || begin > end ||
+        end > static_cast<int>(param.nr_indices)) {
+        set_async_error_info(
+                param.error_info, param.error_tracker,
+                "invalid EmbeddingBag offsets: bag=%d begin=%d end=%d", bag, begin,
+                end);
+        begin = end = 0;
+    }
+}
+
+__device__ __forceinline__ bool check_index(int idx, const KernParam& param) {
+    if (idx < 0 || static_cast<uint32_t>(idx) >= param.nr_rows) {
+        set_async_error_info(
+                param.error_info, param.error_tracker,
+                "invalid EmbeddingBag index: %d, num_embeddings=%d", idx,
+                param.nr_rows);
+        return false;
+    }
+    return true;
+}
+
+//! one block per bag, threads iterate over the embedding dim
+template <typename T>
+__global__ void forward_kernel(
+        const T* weight, const dt_int32* indices, const dt_int32* offsets,
+        const T* per_sample_weights, T* dst, KernParam param) {
+    uint32_t bag = blockIdx.x;
+    int begin, end;
+    get_bag_range(offsets, bag, param, begin, end);
+    T* out = dst + bag * param.dim;
+    for (uint32_t d = threadIdx.x; d < param.dim; d += blockDim.x) {
+        float acc = 0.f;
+        for (int i = begin; i < end; ++i) {
+            int idx = indices[i];
+            if (!check_index(idx, param)) {
+                continue;
+            }
+            float val = static_cast<float>(weight[idx * param.dim + d]);
+            if (param.mode == MODE_MAX) {
+                acc = i == begin ? val : fmaxf(acc, val);
+            } else {
+                float scale = per_sample_weights
+                                    ? static_cast<float>(per_sample_weights[i])
+                                    : 1.f;
+                acc += val * scale;
+            }
+        }
+        if (param.mode == MODE_MEAN && end > begin) {
+            acc /= static_cast<float>(end - begin);
+        }
+        out[d] = static_cast<T>(acc);
+    }
+}
+
+template <typename T>
+__global__ void backward_kernel(
+        const T* weight, const dt_int32* indices, const dt_int32* offsets,
+        const T* per_sample_weights, const T* diff, T* grad, KernParam param) {
+    uint32_t bag = blockIdx.x;
+    int begin, end;
+    get_bag_range(offsets, bag, param, begin, end);
+    const T* og = diff + bag * param.dim;
+    for (uint32_t d = threadIdx.x; d < param.dim; d += blockDim.x) {
+        float g = static_cast<float>(og[d]);
+        if (param.mode == MODE_MAX) {
+            int arg = begin;
+            float max_val = 0.f;
+            for (int i = begin; i < end; ++i) {
+                int idx = indices[i];
+                float val = check_index(idx, param)
+                                  ? static_cast<float>(weight[idx * param.dim + d])
+                                  : 0.f;
+                if (i == begin || val > max_val) {
+                    max_val = val;
+                    arg = i;
+                }
+                grad[i * param.dim + d] = static_cast<T>(0.f);
+            }
+            if (end > begin) {
+                grad[arg * param.dim + d] = static_cast<T>(g);
+            }
+            continue;
+        }
+        if (param.mode == MODE_MEAN && end > begin) {
+            g /= static_cast<float>(end - begin);
+        }
+        for (int i = begin; i < end; ++i) {
+            float scale =
+                    per_sample_weights ? static_cast<float>(per_sample_weights[i]) : 1.f;
+            grad[i * param.dim + d] = static_cast<T>(g * scale);
+        }
+    }
+}
+
+uint32_t get_nr_threads(uint32_t dim) {
+    return std::min<uint32_t>(NR_THREADS, DIVUP(dim, 32) * 32);
+}
+
+}  // anonymous namespace
+
+size_t embedding_bag::get_workspace_in_bytes_lengths(uint32_t nr_bags) {
+    size_t wk_size = 0;
+    cuda_check(cub::DeviceScan::ExclusiveSum(
+            NULL, wk_size, static_cast<const dt_int32*>(NULL),
+            static_cast<dt_int32*>(NULL), nr_bags));
+    return wk_size;
+}
+
+void embedding_bag::lengths_to_offsets(
+        const dt_int32* lengths, dt_int32* offsets, uint32_t nr_bags,
+        void* workspace, size_t workspace_size, cudaStream_t stream) {
+    cuda_check(cub::DeviceScan::ExclusiveSum(
+            workspace, workspace_size, lengths, offsets, nr_bags, stream));
+}
+
+template <typename T>
+void embedding_bag::forward_proxy(
+        const T* weight, const dt_int32* indices, const dt_int32* offsets,
+        const T* per_sample_weights, T* dst, const KernParam& param,
+        cudaStream_t stream) {
+    if (!param.nr_bags) {
+        return;
+    }
+    forward_kernel<T><<<param.nr_bags, get_nr_threads(param.dim), 0, stream>>>(
+            weight, indices, offsets, per_sample_weights, dst, param);
+    after_kernel_launch();
+}
+
+template <typename T>
+void embedding_bag::backward_proxy(
+        const T* weight, const dt_int32* indices, const dt_int32* offsets,
+        const T* per_sample_weights, const T* diff, T* grad, const KernParam& param,
+        cudaStream_t stream) {
+    if (!param.nr_bags) {
+        return;
+    }
+    backward_kernel<T><<<param.nr_bags, get_nr_threads(param.dim), 0, stream>>>(
+            weight, indices, offsets, per_sample_weights, diff, grad, param);
+    after_kernel_launch();
+}
+
+namespace megdnn {
+namespace cuda {
+namespace embedding_bag {
+
+#define INST(_dt)                                                                \
+    template void forward_proxy<DTypeTrait<_dt>::ctype>(                         \
+            const DTypeTrait<_dt>::ctype*, const dt_int32*, const dt_int32*,     \
+            const DTypeTrait<_dt>::ctype*, DTypeTrait<_dt>::ctype*,              \
+            const KernParam&, cudaStream_t);                                     \
+    template void backward_proxy<DTypeTrait<_dt>::ctype>(                        \
+            const DTypeTrait<_dt>::ctype*, const dt_int32*, const dt_int32*,     \
+            const DTypeTrait<_dt>::ctype*, const DTypeTrait<_dt>::ctype*,        \
+            DTypeTrait<_dt>::ctype*, const KernParam&, cudaStream_t);
+
+MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(INST)
+
+#undef INST
+
+}  // namespace embedding_bag
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,62 @@
+/**
+ * \file dnn/src/cuda/embedding_bag/embedding_bag.cuh
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#pragma once
+
+#include "src/cuda/error_info.cuh"
+#include "src/cuda/utils.cuh"
+
+namespace megdnn {
+namespace cuda {
+namespace embedding_bag {
+
+struct KernParam {
+    uint32_t nr_rows, dim, nr_bags, nr_indices;
+    //! 0 for SUM, 1 for MEAN, 2 for MAX; see param::EmbeddingBag::Mode
+    uint32_t mode;
+    //! bag lengths in LENGTHS mode, nullptr in OFFSETS mode
+    const dt_int32* lengths;
+    void* error_tracker;
+    AsyncErrorInfo* error_info;
+};
+
+//! workspace needed by lengths_to_offsets()
+size_t get_workspace_in_bytes_lengths(uint32_t nr_bags);
+
+/*!
+ * \brief compute start offsets of bags from their lengths by exclusive scan
+ *
+ * \param offsets output of nr_bags elements
+ */
+void lengths_to_offsets(
+        const dt_int32* lengths, dt_int32* offsets, uint32_t nr_bags,
+        void* workspace, size_t workspace_size, cudaStream_t stream);
+
+/*!
+ * \brief bag b contains indices[offsets[b]:offsets[b + 1]], where
+ *      offsets[nr_bags] is implicitly nr_indices
+ */
+template <typename T>
+void forward_proxy(
+        const T* weight, const dt_int32* indices, const dt_int32* offsets,
+        const T* per_sample_weights, T* dst, const KernParam& param,
+        cudaStream_t stream);
+
+template <typename T>
+void backward_proxy(
+        const T* weight, const dt_int32* indices, const dt_int32* offsets,
+        const T* per_sample_weights, const T* diff, T* grad, const KernParam& param,
+        cudaStream_t stream);
+
+}  // namespace embedding_bag
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
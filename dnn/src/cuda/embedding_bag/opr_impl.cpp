@@ -0,0 +1,141 @@
+/**
+ * \file dnn/src/cuda/embedding_bag/opr_impl.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "./opr_impl.h"
+#include "./embedding_bag.cuh"
+
+#include "src/common/utils.h"
+#include "src/cuda/utils.h"
+
+using namespace megdnn;
+using namespace cuda;
+
+namespace {
+
+using OffsetMode = param::EmbeddingBag::OffsetMode;
+
+WorkspaceBundle get_bundle(
+        void* ptr, const TensorLayout& bags, const param::EmbeddingBag& param) {
+    if (param.offset_mode == OffsetMode::OFFSETS) {
+        return {ptr, {}};
+    }
+    size_t nr_bags = bags.shape[0];
+    return {ptr,
+            {nr_bags * sizeof(dt_int32),
+             embedding_bag::get_workspace_in_bytes_lengths(nr_bags)}};
+}
+
+/*!
+ * \brief get start offsets of all bags on device; bags are used directly in
+ *      OFFSETS mode and scanned into the workspace in LENGTHS mode
+ */
+const dt_int32* get_offsets(
+        const TensorND& bags, const WorkspaceBundle& bundle,
+        const param::EmbeddingBag& param, cudaStream_t stream) {
+    if (param.offset_mode == OffsetMode::OFFSETS) {
+        return bags.ptr<dt_int32>();
+    }
+    auto offsets = static_cast<dt_int32*>(bundle.get(0));
+    embedding_bag::lengths_to_offsets(
+            bags.ptr<dt_int32>(), offsets, bags.layout.shape[0], bundle.get(1),
+            bundle.get_size(1), stream);
+    return offsets;
+}
+
+embedding_bag::KernParam make_kern_param(
+        const TensorLayout& weight, const TensorLayout& indices, const TensorND& bags,
+        const param::EmbeddingBag& param, void* error_tracker, Handle* handle) {
+    embedding_bag::KernParam ret;
+    ret.nr_rows = weight.shape[0];
+    ret.dim = weight.shape[1];
+    ret.nr_bags = bags.layout.shape[0];
+    ret.nr_indices = indices.shape[0];
+    ret.mode = static_cast<uint32_t>(param.mode);
+    ret.lengths =
+            param.offset_mode == OffsetMode::LENGTHS ? bags.ptr<dt_int32>() : nullptr;
+    ret.error_tracker = error_tracker;
+    ret.error_info = async_error_info(handle);
+    return ret;
+}
+
+}  // anonymous namespace
+
+size_t EmbeddingBagForwardImpl::get_workspace_in_bytes(
+        const TensorLayout&, const TensorLayout&, const TensorLayout& bags,
+        const TensorLayout&, const TensorLayout&) {
+    return get_bundle(nullptr, bags, param()).total_size_in_bytes();
+}
+
+void EmbeddingBagForwardImpl::exec(
+        _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+        _megdnn_tensor_in per_sample_weights, _megdnn_tensor_out dst,
+        _megdnn_workspace workspace) {
+    check_exec(
+            weight.layout, indices.layout, bags.layout, per_sample_weights.layout,
+            dst.layout, workspace.size);
+    auto stream = cuda_stream(handle());
+    auto bundle = get_bundle(workspace.raw_ptr, bags.layout, param());
+    auto offsets = get_offsets(bags, bundle, param(), stream);
+    auto kern_param = make_kern_param(
+            weight.layout, indices.layout, bags, param(), m_error_tracker, handle());
+#define cb(_dt)                                                                  \
+    case DTypeTrait<_dt>::enumv: {                                               \
+        using ctype = DTypeTrait<_dt>::ctype;                                    \
+        return embedding_bag::forward_proxy<ctype>(                              \
+                weight.ptr<ctype>(), indices.ptr<dt_int32>(), offsets,           \
+                per_sample_weights.layout.ndim ? per_sample_weights.ptr<ctype>() \
+                                               : nullptr,                        \
+                dst.ptr<ctype>(), kern_param, stream);                           \
+    }
+    switch (weight.layout.dtype.enumv()) {
+        MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+        default:
+            megdnn_throw("bad dtype");
+    }
+#undef cb
+}
+
+size_t EmbeddingBagBackwardImpl::get_workspace_in_bytes(
+        const TensorLayout&, const TensorLayout&, const TensorLayout& bags,
+        const TensorLayout&, const TensorLayout&, const TensorLayout&) {
+    return get_bundle(nullptr, bags, param()).total_size_in_bytes();
+}
+
+void EmbeddingBagBackwardImpl::exec(
+        _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+        _megdnn_tensor_in per_sample_weights, _megdnn_tensor_in diff,
+        _megdnn_tensor_out grad, _megdnn_workspace workspace) {
+    check_exec(
+            weight.layout, indices.layout, bags.layout, per_sample_weights.layout,
+            diff.layout, grad.layout, workspace.size);
+    auto stream = cuda_stream(handle());
+    auto bundle = get_bundle(workspace.raw_ptr, bags.layout, param());
+    auto offsets = get_offsets(bags, bundle, param(), stream);
+    auto kern_param = make_kern_param(
+            weight.layout, indices.layout, bags, param(), m_error_tracker, handle());
+#define cb(_dt)                                                                  \
+    case DTypeTrait<_dt>::enumv: {                                               \
+        using ctype = DTypeTrait<_dt>::ctype;                                    \
+        return embedding_bag::backward_proxy<ctype>(                             \
+                weight.ptr<ctype>(), indices.ptr<dt_int32>(), offsets,           \
+                per_sample_weights.layout.ndim ? per_sample_weights.ptr<ctype>() \
+                                               : nullptr,                        \
+                diff.ptr<ctype>(), grad.ptr<ctype>(), kern_param, stream);       \
+    }
+    switch (weight.layout.dtype.enumv()) {
+        MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+        default:
+            megdnn_throw("bad dtype");
+    }
+#undef cb
+}
+
+// vim: syntax=cpp.doxygen
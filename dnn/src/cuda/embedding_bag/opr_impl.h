@@ -0,0 +1,53 @@
+/**
+ * \file dnn/src/cuda/embedding_bag/opr_impl.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#pragma once
+
+#include "megdnn/oprs.h"
+
+namespace megdnn {
+namespace cuda {
+
+class EmbeddingBagForwardImpl final : public EmbeddingBagForward {
+    void* m_error_tracker = nullptr;
+
+public:
+    using EmbeddingBagForward::EmbeddingBagForward;
+    void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+            _megdnn_tensor_in per_sample_weights, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout& bags,
+            const TensorLayout&, const TensorLayout&) override;
+
+    void set_error_tracker(void* tracker) override { m_error_tracker = tracker; }
+};
+
+class EmbeddingBagBackwardImpl final : public EmbeddingBagBackward {
+    void* m_error_tracker = nullptr;
+
+public:
+    using EmbeddingBagBackward::EmbeddingBagBackward;
+    void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+            _megdnn_tensor_in per_sample_weights, _megdnn_tensor_in diff,
+            _megdnn_tensor_out grad, _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout& bags,
+            const TensorLayout&, const TensorLayout&, const TensorLayout&) override;
+
+    void set_error_tracker(void* tracker) override { m_error_tracker = tracker; }
+};
+
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -36,6 +36,7 @@
 #include "src/cuda/dot/opr_impl.h"
 #include "src/cuda/elemwise/opr_impl.h"
 #include "src/cuda/elemwise_multi_type/opr_impl.h"
+#include "src/cuda/embedding_bag/opr_impl.h"
 #include "src/cuda/eye/opr_impl.h"
 #include "src/cuda/fake_quant/opr_impl.h"
 #include "src/cuda/fill/opr_impl.h"
@@ -11,11 +11,13 @@
  */
 
 #include "src/fallback/conv_bias/conv1x1/algos.h"
+#include "src/common/cpu_cache_info.h"
 #include "src/common/opr_delegate.h"
 #include "src/fallback/conv_bias/common.h"
 #include "src/fallback/conv_bias/conv1x1/conv1x1_dispatcher.h"
 #include "src/fallback/conv_bias/conv1x1/conv1x1_strategy.h"
 #include "src/fallback/conv_bias/opr_impl.h"
+#include "src/fallback/matrix_mul/cache_blocking.h"
 
 #include "megdnn/opr_param_defs.h"
 #include "src/naive/convolution/helper.h"
@@ -43,9 +45,19 @@ size_t ConvBiasImpl::AlgoConv1x1::get_oc_tile_size_heuristic(
     size_t OH = param.osz[0];
     size_t OW = param.osz[1];
     size_t OC = param.filter_meta.ocpg;
-    if (OH * OW >= 56 * 56 || OC >= 64)
-        return m_oc_block_size;
-    size_t oc_block_size_one_thread = div_ceil(OC, param.nr_threads);
+    if (OH * OW >= 56 * 56 || OC >= 64) {
+        if (m_oc_block_size != AUTO_OC_TILE_SIZE)
+            return m_oc_block_size;
+        //! keep the packed filter tile in half of L2 while streaming the src,
+        //! but not less tiles than threads
+        size_t IC = param.filter_meta.icpg;
+        size_t oc_tile_size = megdnn::matmul::get_cache_tile_size(
+                cpu_cache_info().l2 / 2, param.filter_type.size(IC), 24, 24, 192);
+        return std::min(
+                oc_tile_size,
+                round_up<size_t>(div_ceil(OC, param.nr_split_threads()), 24));
+    }
+    size_t oc_block_size_one_thread = div_ceil(OC, param.nr_split_threads());
     return round_up<size_t>(oc_block_size_one_thread, 24);
 }
 
@@ -19,6 +19,12 @@
 namespace megdnn {
 namespace fallback {
 
+namespace conv1x1 {
+//! the oc_block_size of AlgoConv1x1 deriving the oc tile size from the cache
+//! sizes of the host
+constexpr size_t AUTO_OC_TILE_SIZE = 0;
+}  // namespace conv1x1
+
 class ConvBiasImpl::AlgoConv1x1 final : public AlgoBase {
     WorkspaceBundle get_bundle_according_packmode(const NCBKernSizeParam& param) const;
     SmallVector<NCBKern> get_kerns_according_packmode(
@@ -32,7 +38,12 @@ public:
 
     const char* name() const override {
         if (m_name.empty()) {
-            m_name = ssprintf("CONV1x1:%s:%zu", m_matmul_algo->name(), m_oc_block_size);
+            if (m_oc_block_size == conv1x1::AUTO_OC_TILE_SIZE) {
+                m_name = ssprintf("CONV1x1:%s:AUTO", m_matmul_algo->name());
+            } else {
+                m_name = ssprintf(
+                        "CONV1x1:%s:%zu", m_matmul_algo->name(), m_oc_block_size);
+            }
         }
         return m_name.c_str();
     }
@@ -231,7 +231,7 @@ size_t ConvBiasImpl::AlgoConv1x1Gemv::get_oc_tile_size_heuristic(
             megdnn_fallback_conv1x1_gemv,
             midout_iv("AlgoConv1x1Gemv::get_oc_tile"_hash)) {
         size_t OC = param.filter_meta.ocpg;
-        size_t oc_block_size_one_thread = div_ceil(OC, param.nr_threads);
+        size_t oc_block_size_one_thread = div_ceil(OC, param.nr_split_threads());
         return round_up<size_t>(oc_block_size_one_thread, 16);
     }
     MIDOUT_END();
@@ -14,11 +14,45 @@
 #include "src/fallback/conv_bias/conv1x1/conv1x1_strategy.h"
 #include "src/fallback/conv_bias/conv1x1/conv1x1_utils.h"
 #include "src/fallback/conv_bias/opr_impl.h"
+#include "src/fallback/conv_bias/tile_dataflow.h"
 
 namespace megdnn {
 namespace fallback {
 namespace conv1x1 {
 
+/*!
+ * \brief fuse the packA and packB kerns into the compute kern with multiple
+ * threads, so a compute tile only waits for the packA of its oc block and the
+ * packB of its batch instead of a barrier
+ *
+ * \param kerns the kerns in the order of packA (if has_packA), packB (if
+ *      has_packB) and compute
+ */
+inline SmallVector<ConvBiasImpl::NCBKern> fuse_conv1x1_kerns(
+        const ConvBiasImpl::NCBKernSizeParam& param,
+        const SmallVector<ConvBiasImpl::NCBKern>& kerns, bool has_packA,
+        bool has_packB, size_t oc_blocks_per_group) {
+    if (param.nr_threads <= 1 || kerns.size() <= 1) {
+        return kerns;
+    }
+    SmallVector<ConvBiasImpl::NCBKern> producers(kerns.begin(), kerns.end() - 1);
+    auto deps = [=](const CpuNDRange& ndrange_id) {
+        size_t batch_id = ndrange_id[0], group_id = ndrange_id[1],
+               oc_block_id = ndrange_id[2];
+        SmallVector<TileRange> ranges;
+        size_t kern_id = 0;
+        if (has_packA) {
+            size_t tile = group_id * oc_blocks_per_group + oc_block_id;
+            ranges.push_back({kern_id++, tile, tile + 1});
+        }
+        if (has_packB) {
+            ranges.push_back({kern_id++, batch_id, batch_id + 1});
+        }
+        return ranges;
+    };
+    return {fuse_kerns_by_tile(producers, kerns.back(), deps)};
+}
+
 template <MatrixMulImpl::AlgoBase::PackMode pack_mode>
 class Conv1x1Kerns;
 
@@ -97,7 +131,9 @@ public:
         }
         ret_kern.push_back({kern_packB, {BATCH}});
         ret_kern.push_back({kern_compt, {BATCH, GROUP, oc_blocks_per_group}});
-        return ret_kern;
+        return fuse_conv1x1_kerns(
+                param, ret_kern, !is_enable_filter_preprocess(param), true,
+                oc_blocks_per_group);
     }
     SmallVector<ConvBiasImpl::NCBKern> get_kern_preprocess(
             const ConvBiasImpl::NCBKernSizeParam& param, WorkspaceBundle& whole_bundle,
@@ -180,7 +216,9 @@ public:
             ret_kern.push_back({kern_packA, {GROUP, oc_blocks_per_group}});
         }
         ret_kern.push_back({kern_compt, {BATCH, GROUP, oc_blocks_per_group}});
-        return ret_kern;
+        return fuse_conv1x1_kerns(
+                param, ret_kern, !is_enable_filter_preprocess(param), false,
+                oc_blocks_per_group);
     }
     SmallVector<ConvBiasImpl::NCBKern> get_kern_preprocess(
             const ConvBiasImpl::NCBKernSizeParam& param, WorkspaceBundle& whole_bundle,
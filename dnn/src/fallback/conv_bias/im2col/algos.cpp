@@ -10,12 +10,14 @@
  */
 #include "megdnn/opr_param_defs.h"
 
+#include "src/common/cpu_cache_info.h"
 #include "src/common/opr_delegate.h"
 #include "src/fallback/conv_bias/common.h"
 #include "src/fallback/conv_bias/im2col/algos.h"
 #include "src/fallback/conv_bias/im2col/factory.h"
 #include "src/fallback/conv_bias/im2col/im2col_kerns.h"
 #include "src/fallback/conv_bias/opr_impl.h"
+#include "src/fallback/matrix_mul/cache_blocking.h"
 #include "src/naive/convolution/helper.h"
 
 #include "midout.h"
@@ -78,11 +80,25 @@ static void choice_ohw_oc_block(
     //! when oc_tile_size < this value oc_tile_size =
     //! DEFAULT_OC_MIN_TILE_SIZE the purpose is aligning the calculation
     size_t DEFAULT_OC_MIN_TILE_SIZE = round_up(static_cast<size_t>(128), block_m);
-    size_t nr_threads = param.nr_threads;
+    //! the largest ohw_tile_size derived from the cache size
+    size_t DEFAULT_OHW_MAX_TILE_SIZE = round_up(static_cast<size_t>(1024), block_n);
+    size_t nr_threads = param.nr_split_threads();
     size_t OC = param.filter_meta.ocpg;
     size_t ohw = param.osz[0] * param.osz[1];
     oc_tile_size = DEFAULT_OC_TILE_SIZE;
     ohw_tile_size = m_ohw_tile_size;
+    if (m_ohw_tile_size == AUTO_OHW_TILE_SIZE) {
+        //! the packed filter tile and the im2col tile take half of L2 each
+        size_t K = param.filter_meta.icpg * param.filter_meta.spatial[0] *
+                   param.filter_meta.spatial[1];
+        size_t half_l2 = cpu_cache_info().l2 / 2;
+        oc_tile_size = megdnn::matmul::get_cache_tile_size(
+                half_l2, param.filter_type.size(K), block_m,
+                DEFAULT_OC_MIN_TILE_SIZE, DEFAULT_OC_MAX_TILE_SIZE);
+        ohw_tile_size = megdnn::matmul::get_cache_tile_size(
+                half_l2, param.src_type.size(K), block_n,
+                DEFAULT_OHW_MIN_TILE_SIZE, DEFAULT_OHW_MAX_TILE_SIZE);
+    }
 
     oc_tile_size = std::min(oc_tile_size, OC);
     ohw_tile_size = std::min(ohw_tile_size, ohw);
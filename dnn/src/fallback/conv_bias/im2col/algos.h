@@ -20,6 +20,12 @@
 namespace megdnn {
 namespace fallback {
 
+namespace im2col {
+//! the ohw_tile_size of AlgoIm2col deriving the ohw and oc tile sizes from the
+//! cache sizes of the host
+constexpr size_t AUTO_OHW_TILE_SIZE = 0;
+}  // namespace im2col
+
 class ConvBiasImpl::AlgoIm2col final : public AlgoBase {
 public:
     AlgoIm2col(MatrixMulImpl::AlgoBase* matmul_algo, size_t ohw_tile_size)
@@ -28,8 +34,13 @@ public:
     AlgoAttribute attribute() const override { return m_matmul_algo->attribute(); }
     const char* name() const override {
         if (m_name.empty()) {
-            m_name = ssprintf(
-                    "IM2COLMATMUL:%s:%zu", m_matmul_algo->name(), m_ohw_tile_size);
+            if (m_ohw_tile_size == im2col::AUTO_OHW_TILE_SIZE) {
+                m_name = ssprintf("IM2COLMATMUL:%s:AUTO", m_matmul_algo->name());
+            } else {
+                m_name = ssprintf(
+                        "IM2COLMATMUL:%s:%zu", m_matmul_algo->name(),
+                        m_ohw_tile_size);
+            }
         }
         return m_name.c_str();
     }
@@ -11,6 +11,7 @@
 
 #include "src/fallback/conv_bias/im2col/factory.h"
 #include "src/fallback/conv_bias/opr_impl.h"
+#include "src/fallback/conv_bias/tile_dataflow.h"
 #include "src/naive/convolution/helper.h"
 
 #include "midout.h"
@@ -78,6 +79,49 @@ static void kerns(
     //! 3.postprocess and copy dst if need
     im2colstrategy->exec_postprocess(param, strategyparam, bundle_thread);
 }
+
+/*!
+ * \brief fuse the packA and padding kerns into the compute kern with
+ * multiple threads, so a compute tile only waits for the packA blocks of its
+ * oc tile and the padding of its batch and group instead of a barrier
+ *
+ * \param kerns the kerns in the order of packA (if has_packA), padding (if
+ *      has_padding) and compute
+ * \param packA_oc_block the number of oc packed by a packA tile
+ */
+static SmallVector<ConvBiasImpl::NCBKern> fuse_im2col_kerns(
+        const ConvBiasImpl::NCBKernSizeParam& param,
+        const SmallVector<ConvBiasImpl::NCBKern>& kerns, bool has_packA,
+        bool has_padding, size_t packA_oc_block, size_t oc_tile_size,
+        size_t pack_oc_size) {
+    if (param.nr_threads <= 1 || kerns.size() <= 1) {
+        return kerns;
+    }
+    SmallVector<ConvBiasImpl::NCBKern> producers(kerns.begin(), kerns.end() - 1);
+    size_t OC = param.filter_meta.ocpg;
+    size_t GROUP = param.filter_meta.group;
+    size_t nr_packA_blocks = div_ceil(OC, packA_oc_block);
+    size_t nr_padding_channels = param.filter_meta.icpg / pack_oc_size;
+    auto deps = [=](const CpuNDRange& ndrange_id) {
+        size_t batch_id = ndrange_id[0], group_id = ndrange_id[1];
+        size_t oc_begin = ndrange_id[3] * oc_tile_size;
+        size_t oc_end = std::min(OC, oc_begin + oc_tile_size);
+        SmallVector<TileRange> ranges;
+        size_t kern_id = 0;
+        if (has_packA) {
+            size_t offset = group_id * nr_packA_blocks;
+            ranges.push_back(
+                    {kern_id++, offset + oc_begin / packA_oc_block,
+                     offset + div_ceil(oc_end, packA_oc_block)});
+        }
+        if (has_padding) {
+            size_t offset = (batch_id * GROUP + group_id) * nr_padding_channels;
+            ranges.push_back({kern_id++, offset, offset + nr_padding_channels});
+        }
+        return ranges;
+    };
+    return {fuse_kerns_by_tile(producers, kerns.back(), deps)};
+}
 }  // namespace
 
 template <Pack_Mode packmode>
@@ -143,7 +187,10 @@ public:
         ret_kern.push_back(
                 {kern_compute_default,
                  {BATCH, GROUP, ohw_parallel_times, oc_parallel_times}});
-        return ret_kern;
+        return fuse_im2col_kerns(
+                param, ret_kern, !is_enable_filter_preprocess(param),
+                PH != 0 || PW != 0, matmul_desc.innerblocksize.m, oc_tile_size,
+                pack_oc_size);
     }
 
     WorkspaceBundle get_thread_bundle(
@@ -229,7 +276,9 @@ public:
         ret_kern.push_back(
                 {kern_compute_onlypackA,
                  {BATCH, GROUP, ohw_parallel_times, oc_parallel_times}});
-        return ret_kern;
+        return fuse_im2col_kerns(
+                param, ret_kern, !is_enable_filter_preprocess(param),
+                PH != 0 || PW != 0, oc_tile_size, oc_tile_size, pack_oc_size);
     }
     WorkspaceBundle get_thread_bundle(
             const fallback::ConvBiasImpl::NCBKernSizeParam& param,
@@ -302,7 +351,9 @@ public:
         ret_kern.push_back(
                 {kern_compute_nopack,
                  {BATCH, GROUP, ohw_parallel_times, oc_parallel_times}});
-        return ret_kern;
+        return fuse_im2col_kerns(
+                param, ret_kern, false, PH != 0 || PW != 0, oc_tile_size, oc_tile_size,
+                pack_oc_size);
     }
     WorkspaceBundle get_thread_bundle(
             const fallback::ConvBiasImpl::NCBKernSizeParam& param,
@@ -109,6 +109,17 @@ public:
                         static_cast<MatrixMulImpl::AlgoBase*>(algo), oc_tile_size));
                 m_all_algos.emplace_back(refhold.back().get());
             }
+            //! the tile sizes derived from the host caches come after the
+            //! fixed ones, so fastrun tunes them against each other while the
+            //! heuristic choice is unchanged
+            refhold.emplace_back(new AlgoIm2col(
+                    static_cast<MatrixMulImpl::AlgoBase*>(algo),
+                    im2col::AUTO_OHW_TILE_SIZE));
+            m_all_algos.emplace_back(refhold.back().get());
+            refhold.emplace_back(new AlgoConv1x1(
+                    static_cast<MatrixMulImpl::AlgoBase*>(algo),
+                    conv1x1::AUTO_OC_TILE_SIZE));
+            m_all_algos.emplace_back(refhold.back().get());
 #endif
 
 #if 0
@@ -388,7 +399,8 @@ ConvBiasImpl::NCBKernSizeParam ConvBiasImpl::make_ncb_kern_size_param(
              param().compute_mode,
              nr_threads,
              reinterpret_cast<const ConvolutionForward::PreprocessedFilter*>(
-                     preprocessed_filter)},
+                     preprocessed_filter),
+             execution_policy().deterministic},
             bias.dtype,
             bias.stride[0],
             bias_mode,
@@ -411,16 +423,47 @@ ConvBiasImpl::NCBKernParam ConvBiasImpl::make_ncb_kern_param(
     return ret;
 }
 
+std::shared_ptr<const ConvBiasImpl::NCBKernPlan> ConvBiasImpl::get_kern_plan(
+        const NCBKernParam& param, ConvBiasImpl::Algorithm* algo) {
+    const NCBKernSizeParam& size_param = param;
+    //! the AUTO tiles of im2col and conv1x1 are derived from the cache sizes
+    //! when the kerns are dispatched
+    auto cache_info = cpu_cache_info();
+    if (!m_prev_kern_plan || m_prev_kern_plan->algo != algo ||
+        memcmp(&m_prev_kern_plan->size_param, &size_param, sizeof(NCBKernSizeParam)) ||
+        memcmp(&m_prev_kern_plan->cache_info, &cache_info, sizeof(CpuCacheInfo))) {
+        m_prev_kern_plan = std::make_shared<const NCBKernPlan>(NCBKernPlan{
+                algo, size_param, cache_info,
+                NCB_ALGO_FUNC(dispatch_kerns, algo, param)});
+    }
+    return m_prev_kern_plan;
+}
+
 void ConvBiasImpl::exec_with_ncb_kern(
         const NCBKernParam& param, ConvBiasImpl::Algorithm* algo) {
-    auto&& ncb_kerns = NCB_ALGO_FUNC(dispatch_kerns, algo, param);
-    for (auto&& kernel : ncb_kerns) {
-        auto run = [kernel, param](size_t index, size_t thread_id) {
-            CpuNDRange ndrange_id(kernel.global_size, index);
-            kernel.kern(param, {thread_id, ndrange_id});
+    auto plan = get_kern_plan(param, algo);
+    auto handle = static_cast<naive::HandleImpl*>(this->handle());
+    if (param.nr_threads == 1 && plan->kerns.size() > 1) {
+        //! there is no barrier to wait for between the kerns on a single
+        //! thread, so run them in order in one task
+        auto run = [plan, param]() {
+            for (auto&& kernel : plan->kerns) {
+                size_t total = kernel.global_size.total_size();
+                for (size_t index = 0; index < total; ++index) {
+                    CpuNDRange ndrange_id(kernel.global_size, index);
+                    kernel.kern(param, {0, ndrange_id});
+                }
+            }
         };
-        static_cast<naive::HandleImpl*>(handle())->dispatch_kern(
-                run, kernel.global_size.total_size());
+        handle->dispatch_kern(run);
+        return;
+    }
+    for (auto&& kernel : plan->kerns) {
+        auto run = [plan, kernel = &kernel, param](size_t index, size_t thread_id) {
+            CpuNDRange ndrange_id(kernel->global_size, index);
+            kernel->kern(param, {thread_id, ndrange_id});
+        };
+        handle->dispatch_kern(run, kernel.global_size.total_size());
     }
 }
 
@@ -12,12 +12,14 @@
 #pragma once
 
 #include "include/megdnn/thin/function.h"
+#include "src/common/cpu_cache_info.h"
 #include "src/common/utils.h"
 #include "src/fallback/conv_bias/common.h"
 #include "src/fallback/convolution/opr_impl.h"
 #include "src/fallback/matrix_mul/opr_impl.h"
 #include "src/naive/conv_bias/opr_impl.h"
 
+#include <memory>
 #include <unordered_map>
 
 namespace megdnn {
@@ -239,6 +241,10 @@ public:
             X86_DIRECT_AVX2_STRD2_INT8,
             X86_MKLDNN_QINT8,
             X86_MKLDNN_MATMUL_QINT8,
+            X86_IM2COL_AVX2_INT4,
+            X86_DIRECT_VNNI_NCHW88_INT8,
+            X86_DIRECT_VNNI_NCHW_NCHW88_INT8,
+            X86_CHANWISE_VNNI_NCHW88_INT8,
 #elif MEGDNN_AARCH64 || MEGDNN_ARMV7
             ARM_COMMON_WINOGRAD_F23_FP16 = 1 << 8,
             ARM_COMMON_WINOGRAD_F45_FP16,
@@ -388,6 +394,26 @@ private:
     NCBKernSizeParam m_prev_selected_algo_sizep;
     Algorithm* m_prev_selected_algo = nullptr;
 
+    /*!
+     * \brief kerns dispatched by an algo for a size param
+     *
+     * the kerns only capture the size param and take the tensor and
+     * workspace ptrs from the NCBKernParam at run time, so they are reused
+     * by the following execs as long as the algo, size param and cpu cache
+     * sizes are the same
+     */
+    struct NCBKernPlan {
+        Algorithm* algo;
+        NCBKernSizeParam size_param;
+        CpuCacheInfo cache_info;
+        SmallVector<NCBKern> kerns;
+    };
+    //! shared with the dispatched tasks, which may run after the plan is replaced
+    std::shared_ptr<const NCBKernPlan> m_prev_kern_plan;
+
+    std::shared_ptr<const NCBKernPlan> get_kern_plan(
+            const NCBKernParam& param, Algorithm* algo);
+
     bool is_naive_algo(ConvBiasImpl::Algorithm* algo);
 
     Algorithm* get_algorithm_from_desc(const AlgorithmDesc& desc) override;
@@ -0,0 +1,100 @@
+/**
+ * \file dnn/src/fallback/conv_bias/tile_dataflow.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#include "src/fallback/conv_bias/tile_dataflow.h"
+
+#include <thread>
+
+using namespace megdnn;
+using namespace fallback;
+using namespace tile_dataflow;
+
+TileStates::TileStates(
+        const SmallVector<ConvBiasImpl::NCBKern>& producers, size_t nr_consumer_tiles)
+        : m_producers{producers}, m_nr_consumer_tiles{nr_consumer_tiles} {
+    for (auto&& producer : m_producers) {
+        size_t nr_tiles = producer.global_size.total_size();
+        m_states.emplace_back(new std::atomic<uint8_t>[nr_tiles]);
+        for (size_t i = 0; i < nr_tiles; ++i) {
+            m_states.back()[i].store(IDLE, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool TileStates::try_run(
+        size_t kern_id, size_t tile, const ConvBiasImpl::NCBKernParam& param,
+        size_t thread_id) {
+    auto&& state = m_states[kern_id][tile];
+    uint8_t expected = IDLE;
+    if (state.load(std::memory_order_relaxed) != IDLE ||
+        !state.compare_exchange_strong(
+                expected, RUNNING, std::memory_order_acquire)) {
+        return false;
+    }
+    //! release the tile if the producer throws, so the exception propagates
+    //! instead of leaving the waiters spinning on a RUNNING tile forever
+    struct ResetOnThrow {
+        std::atomic<uint8_t>* state;
+        ~ResetOnThrow() {
+            if (state) {
+                state->store(IDLE, std::memory_order_release);
+            }
+        }
+    } guard{&state};
+    auto&& producer = m_producers[kern_id];
+    CpuNDRange ndrange_id(producer.global_size, tile);
+    producer.kern(param, {thread_id, ndrange_id});
+    guard.state = nullptr;
+    state.store(DONE, std::memory_order_release);
+    return true;
+}
+
+void TileStates::require(
+        const SmallVector<TileRange>& ranges, const ConvBiasImpl::NCBKernParam& param,
+        size_t thread_id) {
+    //! run the unclaimed tiles, start at an offset of the thread so that the
+    //! threads sharing the same dependencies claim different tiles
+    for (auto&& range : ranges) {
+        size_t nr_tiles = range.end - range.begin;
+        for (size_t i = 0; i < nr_tiles; ++i) {
+            size_t tile = range.begin + (i + thread_id) % nr_tiles;
+            try_run(range.kern_id, tile, param, thread_id);
+        }
+    }
+    //! the remaining tiles are being run by the other threads; a tile released
+    //! by a throwing producer is claimed again here
+    for (auto&& range : ranges) {
+        auto states = m_states[range.kern_id].get();
+        for (size_t tile = range.begin; tile < range.end; ++tile) {
+            while (states[tile].load(std::memory_order_acquire) != DONE) {
+                if (!try_run(range.kern_id, tile, param, thread_id)) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+}
+
+void TileStates::consumer_done() {
+    if (m_nr_done_consumer_tiles.fetch_add(1, std::memory_order_acq_rel) + 1 !=
+        m_nr_consumer_tiles) {
+        return;
+    }
+    for (size_t id = 0; id < m_producers.size(); ++id) {
+        size_t nr_tiles = m_producers[id].global_size.total_size();
+        for (size_t i = 0; i < nr_tiles; ++i) {
+            m_states[id][i].store(IDLE, std::memory_order_relaxed);
+        }
+    }
+    m_nr_done_consumer_tiles.store(0, std::memory_order_relaxed);
+}
+
+// vim: syntax=cpp.doxygen
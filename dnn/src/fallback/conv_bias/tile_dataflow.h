@@ -0,0 +1,106 @@
+/**
+ * \file dnn/src/fallback/conv_bias/tile_dataflow.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#pragma once
+
+#include "src/fallback/conv_bias/opr_impl.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief a range of tiles of a producer kern, the tile index is the linear
+ * index in the global_size of the producer
+ */
+struct TileRange {
+    size_t kern_id;
+    size_t begin;
+    size_t end;
+};
+
+/*!
+ * \brief fuse producer kerns (packA, padding, filter transform, ...) into the
+ * consumer kern, so they are dispatched once without a barrier between them
+ *
+ * Each consumer tile runs the producer tiles it depends on before its own
+ * work. A producer tile is run by the first consumer tile claiming it, and
+ * the other consumers wait for it. A waiting consumer first runs the
+ * unclaimed tiles of its own dependencies, so the producer work is spread
+ * over the threads. The tile states reset themselves when the last consumer
+ * tile of an exec is done, which relies on the execs of an opr never
+ * overlapping.
+ *
+ * \param deps returns the producer tiles needed by a consumer tile, as
+ *      SmallVector<TileRange>(const CpuNDRange& consumer_ndrange_id)
+ */
+template <typename Deps>
+ConvBiasImpl::NCBKern fuse_kerns_by_tile(
+        const SmallVector<ConvBiasImpl::NCBKern>& producers,
+        const ConvBiasImpl::NCBKern& consumer, Deps deps);
+
+namespace tile_dataflow {
+
+class TileStates {
+public:
+    TileStates(const SmallVector<ConvBiasImpl::NCBKern>& producers,
+               size_t nr_consumer_tiles);
+
+    //! run or wait for all the tiles in \p ranges
+    void require(
+            const SmallVector<TileRange>& ranges,
+            const ConvBiasImpl::NCBKernParam& param, size_t thread_id);
+
+    //! reset all the states when it is the last consumer tile of an exec
+    void consumer_done();
+
+private:
+    enum State : uint8_t { IDLE = 0, RUNNING = 1, DONE = 2 };
+
+    //! claim and run a producer tile, return false if it is already claimed
+    bool try_run(
+            size_t kern_id, size_t tile, const ConvBiasImpl::NCBKernParam& param,
+            size_t thread_id);
+
+    SmallVector<ConvBiasImpl::NCBKern> m_producers;
+    std::vector<std::unique_ptr<std::atomic<uint8_t>[]>> m_states;
+    size_t m_nr_consumer_tiles;
+    std::atomic<size_t> m_nr_done_consumer_tiles{0};
+};
+
+}  // namespace tile_dataflow
+
+template <typename Deps>
+ConvBiasImpl::NCBKern fuse_kerns_by_tile(
+        const SmallVector<ConvBiasImpl::NCBKern>& producers,
+        const ConvBiasImpl::NCBKern& consumer, Deps deps) {
+    if (producers.empty()) {
+        return consumer;
+    }
+    auto states = std::make_shared<tile_dataflow::TileStates>(
+            producers, consumer.global_size.total_size());
+    auto kern = [states, consumer_kern = consumer.kern, deps](
+                        const ConvBiasImpl::NCBKernParam& param,
+                        const ConvBiasImpl::NCBKernIndex& ncb_index) {
+        states->require(deps(ncb_index.ndrange_id), param, ncb_index.thread_id);
+        consumer_kern(param, ncb_index);
+        states->consumer_done();
+    };
+    return {kern, consumer.global_size};
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
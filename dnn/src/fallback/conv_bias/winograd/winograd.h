@@ -17,6 +17,7 @@
 #include "include/megdnn/dtype.h"
 #include "include/megdnn/thin/small_vector.h"
 #include "src/fallback/conv_bias/opr_impl.h"
+#include "src/fallback/conv_bias/tile_dataflow.h"
 #include "src/fallback/matrix_mul/opr_impl.h"
 
 #include "midout.h"
@@ -155,7 +156,7 @@ public:
             const Strategy& strategy, size_t unit_tile_size,
             const NCBKernSizeParam& param)
             : m_strategy{strategy}, m_unit_tile_size{unit_tile_size} {
-        size_t nr_threads = param.nr_threads;
+        size_t nr_threads = param.nr_split_threads();
         size_t OC = param.filter_meta.ocpg;
         size_t OH = param.osz[0];
         size_t OW = param.osz[1];
@@ -579,7 +580,23 @@ public:
             MIDOUT_END();
         };
         kerns.push_back({winograd_compute_kern, {GROUP, N, nr_hw_tiles, nr_oc_tiles}});
-        return kerns;
+        if (param.nr_threads <= 1 || kerns.size() <= 1) {
+            return kerns;
+        }
+        //! with multiple threads a compute tile only waits for the filter
+        //! transform of its oc tile instead of a barrier
+        size_t oc_parallelism = kerns[0].global_size[2];
+        size_t oc_pack_size = OC / oc_parallelism;
+        auto deps = [=](const CpuNDRange& ndrange_id) {
+            size_t group_id = ndrange_id[0];
+            size_t oc_begin = ndrange_id[3] * unit_oc_size;
+            size_t oc_end = std::min(OC, oc_begin + unit_oc_size);
+            size_t offset = group_id * oc_parallelism;
+            return SmallVector<fallback::TileRange>{
+                    {0, offset + oc_begin / oc_pack_size,
+                     offset + div_ceil(oc_end, oc_pack_size)}};
+        };
+        return {fallback::fuse_kerns_by_tile({kerns[0]}, kerns[1], deps)};
     }
 
     fallback::MatrixMulImpl::KernSizeParam get_matmul_kern_param(
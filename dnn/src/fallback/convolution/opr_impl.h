@@ -109,8 +109,26 @@ public:
         size_t nr_threads;
         //! weight_preprocess info
         const PreprocessedFilter* preprocessed_filter;
+        //! see ExecutionPolicy::deterministic
+        bool deterministic = false;
         //! get the data type category of the param for select the algo
         AlgoDataType deduce_algo_data_type() const;
+
+        /*!
+         * \brief number of threads the work split of a kernel is tuned for
+         *
+         * It is nr_threads normally; in deterministic mode it is a fixed
+         * value, so the tiles and hence the accumulation order of each
+         * output are the same for any number of threads. Per-thread
+         * workspace must still be allocated by nr_threads.
+         */
+        size_t nr_split_threads() const {
+            if (deterministic) {
+                return DETERMINISTIC_NR_SPLIT_THREADS;
+            }
+            return nr_threads;
+        }
+        static constexpr size_t DETERMINISTIC_NR_SPLIT_THREADS = 4;
     };
 
     //! memory param for kernels with non-contiguous batch
@@ -76,7 +76,9 @@ public:
                     static_cast<uint32_t>(AlgoDataType::FLOAT32) |
                     static_cast<uint32_t>(AlgoDataType::INT8X8X16) |
                     static_cast<uint32_t>(AlgoDataType::QINT8X8X32) |
-                    static_cast<uint32_t>(AlgoDataType::QUINT8X8X32)),
+                    static_cast<uint32_t>(AlgoDataType::QUINT8X8X32) |
+                    static_cast<uint32_t>(AlgoDataType::INT4X4X16) |
+                    static_cast<uint32_t>(AlgoDataType::QINT4x4x32)),
             DEFAULT)
 };
 
@@ -0,0 +1,67 @@
+/**
+ * \file dnn/src/fallback/matrix_mul/cache_blocking.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#include "src/fallback/matrix_mul/cache_blocking.h"
+#include "src/common/cpu_cache_info.h"
+#include "src/common/utils.h"
+
+#include <algorithm>
+
+using namespace megdnn;
+using namespace matmul;
+
+namespace {
+//! the block size splitting \p total into the fewest blocks not larger than
+//! \p max_block, with all the blocks of about the same size
+size_t balance_block(size_t total, size_t max_block, size_t align) {
+    total = std::max<size_t>(total, 1);
+    size_t nr_blocks = div_ceil(total, max_block);
+    return round_up(div_ceil(total, nr_blocks), align);
+}
+
+//! a k block shorter than this makes the micro kernel dominated by the
+//! load and store of C
+constexpr size_t MIN_BLOCK_K = 64;
+}  // namespace
+
+size_t matmul::get_cache_tile_size(
+        size_t cache_bytes, size_t row_bytes, size_t align, size_t min_rows,
+        size_t max_rows) {
+    megdnn_assert(row_bytes > 0 && align > 0 && min_rows <= max_rows);
+    size_t rows = cache_bytes / row_bytes / align * align;
+    return std::min(std::max(rows, min_rows), max_rows);
+}
+
+GemmBlockSize matmul::get_gemm_block_size(
+        size_t M, size_t N, size_t K, size_t kernel_h, size_t kernel_w,
+        size_t unroll_k, size_t a_elem_size, size_t b_elem_size) {
+    auto cache = cpu_cache_info();
+    GemmBlockSize ret;
+
+    size_t min_block_k = round_up(MIN_BLOCK_K, unroll_k);
+    size_t max_block_k = get_cache_tile_size(
+            cache.l1d / 2, kernel_h * a_elem_size + kernel_w * b_elem_size,
+            unroll_k, min_block_k, std::max(K, min_block_k));
+    ret.k = balance_block(K, max_block_k, unroll_k);
+
+    size_t max_block_m = get_cache_tile_size(
+            cache.l2 / 2, ret.k * a_elem_size, kernel_h, kernel_h,
+            std::max(M, kernel_h));
+    ret.m = balance_block(M, max_block_m, kernel_h);
+
+    size_t max_block_n = get_cache_tile_size(
+            cache.l3 / 2, ret.k * b_elem_size, kernel_w, kernel_w,
+            std::max(N, kernel_w));
+    ret.n = balance_block(N, max_block_n, kernel_w);
+    return ret;
+}
+
+// vim: syntax=cpp.doxygen
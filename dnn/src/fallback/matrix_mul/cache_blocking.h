@@ -0,0 +1,49 @@
+/**
+ * \file dnn/src/fallback/matrix_mul/cache_blocking.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace megdnn {
+namespace matmul {
+
+struct GemmBlockSize {
+    size_t m;
+    size_t n;
+    size_t k;
+};
+
+/*!
+ * \brief block sizes of GemmInterleaved derived from the host cache sizes
+ *
+ * The A and B micro panels of one kernel call (kernel_h x block_k and
+ * kernel_w x block_k) take half of L1, the packed A block (block_m x block_k)
+ * takes half of L2 and the packed B block (block_k x block_n) takes half of
+ * L3. Each block size is then balanced over its dimension, so there is no
+ * small tail block.
+ */
+GemmBlockSize get_gemm_block_size(
+        size_t M, size_t N, size_t K, size_t kernel_h, size_t kernel_w,
+        size_t unroll_k, size_t a_elem_size, size_t b_elem_size);
+
+/*!
+ * \brief the number of rows of \p row_bytes bytes fitting in \p cache_bytes,
+ * aligned down to \p align and clamped into [min_rows, max_rows]
+ */
+size_t get_cache_tile_size(
+        size_t cache_bytes, size_t row_bytes, size_t align, size_t min_rows,
+        size_t max_rows);
+
+}  // namespace matmul
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
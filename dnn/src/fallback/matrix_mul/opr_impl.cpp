@@ -287,6 +287,10 @@ MatrixMulImpl::AlgoDataType MatrixMulImpl::KernSizeParam::deduce_algo_data_type(
         return MatrixMulImpl::AlgoDataType::QUINT8X8X32;
     } else if (A_type.enumv() == DTypeEnum::Int16) {
         return MatrixMulImpl::AlgoDataType::INT16X16X32;
+    } else if (A_type.enumv() == DTypeEnum::QuantizedS4) {
+        return MatrixMulImpl::AlgoDataType::INT4X4X16;
+    } else if (A_type.enumv() == DTypeEnum::Quantized4Asymm) {
+        return MatrixMulImpl::AlgoDataType::QINT4x4x32;
     } else {
         megdnn_throw(ssprintf(
                 "matmul not support data type of %s * %s -> %s\n", A_type.name(),
@@ -0,0 +1,194 @@
+/**
+ * \file dnn/src/naive/embedding_bag/opr_impl.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "./opr_impl.h"
+
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
+
+#include <cstring>
+
+using namespace megdnn;
+using namespace naive;
+
+void embedding_bag::get_bag_offsets(
+        const dt_int32* bags, size_t nr_bags, size_t nr_indices,
+        param::EmbeddingBag::OffsetMode mode, dt_int32* offsets) {
+    using OffsetMode = param::EmbeddingBag::OffsetMode;
+    if (mode == OffsetMode::OFFSETS) {
+        megdnn_assert(
+                !nr_bags || bags[0] == 0,
+                "the first bag offset in EmbeddingBag must be 0, got %d", bags[0]);
+        for (size_t i = 0; i < nr_bags; ++i) {
+            offsets[i] = bags[i];
+        }
+    } else {
+        offsets[0] = 0;
+        for (size_t i = 0; i < nr_bags; ++i) {
+            megdnn_assert(bags[i] >= 0, "negative bag length in EmbeddingBag");
+            offsets[i + 1] = offsets[i] + bags[i];
+        }
+        megdnn_assert(
+                static_cast<size_t>(offsets[nr_bags]) == nr_indices,
+                "bag lengths in EmbeddingBag sum up to %d, but got %zu indices",
+                offsets[nr_bags], nr_indices);
+    }
+    offsets[nr_bags] = nr_indices;
+    for (size_t i = 0; i < nr_bags; ++i) {
+        megdnn_assert(
+                offsets[i] >= 0 && offsets[i] <= offsets[i + 1],
+                "bad bag offset in EmbeddingBag: offsets[%zu]=%d, end=%d", i,
+                offsets[i], offsets[i + 1]);
+    }
+}
+
+namespace {
+
+using Mode = param::EmbeddingBag::Mode;
+
+template <typename T>
+void forward(
+        const TensorND& weight, const TensorND& indices, const TensorND& bags,
+        const TensorND& per_sample_weights, const TensorND& dst,
+        const param::EmbeddingBag& param, dt_int32* offsets) {
+    size_t nr_rows = weight.layout.shape[0], dim = weight.layout.shape[1],
+           nr_bags = bags.layout.shape[0], nr_indices = indices.layout.shape[0];
+    embedding_bag::get_bag_offsets(
+            bags.ptr<dt_int32>(), nr_bags, nr_indices, param.offset_mode, offsets);
+    auto wptr = weight.ptr<T>(), dptr = dst.ptr<T>();
+    auto iptr = indices.ptr<dt_int32>();
+    auto sptr = per_sample_weights.layout.ndim ? per_sample_weights.ptr<T>() : nullptr;
+    for (size_t b = 0; b < nr_bags; ++b) {
+        T* out = dptr + b * dim;
+        for (size_t d = 0; d < dim; ++d) {
+            out[d] = T(0);
+        }
+        for (int i = offsets[b]; i < offsets[b + 1]; ++i) {
+            auto idx = iptr[i];
+            megdnn_assert(
+                    idx >= 0 && static_cast<size_t>(idx) < nr_rows,
+                    "bad value in EmbeddingBag indices: %d, num_embeddings=%zu", idx,
+                    nr_rows);
+            const T* row = wptr + idx * dim;
+            T scale = sptr ? sptr[i] : T(1);
+            for (size_t d = 0; d < dim; ++d) {
+                if (param.mode == Mode::MAX) {
+                    out[d] = i == offsets[b] || row[d] > out[d] ? row[d] : out[d];
+                } else {
+                    out[d] += row[d] * scale;
+                }
+            }
+        }
+        int cnt = offsets[b + 1] - offsets[b];
+        if (param.mode == Mode::MEAN && cnt) {
+            for (size_t d = 0; d < dim; ++d) {
+                out[d] /= T(cnt);
+            }
+        }
+    }
+}
+
+template <typename T>
+void backward(
+        const TensorND& weight, const TensorND& indices, const TensorND& bags,
+        const TensorND& per_sample_weights, const TensorND& diff, const TensorND& grad,
+        const param::EmbeddingBag& param, dt_int32* offsets) {
+    size_t dim = weight.layout.shape[1], nr_bags = bags.layout.shape[0],
+           nr_indices = indices.layout.shape[0];
+    embedding_bag::get_bag_offsets(
+            bags.ptr<dt_int32>(), nr_bags, nr_indices, param.offset_mode, offsets);
+    auto wptr = weight.ptr<T>(), diff_ptr = diff.ptr<T>(), gptr = grad.ptr<T>();
+    auto iptr = indices.ptr<dt_int32>();
+    auto sptr = per_sample_weights.layout.ndim ? per_sample_weights.ptr<T>() : nullptr;
+    for (size_t b = 0; b < nr_bags; ++b) {
+        const T* og = diff_ptr + b * dim;
+        int begin = offsets[b], end = offsets[b + 1];
+        if (param.mode == Mode::MAX) {
+            for (int i = begin; i < end; ++i) {
+                for (size_t d = 0; d < dim; ++d) {
+                    gptr[i * dim + d] = T(0);
+                }
+            }
+            if (begin == end) {
+                continue;
+            }
+            // gradient goes to the first index achieving the max
+            for (size_t d = 0; d < dim; ++d) {
+                int arg = begin;
+                for (int i = begin + 1; i < end; ++i) {
+                    if (wptr[iptr[i] * dim + d] > wptr[iptr[arg] * dim + d]) {
+                        arg = i;
+                    }
+                }
+                gptr[arg * dim + d] = og[d];
+            }
+            continue;
+        }
+        for (int i = begin; i < end; ++i) {
+            T scale = sptr ? sptr[i] : T(1);
+            if (param.mode == Mode::MEAN) {
+                scale /= T(end - begin);
+            }
+            for (size_t d = 0; d < dim; ++d) {
+                gptr[i * dim + d] = og[d] * scale;
+            }
+        }
+    }
+}
+
+}  // anonymous namespace
+
+void EmbeddingBagForwardImpl::exec(
+        _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+        _megdnn_tensor_in per_sample_weights, _megdnn_tensor_out dst,
+        _megdnn_workspace workspace) {
+    check_exec(
+            weight.layout, indices.layout, bags.layout, per_sample_weights.layout,
+            dst.layout, workspace.size);
+    auto offsets = workspace.ptr<dt_int32>();
+#define cb(_dt)                                                                   \
+    case DTypeTrait<_dt>::enumv: {                                                \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(forward<DTypeTrait<_dt>::ctype>(             \
+                weight, indices, bags, per_sample_weights, dst, param(), offsets)); \
+        return;                                                                   \
+    }
+    switch (weight.layout.dtype.enumv()) {
+        MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+        default:
+            megdnn_throw("bad dtype");
+    }
+#undef cb
+}
+
+void EmbeddingBagBackwardImpl::exec(
+        _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+        _megdnn_tensor_in per_sample_weights, _megdnn_tensor_in diff,
+        _megdnn_tensor_out grad, _megdnn_workspace workspace) {
+    check_exec(
+            weight.layout, indices.layout, bags.layout, per_sample_weights.layout,
+            diff.layout, grad.layout, workspace.size);
+    auto offsets = workspace.ptr<dt_int32>();
+#define cb(_dt)                                                                \
+    case DTypeTrait<_dt>::enumv: {                                             \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(backward<DTypeTrait<_dt>::ctype>(         \
+                weight, indices, bags, per_sample_weights, diff, grad, param(), \
+                offsets));                                                     \
+        return;                                                                \
+    }
+    switch (weight.layout.dtype.enumv()) {
+        MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+        default:
+            megdnn_throw("bad dtype");
+    }
+#undef cb
+}
+
+// vim: syntax=cpp.doxygen
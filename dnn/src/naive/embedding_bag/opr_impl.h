@@ -0,0 +1,58 @@
+/**
+ * \file dnn/src/naive/embedding_bag/opr_impl.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#pragma once
+#include "megdnn/oprs.h"
+
+namespace megdnn {
+namespace naive {
+
+namespace embedding_bag {
+/*!
+ * \brief convert the bags input of EmbeddingBag to nr_bags + 1 offsets, so
+ *      that bag b contains indices[offsets[b]:offsets[b + 1]]
+ */
+void get_bag_offsets(
+        const dt_int32* bags, size_t nr_bags, size_t nr_indices,
+        param::EmbeddingBag::OffsetMode mode, dt_int32* offsets);
+}  // namespace embedding_bag
+
+class EmbeddingBagForwardImpl : public EmbeddingBagForward {
+public:
+    using EmbeddingBagForward::EmbeddingBagForward;
+    void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+            _megdnn_tensor_in per_sample_weights, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout& bags,
+            const TensorLayout&, const TensorLayout&) override {
+        return (bags.shape[0] + 1) * sizeof(dt_int32);
+    }
+};
+
+class EmbeddingBagBackwardImpl : public EmbeddingBagBackward {
+public:
+    using EmbeddingBagBackward::EmbeddingBagBackward;
+    void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+            _megdnn_tensor_in per_sample_weights, _megdnn_tensor_in diff,
+            _megdnn_tensor_out grad, _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout& bags,
+            const TensorLayout&, const TensorLayout&, const TensorLayout&) override {
+        return (bags.shape[0] + 1) * sizeof(dt_int32);
+    }
+};
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
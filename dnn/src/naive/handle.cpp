@@ -10,6 +10,7 @@
  * implied.
  */
 
+#include "src/naive/embedding_bag/opr_impl.h"
 #include "src/naive/handle.h"
 
 #include "src/common/handle_impl.h"
@@ -0,0 +1,351 @@
+/**
+ * \file dnn/src/x86/conv_bias/int4/algos.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+
+#include "src/x86/conv_bias/int4/algos.h"
+#include "src/common/opr_delegate.h"
+#include "src/common/utils.h"
+#include "src/fallback/convolution/img2col_helper.h"
+#include "src/x86/matrix_mul/int4/unpack.h"
+#include "src/x86/utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "midout.h"
+
+MIDOUT_DECL(megdnn_x86_conv_bias_int4)
+
+using namespace megdnn;
+using namespace x86;
+
+namespace {
+
+bool is_int4(DType dtype) {
+    return dtype.enumv() == DTypeEnum::QuantizedS4 ||
+           dtype.enumv() == DTypeEnum::Quantized4Asymm;
+}
+
+bool need_img2col(const ConvBiasImpl::NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    return !(
+            fm.spatial[0] == 1 && fm.spatial[1] == 1 && fm.stride[0] == 1 &&
+            fm.stride[1] == 1 && fm.padding[0] == 0 && fm.padding[1] == 0);
+}
+
+size_t filter_size_per_group(const ConvBiasImpl::NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    return fm.ocpg * fm.icpg * fm.spatial[0] * fm.spatial[1];
+}
+
+void add_bias(
+        int32_t* acc, const int32_t* bias, BiasMode bias_mode, size_t OC,
+        size_t OHW) {
+    if (bias_mode == BiasMode::BROADCAST_CHANNEL_BIAS) {
+        rep(oc, OC) {
+            int32_t b = bias[oc];
+            rep(i, OHW) { acc[oc * OHW + i] += b; }
+        }
+    } else if (bias_mode == BiasMode::BIAS) {
+        rep(i, OC * OHW) { acc[i] += bias[i]; }
+    }
+}
+
+//! requantize the int32 result of src_scale * filter_scale into dst
+struct Requantizer {
+    float scale, inv_dst_scale;
+    int zero_point, qmin, qmax;
+    NonlineMode nonline_mode;
+
+    Requantizer(const ConvBiasImpl::NCBKernSizeParam& param)
+            : scale{get_scale(param.src_type) * get_scale(param.filter_type)},
+              inv_dst_scale{1.f / get_scale(param.dst_type)},
+              zero_point{0},
+              nonline_mode{param.nonlineMode} {
+        switch (param.dst_type.enumv()) {
+            case DTypeEnum::QuantizedS8:
+                qmin = -128;
+                qmax = 127;
+                break;
+            case DTypeEnum::QuantizedS4:
+                qmin = -8;
+                qmax = 7;
+                break;
+            case DTypeEnum::Quantized4Asymm:
+                zero_point =
+                        param.dst_type.param<dtype::Quantized4Asymm>().zero_point;
+                qmin = 0;
+                qmax = 15;
+                break;
+            default:
+                megdnn_throw("invalid dst dtype of int4 conv_bias");
+        }
+    }
+
+    int operator()(int32_t acc) const {
+        float x = acc * scale;
+        if (nonline_mode == NonlineMode::RELU) {
+            x = std::max(x, 0.f);
+        } else if (nonline_mode == NonlineMode::H_SWISH) {
+            x = x * std::min(std::max(x + 3.f, 0.f), 6.f) / 6.f;
+        }
+        int q = static_cast<int>(std::round(x * inv_dst_scale)) + zero_point;
+        return std::min(std::max(q, qmin), qmax);
+    }
+};
+
+}  // anonymous namespace
+
+bool ConvBiasImpl::AlgoInt4Im2colAVX2::usable(
+        const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
+    auto&& fm = param.filter_meta;
+    auto OH = param.osz[0], OW = param.osz[1];
+    auto dst_enum = param.dst_type.enumv();
+    bool dtype_ok = is_int4(param.src_type) &&
+                    param.filter_type.enumv() == DTypeEnum::QuantizedS4 &&
+                    (dst_enum == DTypeEnum::QuantizedS32 ||
+                     dst_enum == DTypeEnum::QuantizedS8 || is_int4(param.dst_type));
+    bool bias_ok = param.bias_mode == BiasMode::NO_BIAS ||
+                   param.bias_type.enumv() == DTypeEnum::QuantizedS32;
+    bool nonline_ok = param.nonlineMode == NonlineMode::IDENTITY ||
+                      param.nonlineMode == NonlineMode::RELU ||
+                      (param.nonlineMode == NonlineMode::H_SWISH &&
+                       dst_enum != DTypeEnum::QuantizedS32);
+    //! every image of every group is handled by one thread, so 4-bit dst
+    //! must not share a byte between two of them
+    bool dst_split_ok = !is_int4(param.dst_type) ||
+                        (fm.ocpg * OH * OW % 2 == 0 && param.out_bs % 2 == 0);
+    bool layout_ok = param.inp_s[1] == static_cast<ptrdiff_t>(
+                                               param.isz[0] * param.isz[1]) &&
+                     param.inp_s[2] == static_cast<ptrdiff_t>(param.isz[1]) &&
+                     param.inp_s[3] == 1 &&
+                     param.out_s[1] == static_cast<ptrdiff_t>(OH * OW) &&
+                     param.out_s[2] == static_cast<ptrdiff_t>(OW) &&
+                     param.out_s[3] == 1;
+    return fm.format == param::ConvBias::Format::NCHW && fm.spatial_ndim == 2 &&
+           fm.dilation[0] == 1 && fm.dilation[1] == 1 && dtype_ok && bias_ok &&
+           nonline_ok && dst_split_ok && layout_ok && is_supported(SIMDType::AVX2);
+}
+
+WorkspaceBundle ConvBiasImpl::AlgoInt4Im2colAVX2::get_thread_bundle(
+        const NCBKernSizeParam& param) {
+    UNPACK_CONV_F32_NCB_KERN_SIZES(param);
+    megdnn_ignore(N);
+    auto IH2 = IH + 2 * PH;
+    auto IW2 = IW + 2 * PW;
+    // unpacked and padded src of one group
+    // unrolled src matrix
+    // int32 result, which is written to dst directly for QuantizedS32 dst
+    // workspace for matrix mul opr
+    size_t part0, part1, part2, part3;
+    part0 = IC * IH2 * IW2 * sizeof(int8_t);
+    part1 = need_img2col(param) ? IC * FH * FW * OH * OW * sizeof(int8_t) : 0;
+    part2 = param.dst_type.enumv() == DTypeEnum::QuantizedS32
+                  ? 0
+                  : OC * OH * OW * sizeof(int32_t);
+    {
+        TensorLayout A_, B_, C_;
+        A_ = TensorLayout({OC, IC * FH * FW}, dtype::Int8());
+        B_ = TensorLayout({IC * FH * FW, OH * OW}, dtype::Int8());
+        C_ = TensorLayout({OC, OH * OW}, dtype::Int32());
+        part3 = get_matmul_opr()->get_workspace_in_bytes(A_, B_, C_);
+    }
+    return {nullptr, {part0, part1, part2, part3}};
+}
+
+WorkspaceBundle ConvBiasImpl::AlgoInt4Im2colAVX2::get_bundle(
+        const NCBKernSizeParam& param) {
+    // unpacked filter of all groups, unless done by weight preprocess
+    // per-thread buffers
+    size_t part0 = is_enable_filter_preprocess(param)
+                         ? 0
+                         : param.filter_meta.group * filter_size_per_group(param);
+    size_t part1 =
+            get_thread_bundle(param).total_size_in_bytes() * param.nr_threads;
+    return {nullptr, {part0, part1}};
+}
+
+MatrixMul* ConvBiasImpl::AlgoInt4Im2colAVX2::get_matmul_opr() {
+    static CpuOprDelegationStorage<> storage;
+    return storage.get<MatrixMul>();
+}
+
+void ConvBiasImpl::AlgoInt4Im2colAVX2::kern_unpack_filter(
+        const NCBKernParam& param, const NCBKernIndex& ncb_index) {
+    MIDOUT_BEGIN(megdnn_x86_conv_bias_int4, midout_iv(0)) {
+        size_t group_id = ncb_index.ndrange_id[0];
+        size_t size = filter_size_per_group(param);
+        auto bundle = get_bundle(param);
+        bundle.set(param.workspace_ptr);
+        int4::unpack_to_int8(
+                param.filter_ptr.get_ptr(), group_id * size, size,
+                static_cast<int8_t*>(bundle.get(0)) + group_id * size,
+                int4::UnpackParam::from_dtype(param.filter_type));
+    }
+    MIDOUT_END();
+}
+
+void ConvBiasImpl::AlgoInt4Im2colAVX2::kern_unpack_filter_preprocess(
+        const NCBKernParam& param, const NCBKernIndex& ncb_index) {
+    MIDOUT_BEGIN(megdnn_x86_conv_bias_int4, midout_iv(1)) {
+        size_t group_id = ncb_index.ndrange_id[0];
+        size_t size = filter_size_per_group(param);
+        int4::unpack_to_int8(
+                param.filter_ptr.get_ptr(), group_id * size, size,
+                static_cast<int8_t*>(
+                        param.preprocessed_filter->tensors[0].raw_ptr()) +
+                        group_id * size,
+                int4::UnpackParam::from_dtype(param.filter_type));
+    }
+    MIDOUT_END();
+}
+
+void ConvBiasImpl::AlgoInt4Im2colAVX2::kern_compute(
+        const NCBKernParam& param, const NCBKernIndex& ncb_index) {
+    MIDOUT_BEGIN(megdnn_x86_conv_bias_int4, midout_iv(2)) {
+        UNPACK_CONV_F32_NCB_KERN_SIZES(param);
+        megdnn_ignore(N);
+        auto IH2 = IH + 2 * PH;
+        auto IW2 = IW + 2 * PW;
+        auto OHW = OH * OW;
+        size_t group_id = ncb_index.ndrange_id[0];
+        size_t batch_id = ncb_index.ndrange_id[1];
+        bool is_xcorr = !param.filter_meta.should_flip;
+        auto bundle = get_bundle(param);
+        bundle.set(param.workspace_ptr);
+        auto thread_bundle = get_thread_bundle(param);
+        thread_bundle.set(
+                static_cast<int8_t*>(bundle.get(1)) +
+                thread_bundle.total_size_in_bytes() * ncb_index.thread_id);
+
+        const int8_t* filter =
+                is_enable_filter_preprocess(param)
+                        ? static_cast<const int8_t*>(
+                                  param.preprocessed_filter->tensors[0].raw_ptr())
+                        : static_cast<const int8_t*>(bundle.get(0));
+        filter += group_id * filter_size_per_group(param);
+
+        //! unpack src, the zero point is removed so padding with 0 is exact
+        auto unpack_param = int4::UnpackParam::from_dtype(param.src_type);
+        size_t src_offset = batch_id * param.inp_bs + group_id * IC * IH * IW;
+        int8_t* src2 = static_cast<int8_t*>(thread_bundle.get(0));
+        if (PH == 0 && PW == 0) {
+            int4::unpack_to_int8(
+                    param.src_ptr.get_ptr(), src_offset, IC * IH * IW, src2,
+                    unpack_param);
+        } else {
+            std::memset(src2, 0, IC * IH2 * IW2);
+            rep(ic, IC) {
+                rep(ih, IH) {
+                    int4::unpack_to_int8(
+                            param.src_ptr.get_ptr(), src_offset + (ic * IH + ih) * IW,
+                            IW, src2 + (ic * IH2 + ih + PH) * IW2 + PW, unpack_param);
+                }
+            }
+        }
+
+        int8_t* B = src2;
+        if (need_img2col(param)) {
+            B = static_cast<int8_t*>(thread_bundle.get(1));
+            if (SH == 1 && SW == 1) {
+                if (is_xcorr) {
+                    img2col<true>(src2, B, OC, OH, OW, IC, IH2, IW2, FH, FW);
+                } else {
+                    img2col<false>(src2, B, OC, OH, OW, IC, IH2, IW2, FH, FW);
+                }
+            } else {
+                if (is_xcorr) {
+                    img2col_stride<true>(
+                            src2, B, OC, OH, OW, IC, IH2, IW2, FH, FW, SH, SW);
+                } else {
+                    img2col_stride<false>(
+                            src2, B, OC, OH, OW, IC, IH2, IW2, FH, FW, SH, SW);
+                }
+            }
+        }
+
+        size_t dst_offset = batch_id * param.out_bs + group_id * OC * OHW;
+        auto dst_enum = param.dst_type.enumv();
+        int32_t* acc = dst_enum == DTypeEnum::QuantizedS32
+                             ? static_cast<int32_t*>(param.dst_ptr.get_ptr()) +
+                                       dst_offset
+                             : static_cast<int32_t*>(thread_bundle.get(2));
+        {
+            TensorND A_, B_, C_;
+            A_.layout = TensorLayout({OC, IC * FH * FW}, dtype::Int8());
+            A_.reset_ptr(const_cast<int8_t*>(filter));
+            B_.layout = TensorLayout({IC * FH * FW, OHW}, dtype::Int8());
+            B_.reset_ptr(B);
+            C_.layout = TensorLayout({OC, OHW}, dtype::Int32());
+            C_.reset_ptr(acc);
+            Workspace workspace(
+                    static_cast<dt_byte*>(thread_bundle.get(3)),
+                    thread_bundle.get_size(3));
+            get_matmul_opr()->exec(A_, B_, C_, workspace);
+        }
+
+        if (param.bias_mode != BiasMode::NO_BIAS) {
+            auto bias = static_cast<const int32_t*>(param.bias_ptr.get_ptr());
+            if (param.bias_mode == BiasMode::BROADCAST_CHANNEL_BIAS) {
+                bias += group_id * OC;
+            } else {
+                bias += batch_id * param.bias_bs + group_id * OC * OHW;
+            }
+            add_bias(acc, bias, param.bias_mode, OC, OHW);
+        }
+
+        if (dst_enum == DTypeEnum::QuantizedS32) {
+            if (param.nonlineMode == NonlineMode::RELU) {
+                rep(i, OC * OHW) { acc[i] = std::max(acc[i], 0); }
+            }
+        } else if (dst_enum == DTypeEnum::QuantizedS8) {
+            Requantizer requant{param};
+            auto dst = static_cast<int8_t*>(param.dst_ptr.get_ptr()) + dst_offset;
+            rep(i, OC * OHW) { dst[i] = requant(acc[i]); }
+        } else {
+            //! dst_offset and OC * OHW are even, which is checked in usable
+            Requantizer requant{param};
+            auto dst = static_cast<uint8_t*>(param.dst_ptr.get_ptr()) + dst_offset / 2;
+            for (size_t i = 0; i < OC * OHW; i += 2) {
+                dst[i / 2] = (requant(acc[i]) & 0x0F) |
+                             ((requant(acc[i + 1]) & 0x0F) << 4);
+            }
+        }
+    }
+    MIDOUT_END();
+}
+
+SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoInt4Im2colAVX2::dispatch_kerns(
+        const NCBKernSizeParam& param) const {
+    size_t group = param.filter_meta.group;
+    size_t batch = param.n;
+    SmallVector<NCBKern> ret_kerns;
+    if (!is_enable_filter_preprocess(param)) {
+        ret_kerns.push_back({kern_unpack_filter, {group, 1_z, 1_z}});
+    }
+    ret_kerns.push_back({kern_compute, {group, batch, 1_z}});
+    return ret_kerns;
+}
+
+SmallVector<TensorLayout> ConvBiasImpl::AlgoInt4Im2colAVX2::
+        deduce_preprocessed_filter_layout(const NCBKernSizeParam& param) const {
+    size_t group = param.filter_meta.group;
+    return {{{group, filter_size_per_group(param)}, dtype::Int8()}};
+}
+
+SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoInt4Im2colAVX2::
+        dispatch_preprocess_kerns(const NCBKernSizeParam& param) const {
+    size_t group = param.filter_meta.group;
+    return {{kern_unpack_filter_preprocess, {group, 1_z, 1_z}}};
+}
+
+// vim: syntax=cpp.doxygen
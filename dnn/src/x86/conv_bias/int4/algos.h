@@ -0,0 +1,58 @@
+/**
+ * \file dnn/src/x86/conv_bias/int4/algos.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#pragma once
+#include "src/x86/conv_bias/opr_impl.h"
+
+namespace megdnn {
+namespace x86 {
+
+/* ===================== avx2 int4 im2col algo ===================== */
+/*!
+ * Src and filter are unpacked into int8 with the zero point removed and
+ * multiplied by the int8 matmul kernels; the int32 result is requantized to
+ * the 4-bit or 8-bit dst. The filter can be unpacked once by weight
+ * preprocess.
+ */
+class ConvBiasImpl::AlgoInt4Im2colAVX2 final : public AlgoBase {
+    static MatrixMul* get_matmul_opr();
+    static void kern_unpack_filter(const NCBKernParam& param, const NCBKernIndex&);
+    static void kern_unpack_filter_preprocess(
+            const NCBKernParam& param, const NCBKernIndex&);
+    static void kern_compute(const NCBKernParam& param, const NCBKernIndex&);
+    static WorkspaceBundle get_bundle(const NCBKernSizeParam& param);
+    static WorkspaceBundle get_thread_bundle(const NCBKernSizeParam& param);
+
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "X86_CONV_BIAS_IM2COL_AVX2_INT4"; }
+    bool usable(const NCBKernSizeParam& param, AlgoSelectionStrategy) const override;
+    size_t get_workspace(const NCBKernSizeParam& param) const override {
+        return get_bundle(param).total_size_in_bytes();
+    }
+    SmallVector<NCBKern> dispatch_kerns(const NCBKernSizeParam& param) const override;
+    bool is_preferred(const NCBKernSizeParam&) const override { return true; }
+
+    SmallVector<TensorLayout> deduce_preprocessed_filter_layout(
+            const NCBKernSizeParam& param) const override;
+    SmallVector<NCBKern> dispatch_preprocess_kerns(
+            const NCBKernSizeParam& param) const override;
+
+    ConvAlgoTypePack get_algo_type() const override {
+        return {AlgoDataType::QINT4x4x32, AlgoCategory::IM2COL};
+    }
+    MEGDNN_DECL_ALGO_TYPE(X86_IM2COL_AVX2_INT4)
+};
+
+}  // namespace x86
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -174,6 +174,46 @@ bool direct_avx2_stride2_int8_usable_preferred(
            direct_avx2_stride2_int8_preferred(param);
 }
 
+#if MEGDNN_X86_WITH_VNNI
+namespace {
+bool vnni_nchw88_int8_common_usable(const ConvBiasImpl::NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    bool dst_qint8 = param.dst_type.enumv() == DTypeEnum::QuantizedS8;
+    bool ok_type = param.src_type.enumv() == DTypeEnum::QuantizedS8 &&
+                   param.filter_type.enumv() == DTypeEnum::QuantizedS8 &&
+                   (dst_qint8 || param.dst_type.enumv() == DTypeEnum::QuantizedS32);
+    //! H_SWISH needs requantization, so it is only fused for qint8 output
+    bool ok_nonline = param.nonlineMode == NonlineMode::IDENTITY ||
+                      param.nonlineMode == NonlineMode::RELU ||
+                      (dst_qint8 && param.nonlineMode == NonlineMode::H_SWISH);
+    bool ok_slide = fm.spatial_ndim == 2 && fm.dilation[0] == 1 &&
+                    fm.dilation[1] == 1 && fm.stride[0] == fm.stride[1] &&
+                    (fm.stride[0] == 1 || fm.stride[0] == 2);
+    return ok_type && ok_nonline && ok_slide && !fm.should_flip &&
+           fm.format == param::ConvBias::Format::NCHW88 &&
+           is_supported(SIMDType::VNNI);
+}
+}  // namespace
+
+bool direct_vnni_nchw88_int8_usable(const ConvBiasImpl::NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    return vnni_nchw88_int8_common_usable(param) && fm.icpg % 8 == 0 &&
+           fm.ocpg % 8 == 0;
+}
+
+bool nchw_nchw88_vnni_int8_usable(const ConvBiasImpl::NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    return vnni_nchw88_int8_common_usable(param) && fm.group == 1 && fm.icpg < 8 &&
+           fm.ocpg % 8 == 0;
+}
+
+bool chanwise_vnni_nchw88_int8_usable(const ConvBiasImpl::NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    return vnni_nchw88_int8_common_usable(param) && fm.group % 8 == 0 &&
+           fm.icpg == 1 && fm.ocpg == 1 && fm.spatial[0] <= 7 && fm.spatial[1] <= 7;
+}
+#endif
+
 #if MEGDNN_X86_WITH_MKL_DNN
 bool mkldnn_qint8_usable(const ConvBiasImpl::NCBKernSizeParam& param) {
     auto&& fm = param.filter_meta;
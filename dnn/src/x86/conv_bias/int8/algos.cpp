@@ -19,6 +19,8 @@
 #include "src/x86/conv_bias/int8/avx2_chanwise_stride2.h"
 #include "src/x86/conv_bias/int8/avx2_direct_conv_stride1.h"
 #include "src/x86/conv_bias/int8/avx2_direct_conv_stride2.h"
+#include "src/x86/conv_bias/int8/vnni_chanwise_nchw88.h"
+#include "src/x86/conv_bias/int8/vnni_direct_nchw88.h"
 #include "src/x86/conv_bias/opr_impl.h"
 #include "src/x86/conv_bias/postprocess_helper.h"
 #include "src/x86/handle.h"
@@ -238,6 +240,89 @@ bool ConvBiasImpl::AlgoAVX2DirectConvStride2::is_preferred(
     return direct_avx2_stride2_int8_preferred(param);
 }
 
+#if MEGDNN_X86_WITH_VNNI
+bool ConvBiasImpl::AlgoDirectVnniNchw88Int8::usable(
+        const NCBKernSizeParam& param,
+        AlgoSelectionStrategy /*algo_selection_strategy*/) const {
+    return direct_vnni_nchw88_int8_usable(param);
+}
+
+WorkspaceBundle ConvBiasImpl::AlgoDirectVnniNchw88Int8::get_bundle(
+        const NCBKernSizeParam& param) {
+    return vnni_direct_nchw88::get_bundle(param);
+}
+
+size_t ConvBiasImpl::AlgoDirectVnniNchw88Int8::get_workspace(
+        const NCBKernSizeParam& param) const {
+    return get_bundle(param).total_size_in_bytes();
+}
+
+SmallVector<fallback::ConvBiasImpl::NCBKern> ConvBiasImpl::
+        AlgoDirectVnniNchw88Int8::get_kimpls(const NCBKernSizeParam& param) const {
+    auto bundle = get_bundle(param);
+    return vnni_direct_nchw88::get_kimpls(param, bundle);
+}
+
+bool ConvBiasImpl::AlgoDirectVnniNchw88Int8::is_preferred(
+        const NCBKernSizeParam& /*param*/) const {
+    return true;
+}
+
+bool ConvBiasImpl::AlgoNchwNchw88VnniInt8::usable(
+        const NCBKernSizeParam& param,
+        AlgoSelectionStrategy /*algo_selection_strategy*/) const {
+    return nchw_nchw88_vnni_int8_usable(param);
+}
+
+WorkspaceBundle ConvBiasImpl::AlgoNchwNchw88VnniInt8::get_bundle(
+        const NCBKernSizeParam& param) {
+    return vnni_direct_nchw88::get_bundle(param);
+}
+
+size_t ConvBiasImpl::AlgoNchwNchw88VnniInt8::get_workspace(
+        const NCBKernSizeParam& param) const {
+    return get_bundle(param).total_size_in_bytes();
+}
+
+SmallVector<fallback::ConvBiasImpl::NCBKern> ConvBiasImpl::
+        AlgoNchwNchw88VnniInt8::get_kimpls(const NCBKernSizeParam& param) const {
+    auto bundle = get_bundle(param);
+    return vnni_direct_nchw88::get_kimpls(param, bundle);
+}
+
+bool ConvBiasImpl::AlgoNchwNchw88VnniInt8::is_preferred(
+        const NCBKernSizeParam& /*param*/) const {
+    return true;
+}
+
+bool ConvBiasImpl::AlgoChanWiseVnniNchw88Int8::usable(
+        const NCBKernSizeParam& param,
+        AlgoSelectionStrategy /*algo_selection_strategy*/) const {
+    return chanwise_vnni_nchw88_int8_usable(param);
+}
+
+WorkspaceBundle ConvBiasImpl::AlgoChanWiseVnniNchw88Int8::get_bundle(
+        const NCBKernSizeParam& param) {
+    return vnni_chanwise_nchw88::get_bundle(param);
+}
+
+size_t ConvBiasImpl::AlgoChanWiseVnniNchw88Int8::get_workspace(
+        const NCBKernSizeParam& param) const {
+    return get_bundle(param).total_size_in_bytes();
+}
+
+SmallVector<fallback::ConvBiasImpl::NCBKern> ConvBiasImpl::
+        AlgoChanWiseVnniNchw88Int8::get_kimpls(const NCBKernSizeParam& param) const {
+    auto bundle = get_bundle(param);
+    return vnni_chanwise_nchw88::get_kimpls(param, bundle);
+}
+
+bool ConvBiasImpl::AlgoChanWiseVnniNchw88Int8::is_preferred(
+        const NCBKernSizeParam& /*param*/) const {
+    return true;
+}
+#endif
+
 #if MEGDNN_X86_WITH_MKL_DNN
 bool ConvBiasImpl::AlgoMkldnnQint8::usable(
         const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
@@ -0,0 +1,235 @@
+/**
+ * \file dnn/src/x86/conv_bias/int8/vnni_chanwise_nchw88.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+
+#include "src/x86/conv_bias/int8/vnni_chanwise_nchw88.h"
+
+#if MEGDNN_X86_WITH_VNNI
+#include "src/x86/conv_bias/int8/vnni_nchw88_common.h"
+
+using namespace megdnn;
+using namespace x86;
+using namespace vnni_nchw88;
+using vnni_chanwise_nchw88::MAX_TAPS;
+
+namespace {
+constexpr size_t PACK = 8;
+constexpr size_t OW_BLOCK = 8;
+
+struct ConvSize {
+    size_t group, IH, IW, OH, OW, FH, FW, PH, PW, SH, SW, IH2, IW2;
+    //! number of filter taps rounded up to a multiple of 4
+    size_t nr_tap4;
+
+    explicit ConvSize(const NCBKernSizeParam& param) {
+        auto&& fm = param.filter_meta;
+        group = fm.group;
+        IH = param.isz[0];
+        IW = param.isz[1];
+        OH = param.osz[0];
+        OW = param.osz[1];
+        FH = fm.spatial[0];
+        FW = fm.spatial[1];
+        PH = fm.padding[0];
+        PW = fm.padding[1];
+        SH = fm.stride[0];
+        SW = fm.stride[1];
+        IH2 = IH + 2 * PH;
+        IW2 = IW + 2 * PW;
+        nr_tap4 = div_ceil<size_t>(FH * FW, 4);
+    }
+
+    size_t src_plane_size() const { return IH2 * IW2 * PACK; }
+    size_t filter_size() const { return nr_tap4 * 32; }
+};
+
+/*!
+ * Each int32 lane of vpdpbusd is one channel, and its 4 bytes are 4 taps of
+ * that channel. Taps beyond FH * FW get zero weights and read the first tap.
+ */
+void pack_filter(
+        const int8_t* src, int8_t* dst, int32_t* comp, const ConvSize& sz) {
+    const size_t nr_tap = sz.FH * sz.FW;
+    int32_t sum[PACK] = {0};
+    for (size_t g = 0; g < sz.nr_tap4; ++g) {
+        for (size_t c = 0; c < PACK; ++c) {
+            for (size_t j = 0; j < 4; ++j) {
+                size_t tap = g * 4 + j;
+                int8_t val = tap < nr_tap ? src[tap * PACK + c] : 0;
+                dst[g * 32 + c * 4 + j] = val;
+                sum[c] += val;
+            }
+        }
+    }
+    for (size_t c = 0; c < PACK; ++c) {
+        comp[c] = SRC_ZERO_POINT * sum[c];
+    }
+}
+
+template <int nr_ow>
+MEGDNN_ATTRIBUTE_TARGET("avx512vl,avx512vnni")
+inline void kern_block(
+        const uint8_t* src, const int8_t* filter, const int32_t* tap_offset,
+        const ConvSize& sz, __m256i* acc) {
+    //! gather the 4 taps of a channel into one int32 lane: the 4 loaded
+    //! pixels are (tap, channel) ordered, the permute moves channel 0-3 to the
+    //! low half and the shuffle transposes each half into (channel, tap)
+    const __m256i perm = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256i shuf = _mm256_setr_epi8(
+            0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15, 0, 4, 8, 12, 1, 5,
+            9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    const size_t ow_stride = sz.SW * PACK;
+    for (int i = 0; i < nr_ow; ++i) {
+        acc[i] = _mm256_setzero_si256();
+    }
+    for (size_t g = 0; g < sz.nr_tap4; ++g) {
+        __m256i weight =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(filter + g * 32));
+        const int32_t* off = tap_offset + g * 4;
+        for (int i = 0; i < nr_ow; ++i) {
+            const uint8_t* sptr = src + i * ow_stride;
+            __m256i feat = _mm256_setr_epi64x(
+                    *reinterpret_cast<const int64_t*>(sptr + off[0]),
+                    *reinterpret_cast<const int64_t*>(sptr + off[1]),
+                    *reinterpret_cast<const int64_t*>(sptr + off[2]),
+                    *reinterpret_cast<const int64_t*>(sptr + off[3]));
+            feat = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(feat, perm), shuf);
+            acc[i] = _mm256_dpbusd_epi32(acc[i], feat, weight);
+        }
+    }
+}
+
+template <class Op, int nr_ow>
+MEGDNN_ATTRIBUTE_TARGET("avx512vl,avx512vnni")
+inline void run_block(
+        const Op& op, const uint8_t* src, const int8_t* filter,
+        const int32_t* tap_offset, const ConvSize& sz, __m256i bias_comp,
+        const int32_t* bias, int8_t* dst, size_t dst_size) {
+    __m256i acc[nr_ow];
+    kern_block<nr_ow>(src, filter, tap_offset, sz, acc);
+    for (int i = 0; i < nr_ow; ++i) {
+        __m256i res = _mm256_add_epi32(acc[i], bias_comp);
+        if (bias) {
+            res = _mm256_add_epi32(
+                    res, _mm256_loadu_si256(
+                                 reinterpret_cast<const __m256i*>(bias + i * PACK)));
+        }
+        op(res, dst + i * PACK * dst_size);
+    }
+}
+
+template <class Op>
+MEGDNN_ATTRIBUTE_TARGET("avx512vl,avx512vnni")
+void do_conv(
+        const NCBKernParam& kern_param, const ConvSize& sz, const uint8_t* src,
+        const int8_t* filter, const int32_t* comp, size_t batch_id, size_t gb) {
+    Op op(kern_param);
+    const size_t dst_size = kern_param.dst_type.size();
+    int8_t* dst = static_cast<int8_t*>(kern_param.dst<void>(batch_id, gb, 0, PACK));
+
+    int32_t tap_offset[MAX_TAPS + 3] = {0};
+    for (size_t fh = 0; fh < sz.FH; ++fh) {
+        for (size_t fw = 0; fw < sz.FW; ++fw) {
+            tap_offset[fh * sz.FW + fw] = (fh * sz.IW2 + fw) * PACK;
+        }
+    }
+
+    __m256i bias_comp = _mm256_sub_epi32(
+            _mm256_setzero_si256(),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(comp)));
+    const int32_t* bias = nullptr;
+    if (kern_param.bias_mode == BiasMode::BROADCAST_CHANNEL_BIAS) {
+        bias_comp = _mm256_add_epi32(
+                bias_comp, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+                                   kern_param.bias<dt_int32>(batch_id, gb, 0, PACK))));
+    } else if (kern_param.bias_mode == BiasMode::BIAS) {
+        bias = kern_param.bias<dt_int32>(batch_id, gb, 0, PACK);
+    }
+
+    for (size_t oh = 0; oh < sz.OH; ++oh) {
+        const uint8_t* src_row = src + oh * sz.SH * sz.IW2 * PACK;
+        size_t ow = 0;
+#define cb(nr_ow)                                                                 \
+    run_block<Op, nr_ow>(                                                         \
+            op, src_row + ow * sz.SW * PACK, filter, tap_offset, sz, bias_comp,   \
+            bias ? bias + (oh * sz.OW + ow) * PACK : nullptr,                     \
+            dst + (oh * sz.OW + ow) * PACK * dst_size, dst_size)
+        for (; ow + OW_BLOCK <= sz.OW; ow += OW_BLOCK) {
+            cb(OW_BLOCK);
+        }
+        switch (sz.OW - ow) {
+            case 0:
+                break;
+#define cb_switch(nr_ow) \
+    case nr_ow:          \
+        cb(nr_ow);       \
+        break;
+                cb_switch(1);
+                cb_switch(2);
+                cb_switch(3);
+                cb_switch(4);
+                cb_switch(5);
+                cb_switch(6);
+                cb_switch(7);
+#undef cb_switch
+            default:
+                megdnn_assert(0, "invalid ow remain %zu", sz.OW - ow);
+        }
+#undef cb
+    }
+}
+
+void conv_kern(
+        const WorkspaceBundle& bundle, const NCBKernParam& kern_param,
+        const NCBKernIndex& ncb_index) {
+    ConvSize sz{kern_param};
+    size_t thread_id = ncb_index.thread_id, batch_id = ncb_index.ndrange_id[0],
+           gb = ncb_index.ndrange_id[1];
+    uint8_t* src = static_cast<uint8_t*>(bundle.get(0)) +
+                   thread_id * sz.src_plane_size();
+    int8_t* filter =
+            static_cast<int8_t*>(bundle.get(1)) + thread_id * sz.filter_size();
+    int32_t comp[PACK];
+
+    pack_src_nchw88(
+            kern_param.src<dt_int8>(batch_id, gb, 0, PACK), src, sz.IH, sz.IW, sz.PH,
+            sz.PW, sz.IH2, sz.IW2);
+    pack_filter(kern_param.filter<dt_int8>(gb, PACK), filter, comp, sz);
+    DISPATCH_VNNI_NCHW88_STORE_OP(
+            kern_param, do_conv, kern_param, sz, src, filter, comp, batch_id, gb);
+}
+
+}  // namespace
+
+WorkspaceBundle vnni_chanwise_nchw88::get_bundle(const NCBKernSizeParam& param) {
+    ConvSize sz{param};
+    size_t nr_threads = param.nr_threads;
+    return WorkspaceBundle(
+            nullptr,
+            {sz.src_plane_size() * nr_threads, sz.filter_size() * nr_threads});
+}
+
+SmallVector<NCBKern> vnni_chanwise_nchw88::get_kimpls(
+        const NCBKernSizeParam& kern_param, const WorkspaceBundle& bundle) {
+    size_t N = kern_param.n;
+    size_t group = kern_param.filter_meta.group;
+    megdnn_assert(group % PACK == 0, "nchw88 channel wise conv need group %% 8 == 0");
+    auto conv_task = [bundle = bundle](
+                             const NCBKernParam& kern_param,
+                             const NCBKernIndex& ncb_index) mutable {
+        bundle.set(kern_param.workspace_ptr);
+        conv_kern(bundle, kern_param, ncb_index);
+    };
+    return {{conv_task, {N, group / PACK}}};
+}
+#endif
+
+// vim: syntax=cpp.doxygen
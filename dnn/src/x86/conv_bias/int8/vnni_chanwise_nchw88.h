@@ -0,0 +1,37 @@
+/**
+ * \file dnn/src/x86/conv_bias/int8/vnni_chanwise_nchw88.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#pragma once
+
+#include "src/x86/conv_bias/opr_impl.h"
+
+#if MEGDNN_X86_WITH_VNNI
+namespace megdnn {
+namespace x86 {
+namespace vnni_chanwise_nchw88 {
+
+using NCBKern = fallback::ConvBiasImpl::NCBKern;
+using NCBKernSizeParam = fallback::ConvBiasImpl::NCBKernSizeParam;
+
+//! max number of filter taps, which is 7x7
+constexpr size_t MAX_TAPS = 49;
+
+WorkspaceBundle get_bundle(const NCBKernSizeParam& param);
+
+SmallVector<NCBKern> get_kimpls(
+        const NCBKernSizeParam& param, const WorkspaceBundle& bundle);
+
+}  // namespace vnni_chanwise_nchw88
+}  // namespace x86
+}  // namespace megdnn
+#endif
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,304 @@
+/**
+ * \file dnn/src/x86/conv_bias/int8/vnni_direct_nchw88.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+
+#include "src/x86/conv_bias/int8/vnni_direct_nchw88.h"
+
+#if MEGDNN_X86_WITH_VNNI
+#include "src/x86/conv_bias/int8/vnni_nchw88_common.h"
+
+#include <type_traits>
+
+using namespace megdnn;
+using namespace x86;
+using namespace vnni_nchw88;
+
+namespace {
+constexpr size_t PACK = 8;
+//! output pixels computed by one kernel block
+constexpr size_t OW_BLOCK = 8;
+
+struct ConvSize {
+    size_t group, N, IC, OC, IH, IW, OH, OW, FH, FW, PH, PW, SH, SW;
+    size_t IH2, IW2, ICB, OCB;
+    //! number of 4-channel groups in a packed src pixel
+    size_t nr_ic4;
+    //! NCHW src with {oc/8, fh, fw, ic, 8} filter
+    bool hybrid;
+
+    explicit ConvSize(const NCBKernSizeParam& param) {
+        auto&& fm = param.filter_meta;
+        group = fm.group;
+        N = param.n;
+        IC = fm.icpg;
+        OC = fm.ocpg;
+        IH = param.isz[0];
+        IW = param.isz[1];
+        OH = param.osz[0];
+        OW = param.osz[1];
+        FH = fm.spatial[0];
+        FW = fm.spatial[1];
+        PH = fm.padding[0];
+        PW = fm.padding[1];
+        SH = fm.stride[0];
+        SW = fm.stride[1];
+        IH2 = IH + 2 * PH;
+        IW2 = IW + 2 * PW;
+        hybrid = IC < PACK;
+        ICB = hybrid ? 1 : IC / PACK;
+        OCB = OC / PACK;
+        nr_ic4 = hybrid ? div_ceil<size_t>(IC, 4) : 2;
+    }
+
+    size_t src_plane_size() const { return ICB * IH2 * IW2 * nr_ic4 * 4; }
+    size_t filter_block_size() const { return ICB * FH * FW * nr_ic4 * 32; }
+};
+
+//! NCHW (IC, IH, IW) int8 -> padded (IH2, IW2, nr_ic4 * 4) uint8
+void pack_src_hybrid(const int8_t* src, uint8_t* dst, const ConvSize& sz) {
+    const size_t CB = sz.nr_ic4 * 4;
+    std::memset(dst, SRC_ZERO_POINT, sz.IH2 * sz.IW2 * CB);
+    for (size_t ic = 0; ic < sz.IC; ++ic) {
+        for (size_t ih = 0; ih < sz.IH; ++ih) {
+            const int8_t* sptr = src + (ic * sz.IH + ih) * sz.IW;
+            uint8_t* dptr = dst + ((ih + sz.PH) * sz.IW2 + sz.PW) * CB + ic;
+            for (size_t iw = 0; iw < sz.IW; ++iw) {
+                dptr[iw * CB] = static_cast<uint8_t>(sptr[iw]) ^ 0x80;
+            }
+        }
+    }
+}
+
+void pack_src(
+        const WorkspaceBundle& bundle, const NCBKernParam& kern_param,
+        const NCBKernIndex& ncb_index) {
+    ConvSize sz{kern_param};
+    size_t group_id = ncb_index.ndrange_id[0], batch_id = ncb_index.ndrange_id[1],
+           icb = ncb_index.ndrange_id[2];
+    uint8_t* dst = static_cast<uint8_t*>(bundle.get(0)) +
+                   (batch_id * sz.group + group_id) * sz.src_plane_size();
+    const int8_t* src = kern_param.src<dt_int8>(batch_id, group_id);
+    if (sz.hybrid) {
+        pack_src_hybrid(src, dst, sz);
+    } else {
+        pack_src_nchw88(
+                src + icb * sz.IH * sz.IW * PACK, dst + icb * sz.IH2 * sz.IW2 * PACK,
+                sz.IH, sz.IW, sz.PH, sz.PW, sz.IH2, sz.IW2);
+    }
+}
+
+/*!
+ * repack one oc block of filter into registers of vpdpbusd, where the int32
+ * lane oc holds 4 consecutive input channels of that output channel, and
+ * compute the compensation of the src shift
+ */
+void pack_filter(
+        const WorkspaceBundle& bundle, const NCBKernParam& kern_param,
+        const NCBKernIndex& ncb_index) {
+    ConvSize sz{kern_param};
+    size_t group_id = ncb_index.ndrange_id[0], ocb = ncb_index.ndrange_id[1];
+    const size_t chunk_ic = sz.hybrid ? sz.IC : PACK;
+    const size_t nr_chunk = sz.ICB * sz.FH * sz.FW;
+    const int8_t* src =
+            kern_param.filter<dt_int8>(group_id) + ocb * nr_chunk * chunk_ic * PACK;
+    int8_t* dst = static_cast<int8_t*>(bundle.get(1)) +
+                  (group_id * sz.OCB + ocb) * sz.filter_block_size();
+    int32_t* comp = static_cast<int32_t*>(bundle.get(2)) + group_id * sz.OC +
+                    ocb * PACK;
+    int32_t sum[PACK] = {0};
+    for (size_t chunk = 0; chunk < nr_chunk; ++chunk) {
+        for (size_t h = 0; h < sz.nr_ic4; ++h) {
+            for (size_t oc = 0; oc < PACK; ++oc) {
+                for (size_t j = 0; j < 4; ++j) {
+                    size_t ic = h * 4 + j;
+                    int8_t val = ic < chunk_ic ? src[ic * PACK + oc] : 0;
+                    dst[h * 32 + oc * 4 + j] = val;
+                    sum[oc] += val;
+                }
+            }
+        }
+        src += chunk_ic * PACK;
+        dst += sz.nr_ic4 * 32;
+    }
+    for (size_t oc = 0; oc < PACK; ++oc) {
+        comp[oc] = SRC_ZERO_POINT * sum[oc];
+    }
+}
+
+template <int nr_ow, int nr_ic4>
+MEGDNN_ATTRIBUTE_TARGET("avx512vl,avx512vnni")
+inline void kern_block(
+        const uint8_t* src, const int8_t* filter, const ConvSize& sz, __m256i* acc) {
+    constexpr size_t CB = nr_ic4 * 4;
+    const size_t ow_stride = sz.SW * CB, row_stride = sz.IW2 * CB,
+                 icb_stride = sz.IH2 * row_stride;
+    for (int i = 0; i < nr_ow; ++i) {
+        acc[i] = _mm256_setzero_si256();
+    }
+    for (size_t icb = 0; icb < sz.ICB; ++icb) {
+        for (size_t fh = 0; fh < sz.FH; ++fh) {
+            const uint8_t* src_row = src + icb * icb_stride + fh * row_stride;
+            for (size_t fw = 0; fw < sz.FW; ++fw) {
+                __m256i weight[nr_ic4];
+                for (int h = 0; h < nr_ic4; ++h) {
+                    weight[h] = _mm256_loadu_si256(
+                            reinterpret_cast<const __m256i*>(filter + h * 32));
+                }
+                filter += nr_ic4 * 32;
+                const uint8_t* sptr = src_row + fw * CB;
+                for (int i = 0; i < nr_ow; ++i) {
+                    for (int h = 0; h < nr_ic4; ++h) {
+                        __m256i feat = _mm256_set1_epi32(
+                                *reinterpret_cast<const int32_t*>(
+                                        sptr + i * ow_stride + h * 4));
+                        acc[i] = _mm256_dpbusd_epi32(acc[i], feat, weight[h]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class Op, int nr_ow, int nr_ic4>
+MEGDNN_ATTRIBUTE_TARGET("avx512vl,avx512vnni")
+inline void run_block(
+        const Op& op, const uint8_t* src, const int8_t* filter, const ConvSize& sz,
+        __m256i bias_comp, const int32_t* bias, int8_t* dst, size_t dst_size) {
+    __m256i acc[nr_ow];
+    kern_block<nr_ow, nr_ic4>(src, filter, sz, acc);
+    for (int i = 0; i < nr_ow; ++i) {
+        __m256i res = _mm256_add_epi32(acc[i], bias_comp);
+        if (bias) {
+            res = _mm256_add_epi32(
+                    res, _mm256_loadu_si256(
+                                 reinterpret_cast<const __m256i*>(bias + i * PACK)));
+        }
+        op(res, dst + i * PACK * dst_size);
+    }
+}
+
+template <class Op, int nr_ic4>
+MEGDNN_ATTRIBUTE_TARGET("avx512vl,avx512vnni")
+void do_conv(
+        std::integral_constant<int, nr_ic4>, const NCBKernParam& kern_param,
+        const ConvSize& sz, const uint8_t* src, const int8_t* filter,
+        const int32_t* comp, size_t batch_id, size_t group_id, size_t ocb) {
+    constexpr size_t CB = nr_ic4 * 4;
+    Op op(kern_param);
+    const size_t dst_size = kern_param.dst_type.size();
+    const size_t OHW = sz.OH * sz.OW;
+    int8_t* dst = static_cast<int8_t*>(kern_param.dst<void>(batch_id, group_id)) +
+                  ocb * OHW * PACK * dst_size;
+    __m256i bias_comp = _mm256_sub_epi32(
+            _mm256_setzero_si256(),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(comp)));
+    const int32_t* bias = nullptr;
+    if (kern_param.bias_mode == BiasMode::BROADCAST_CHANNEL_BIAS) {
+        bias_comp = _mm256_add_epi32(
+                bias_comp,
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+                        kern_param.bias<dt_int32>(batch_id, group_id) + ocb * PACK)));
+    } else if (kern_param.bias_mode == BiasMode::BIAS) {
+        bias = kern_param.bias<dt_int32>(batch_id, group_id) + ocb * OHW * PACK;
+    }
+
+    for (size_t oh = 0; oh < sz.OH; ++oh) {
+        const uint8_t* src_row = src + oh * sz.SH * sz.IW2 * CB;
+        size_t ow = 0;
+#define cb(nr_ow)                                                                 \
+    run_block<Op, nr_ow, nr_ic4>(                                                 \
+            op, src_row + ow * sz.SW * CB, filter, sz, bias_comp,                 \
+            bias ? bias + (oh * sz.OW + ow) * PACK : nullptr,                     \
+            dst + (oh * sz.OW + ow) * PACK * dst_size, dst_size)
+        for (; ow + OW_BLOCK <= sz.OW; ow += OW_BLOCK) {
+            cb(OW_BLOCK);
+        }
+        switch (sz.OW - ow) {
+            case 0:
+                break;
+#define cb_switch(nr_ow) \
+    case nr_ow:          \
+        cb(nr_ow);       \
+        break;
+                cb_switch(1);
+                cb_switch(2);
+                cb_switch(3);
+                cb_switch(4);
+                cb_switch(5);
+                cb_switch(6);
+                cb_switch(7);
+#undef cb_switch
+            default:
+                megdnn_assert(0, "invalid ow remain %zu", sz.OW - ow);
+        }
+#undef cb
+    }
+}
+
+void conv_kern(
+        const WorkspaceBundle& bundle, const NCBKernParam& kern_param,
+        const NCBKernIndex& ncb_index) {
+    ConvSize sz{kern_param};
+    size_t group_id = ncb_index.ndrange_id[0], batch_id = ncb_index.ndrange_id[1],
+           ocb = ncb_index.ndrange_id[2];
+    const uint8_t* src = static_cast<uint8_t*>(bundle.get(0)) +
+                         (batch_id * sz.group + group_id) * sz.src_plane_size();
+    const int8_t* filter = static_cast<int8_t*>(bundle.get(1)) +
+                           (group_id * sz.OCB + ocb) * sz.filter_block_size();
+    const int32_t* comp =
+            static_cast<int32_t*>(bundle.get(2)) + group_id * sz.OC + ocb * PACK;
+    if (sz.nr_ic4 == 1) {
+        DISPATCH_VNNI_NCHW88_STORE_OP(
+                kern_param, do_conv, std::integral_constant<int, 1>(), kern_param, sz,
+                src, filter, comp, batch_id, group_id, ocb);
+    } else {
+        megdnn_assert(sz.nr_ic4 == 2);
+        DISPATCH_VNNI_NCHW88_STORE_OP(
+                kern_param, do_conv, std::integral_constant<int, 2>(), kern_param, sz,
+                src, filter, comp, batch_id, group_id, ocb);
+    }
+}
+
+}  // namespace
+
+WorkspaceBundle vnni_direct_nchw88::get_bundle(const NCBKernSizeParam& param) {
+    ConvSize sz{param};
+    size_t src_size = sz.group * sz.N * sz.src_plane_size();
+    size_t filter_size = sz.group * sz.OCB * sz.filter_block_size();
+    size_t comp_size = sz.group * sz.OC * sizeof(int32_t);
+    return WorkspaceBundle(nullptr, {src_size, filter_size, comp_size});
+}
+
+SmallVector<NCBKern> vnni_direct_nchw88::get_kimpls(
+        const NCBKernSizeParam& kern_param, const WorkspaceBundle& bundle) {
+    ConvSize sz{kern_param};
+    SmallVector<NCBKern> ncb_kerns;
+#define cb(task, func)                                                         \
+    auto task = [bundle = bundle](                                             \
+                        const NCBKernParam& kern_param,                        \
+                        const NCBKernIndex& ncb_index) mutable {               \
+        bundle.set(kern_param.workspace_ptr);                                  \
+        func(bundle, kern_param, ncb_index);                                   \
+    };
+    cb(pack_src_task, pack_src);
+    ncb_kerns.push_back({pack_src_task, {sz.group, sz.N, sz.ICB}});
+
+    cb(pack_filter_task, pack_filter);
+    ncb_kerns.push_back({pack_filter_task, {sz.group, sz.OCB, 1_z}});
+
+    cb(conv_task, conv_kern);
+    ncb_kerns.push_back({conv_task, {sz.group, sz.N, sz.OCB}});
+#undef cb
+    return ncb_kerns;
+}
+#endif
+
+// vim: syntax=cpp.doxygen
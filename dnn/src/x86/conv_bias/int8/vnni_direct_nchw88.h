@@ -0,0 +1,39 @@
+/**
+ * \file dnn/src/x86/conv_bias/int8/vnni_direct_nchw88.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#pragma once
+
+#include "src/x86/conv_bias/opr_impl.h"
+
+#if MEGDNN_X86_WITH_VNNI
+namespace megdnn {
+namespace x86 {
+namespace vnni_direct_nchw88 {
+
+using NCBKern = fallback::ConvBiasImpl::NCBKern;
+using NCBKernSizeParam = fallback::ConvBiasImpl::NCBKernSizeParam;
+
+/*!
+ * direct int8 conv with NCHW88 src and dst. If the filter is in the hybrid
+ * layout {oc/8, fh, fw, ic, 8}, the src is in NCHW, which is used by the
+ * first layer of a NCHW88 network.
+ */
+WorkspaceBundle get_bundle(const NCBKernSizeParam& param);
+
+SmallVector<NCBKern> get_kimpls(
+        const NCBKernSizeParam& param, const WorkspaceBundle& bundle);
+
+}  // namespace vnni_direct_nchw88
+}  // namespace x86
+}  // namespace megdnn
+#endif
+
+// vim: syntax=cpp.doxygen
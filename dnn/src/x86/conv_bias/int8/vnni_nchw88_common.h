@@ -0,0 +1,177 @@
+/**
+ * \file dnn/src/x86/conv_bias/int8/vnni_nchw88_common.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#pragma once
+
+#if MEGDNN_X86_WITH_VNNI
+#include <immintrin.h>
+#include <cstring>
+#include "src/x86/conv_bias/opr_impl.h"
+
+namespace megdnn {
+namespace x86 {
+namespace vnni_nchw88 {
+
+using NCBKern = fallback::ConvBiasImpl::NCBKern;
+using NCBKernSizeParam = fallback::ConvBiasImpl::NCBKernSizeParam;
+using NCBKernParam = fallback::ConvBiasImpl::NCBKernParam;
+using NCBKernIndex = fallback::ConvBiasImpl::NCBKernIndex;
+using NonlineMode = param::ConvBias::NonlineMode;
+
+/*!
+ * vpdpbusd multiplies unsigned bytes with signed bytes, so the int8 src is
+ * shifted by 128 when it is packed and the excess 128 * sum(filter) is
+ * subtracted in the epilogue. Padding is filled with 128, which stands for
+ * zero after the shift.
+ */
+constexpr uint8_t SRC_ZERO_POINT = 128;
+
+/*!
+ * \brief copy a (IH, IW, 8) int8 plane into the padded (IH2, IW2, 8) uint8
+ * plane used by the vnni kernels
+ */
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+static inline void pack_src_nchw88(
+        const int8_t* src, uint8_t* dst, size_t IH, size_t IW, size_t PH, size_t PW,
+        size_t IH2, size_t IW2) {
+    constexpr size_t pack = 8;
+    const __m256i shift = _mm256_set1_epi8(static_cast<char>(0x80));
+    const size_t row_bytes = IW * pack;
+    std::memset(dst, SRC_ZERO_POINT, PH * IW2 * pack);
+    uint8_t* out = dst + PH * IW2 * pack;
+    for (size_t ih = 0; ih < IH; ++ih) {
+        std::memset(out, SRC_ZERO_POINT, PW * pack);
+        uint8_t* out_row = out + PW * pack;
+        const int8_t* in_row = src + ih * row_bytes;
+        size_t i = 0;
+        for (; i + 32 <= row_bytes; i += 32) {
+            __m256i v =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in_row + i));
+            _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(out_row + i),
+                    _mm256_xor_si256(v, shift));
+        }
+        for (; i < row_bytes; ++i) {
+            out_row[i] = static_cast<uint8_t>(in_row[i]) ^ 0x80;
+        }
+        std::memset(
+                out_row + row_bytes, SRC_ZERO_POINT, (IW2 - IW - PW) * pack);
+        out += IW2 * pack;
+    }
+    std::memset(out, SRC_ZERO_POINT, (IH2 - IH - PH) * IW2 * pack);
+}
+
+/*!
+ * \brief fused epilogue which writes one NCHW88 pixel (8 channels) of dst
+ *
+ * The input is the int32 accumulator with bias already added, which is in the
+ * src_scale * filter_scale domain.
+ */
+template <typename dst_ctype, NonlineMode mode>
+struct StoreOp;
+
+template <NonlineMode mode>
+struct StoreOp<dt_qint32, mode> {
+    static_assert(
+            mode == NonlineMode::IDENTITY || mode == NonlineMode::RELU,
+            "qint32 output only supports IDENTITY and RELU");
+    explicit StoreOp(const NCBKernParam&) {}
+
+    MEGDNN_ATTRIBUTE_TARGET("avx512vl,avx512vnni")
+    void operator()(__m256i res, void* dst) const {
+        if (mode == NonlineMode::RELU) {
+            res = _mm256_max_epi32(res, _mm256_setzero_si256());
+        }
+        _mm256_storeu_si256(static_cast<__m256i*>(dst), res);
+    }
+};
+
+template <NonlineMode mode>
+struct StoreOp<dt_qint8, mode> {
+    static_assert(
+            mode == NonlineMode::IDENTITY || mode == NonlineMode::RELU ||
+                    mode == NonlineMode::H_SWISH,
+            "qint8 output only supports IDENTITY, RELU and H_SWISH");
+    float scale, dst_scale;
+    explicit StoreOp(const NCBKernParam& param) {
+        scale = param.src_type.param<dtype::QuantizedS8>().scale *
+                param.filter_type.param<dtype::QuantizedS8>().scale;
+        dst_scale = param.dst_type.param<dtype::QuantizedS8>().scale;
+    }
+
+    MEGDNN_ATTRIBUTE_TARGET("avx512vl,avx512vnni")
+    void operator()(__m256i res, void* dst) const {
+        __m256 val = _mm256_cvtepi32_ps(res);
+        if (mode == NonlineMode::H_SWISH) {
+            val = _mm256_mul_ps(val, _mm256_set1_ps(scale));
+            __m256 relu6 = _mm256_min_ps(
+                    _mm256_max_ps(
+                            _mm256_add_ps(val, _mm256_set1_ps(3.f)),
+                            _mm256_setzero_ps()),
+                    _mm256_set1_ps(6.f));
+            val = _mm256_mul_ps(
+                    _mm256_mul_ps(val, relu6), _mm256_set1_ps(1.f / 6.f / dst_scale));
+        } else {
+            val = _mm256_mul_ps(val, _mm256_set1_ps(scale / dst_scale));
+            if (mode == NonlineMode::RELU) {
+                val = _mm256_max_ps(val, _mm256_setzero_ps());
+            }
+        }
+        //! round half away from zero like dtype::QuantizedS8::quantize
+        __m256 inc = _mm256_blendv_ps(
+                _mm256_set1_ps(-0.5f), _mm256_set1_ps(0.5f),
+                _mm256_cmp_ps(val, _mm256_setzero_ps(), _CMP_GE_OQ));
+        __m256i q = _mm256_cvttps_epi32(_mm256_add_ps(val, inc));
+        _mm_storel_epi64(static_cast<__m128i*>(dst), _mm256_cvtsepi32_epi8(q));
+    }
+};
+
+/*!
+ * \brief dispatch a kernel templated on StoreOp according to the dst dtype
+ * and nonline mode
+ *
+ * \param _kern a template taking the StoreOp type
+ */
+#define DISPATCH_VNNI_NCHW88_STORE_OP(_param, _kern, ...)                      \
+    do {                                                                       \
+        bool _dst_qint8 = (_param).dst_type.enumv() == DTypeEnum::QuantizedS8; \
+        switch ((_param).nonlineMode) {                                        \
+            case NonlineMode::IDENTITY:                                        \
+                if (_dst_qint8) {                                              \
+                    _kern<StoreOp<dt_qint8, NonlineMode::IDENTITY>>(           \
+                            __VA_ARGS__);                                      \
+                } else {                                                       \
+                    _kern<StoreOp<dt_qint32, NonlineMode::IDENTITY>>(          \
+                            __VA_ARGS__);                                      \
+                }                                                              \
+                break;                                                         \
+            case NonlineMode::RELU:                                            \
+                if (_dst_qint8) {                                              \
+                    _kern<StoreOp<dt_qint8, NonlineMode::RELU>>(__VA_ARGS__);  \
+                } else {                                                       \
+                    _kern<StoreOp<dt_qint32, NonlineMode::RELU>>(__VA_ARGS__); \
+                }                                                              \
+                break;                                                         \
+            case NonlineMode::H_SWISH:                                         \
+                megdnn_assert(_dst_qint8);                                     \
+                _kern<StoreOp<dt_qint8, NonlineMode::H_SWISH>>(__VA_ARGS__);   \
+                break;                                                         \
+            default:                                                           \
+                megdnn_throw("unsupported nonline mode of vnni nchw88 conv");  \
+        }                                                                      \
+    } while (0)
+
+}  // namespace vnni_nchw88
+}  // namespace x86
+}  // namespace megdnn
+#endif
+
+// vim: syntax=cpp.doxygen
@@ -16,6 +16,7 @@
 #include "src/common/metahelper.h"
 #include "src/common/opr_delegate.h"
 #include "src/x86/conv_bias/f32/algos.h"
+#include "src/x86/conv_bias/int4/algos.h"
 #include "src/x86/conv_bias/int8/algo_usable_preferred.h"
 #include "src/x86/conv_bias/int8/algos.h"
 #include "src/x86/matrix_mul/opr_impl.h"
@@ -38,6 +39,12 @@ class ConvBiasImpl::AlgoPack : NonCopyableObj {
     AlgoAVX2DirectConvStride2 avx2_stride2_direct;
     AlgoChanWiseAvx2Stride1Qint8 avx2_stride1_chanwsie_qint8;
     AlgoChanWiseAvx2Stride2Qint8 avx2_stride2_chanwsie_qint8;
+    AlgoInt4Im2colAVX2 avx2_im2col_int4;
+#if MEGDNN_X86_WITH_VNNI
+    AlgoDirectVnniNchw88Int8 vnni_direct_nchw88_int8;
+    AlgoNchwNchw88VnniInt8 vnni_nchw_nchw88_int8;
+    AlgoChanWiseVnniNchw88Int8 vnni_chanwise_nchw88_int8;
+#endif
 #if MEGDNN_X86_WITH_MKL_DNN
     AlgoMkldnnMatmulQint8 mkldnn_matmul_qint8;
     //! Because the mkldnnconv need handle
@@ -58,6 +65,11 @@ public:
         m_all_no_winograd_algo.emplace_back(&mkldnn_conv_fp32);
         m_all_no_winograd_algo.emplace_back(&mkldnn_matmul_qint8);
         m_all_no_winograd_algo.emplace_back(&mkldnn_qint8);
+#endif
+#if MEGDNN_X86_WITH_VNNI
+        m_all_no_winograd_algo.emplace_back(&vnni_chanwise_nchw88_int8);
+        m_all_no_winograd_algo.emplace_back(&vnni_nchw_nchw88_int8);
+        m_all_no_winograd_algo.emplace_back(&vnni_direct_nchw88_int8);
 #endif
         m_all_no_winograd_algo.emplace_back(&stride1_direct);
         m_all_no_winograd_algo.emplace_back(&stride2_direct);
@@ -65,6 +77,7 @@ public:
         m_all_no_winograd_algo.emplace_back(&avx2_stride2_chanwsie_qint8);
         m_all_no_winograd_algo.emplace_back(&avx2_stride1_direct_int8);
         m_all_no_winograd_algo.emplace_back(&avx2_stride2_direct);
+        m_all_no_winograd_algo.emplace_back(&avx2_im2col_int4);
 
         static CpuOprDelegationStorage<> storage;
         auto matmul_opr = storage.get<MatrixMul>();
@@ -58,6 +58,12 @@ private:
     class AlgoAVX2DirectConvStride2;
     class AlgoChanWiseAvx2Stride1Qint8;
     class AlgoChanWiseAvx2Stride2Qint8;
+    class AlgoInt4Im2colAVX2;
+#if MEGDNN_X86_WITH_VNNI
+    class AlgoDirectVnniNchw88Int8;
+    class AlgoNchwNchw88VnniInt8;
+    class AlgoChanWiseVnniNchw88Int8;
+#endif
 #if MEGDNN_X86_WITH_MKL_DNN
     class AlgoMkldnnConv;
     class AlgoMkldnnQint8;
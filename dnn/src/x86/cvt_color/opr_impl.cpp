@@ -67,6 +67,7 @@
 #include "src/naive/handle.h"
 #include "src/x86/utils.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include <pmmintrin.h>
@@ -89,10 +90,12 @@ namespace {
  * \tparam is_planar, if true, the layout is YYYYUUVV or YYYYVVUU, otherwise
  *     YYYYYUVUV or YYYYYVUVU
  * \tparam is_uv, if true, U is before V, otherwise V is before U
+ * \param row_begin, row_end, the dst rows to convert, row_begin must be even
  */
 template <bool rgb = true, bool is_planar = true, bool is_uv = true>
 MEGDNN_ATTRIBUTE_TARGET("sse4.2")
-void cvt_yuv_transform(const Mat8u& src, Mat8u& dst) {
+void cvt_yuv_transform(
+        const Mat8u& src, Mat8u& dst, size_t row_begin, size_t row_end) {
     __m128i out0, out1, out2;
     __m128i Y0, Y1, VU, V0, V1, V3, U0, U1, U3;
     __m128i Y00, Y01, Y02, Y03;
@@ -165,7 +168,20 @@ void cvt_yuv_transform(const Mat8u& src, Mat8u& dst) {
         out[index++] = R;     \
     }
 
-    for (size_t r = 0; r < height; r += 2, pY += (src_step << 1)) {
+    //! skip to the first row pair of [row_begin, row_end)
+    pY += row_begin * src_step;
+    if (is_planar) {
+        pV += row_begin / 2 * (src_step / 2);
+        pU += row_begin / 2 * (src_step / 2);
+    } else {
+        if (is_uv) {
+            pU += row_begin / 2 * src_step;
+        } else {
+            pV += row_begin / 2 * src_step;
+        }
+    }
+
+    for (size_t r = row_begin; r < row_end; r += 2, pY += (src_step << 1)) {
         unsigned char* dst0 = dst.ptr(r);
         unsigned char* dst1 = dst.ptr(r + 1);
         size_t index0 = 0;
@@ -474,6 +490,7 @@ void cvt_yuv_transform(const Mat8u& src, Mat8u& dst) {
  * \tparam is_planar, if true, the layout is YYYYUUVV or YYYYVVUU, otherwise
  *     YYYYYUVUV or YYYYYVUVU
  * \tparam is_uv, if true, U is before V, otherwise V is before U
+ * \param row_begin, row_end, the dst rows to convert, row_begin must be even
  *
  * \note it is BT.601 YUV to RGB reference, it refer to
  * https://github.com/opencv/opencv/blob/1b53a4fccc1a61541b71340af9a04b59484ec2cf/modules/imgproc/src/opencl/color_yuv.cl#L253
@@ -485,7 +502,8 @@ void cvt_yuv_transform(const Mat8u& src, Mat8u& dst) {
  */
 template <bool rgb = true, bool is_planar = true, bool is_uv = true>
 MEGDNN_ATTRIBUTE_TARGET("sse4.2")
-void cvt_BT601_yuv_transform(const Mat8u& src, Mat8u& dst) {
+void cvt_BT601_yuv_transform(
+        const Mat8u& src, Mat8u& dst, size_t row_begin, size_t row_end) {
     typedef unsigned char uint8;
 
     size_t height = dst.rows();
@@ -571,7 +589,20 @@ void cvt_BT601_yuv_transform(const Mat8u& src, Mat8u& dst) {
     __m128i RV2, GUV2, BU2;
     __m128i RV3, GUV3, BU3;
 
-    for (size_t r = 0; r < height; r += 2, pY += (src_step << 1)) {
+    //! skip to the first row pair of [row_begin, row_end)
+    pY += row_begin * src_step;
+    if (is_planar) {
+        pV += row_begin / 2 * (src_step / 2);
+        pU += row_begin / 2 * (src_step / 2);
+    } else {
+        if (is_uv) {
+            pU += row_begin / 2 * src_step;
+        } else {
+            pV += row_begin / 2 * src_step;
+        }
+    }
+
+    for (size_t r = row_begin; r < row_end; r += 2, pY += (src_step << 1)) {
         unsigned char* dst0 = dst.ptr(r);
         unsigned char* dst1 = dst.ptr(r + 1);
         size_t index0 = 0;
@@ -1530,34 +1561,81 @@ void cvt_rgb2bgr_8u_SSE_4_2(const Mat8u& src, Mat8u& dst) {
     }
 }
 
-template <>
-void cvt_rgb2gray<uchar>(const Mat8u& src, Mat8u& dst) {
-    megdnn_assert(src.rows() == dst.rows());
-    megdnn_assert(src.cols() == dst.cols());
-    megdnn_assert(src.channels() == 3);
-    megdnn_assert(dst.channels() == 1);
+MEGDNN_ATTRIBUTE_TARGET("sse4.2")
+static inline __m128i cvt_gray_4px_SSE_4_2(
+        __m128i px, __m128i shuff_01, __m128i shuff_2, __m128i w01, __m128i w2,
+        __m128i delta) {
+    __m128i x01 = _mm_madd_epi16(_mm_shuffle_epi8(px, shuff_01), w01);
+    __m128i x2 = _mm_madd_epi16(_mm_shuffle_epi8(px, shuff_2), w2);
+    return _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(x01, x2), delta), 14);
+}
 
+/**
+ * \brief 8-bit color to gray with the same fixed point weights as the scalar
+ * version: gray = (w0 * x0 + w1 * x1 + w2 * x2 + (1 << 13)) >> 14
+ *
+ * \tparam scn channels of src, 3 or 4 (the 4th one is ignored)
+ * \tparam bgr if true, the channel order of src is BGR, otherwise RGB
+ */
+template <size_t scn, bool bgr>
+MEGDNN_ATTRIBUTE_TARGET("sse4.2")
+void cvt_color2gray_8u_SSE_4_2(const Mat8u& src, Mat8u& dst) {
     const int yuv_shift = 14, R2Y = 4899, G2Y = 9617, B2Y = 1868;
-
-    int tab[256 * 3];
-
-    int b = 0, g = 0, r = (1 << (yuv_shift - 1));
-    for (int i = 0; i < 256; ++i, r += R2Y, g += G2Y, b += B2Y) {
-        tab[i] = r;
-        tab[i + 256] = g;
-        tab[i + 512] = b;
-    }
+    const int w0 = bgr ? B2Y : R2Y, w2 = bgr ? R2Y : B2Y;
+
+    //! (x0, x1) and (x2, 0) of 4 pixels as int16 pairs for _mm_madd_epi16
+    __m128i shuff_01 =
+            scn == 3 ? _mm_setr_epi8(
+                               0, -1, 1, -1, 3, -1, 4, -1, 6, -1, 7, -1, 9, -1, 10, -1)
+                     : _mm_setr_epi8(
+                               0, -1, 1, -1, 4, -1, 5, -1, 8, -1, 9, -1, 12, -1, 13,
+                               -1);
+    __m128i shuff_2 =
+            scn == 3 ? _mm_setr_epi8(
+                               2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1,
+                               -1)
+                     : _mm_setr_epi8(
+                               2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1,
+                               -1, -1);
+    __m128i w01 = _mm_set1_epi32((G2Y << 16) | w0);
+    __m128i w2_ = _mm_set1_epi32(w2);
+    __m128i delta = _mm_set1_epi32(1 << (yuv_shift - 1));
+
+    //! 8 pixels are loaded by two 16-byte loads at pixel 0 and 4
+    const size_t tail = 4 + (16 + scn - 1) / scn;
+    size_t cols = src.cols();
     for (size_t r = 0; r < src.rows(); ++r) {
         const uchar* psrc = src.ptr(r);
-        const uchar* pend = psrc + src.cols() * src.channels();
         uchar* pdst = dst.ptr(r);
-        for (; psrc < pend; psrc += 3, pdst += 1) {
-            pdst[0] = (tab[psrc[0]] + tab[psrc[1] + 256] + tab[psrc[2] + 512]) >>
+        size_t c = 0;
+        for (; c + tail <= cols; c += 8, psrc += 8 * scn, pdst += 8) {
+            __m128i g0 = cvt_gray_4px_SSE_4_2(
+                    _mm_lddqu_si128((__m128i*)psrc), shuff_01, shuff_2, w01, w2_,
+                    delta);
+            __m128i g1 = cvt_gray_4px_SSE_4_2(
+                    _mm_lddqu_si128((__m128i*)(psrc + 4 * scn)), shuff_01, shuff_2,
+                    w01, w2_, delta);
+            __m128i g = _mm_packs_epi32(g0, g1);
+            _mm_storel_epi64((__m128i*)pdst, _mm_packus_epi16(g, g));
+        }
+        for (; c < cols; ++c, psrc += scn, pdst += 1) {
+            pdst[0] = (psrc[0] * w0 + psrc[1] * G2Y + psrc[2] * w2 +
+                       (1 << (yuv_shift - 1))) >>
                       yuv_shift;
         }
     }
 }
 
+template <>
+void cvt_rgb2gray<uchar>(const Mat8u& src, Mat8u& dst) {
+    megdnn_assert(src.rows() == dst.rows());
+    megdnn_assert(src.cols() == dst.cols());
+    megdnn_assert(src.channels() == 3);
+    megdnn_assert(dst.channels() == 1);
+
+    return cvt_color2gray_8u_SSE_4_2<3, false>(src, dst);
+}
+
 template <>
 void cvt_rgb2gray<float>(const Mat32f& src, Mat32f& dst) {
     megdnn_assert(src.channels() == 3);
@@ -1656,25 +1734,7 @@ void cvt_rgba2gray<uchar>(const Mat8u& src, Mat8u& dst) {
     megdnn_assert(src.rows() == dst.rows());
     megdnn_assert(src.cols() == dst.cols());
 
-    const int yuv_shift = 14, R2Y = 4899, G2Y = 9617, B2Y = 1868;
-
-    const uchar* _src = src.ptr();
-    uchar* _dst = dst.ptr();
-    size_t rows = src.rows();
-    size_t cols = src.cols();
-    size_t src_step = src.step();
-    size_t dst_step = dst.step();
-    for (size_t r = 0; r < rows; ++r, _src += src_step, _dst += dst_step) {
-        const uchar* temp_src = _src;
-        uchar* temp_dst = _dst;
-        for (size_t c = 0; c < cols; ++c, temp_src += 4, temp_dst += 1) {
-            uchar x0 = temp_src[0];
-            uchar x1 = temp_src[1];
-            uchar x2 = temp_src[2];
-            temp_dst[0] = (x0 * R2Y + x1 * G2Y + x2 * B2Y + (1 << (yuv_shift - 1))) >>
-                          yuv_shift;
-        }
-    }
+    return cvt_color2gray_8u_SSE_4_2<4, false>(src, dst);
 }
 
 template <>
@@ -1689,38 +1749,12 @@ void cvt_rgb2bgr<uchar>(const Mat8u& src, Mat8u& dst) {
 
 template <>
 void cvt_bgr2gray<uchar>(const Mat8u& src, Mat8u& dst) {
-    megdnn_assert(src.channels() == 3);
-    megdnn_assert(dst.channels() == 1);
     megdnn_assert(src.rows() == dst.rows());
     megdnn_assert(src.cols() == dst.cols());
+    megdnn_assert(src.channels() == 3);
+    megdnn_assert(dst.channels() == 1);
 
-    const int yuv_shift = 14, R2Y = 4899, G2Y = 9617, B2Y = 1868;
-
-    int tab[256 * 3];
-
-    int b = 0, g = 0, r = (1 << (yuv_shift - 1));
-    for (int i = 0; i < 256; ++i, r += R2Y, g += G2Y, b += B2Y) {
-        tab[i] = r;
-        tab[i + 256] = g;
-        tab[i + 512] = b;
-    }
-
-    const uchar* _src = src.ptr();
-    uchar* _dst = dst.ptr();
-    size_t rows = src.rows();
-    size_t cols = src.cols();
-    size_t src_step = src.step();
-    size_t dst_step = dst.step();
-    for (size_t r = 0; r < rows; ++r, _src += src_step, _dst += dst_step) {
-        const uchar* temp_src = _src;
-        uchar* temp_dst = _dst;
-        for (size_t c = 0; c < cols; ++c, temp_src += 3, temp_dst += 1) {
-            uchar x0 = temp_src[0];
-            uchar x1 = temp_src[1];
-            uchar x2 = temp_src[2];
-            temp_dst[0] = (tab[x2] + tab[x1 + 256] + tab[x0 + 512]) >> yuv_shift;
-        }
-    }
+    return cvt_color2gray_8u_SSE_4_2<3, true>(src, dst);
 }
 
 template <>
@@ -1740,180 +1774,227 @@ void cvt_bgr2rgb<uchar>(const Mat8u& src, Mat8u& dst) {
 
 template <>
 void cvt_yuv2gray_nv21<uchar>(const Mat8u& src, Mat8u& dst) {
-    const uchar* _src = src.ptr();
-    uchar* _dst = dst.ptr();
-    size_t rows = dst.rows();
-    size_t cols = dst.cols();
-    size_t src_step = src.step();
-    size_t dst_step = dst.step();
-    for (size_t r = 0; r < rows; ++r, _src += src_step, _dst += dst_step) {
-        const uchar* temp_src = _src;
-        uchar* temp_dst = _dst;
-        for (size_t c = 0; c < cols; ++c, temp_src += 1, temp_dst += 1) {
-            temp_dst[0] = temp_src[0];
-        }
+    //! gray is the Y plane, which is the first dst.rows() rows of src
+    for (size_t r = 0; r < dst.rows(); ++r) {
+        memcpy(dst.ptr(r), src.ptr(r), dst.cols());
     }
 }
 
-template <>
-void cvt_yuv2rgb_nv21<uchar>(const Mat8u& src, Mat8u& dst) {
-    return cvt_yuv_transform<true, false, false>(src, dst);
-}
-
-template <>
-void cvt_yuv2bgr_nv21<uchar>(const Mat8u& src, Mat8u& dst) {
-    return cvt_yuv_transform<false, false, false>(src, dst);
-}
-
-template <>
-void cvt_yuv2rgb_nv12<uchar>(const Mat8u& src, Mat8u& dst) {
-    return cvt_yuv_transform<true, false, true>(src, dst);
-}
-
-template <>
-void cvt_yuv2bgr_nv12<uchar>(const Mat8u& src, Mat8u& dst) {
-    return cvt_yuv_transform<false, false, true>(src, dst);
-}
-
-template <>
-void cvt_yuv2rgb_yv12<uchar>(const Mat8u& src, Mat8u& dst) {
-    return cvt_yuv_transform<true, true, false>(src, dst);
-}
-
-template <>
-void cvt_yuv2bgr_yv12<uchar>(const Mat8u& src, Mat8u& dst) {
-    return cvt_yuv_transform<false, true, false>(src, dst);
-}
-
-template <>
-void cvt_yuv2rgb_yu12<uchar>(const Mat8u& src, Mat8u& dst) {
-    return cvt_yuv_transform<true, true, true>(src, dst);
+template <typename T>
+void cvt_yuv420(
+        const megcv::Mat<T>& src, megcv::Mat<T>& dst, param::CvtColor::Mode mode,
+        size_t row_begin, size_t row_end) {
+    MEGDNN_MARK_USED_VAR(src);
+    MEGDNN_MARK_USED_VAR(dst);
+    MEGDNN_MARK_USED_VAR(mode);
+    MEGDNN_MARK_USED_VAR(row_begin);
+    MEGDNN_MARK_USED_VAR(row_end);
+    megdnn_throw("Unsupport dtype for yuv420");
 }
 
 template <>
-void cvt_yuv2bgr_yu12<uchar>(const Mat8u& src, Mat8u& dst) {
-    return cvt_yuv_transform<false, true, true>(src, dst);
+void cvt_yuv420<uchar>(
+        const megcv::Mat<uchar>& src, megcv::Mat<uchar>& dst,
+        param::CvtColor::Mode mode, size_t row_begin, size_t row_end) {
+    using Mode = param::CvtColor::Mode;
+    switch (mode) {
+        case Mode::YUV2RGB_NV21:
+        case Mode::YCrCb2RGB:
+            return cvt_yuv_transform<true, false, false>(src, dst, row_begin, row_end);
+        case Mode::YUV2BGR_NV21:
+        case Mode::YCrCb2BGR:
+            return cvt_yuv_transform<false, false, false>(
+                    src, dst, row_begin, row_end);
+        case Mode::YUV2RGB_NV12:
+            return cvt_yuv_transform<true, false, true>(src, dst, row_begin, row_end);
+        case Mode::YUV2BGR_NV12:
+            return cvt_yuv_transform<false, false, true>(src, dst, row_begin, row_end);
+        case Mode::YUV2RGB_YV12:
+            return cvt_yuv_transform<true, true, false>(src, dst, row_begin, row_end);
+        case Mode::YUV2BGR_YV12:
+            return cvt_yuv_transform<false, true, false>(src, dst, row_begin, row_end);
+        case Mode::YUV2RGB_YU12:
+            return cvt_yuv_transform<true, true, true>(src, dst, row_begin, row_end);
+        case Mode::YUV2BGR_YU12:
+            return cvt_yuv_transform<false, true, true>(src, dst, row_begin, row_end);
+        default:
+            megdnn_throw("unknown mode for yuv420.");
+    }
 }
 
 template <typename T>
 void cvt_bt601_yuv(
-        const megcv::Mat<T>& src, megcv::Mat<T>& dst, param::CvtColor::Mode mode) {
+        const megcv::Mat<T>& src, megcv::Mat<T>& dst, param::CvtColor::Mode mode,
+        size_t row_begin, size_t row_end) {
     MEGDNN_MARK_USED_VAR(src);
     MEGDNN_MARK_USED_VAR(dst);
     MEGDNN_MARK_USED_VAR(mode);
+    MEGDNN_MARK_USED_VAR(row_begin);
+    MEGDNN_MARK_USED_VAR(row_end);
     megdnn_throw("Unsupport dtype for real yuv");
 }
 
 template <>
 void cvt_bt601_yuv<uchar>(
         const megcv::Mat<uchar>& src, megcv::Mat<uchar>& dst,
-        param::CvtColor::Mode mode) {
+        param::CvtColor::Mode mode, size_t row_begin, size_t row_end) {
     using Mode = param::CvtColor::Mode;
     switch (mode) {
         case Mode::BT601_YUV2RGB_NV21:
-            return cvt_BT601_yuv_transform<true, false, false>(src, dst);
+            return cvt_BT601_yuv_transform<true, false, false>(
+                    src, dst, row_begin, row_end);
         case Mode::BT601_YUV2BGR_NV21:
-            return cvt_BT601_yuv_transform<false, false, false>(src, dst);
+            return cvt_BT601_yuv_transform<false, false, false>(
+                    src, dst, row_begin, row_end);
         case Mode::BT601_YUV2RGB_NV12:
-            return cvt_BT601_yuv_transform<true, false, true>(src, dst);
+            return cvt_BT601_yuv_transform<true, false, true>(
+                    src, dst, row_begin, row_end);
         case Mode::BT601_YUV2BGR_NV12:
-            return cvt_BT601_yuv_transform<false, false, true>(src, dst);
+            return cvt_BT601_yuv_transform<false, false, true>(
+                    src, dst, row_begin, row_end);
         case Mode::BT601_YUV2RGB_YV12:
-            return cvt_BT601_yuv_transform<true, true, false>(src, dst);
+            return cvt_BT601_yuv_transform<true, true, false>(
+                    src, dst, row_begin, row_end);
         case Mode::BT601_YUV2BGR_YV12:
-            return cvt_BT601_yuv_transform<false, true, false>(src, dst);
+            return cvt_BT601_yuv_transform<false, true, false>(
+                    src, dst, row_begin, row_end);
         case Mode::BT601_YUV2RGB_YU12:
-            return cvt_BT601_yuv_transform<true, true, true>(src, dst);
+            return cvt_BT601_yuv_transform<true, true, true>(
+                    src, dst, row_begin, row_end);
         case Mode::BT601_YUV2BGR_YU12:
-            return cvt_BT601_yuv_transform<false, true, true>(src, dst);
+            return cvt_BT601_yuv_transform<false, true, true>(
+                    src, dst, row_begin, row_end);
         default:
             megdnn_throw("unknown mode for real yuv.");
     }
 }
 
+namespace {
+
+//! the conversions are memory bound; a band is kept large enough so that
+//! the task dispatch is negligible
+constexpr size_t BAND_MIN_ROWS = 16;
+constexpr size_t BAND_MAX_NR = 16;
+
+using Mode = param::CvtColor::Mode;
+
+//! whether src is a YUV420 image of 3 / 2 * dst rows
+bool is_yuv420(Mode mode) {
+    return mode >= Mode::YUV2GRAY_NV21 && mode <= Mode::BT601_YUV2BGR_YU12;
+}
+
+/*!
+ * \brief convert rows [row_begin, row_end) of dst
+ *
+ * YUV420 sources are converted in place since their chroma planes are
+ * shared by row pairs; the others are converted on sub-matrices of the
+ * band.
+ */
+template <typename T>
+void cvt_color_band(
+        const Mat<T>& src_img, Mat<T>& dst_img, Mode mode, size_t row_begin,
+        size_t row_end) {
+    using Param = param::CvtColor;
+    if (is_yuv420(mode)) {
+        megdnn_assert(row_begin % 2 == 0);
+    }
+    Mat<T> src = src_img, dst = dst_img;
+    bool sub_band = !is_yuv420(mode) || mode == Mode::YUV2GRAY_NV21 ||
+                    mode == Mode::YUV2GRAY_NV12 || mode == Mode::YUV2GRAY_YV12 ||
+                    mode == Mode::YUV2GRAY_YU12;
+    if (sub_band) {
+        src = Mat<T>(src_img, row_begin, row_end - row_begin, 0, src_img.cols());
+        dst = Mat<T>(dst_img, row_begin, row_end - row_begin, 0, dst_img.cols());
+    }
+    switch (mode) {
+        case Param::Mode::RGB2GRAY:
+            cvt_rgb2gray<T>(src, dst);
+            break;
+        case Param::Mode::RGB2YUV:
+            cvt_rgb2yuv<T>(src, dst);
+            break;
+        case Param::Mode::YUV2RGB:
+            cvt_yuv2rgb<T>(src, dst);
+            break;
+        case Param::Mode::GRAY2RGB:
+            cvt_gray2rgb<T>(src, dst);
+            break;
+        case Param::Mode::RGBA2RGB:
+            cvt_rgba2rgb<T>(src, dst);
+            break;
+        case Param::Mode::RGBA2BGR:
+            cvt_rgba2bgr<T>(src, dst);
+            break;
+        case Param::Mode::RGBA2GRAY:
+            cvt_rgba2gray<T>(src, dst);
+            break;
+        case Param::Mode::RGB2BGR:
+            cvt_rgb2bgr<T>(src, dst);
+            break;
+        case Param::Mode::BGR2GRAY:
+            cvt_bgr2gray<T>(src, dst);
+            break;
+        case Param::Mode::BGR2RGB:
+            cvt_bgr2rgb<T>(src, dst);
+            break;
+        case Param::Mode::YUV2GRAY_NV21:
+        case Param::Mode::YUV2GRAY_NV12:
+        case Param::Mode::YUV2GRAY_YV12:
+        case Param::Mode::YUV2GRAY_YU12:
+            cvt_yuv2gray_nv21<T>(src, dst);
+            break;
+        case Param::Mode::YUV2RGB_NV21:
+        case Param::Mode::YCrCb2RGB:
+        case Param::Mode::YUV2BGR_NV21:
+        case Param::Mode::YCrCb2BGR:
+        case Param::Mode::YUV2RGB_NV12:
+        case Param::Mode::YUV2BGR_NV12:
+        case Param::Mode::YUV2RGB_YV12:
+        case Param::Mode::YUV2BGR_YV12:
+        case Param::Mode::YUV2RGB_YU12:
+        case Param::Mode::YUV2BGR_YU12:
+            cvt_yuv420<T>(src, dst, mode, row_begin, row_end);
+            break;
+        case Param::Mode::BT601_YUV2BGR_NV12:
+        case Param::Mode::BT601_YUV2RGB_NV12:
+        case Param::Mode::BT601_YUV2BGR_NV21:
+        case Param::Mode::BT601_YUV2RGB_NV21:
+        case Param::Mode::BT601_YUV2RGB_YU12:
+        case Param::Mode::BT601_YUV2BGR_YU12:
+        case Param::Mode::BT601_YUV2RGB_YV12:
+        case Param::Mode::BT601_YUV2BGR_YV12:
+            cvt_bt601_yuv<T>(src, dst, mode, row_begin, row_end);
+            break;
+        default:
+            megdnn_throw("Can not find property cvt_color operator.");
+    }
+}
+
+}  // anonymous namespace
+
 template <typename T>
 void CvtColorImpl::cvt_color_exec(
         _megdnn_tensor_in src_tensor, _megdnn_tensor_out dst_tensor, Param::Mode mode) {
-    for (size_t i = 0; i < src_tensor.layout.shape[0]; ++i) {
-        Mat<T> src = TensorND2Mat<T>(src_tensor, i);
-        Mat<T> dst = TensorND2Mat<T>(dst_tensor, i);
-        switch (mode) {
-            case Param::Mode::RGB2GRAY:
-                cvt_rgb2gray<T>(src, dst);
-                break;
-            case Param::Mode::RGB2YUV:
-                cvt_rgb2yuv<T>(src, dst);
-                break;
-            case Param::Mode::YUV2RGB:
-                cvt_yuv2rgb<T>(src, dst);
-                break;
-            case Param::Mode::GRAY2RGB:
-                cvt_gray2rgb<T>(src, dst);
-                break;
-            case Param::Mode::RGBA2RGB:
-                cvt_rgba2rgb<T>(src, dst);
-                break;
-            case Param::Mode::RGBA2BGR:
-                cvt_rgba2bgr<T>(src, dst);
-                break;
-            case Param::Mode::RGBA2GRAY:
-                cvt_rgba2gray<T>(src, dst);
-                break;
-            case Param::Mode::RGB2BGR:
-                cvt_rgb2bgr<T>(src, dst);
-                break;
-            case Param::Mode::BGR2GRAY:
-                cvt_bgr2gray<T>(src, dst);
-                break;
-            case Param::Mode::BGR2RGB:
-                cvt_bgr2rgb<T>(src, dst);
-                break;
-            case Param::Mode::YUV2GRAY_NV21:
-            case Param::Mode::YUV2GRAY_NV12:
-            case Param::Mode::YUV2GRAY_YV12:
-            case Param::Mode::YUV2GRAY_YU12:
-                cvt_yuv2gray_nv21<T>(src, dst);
-                break;
-            case Param::Mode::YUV2RGB_NV21:
-            case Param::Mode::YCrCb2RGB:
-                cvt_yuv2rgb_nv21<T>(src, dst);
-                break;
-            case Param::Mode::YUV2BGR_NV21:
-            case Param::Mode::YCrCb2BGR:
-                cvt_yuv2bgr_nv21<T>(src, dst);
-                break;
-            case Param::Mode::YUV2RGB_NV12:
-                cvt_yuv2rgb_nv12<T>(src, dst);
-                break;
-            case Param::Mode::YUV2BGR_NV12:
-                cvt_yuv2bgr_nv12<T>(src, dst);
-                break;
-            case Param::Mode::YUV2RGB_YV12:
-                cvt_yuv2rgb_yv12<T>(src, dst);
-                break;
-            case Param::Mode::YUV2BGR_YV12:
-                cvt_yuv2bgr_yv12<T>(src, dst);
-                break;
-            case Param::Mode::YUV2RGB_YU12:
-                cvt_yuv2rgb_yu12<T>(src, dst);
-                break;
-            case Param::Mode::YUV2BGR_YU12:
-                cvt_yuv2bgr_yu12<T>(src, dst);
-                break;
-            case Param::Mode::BT601_YUV2BGR_NV12:
-            case Param::Mode::BT601_YUV2RGB_NV12:
-            case Param::Mode::BT601_YUV2BGR_NV21:
-            case Param::Mode::BT601_YUV2RGB_NV21:
-            case Param::Mode::BT601_YUV2RGB_YU12:
-            case Param::Mode::BT601_YUV2BGR_YU12:
-            case Param::Mode::BT601_YUV2RGB_YV12:
-            case Param::Mode::BT601_YUV2BGR_YV12:
-                cvt_bt601_yuv<T>(src, dst, mode);
-                break;
-            default:
-                megdnn_throw("Can not find property cvt_color operator.");
+    size_t rows = dst_tensor.layout.shape[1];
+    //! bands are aligned to row pairs for the YUV420 chroma planes
+    size_t nr_pair = div_ceil<size_t>(rows, 2);
+    size_t nr_band = std::max<size_t>(
+            1, std::min(BAND_MAX_NR, nr_pair * 2 / BAND_MIN_ROWS));
+    auto task = [src_tensor, dst_tensor, mode, rows, nr_pair, nr_band](
+                        size_t index, size_t) {
+        size_t n = index / nr_band, band = index % nr_band;
+        size_t row_begin = std::min(rows, nr_pair * band / nr_band * 2),
+               row_end = std::min(rows, nr_pair * (band + 1) / nr_band * 2);
+        if (row_begin >= row_end) {
+            return;
         }
-    }
+        Mat<T> src = TensorND2Mat<T>(src_tensor, n);
+        Mat<T> dst = TensorND2Mat<T>(dst_tensor, n);
+        cvt_color_band<T>(src, dst, mode, row_begin, row_end);
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+            static_cast<naive::HandleImpl*>(handle()),
+            src_tensor.layout.shape[0] * nr_band, task);
 }
 
 void CvtColorImpl::exec(
@@ -1926,12 +2007,13 @@ void CvtColorImpl::exec(
         return;
     }
     auto mode = this->param().mode;
-    MEGDNN_DISPATCH_CPU_KERN_OPR(
-            if (dst.layout.dtype == dtype::Float32()) {
-                cvt_color_exec<float>(src, dst, mode);
-            } else if (dst.layout.dtype == dtype::Uint8()) {
-                cvt_color_exec<uchar>(src, dst, mode);
-            } else { megdnn_throw("Unsupported datatype of CvtColor optr."); });
+    if (dst.layout.dtype == dtype::Float32()) {
+        cvt_color_exec<float>(src, dst, mode);
+    } else if (dst.layout.dtype == dtype::Uint8()) {
+        cvt_color_exec<uchar>(src, dst, mode);
+    } else {
+        megdnn_throw("Unsupported datatype of CvtColor optr.");
+    }
 }
 
 }  // namespace x86
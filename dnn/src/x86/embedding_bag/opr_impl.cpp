@@ -0,0 +1,225 @@
+/**
+ * \file dnn/src/x86/embedding_bag/opr_impl.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "./opr_impl.h"
+
+#include "src/common/utils.h"
+#include "src/x86/handle.h"
+#include "src/x86/utils.h"
+
+#include <immintrin.h>
+#ifdef WIN32
+#include <avxintrin.h>
+#endif
+
+#include <cstring>
+
+using namespace megdnn;
+using namespace x86;
+
+namespace {
+
+using Mode = param::EmbeddingBag::Mode;
+
+//! number of bags processed in one task
+constexpr size_t BAGS_PER_TASK = 8;
+//! number of indices to look ahead for prefetching
+constexpr int PREFETCH_DIST = 4;
+
+inline void prefetch_row(const float* row, size_t dim) {
+    for (size_t i = 0; i < dim; i += 64 / sizeof(float)) {
+        _mm_prefetch(reinterpret_cast<const char*>(row + i), _MM_HINT_T0);
+    }
+}
+
+struct KernParam {
+    const float* weight;
+    const dt_int32* indices;
+    const dt_int32* offsets;
+    const float* per_sample_weights;
+    size_t nr_rows, dim, nr_bags;
+};
+
+inline const float* get_row(const KernParam& kp, int i) {
+    auto idx = kp.indices[i];
+    megdnn_assert(
+            idx >= 0 && static_cast<size_t>(idx) < kp.nr_rows,
+            "bad value in EmbeddingBag indices: %d, num_embeddings=%zu", idx,
+            kp.nr_rows);
+    return kp.weight + idx * kp.dim;
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx")
+void forward_bag(const KernParam& kp, Mode mode, size_t bag, float* out) {
+    const size_t dim = kp.dim;
+    const int begin = kp.offsets[bag], end = kp.offsets[bag + 1];
+    if (begin == end) {
+        memset(out, 0, sizeof(float) * dim);
+        return;
+    }
+    for (int i = begin; i < std::min(begin + PREFETCH_DIST, end); ++i) {
+        prefetch_row(get_row(kp, i), dim);
+    }
+    for (int i = begin; i < end; ++i) {
+        if (i + PREFETCH_DIST < end) {
+            prefetch_row(get_row(kp, i + PREFETCH_DIST), dim);
+        }
+        const float* row = get_row(kp, i);
+        float scale = kp.per_sample_weights ? kp.per_sample_weights[i] : 1.f;
+        __m256 vscale = _mm256_set1_ps(scale);
+        size_t d = 0;
+        if (i == begin) {
+            if (mode == Mode::MAX) {
+                memcpy(out, row, sizeof(float) * dim);
+                continue;
+            }
+            for (; d + 8 <= dim; d += 8) {
+                _mm256_storeu_ps(out + d, _mm256_mul_ps(_mm256_loadu_ps(row + d), vscale));
+            }
+            for (; d < dim; ++d) {
+                out[d] = row[d] * scale;
+            }
+            continue;
+        }
+        if (mode == Mode::MAX) {
+            for (; d + 8 <= dim; d += 8) {
+                _mm256_storeu_ps(
+                        out + d, _mm256_max_ps(
+                                         _mm256_loadu_ps(out + d),
+                                         _mm256_loadu_ps(row + d)));
+            }
+            for (; d < dim; ++d) {
+                out[d] = std::max(out[d], row[d]);
+            }
+        } else {
+            for (; d + 8 <= dim; d += 8) {
+                _mm256_storeu_ps(
+                        out + d, _mm256_add_ps(
+                                         _mm256_loadu_ps(out + d),
+                                         _mm256_mul_ps(_mm256_loadu_ps(row + d), vscale)));
+            }
+            for (; d < dim; ++d) {
+                out[d] += row[d] * scale;
+            }
+        }
+    }
+    if (mode == Mode::MEAN) {
+        float scale = 1.f / (end - begin);
+        __m256 vscale = _mm256_set1_ps(scale);
+        size_t d = 0;
+        for (; d + 8 <= dim; d += 8) {
+            _mm256_storeu_ps(out + d, _mm256_mul_ps(_mm256_loadu_ps(out + d), vscale));
+        }
+        for (; d < dim; ++d) {
+            out[d] *= scale;
+        }
+    }
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx")
+void backward_bag(
+        const KernParam& kp, Mode mode, size_t bag, const float* diff, float* grad) {
+    const size_t dim = kp.dim;
+    const int begin = kp.offsets[bag], end = kp.offsets[bag + 1];
+    float mean_scale = mode == Mode::MEAN && end > begin ? 1.f / (end - begin) : 1.f;
+    for (int i = begin; i < end; ++i) {
+        float scale = kp.per_sample_weights ? kp.per_sample_weights[i] * mean_scale
+                                            : mean_scale;
+        __m256 vscale = _mm256_set1_ps(scale);
+        float* out = grad + i * dim;
+        size_t d = 0;
+        for (; d + 8 <= dim; d += 8) {
+            _mm256_storeu_ps(out + d, _mm256_mul_ps(_mm256_loadu_ps(diff + d), vscale));
+        }
+        for (; d < dim; ++d) {
+            out[d] = diff[d] * scale;
+        }
+    }
+}
+
+KernParam make_kern_param(
+        const TensorND& weight, const TensorND& indices, const TensorND& bags,
+        const TensorND& per_sample_weights, dt_int32* offsets) {
+    KernParam kp;
+    kp.weight = weight.ptr<float>();
+    kp.indices = indices.ptr<dt_int32>();
+    kp.offsets = offsets;
+    kp.per_sample_weights =
+            per_sample_weights.layout.ndim ? per_sample_weights.ptr<float>() : nullptr;
+    kp.nr_rows = weight.layout.shape[0];
+    kp.dim = weight.layout.shape[1];
+    kp.nr_bags = bags.layout.shape[0];
+    return kp;
+}
+
+}  // anonymous namespace
+
+void EmbeddingBagForwardImpl::exec(
+        _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+        _megdnn_tensor_in per_sample_weights, _megdnn_tensor_out dst,
+        _megdnn_workspace workspace) {
+    if (weight.layout.dtype != dtype::Float32() || !is_supported(SIMDType::AVX)) {
+        return naive::EmbeddingBagForwardImpl::exec(
+                weight, indices, bags, per_sample_weights, dst, workspace);
+    }
+    check_exec(
+            weight.layout, indices.layout, bags.layout, per_sample_weights.layout,
+            dst.layout, workspace.size);
+    auto offsets = workspace.ptr<dt_int32>();
+    auto kp = make_kern_param(weight, indices, bags, per_sample_weights, offsets);
+    auto nr_indices = indices.layout.shape[0];
+    auto param = this->param();
+    auto bags_ptr = bags.ptr<dt_int32>();
+    MEGDNN_DISPATCH_CPU_KERN_OPR(naive::embedding_bag::get_bag_offsets(
+            bags_ptr, kp.nr_bags, nr_indices, param.offset_mode, offsets));
+
+    auto dptr = dst.ptr<float>();
+    auto run = [kp, param, dptr](size_t index, size_t) {
+        size_t end = std::min(kp.nr_bags, (index + 1) * BAGS_PER_TASK);
+        for (size_t b = index * BAGS_PER_TASK; b < end; ++b) {
+            forward_bag(kp, param.mode, b, dptr + b * kp.dim);
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, div_ceil(kp.nr_bags, BAGS_PER_TASK));
+}
+
+void EmbeddingBagBackwardImpl::exec(
+        _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+        _megdnn_tensor_in per_sample_weights, _megdnn_tensor_in diff,
+        _megdnn_tensor_out grad, _megdnn_workspace workspace) {
+    if (weight.layout.dtype != dtype::Float32() || param().mode == Mode::MAX ||
+        !is_supported(SIMDType::AVX)) {
+        return naive::EmbeddingBagBackwardImpl::exec(
+                weight, indices, bags, per_sample_weights, diff, grad, workspace);
+    }
+    check_exec(
+            weight.layout, indices.layout, bags.layout, per_sample_weights.layout,
+            diff.layout, grad.layout, workspace.size);
+    auto offsets = workspace.ptr<dt_int32>();
+    auto kp = make_kern_param(weight, indices, bags, per_sample_weights, offsets);
+    auto nr_indices = indices.layout.shape[0];
+    auto param = this->param();
+    auto bags_ptr = bags.ptr<dt_int32>();
+    MEGDNN_DISPATCH_CPU_KERN_OPR(naive::embedding_bag::get_bag_offsets(
+            bags_ptr, kp.nr_bags, nr_indices, param.offset_mode, offsets));
+
+    auto diff_ptr = diff.ptr<float>();
+    auto grad_ptr = grad.ptr<float>();
+    auto run = [kp, param, diff_ptr, grad_ptr](size_t index, size_t) {
+        size_t end = std::min(kp.nr_bags, (index + 1) * BAGS_PER_TASK);
+        for (size_t b = index * BAGS_PER_TASK; b < end; ++b) {
+            backward_bag(kp, param.mode, b, diff_ptr + b * kp.dim, grad_ptr);
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, div_ceil(kp.nr_bags, BAGS_PER_TASK));
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,49 @@
+/**
+ * \file dnn/src/x86/embedding_bag/opr_impl.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#pragma once
+#include "megdnn/oprs.h"
+#include "src/naive/embedding_bag/opr_impl.h"
+
+namespace megdnn {
+namespace x86 {
+
+/*!
+ * \brief float32 EmbeddingBag on avx
+ *
+ * Bags are distributed to the threads; rows of each bag are accumulated
+ * directly into the output row, and the rows of the following indices are
+ * prefetched while the current one is being reduced.
+ */
+class EmbeddingBagForwardImpl : public naive::EmbeddingBagForwardImpl {
+public:
+    using naive::EmbeddingBagForwardImpl::EmbeddingBagForwardImpl;
+    void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+            _megdnn_tensor_in per_sample_weights, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) override;
+    bool is_thread_safe() const override { return true; }
+};
+
+//! float32 EmbeddingBagBackward on avx for SUM and MEAN mode
+class EmbeddingBagBackwardImpl : public naive::EmbeddingBagBackwardImpl {
+public:
+    using naive::EmbeddingBagBackwardImpl::EmbeddingBagBackwardImpl;
+    void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices, _megdnn_tensor_in bags,
+            _megdnn_tensor_in per_sample_weights, _megdnn_tensor_in diff,
+            _megdnn_tensor_out grad, _megdnn_workspace workspace) override;
+    bool is_thread_safe() const override { return true; }
+};
+
+}  // namespace x86
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
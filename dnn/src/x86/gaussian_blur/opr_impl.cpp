@@ -60,106 +60,89 @@
  */
 
 #include "./opr_impl.h"
-#include "./filter.h"
 
-#include <cstring>
 #include "src/common/cv/common.h"
-#include "src/common/cv/helper.h"
 #include "src/common/gaussian_blur_helper.h"
 #include "src/x86/handle.h"
+#include "src/x86/sep_filter_core/sep_filter_core.h"
 
 namespace megdnn {
 namespace x86 {
 
 using namespace megcv;
+using namespace sep_filter_core;
 using BorderMode = param::GaussianBlur::BorderMode;
 
-template <typename T>
-void GaussianBlurImpl::gaussian_blur_exec(
-        const TensorND& src_tensor, const TensorND& dst_tensor, const Param& param) {
-    Size ksize = Size(param.kernel_height, param.kernel_width);
-
-    Mat<T> kernel_column(1, ksize.cols(), 1);
-    Mat<T> kernel_row(1, ksize.rows(), 1);
-
-    gaussian_blur::createGaussianKernels<T>(
-            kernel_column, kernel_row, ksize, param.sigma_x, param.sigma_y);
-    size_t src_channels = src_tensor.layout.shape[3];
-
-    T border_value[4] = {0, 0, 0, 0};
-
-    using namespace gaussian_blur;
-
-    BaseRowFilter* row_filter = getLinearRowFilter<T, T>(kernel_column);
-    BaseColumnFilter* column_filter = getLinearColumnFilter<T, T>(kernel_row, (int)0);
-
-    FilterEngine<T, T> filter(
-            row_filter, column_filter, src_channels, border_value, param.border_mode);
-
-    megdnn_assert(param.border_mode != BorderMode::BORDER_ISOLATED);
-    for (size_t i = 0; i < src_tensor.layout.shape[0]; ++i) {
-        Mat<T> src = TensorND2Mat<T>(src_tensor, i);
-        Mat<T> dst = TensorND2Mat<T>(dst_tensor, i);
-
-        filter.apply(src, dst);
-    }
-}
+namespace {
 
-void GaussianBlurImpl::gaussian_blur_exec_8u(
-        const TensorND& src_tensor, const TensorND& dst_tensor, const Param& param) {
-    megdnn_assert(src_tensor.layout.dtype == dtype::Uint8());
-    Size ksize = Size(param.kernel_height, param.kernel_width);
+template <typename T>
+struct GaussianKernel {
+    using Acc = typename SepFilterTrait<T>::Acc;
+    std::vector<Acc> kx, ky;
+};
 
-    Mat<float> kernel_column(1, ksize.cols(), 1);
-    Mat<float> kernel_row(1, ksize.rows(), 1);
+template <typename T>
+std::shared_ptr<GaussianKernel<T>> make_kernel(const param::GaussianBlur& param);
 
+template <>
+std::shared_ptr<GaussianKernel<float>> make_kernel(const param::GaussianBlur& param) {
+    Mat<float> kx(1, param.kernel_width, 1), ky(1, param.kernel_height, 1);
     gaussian_blur::createGaussianKernels<float>(
-            kernel_column, kernel_row, ksize, param.sigma_x, param.sigma_y);
-    size_t src_channels = src_tensor.layout.shape[3];
-
-    const uint8_t bits = 8;
-    //! Shift, make the elements of the kernel int
-    Mat<int> kernel_column_int(1, kernel_column.cols(), 1);
-    Mat<int> kernel_row_int(1, kernel_row.cols(), 1);
-    for (size_t i = 0; i < kernel_row.cols(); i++) {
-        kernel_row_int.at(0, i, 0) =
-                static_cast<int>(kernel_row.at(0, i, 0) * (1 << bits));
-    }
-    for (size_t i = 0; i < kernel_column.cols(); i++) {
-        kernel_column_int.at(0, i, 0) =
-                static_cast<int>(kernel_column.at(0, i, 0) * (1 << bits));
-    }
-
-    uchar border_value[4] = {0, 0, 0, 0};
+            kx, ky, Size(param.kernel_height, param.kernel_width), param.sigma_x,
+            param.sigma_y);
+    auto ret = std::make_shared<GaussianKernel<float>>();
+    ret->kx.assign(kx.ptr(), kx.ptr() + kx.cols());
+    ret->ky.assign(ky.ptr(), ky.ptr() + ky.cols());
+    return ret;
+}
 
-    using namespace gaussian_blur;
-    BaseRowFilter* rowFilter = getLinearRowFilter<uchar, int>(kernel_column_int);
-    BaseColumnFilter* columnFilter =
-            getLinearColumnFilter<int, uchar>(kernel_row_int, bits * 2);
+template <>
+std::shared_ptr<GaussianKernel<uchar>> make_kernel(const param::GaussianBlur& param) {
+    //! the kernel is computed in float and then quantized, as the naive impl
+    auto kern = make_kernel<float>(param);
+    auto ret = std::make_shared<GaussianKernel<uchar>>();
+    ret->kx = quantize_kernel(kern->kx.data(), kern->kx.size());
+    ret->ky = quantize_kernel(kern->ky.data(), kern->ky.size());
+    return ret;
+}
 
-    FilterEngine<uchar, int> filter(
-            rowFilter, columnFilter, src_channels, border_value, param.border_mode);
+}  // anonymous namespace
 
+template <typename T>
+void GaussianBlurImpl::exec_internal(_megdnn_tensor_in src, _megdnn_tensor_out dst) {
+    auto param = this->param();
     megdnn_assert(param.border_mode != BorderMode::BORDER_ISOLATED);
-    for (size_t i = 0; i < src_tensor.layout.shape[0]; ++i) {
-        Mat<uchar> src = TensorND2Mat<uchar>(src_tensor, i);
-        Mat<uchar> dst = TensorND2Mat<uchar>(dst_tensor, i);
-
-        filter.apply(src, dst);
-    }
+    auto kern = make_kernel<T>(param);
+    size_t ih = src.layout.shape[1], iw = src.layout.shape[2],
+           ch = src.layout.shape[3];
+    size_t nr = nr_stripe(dst.layout.shape[1]);
+    auto task = [src, dst, kern, param, ih, iw, ch, nr](size_t index, size_t) {
+        size_t n = index / nr, stripe = index % nr;
+        size_t kw = kern->kx.size(), kh = kern->ky.size();
+        SepFilterStage<T> stage{
+                kern->kx.data(), kw, kern->ky.data(), kh, kw / 2, kh / 2,
+                dst.layout.shape[1], dst.layout.shape[2]};
+        size_t begin, end;
+        get_stripe(stage.out_h, nr, stripe, begin, end);
+        sep_filter_chain<T>(
+                src.ptr<T>() + n * src.layout.stride[0], ih, iw, ch,
+                dst.ptr<T>() + n * dst.layout.stride[0], &stage, 1, param.border_mode,
+                begin, end);
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+            static_cast<naive::HandleImpl*>(handle()), src.layout.shape[0] * nr, task);
 }
 
 void GaussianBlurImpl::exec(
         _megdnn_tensor_in src, _megdnn_tensor_in dst, _megdnn_workspace workspace) {
-    using namespace megcv;
     check_exec(src.layout, dst.layout, workspace.size);
-    Param param = this->param();
-    MEGDNN_DISPATCH_CPU_KERN_OPR(
-            if (dst.layout.dtype == dtype::Float32()) {
-                gaussian_blur_exec<float>(src, dst, param);
-            } else if (dst.layout.dtype == dtype::Uint8()) {
-                gaussian_blur_exec_8u(src, dst, param);
-            } else { megdnn_throw("Unsupported datatype of GaussianBlur optr."); });
+    if (dst.layout.dtype == dtype::Float32()) {
+        exec_internal<float>(src, dst);
+    } else if (dst.layout.dtype == dtype::Uint8()) {
+        exec_internal<uchar>(src, dst);
+    } else {
+        megdnn_throw("Unsupported datatype of GaussianBlur optr.");
+    }
 }
 
 }  // namespace x86
@@ -9,28 +9,12 @@
  * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
  */
 #pragma once
-#include <cstring>
 #include "megdnn/oprs.h"
-#include "src/common/cv/common.h"
-#include "src/common/cv/helper.h"
-#include "src/common/utils.h"
 
 namespace megdnn {
 namespace x86 {
 
 class GaussianBlurImpl : public GaussianBlur {
-private:
-    template <typename T>
-    void gaussian_blur_exec(
-            const TensorND& src_tensor, const TensorND& dst_tensor, const Param& param);
-    void gaussian_blur_exec_8u(
-            const TensorND& src_tensor, const TensorND& dst_tensor, const Param& param);
-
-    template <typename T>
-    void createGaussianKernels(
-            megcv::Mat<T>& kx, megcv::Mat<T>& ky, megcv::Size ksize, double sigma_r,
-            double sigma_c);
-
 public:
     using GaussianBlur::GaussianBlur;
     using Param = param::GaussianBlur;
@@ -41,6 +25,10 @@ public:
     void exec(_megdnn_tensor_in src, _megdnn_tensor_in dst, _megdnn_workspace workspace)
             override;
 
+private:
+    template <typename T>
+    void exec_internal(_megdnn_tensor_in src, _megdnn_tensor_out dst);
+
 };  // class GaussianBlurImpl
 
 }  // namespace x86
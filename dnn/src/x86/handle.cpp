@@ -12,6 +12,7 @@
 #include "src/common/handle_impl.h"
 #include "src/common/version_symbol.h"
 
+#include "src/x86/embedding_bag/opr_impl.h"
 #include "src/x86/handle.h"
 
 #include "src/x86/add_update/opr_impl.h"
@@ -87,6 +88,8 @@ MEGDNN_SPECIALIZE_CREATE_OPERATOR(WarpPerspective)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(AddUpdate)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(TypeCvt)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(ConvBias)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(EmbeddingBagForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(EmbeddingBagBackward)
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpragmas"
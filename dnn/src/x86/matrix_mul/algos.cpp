@@ -12,8 +12,10 @@
 
 #include "src/x86/matrix_mul/algos.h"
 #include "src/common/utils.h"
+#include "src/fallback/matrix_mul/cache_blocking.h"
 #include "src/fallback/matrix_mul/gemm_impl.h"
 #include "src/x86/matrix_mul/f32/strategy.h"
+#include "src/x86/matrix_mul/int4/unpack.h"
 #include "src/x86/matrix_mul/int8/strategy.h"
 
 #include "midout.h"
@@ -309,6 +311,18 @@ void gemm_s8s8s32_sse_4x8x2(const MatrixMulImpl::KernParam& kern_param) {
     MIDOUT_END();
 }
 
+//! the strategy of the whole matmul, blocked according to the host caches
+x86::matmul::sgemm_pack_6x16_avx2 get_6x16_strategy(
+        const MatrixMulImpl::KernSizeParam& kern_param) {
+    using Strategy = x86::matmul::sgemm_pack_6x16_avx2;
+    auto block = megdnn::matmul::get_gemm_block_size(
+            kern_param.M, kern_param.N, kern_param.K, Strategy::KERNEL_H,
+            Strategy::KERNEL_W, Strategy::UNROLL_K, sizeof(float), sizeof(float));
+    return Strategy(
+            block.m, block.n, block.k, kern_param.A_type, kern_param.B_type,
+            kern_param.C_type);
+}
+
 void gemm_f32_avx2_6x16(const MatrixMulImpl::KernParam& kern_param) {
     MEGDNN_MARK_USED_VAR(kern_param);
     MIDOUT_BEGIN(megdnn_x86_matmul_kern_avx2_6x16x2, midout_iv(0)) {
@@ -321,13 +335,10 @@ void gemm_f32_avx2_6x16(const MatrixMulImpl::KernParam& kern_param) {
         const size_t lda = kern_param.LDA;
         const size_t ldb = kern_param.LDB;
         const size_t ldc = kern_param.LDC;
-        auto a_type = kern_param.A_type;
-        auto b_type = kern_param.B_type;
-        auto c_type = kern_param.C_type;
         const auto a_ptr = kern_param.A<float>();
         const auto b_ptr = kern_param.B<float>();
         auto c_ptr = kern_param.C<float>();
-        x86::matmul::sgemm_pack_6x16_avx2 strategy(m, n, k, a_type, b_type, c_type);
+        auto strategy = get_6x16_strategy(kern_param);
 
         megdnn::matmul::GemmInterleaved<x86::matmul::sgemm_pack_6x16_avx2>(
                 m, n, k, trans_a, trans_b, strategy, cacheline)
@@ -410,6 +421,101 @@ MEGDNN_REG_GEMM_FUNC_FOR_IM2COL_IMPL_DETAIL(
         x86::matmul::gemm_avx2_s8s8s16_4x16x2, dt_int8, dt_int16, dt_int16,
         AlgoDataType::INT8X8X16, DEFAULT);
 
+/*************************AlgoInt4AVX2********************/
+namespace {
+//! int4 operands are fed to the int8 kernels with the zero point removed
+DType int4_unpacked_dtype(DType dtype) {
+    return dtype::QuantizedS8(get_scale(dtype));
+}
+
+template <typename Strategy>
+size_t int4_gemm_workspace(const MatrixMulImpl::KernSizeParam& param) {
+    constexpr int cacheline = 64;
+    Strategy strategy(
+            param.M, param.N, param.K, int4_unpacked_dtype(param.A_type),
+            int4_unpacked_dtype(param.B_type), param.C_type);
+    return megdnn::matmul::GemmInterleaved<Strategy>(
+                   param.M, param.N, param.K, param.trA, param.trB, strategy,
+                   cacheline)
+            .get_workspace_size();
+}
+
+WorkspaceBundle get_int4_bundle(const MatrixMulImpl::KernSizeParam& param) {
+    size_t gemm_size =
+            param.C_type.enumv() == DTypeEnum::QuantizedS16
+                    ? int4_gemm_workspace<x86::matmul::gemm_avx2_s8s8s16_4x16x2>(param)
+                    : int4_gemm_workspace<x86::matmul::gemm_avx2_s8s8s32_4x16x2>(
+                              param);
+    return {nullptr, {param.M * param.K, param.K * param.N, gemm_size}};
+}
+
+template <typename Strategy, typename CType>
+void int4_gemm_exec(const MatrixMulImpl::KernParam& kern_param) {
+    constexpr int cacheline = 64;
+    const size_t m = kern_param.M;
+    const size_t n = kern_param.N;
+    const size_t k = kern_param.K;
+    const bool trans_a = kern_param.trA;
+    const bool trans_b = kern_param.trB;
+    auto bundle = get_int4_bundle(kern_param);
+    bundle.set(kern_param.workspace_ptr);
+    auto a_ptr = static_cast<int8_t*>(bundle.get(0));
+    auto b_ptr = static_cast<int8_t*>(bundle.get(1));
+    //! unpacked matrices keep the storage order of the inputs
+    const size_t lda = trans_a ? m : k;
+    const size_t ldb = trans_b ? k : n;
+    x86::int4::unpack_matrix_to_int8(
+            kern_param.A_ptr.get_ptr(), 0, trans_a ? k : m, lda, kern_param.LDA,
+            a_ptr, x86::int4::UnpackParam::from_dtype(kern_param.A_type));
+    x86::int4::unpack_matrix_to_int8(
+            kern_param.B_ptr.get_ptr(), 0, trans_b ? n : k, ldb, kern_param.LDB,
+            b_ptr, x86::int4::UnpackParam::from_dtype(kern_param.B_type));
+
+    Strategy strategy(
+            m, n, k, int4_unpacked_dtype(kern_param.A_type),
+            int4_unpacked_dtype(kern_param.B_type), kern_param.C_type);
+    megdnn::matmul::GemmInterleaved<Strategy>(
+            m, n, k, trans_a, trans_b, strategy, cacheline)
+            .execute(
+                    a_ptr, lda, b_ptr, ldb, kern_param.C<CType>(), kern_param.LDC,
+                    bundle.get(2));
+}
+}  // anonymous namespace
+
+void MatrixMulImpl::AlgoInt4AVX2::gemm_int4_avx2(
+        const MatrixMulImpl::KernParam& kern_param) {
+    MIDOUT_BEGIN(megdnn_x86_matmul_kern, midout_iv("AlgoInt4AVX2::kern"_hash)) {
+        if (kern_param.C_type.enumv() == DTypeEnum::QuantizedS16) {
+            int4_gemm_exec<x86::matmul::gemm_avx2_s8s8s16_4x16x2, dt_int16>(
+                    kern_param);
+        } else {
+            int4_gemm_exec<x86::matmul::gemm_avx2_s8s8s32_4x16x2, dt_int32>(
+                    kern_param);
+        }
+    }
+    MIDOUT_END();
+}
+MatrixMulImpl::kern_t MatrixMulImpl::AlgoInt4AVX2::get_kern(
+        const KernSizeParam&) const {
+    return gemm_int4_avx2;
+}
+bool MatrixMulImpl::AlgoInt4AVX2::usable(const KernSizeParam& kern_size_param) const {
+    bool is_ab_same = kern_size_param.A_type.enumv() == kern_size_param.B_type.enumv();
+    bool is_type_ok =
+            ((kern_size_param.A_type.enumv() == DTypeEnum::QuantizedS4 &&
+              kern_size_param.C_type.enumv() == DTypeEnum::QuantizedS16) ||
+             (kern_size_param.A_type.enumv() == DTypeEnum::Quantized4Asymm &&
+              kern_size_param.C_type.enumv() == DTypeEnum::QuantizedS32));
+    bool is_mode_ok = kern_size_param.compute_mode == Param::ComputeMode::DEFAULT &&
+                      kern_size_param.format == Param::Format::DEFAULT &&
+                      is_supported(SIMDType::AVX2);
+    return is_ab_same && is_type_ok && is_mode_ok;
+}
+size_t MatrixMulImpl::AlgoInt4AVX2::get_workspace(
+        const KernSizeParam& kern_param) const {
+    return get_int4_bundle(kern_param).total_size_in_bytes();
+}
+
 /*************************AlgoInt8x8x16SSE********************/
 void MatrixMulImpl::AlgoInt8x8x16SSE::gemm_s8s8s16_sse_4x8x2(
         const MatrixMulImpl::KernParam& kern_param) {
@@ -676,10 +782,7 @@ size_t MatrixMulImpl::AlgoFloatAVX2M6N16::get_workspace(
     const size_t k = kern_param.K;
     const bool trans_a = kern_param.trA;
     const bool trans_b = kern_param.trB;
-    auto a_type = kern_param.A_type;
-    auto b_type = kern_param.B_type;
-    auto c_type = kern_param.C_type;
-    x86::matmul::sgemm_pack_6x16_avx2 strategy(m, n, k, a_type, b_type, c_type);
+    auto strategy = get_6x16_strategy(kern_param);
 
     return megdnn::matmul::GemmInterleaved<x86::matmul::sgemm_pack_6x16_avx2>(
                    m, n, k, trans_a, trans_b, strategy, cacheline)
@@ -109,6 +109,32 @@ public:
     MEGDNN_DECL_ALGO_TYPE(X86_INT8X8X16_SSE)
 };
 
+/*!
+ * \brief int4 matmul on top of the int8 AVX2 kernels
+ *
+ * A and B are unpacked into int8 with the zero point removed, so QuantizedS4
+ * runs the int8x8x16 kernel and Quantized4Asymm runs the int8x8x32 kernel.
+ */
+class MatrixMulImpl::AlgoInt4AVX2 : public AlgoBase {
+private:
+    static void gemm_int4_avx2(const MatrixMulImpl::KernParam& kern_param);
+
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "X86_INT4_AVX2"; }
+    bool usable(const KernSizeParam&) const override;
+    size_t get_workspace(const KernSizeParam&) const override;
+    kern_t get_kern(const KernSizeParam&) const override;
+    PackMode packmode() const override { return PackMode::NO_PACK; }
+    MEGDNN_OVERRIDE_MATMUL_DESC(
+            4, 16, 2, 1,
+            static_cast<AlgoDataType>(
+                    static_cast<uint32_t>(AlgoDataType::INT4X4X16) |
+                    static_cast<uint32_t>(AlgoDataType::QINT4x4x32)),
+            DEFAULT)
+    MEGDNN_DECL_ALGO_TYPE(X86_INT4_AVX2)
+};
+
 class MatrixMulImpl::AlgoInt8x8x32SSEM4N8K2 : public AlgoBase {
 public:
     AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
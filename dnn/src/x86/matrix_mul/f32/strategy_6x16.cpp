@@ -859,7 +859,7 @@ void gemm_6x16_pack_A_t(
     int k = k0;
 
     for (; k + 7 < kmax; k += 8) {
-        const float* cur_inptr = inptr + k * ldin + k0;
+        const float* cur_inptr = inptr + k * ldin + x0;
 #define cb(i) const float* inptr##i = cur_inptr + ldin * i;
         UNROLL_CODE(cb, 8)
 #undef cb
@@ -904,7 +904,7 @@ void gemm_6x16_pack_A_t(
         outptr_base2 += 8 * 2;
     }
     for (; k < kmax; k++) {
-        const float* inptr0 = inptr + k * ldin + k0;
+        const float* inptr0 = inptr + k * ldin + x0;
         __builtin_prefetch(inptr0, 0, 3);
         int x = x0;
         float* outptr = outptr_base6;
@@ -1170,7 +1170,7 @@ void gemm_6x16_pack_B_n(
     int k = k0;
 
     for (; k + 7 < kmax; k += 8) {
-        const float* cur_inptr = inptr + k * ldin + k0;
+        const float* cur_inptr = inptr + k * ldin + x0;
 #define cb(i) const float* inptr##i = cur_inptr + ldin * i;
         UNROLL_CODE(cb, 8)
 #undef cb
@@ -1217,7 +1217,7 @@ void gemm_6x16_pack_B_n(
     }
 
     for (; k < kmax; k++) {
-        const float* inptr0 = inptr + k * ldin + k0;
+        const float* inptr0 = inptr + k * ldin + x0;
         __builtin_prefetch(inptr0, 0, 3);
         int x = x0;
         float* outptr = outptr_base16;
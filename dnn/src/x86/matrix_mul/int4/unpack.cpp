@@ -0,0 +1,87 @@
+/**
+ * \file dnn/src/x86/matrix_mul/int4/unpack.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+
+#include "src/x86/matrix_mul/int4/unpack.h"
+#include <immintrin.h>
+#include "src/common/utils.h"
+
+using namespace megdnn;
+using namespace x86;
+using namespace int4;
+
+namespace {
+
+inline int8_t unpack_one(const uint8_t* src, size_t idx, const UnpackParam& param) {
+    uint8_t code = (idx & 1) ? (src[idx >> 1] >> 4) : (src[idx >> 1] & 0x0F);
+    return static_cast<int8_t>(code ^ param.xor_mask) - param.sub;
+}
+
+}  // anonymous namespace
+
+UnpackParam UnpackParam::from_dtype(DType dtype) {
+    if (dtype.enumv() == DTypeEnum::QuantizedS4) {
+        return {8, 8};
+    }
+    megdnn_assert(
+            dtype.enumv() == DTypeEnum::Quantized4Asymm,
+            "int4 unpack does not support dtype %s", dtype.name());
+    return {0, static_cast<int8_t>(
+                       dtype.param<dtype::Quantized4Asymm>().zero_point)};
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+void int4::unpack_to_int8(
+        const void* src_ptr, size_t offset, size_t n, int8_t* dst,
+        const UnpackParam& param) {
+    auto src = static_cast<const uint8_t*>(src_ptr);
+    if (n && (offset & 1)) {
+        *(dst++) = unpack_one(src, offset++, param);
+        --n;
+    }
+    const uint8_t* sptr = src + offset / 2;
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    const __m256i vxor = _mm256_set1_epi8(param.xor_mask);
+    const __m256i vsub = _mm256_set1_epi8(param.sub);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sptr));
+        __m256i lo = _mm256_and_si256(v, mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), mask);
+        //! interleave inside 128-bit lanes, then restore the lane order
+        __m256i ilo = _mm256_unpacklo_epi8(lo, hi);
+        __m256i ihi = _mm256_unpackhi_epi8(lo, hi);
+        __m256i out0 = _mm256_permute2x128_si256(ilo, ihi, 0x20);
+        __m256i out1 = _mm256_permute2x128_si256(ilo, ihi, 0x31);
+        out0 = _mm256_sub_epi8(_mm256_xor_si256(out0, vxor), vsub);
+        out1 = _mm256_sub_epi8(_mm256_xor_si256(out1, vxor), vsub);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), out1);
+        sptr += 32;
+    }
+    for (; i < n; ++i) {
+        dst[i] = unpack_one(src, offset + i, param);
+    }
+}
+
+void int4::unpack_matrix_to_int8(
+        const void* src, size_t offset, size_t rows, size_t cols, size_t ld,
+        int8_t* dst, const UnpackParam& param) {
+    if (ld == cols) {
+        unpack_to_int8(src, offset, rows * cols, dst, param);
+        return;
+    }
+    rep(r, rows) {
+        unpack_to_int8(src, offset + r * ld, cols, dst + r * cols, param);
+    }
+}
+
+// vim: syntax=cpp.doxygen
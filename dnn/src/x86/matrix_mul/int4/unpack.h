@@ -0,0 +1,56 @@
+/**
+ * \file dnn/src/x86/matrix_mul/int4/unpack.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "megdnn/dtype.h"
+
+namespace megdnn {
+namespace x86 {
+namespace int4 {
+
+/*!
+ * \brief how to turn a 4-bit code into the int8 value fed to the int8 kernels
+ *
+ * The result is (code ^ xor_mask) - sub: sign extension for QuantizedS4 and
+ * zero point removal for Quantized4Asymm, so that zero padding of the
+ * unpacked buffers is the real zero of both dtypes.
+ */
+struct UnpackParam {
+    uint8_t xor_mask;
+    int8_t sub;
+
+    static UnpackParam from_dtype(DType dtype);
+};
+
+/*!
+ * \brief unpack n 4-bit values starting at element offset of src into dst
+ *
+ * Element i of a packed tensor is the low nibble of byte i / 2 if i is even,
+ * and the high nibble otherwise. Requires AVX2.
+ */
+void unpack_to_int8(
+        const void* src, size_t offset, size_t n, int8_t* dst,
+        const UnpackParam& param);
+
+//! unpack a rows x cols block with row stride ld (in elements) into a dense
+//! row-major int8 matrix
+void unpack_matrix_to_int8(
+        const void* src, size_t offset, size_t rows, size_t cols, size_t ld,
+        int8_t* dst, const UnpackParam& param);
+
+}  // namespace int4
+}  // namespace x86
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
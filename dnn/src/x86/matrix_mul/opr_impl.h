@@ -65,6 +65,7 @@ private:
     class AlgoInt8x8x32SSEM4N8K2;
     class AlgoInt8x8x16AVX2;
     class AlgoInt8x8x16SSE;
+    class AlgoInt4AVX2;
     class AlgoPack;
     class AlgoF32MK8_8x8;
     class AlgoFloatAVX2M6N16;
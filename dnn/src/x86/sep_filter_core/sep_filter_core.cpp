@@ -0,0 +1,484 @@
+/**
+ * \file dnn/src/x86/sep_filter_core/sep_filter_core.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#include "src/x86/sep_filter_core/sep_filter_core.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "src/common/cv/helper.h"
+#include "src/common/utils.h"
+#include "src/x86/utils.h"
+
+#include <immintrin.h>
+#ifdef WIN32
+#include <avx2intrin.h>
+#include <avxintrin.h>
+#endif
+
+using namespace megdnn;
+using namespace x86;
+using namespace sep_filter_core;
+
+namespace {
+
+constexpr int FIXED_POINT_SHIFT = FIXED_POINT_BITS * 2;
+constexpr int FIXED_POINT_DELTA = 1 << (FIXED_POINT_SHIFT - 1);
+
+//! output rows per stripe is at least this, so the ring buffer warm-up of
+//! each stripe stays cheap compared to the rows it produces
+constexpr size_t STRIPE_MIN_ROWS = 32;
+constexpr size_t STRIPE_MAX_NR = 16;
+
+/* ======================= scalar kernels ======================= */
+
+/*!
+ * dst[i] = sum_j k[j] * src[i + j * step]; channels are interleaved so step
+ * is the channel number and every channel is filtered independently
+ */
+template <typename T, typename Acc>
+void hfilter_naive(
+        const T* src, Acc* dst, size_t n, const Acc* k, size_t kw, size_t step) {
+    for (size_t i = 0; i < n; ++i) {
+        Acc sum = k[0] * static_cast<Acc>(src[i]);
+        for (size_t j = 1; j < kw; ++j) {
+            sum += k[j] * static_cast<Acc>(src[i + j * step]);
+        }
+        dst[i] = sum;
+    }
+}
+
+//! dst[i] = sum_j k[j] * rows[j][i]
+template <typename Acc>
+void vfilter_naive(
+        const Acc* const* rows, Acc* dst, size_t n, const Acc* k, size_t kh) {
+    for (size_t i = 0; i < n; ++i) {
+        Acc sum = k[0] * rows[0][i];
+        for (size_t j = 1; j < kh; ++j) {
+            sum += k[j] * rows[j][i];
+        }
+        dst[i] = sum;
+    }
+}
+
+void store_f32(const float* src, float* dst, size_t n, bool accumulate) {
+    if (accumulate) {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] += src[i];
+        }
+    } else {
+        memcpy(dst, src, n * sizeof(float));
+    }
+}
+
+void store_u8_naive(const int* src, uint8_t* dst, size_t n, bool) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = megcv::saturate_cast<uint8_t>(
+                (src[i] + FIXED_POINT_DELTA) >> FIXED_POINT_SHIFT);
+    }
+}
+
+/* ======================= AVX2 kernels ======================= */
+
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+void hfilter_f32_avx2(
+        const float* src, float* dst, size_t n, const float* k, size_t kw,
+        size_t step) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 k0 = _mm256_set1_ps(k[0]);
+        __m256 acc0 = _mm256_mul_ps(k0, _mm256_loadu_ps(src + i));
+        __m256 acc1 = _mm256_mul_ps(k0, _mm256_loadu_ps(src + i + 8));
+        for (size_t j = 1; j < kw; ++j) {
+            __m256 kj = _mm256_set1_ps(k[j]);
+            const float* sptr = src + i + j * step;
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(kj, _mm256_loadu_ps(sptr)));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(kj, _mm256_loadu_ps(sptr + 8)));
+        }
+        _mm256_storeu_ps(dst + i, acc0);
+        _mm256_storeu_ps(dst + i + 8, acc1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 acc = _mm256_mul_ps(_mm256_set1_ps(k[0]), _mm256_loadu_ps(src + i));
+        for (size_t j = 1; j < kw; ++j) {
+            acc = _mm256_add_ps(
+                    acc, _mm256_mul_ps(
+                                 _mm256_set1_ps(k[j]),
+                                 _mm256_loadu_ps(src + i + j * step)));
+        }
+        _mm256_storeu_ps(dst + i, acc);
+    }
+    hfilter_naive(src + i, dst + i, n - i, k, kw, step);
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+void vfilter_f32_avx2(
+        const float* const* rows, float* dst, size_t n, const float* k, size_t kh) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 k0 = _mm256_set1_ps(k[0]);
+        __m256 acc0 = _mm256_mul_ps(k0, _mm256_loadu_ps(rows[0] + i));
+        __m256 acc1 = _mm256_mul_ps(k0, _mm256_loadu_ps(rows[0] + i + 8));
+        for (size_t j = 1; j < kh; ++j) {
+            __m256 kj = _mm256_set1_ps(k[j]);
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(kj, _mm256_loadu_ps(rows[j] + i)));
+            acc1 = _mm256_add_ps(
+                    acc1, _mm256_mul_ps(kj, _mm256_loadu_ps(rows[j] + i + 8)));
+        }
+        _mm256_storeu_ps(dst + i, acc0);
+        _mm256_storeu_ps(dst + i + 8, acc1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 acc = _mm256_mul_ps(_mm256_set1_ps(k[0]), _mm256_loadu_ps(rows[0] + i));
+        for (size_t j = 1; j < kh; ++j) {
+            acc = _mm256_add_ps(
+                    acc,
+                    _mm256_mul_ps(_mm256_set1_ps(k[j]), _mm256_loadu_ps(rows[j] + i)));
+        }
+        _mm256_storeu_ps(dst + i, acc);
+    }
+    for (; i < n; ++i) {
+        float sum = k[0] * rows[0][i];
+        for (size_t j = 1; j < kh; ++j) {
+            sum += k[j] * rows[j][i];
+        }
+        dst[i] = sum;
+    }
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+void hfilter_u8_avx2(
+        const uint8_t* src, int* dst, size_t n, const int* k, size_t kw,
+        size_t step) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i acc = _mm256_mullo_epi32(
+                _mm256_set1_epi32(k[0]),
+                _mm256_cvtepu8_epi32(
+                        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i))));
+        for (size_t j = 1; j < kw; ++j) {
+            __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+                    reinterpret_cast<const __m128i*>(src + i + j * step)));
+            acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(_mm256_set1_epi32(k[j]), v));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), acc);
+    }
+    hfilter_naive(src + i, dst + i, n - i, k, kw, step);
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+void vfilter_s32_avx2(
+        const int* const* rows, int* dst, size_t n, const int* k, size_t kh) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i acc = _mm256_mullo_epi32(
+                _mm256_set1_epi32(k[0]),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[0] + i)));
+        for (size_t j = 1; j < kh; ++j) {
+            __m256i v =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[j] + i));
+            acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(_mm256_set1_epi32(k[j]), v));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), acc);
+    }
+    for (; i < n; ++i) {
+        int sum = k[0] * rows[0][i];
+        for (size_t j = 1; j < kh; ++j) {
+            sum += k[j] * rows[j][i];
+        }
+        dst[i] = sum;
+    }
+}
+
+MEGDNN_ATTRIBUTE_TARGET("avx2")
+void store_u8_avx2(const int* src, uint8_t* dst, size_t n, bool) {
+    __m256i delta = _mm256_set1_epi32(FIXED_POINT_DELTA);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        v = _mm256_srai_epi32(_mm256_add_epi32(v, delta), FIXED_POINT_SHIFT);
+        __m128i s16 = _mm_packs_epi32(
+                _mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        _mm_storel_epi64(
+                reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(s16, s16));
+    }
+    store_u8_naive(src + i, dst + i, n - i, false);
+}
+
+/* ======================= kernel selection ======================= */
+
+template <typename T>
+struct Kernels {
+    using Acc = typename SepFilterTrait<T>::Acc;
+    void (*hfilter)(const T*, Acc*, size_t, const Acc*, size_t, size_t);
+    void (*vfilter)(const Acc* const*, Acc*, size_t, const Acc*, size_t);
+    void (*store)(const Acc*, T*, size_t, bool);
+
+    static Kernels get();
+};
+
+template <>
+Kernels<float> Kernels<float>::get() {
+    if (is_supported(SIMDType::AVX2)) {
+        return {hfilter_f32_avx2, vfilter_f32_avx2, store_f32};
+    }
+    return {hfilter_naive<float, float>, vfilter_naive<float>, store_f32};
+}
+
+template <>
+Kernels<uint8_t> Kernels<uint8_t>::get() {
+    if (is_supported(SIMDType::AVX2)) {
+        return {hfilter_u8_avx2, vfilter_s32_avx2, store_u8_avx2};
+    }
+    return {hfilter_naive<uint8_t, int>, vfilter_naive<int>, store_u8_naive};
+}
+
+/* ======================= chain runner ======================= */
+
+template <typename T>
+class ChainRunner {
+    using Acc = typename SepFilterTrait<T>::Acc;
+    static constexpr bool ACC_IS_T = std::is_same<T, Acc>::value;
+
+    struct StageState {
+        const SepFilterStage<T>* stage;
+        size_t in_h, in_w;
+        //! one input row with the border columns filled in
+        std::vector<T> padded;
+        //! source column of each padded column, -1 for a zero column
+        std::vector<int> xtab;
+        //! padded columns in [copy_begin, copy_end) are copied in bulk
+        size_t copy_begin, copy_end;
+        //! kh horizontally filtered rows and the input row each one holds
+        std::vector<Acc> ring;
+        std::vector<ptrdiff_t> tag;
+        std::vector<ptrdiff_t> needed;
+        std::vector<const Acc*> rows;
+        //! vertical result and the output row handed to the next stage
+        std::vector<Acc> vrow;
+        std::vector<T> orow;
+    };
+
+    const T* m_src;
+    size_t m_ch;
+    BorderMode m_bmode;
+    Kernels<T> m_kern;
+    std::vector<StageState> m_states;
+    std::vector<Acc> m_zero_row;
+
+    size_t row_size(size_t s) const { return m_states[s].stage->out_w * m_ch; }
+
+    int border(ptrdiff_t p, size_t len) const {
+        if (p >= 0 && static_cast<size_t>(p) < len) {
+            return p;
+        }
+        return megcv::gaussian_blur::border_interpolate(
+                static_cast<int>(p), static_cast<int>(len), m_bmode);
+    }
+
+    //! input row \p y of stage \p s; only valid until the next call
+    const T* input_row(size_t s, size_t y) {
+        if (!s) {
+            return m_src + y * m_states[0].in_w * m_ch;
+        }
+        return output_row(s - 1, y);
+    }
+
+    //! filter input row \p y of stage \p s into ring slot \p slot
+    void fill_slot(size_t s, size_t slot, size_t y) {
+        auto&& st = m_states[s];
+        auto&& sg = *st.stage;
+        const T* in = input_row(s, y);
+        T* pad = st.padded.data();
+        size_t ch = m_ch;
+        memcpy(pad + st.copy_begin * ch, in + (st.copy_begin - sg.anchor_x) * ch,
+               (st.copy_end - st.copy_begin) * ch * sizeof(T));
+        auto fill_col = [&](size_t px) {
+            int x = st.xtab[px];
+            if (x < 0) {
+                std::fill_n(pad + px * ch, ch, T(0));
+            } else {
+                memcpy(pad + px * ch, in + x * ch, ch * sizeof(T));
+            }
+        };
+        for (size_t px = 0; px < st.copy_begin; ++px) {
+            fill_col(px);
+        }
+        for (size_t px = st.copy_end; px < st.xtab.size(); ++px) {
+            fill_col(px);
+        }
+        size_t n = row_size(s);
+        m_kern.hfilter(pad, st.ring.data() + slot * n, n, sg.kx, sg.kw, ch);
+        st.tag[slot] = y;
+    }
+
+    //! vertical pass of output row \p y of stage \p s
+    void filter_row(size_t s, size_t y, Acc* out) {
+        auto&& st = m_states[s];
+        auto&& sg = *st.stage;
+        size_t kh = sg.kh, n = row_size(s);
+        for (size_t i = 0; i < kh; ++i) {
+            st.needed[i] = border(
+                    static_cast<ptrdiff_t>(y + i) - static_cast<ptrdiff_t>(sg.anchor_y),
+                    st.in_h);
+        }
+        auto is_needed = [&](ptrdiff_t row) {
+            return std::find(st.needed.begin(), st.needed.end(), row) !=
+                   st.needed.end();
+        };
+        for (size_t i = 0; i < kh; ++i) {
+            ptrdiff_t row = st.needed[i];
+            if (row < 0) {
+                st.rows[i] = m_zero_row.data();
+                continue;
+            }
+            auto iter = std::find(st.tag.begin(), st.tag.end(), row);
+            if (iter == st.tag.end()) {
+                // the slots not needed by this output row can be reused;
+                // there are always enough since at most kh rows are needed
+                iter = std::find_if(st.tag.begin(), st.tag.end(), [&](ptrdiff_t t) {
+                    return t < 0 || !is_needed(t);
+                });
+                megdnn_assert(iter != st.tag.end());
+                fill_slot(s, iter - st.tag.begin(), row);
+            }
+            st.rows[i] = st.ring.data() + (iter - st.tag.begin()) * n;
+        }
+        m_kern.vfilter(st.rows.data(), out, n, sg.ky, kh);
+    }
+
+    const T* output_row(size_t s, size_t y) {
+        auto&& st = m_states[s];
+        if (ACC_IS_T) {
+            filter_row(s, y, reinterpret_cast<Acc*>(st.orow.data()));
+        } else {
+            filter_row(s, y, st.vrow.data());
+            m_kern.store(st.vrow.data(), st.orow.data(), row_size(s), false);
+        }
+        return st.orow.data();
+    }
+
+public:
+    ChainRunner(
+            const T* src, size_t ih, size_t iw, size_t ch,
+            const SepFilterStage<T>* stages, size_t nr_stage, BorderMode bmode)
+            : m_src{src},
+              m_ch{ch},
+              m_bmode{bmode},
+              m_kern{Kernels<T>::get()},
+              m_states(nr_stage) {
+        megdnn_assert(nr_stage > 0 && ch > 0);
+        size_t max_row = 0;
+        for (size_t s = 0; s < nr_stage; ++s) {
+            auto&& sg = stages[s];
+            auto&& st = m_states[s];
+            megdnn_assert(sg.kw > 0 && sg.kh > 0 && sg.out_w > 0 && sg.out_h > 0);
+            st.stage = &sg;
+            st.in_h = s ? stages[s - 1].out_h : ih;
+            st.in_w = s ? stages[s - 1].out_w : iw;
+
+            size_t padded_w = sg.out_w + sg.kw - 1;
+            st.padded.resize(padded_w * ch);
+            st.xtab.resize(padded_w);
+            for (size_t px = 0; px < padded_w; ++px) {
+                st.xtab[px] = border(
+                        static_cast<ptrdiff_t>(px) -
+                                static_cast<ptrdiff_t>(sg.anchor_x),
+                        st.in_w);
+            }
+            st.copy_begin = std::min(sg.anchor_x, padded_w);
+            st.copy_end = std::max(
+                    st.copy_begin, std::min(sg.anchor_x + st.in_w, padded_w));
+
+            size_t n = sg.out_w * ch;
+            st.ring.resize(sg.kh * n);
+            st.tag.assign(sg.kh, -1);
+            st.needed.resize(sg.kh);
+            st.rows.resize(sg.kh);
+            st.vrow.resize(n);
+            st.orow.resize(n);
+            max_row = std::max(max_row, n);
+        }
+        m_zero_row.assign(max_row, Acc(0));
+    }
+
+    void run(T* dst, size_t row_begin, size_t row_end, bool accumulate) {
+        size_t last = m_states.size() - 1;
+        size_t n = row_size(last);
+        for (size_t y = row_begin; y < row_end; ++y) {
+            T* drow = dst + y * n;
+            if (ACC_IS_T && !accumulate) {
+                filter_row(last, y, reinterpret_cast<Acc*>(drow));
+            } else {
+                auto vrow = m_states[last].vrow.data();
+                filter_row(last, y, vrow);
+                m_kern.store(vrow, drow, n, accumulate);
+            }
+        }
+    }
+};
+
+}  // anonymous namespace
+
+namespace megdnn {
+namespace x86 {
+namespace sep_filter_core {
+
+template <typename T>
+void sep_filter_chain(
+        const T* src, size_t ih, size_t iw, size_t ch, T* dst,
+        const SepFilterStage<T>* stages, size_t nr_stage, BorderMode bmode,
+        size_t row_begin, size_t row_end, bool accumulate) {
+    megdnn_assert(
+            !accumulate || (std::is_same<T, float>::value),
+            "accumulating separable filter is only supported for float");
+    megdnn_assert(
+            bmode != BorderMode::BORDER_ISOLATED,
+            "BORDER_ISOLATED is not supported by separable filter");
+    megdnn_assert(row_end <= stages[nr_stage - 1].out_h);
+    if (row_begin >= row_end) {
+        return;
+    }
+    ChainRunner<T> runner{src, ih, iw, ch, stages, nr_stage, bmode};
+    runner.run(dst, row_begin, row_end, accumulate);
+}
+
+#define INST(T)                                                                     \
+    template void sep_filter_chain<T>(                                              \
+            const T*, size_t, size_t, size_t, T*, const SepFilterStage<T>*, size_t, \
+            BorderMode, size_t, size_t, bool);
+INST(float)
+INST(uint8_t)
+#undef INST
+
+size_t nr_stripe(size_t out_h) {
+    return std::max<size_t>(
+            1, std::min(STRIPE_MAX_NR, div_ceil(out_h, STRIPE_MIN_ROWS)));
+}
+
+void get_stripe(size_t out_h, size_t nr, size_t id, size_t& begin, size_t& end) {
+    begin = out_h * id / nr;
+    end = out_h * (id + 1) / nr;
+}
+
+std::vector<int> quantize_kernel(const float* kern, size_t size) {
+    std::vector<int> ret(size);
+    for (size_t i = 0; i < size; ++i) {
+        ret[i] = static_cast<int>(kern[i] * (1 << FIXED_POINT_BITS));
+    }
+    return ret;
+}
+
+}  // namespace sep_filter_core
+}  // namespace x86
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,103 @@
+/**
+ * \file dnn/src/x86/sep_filter_core/sep_filter_core.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "megdnn/opr_param_defs.h"
+
+namespace megdnn {
+namespace x86 {
+namespace sep_filter_core {
+
+/*!
+ * Row-streaming separable filtering shared by the x86 CV operators
+ * (GaussianBlur, SeparableFilter and SeparableConv).
+ *
+ * Each output row is computed by a horizontal pass over the needed input
+ * rows followed by a vertical pass over the horizontally filtered rows. The
+ * filtered rows of a stage live in a ring of kh row buffers, so the working
+ * set is O(kh * width) instead of a whole intermediate image. A chain of
+ * stages is evaluated row by row: the input rows of stage k are produced on
+ * demand by stage k - 1, so no intermediate image is materialized.
+ *
+ * Pixels are interleaved (HWC) and rows are contiguous. float is filtered in
+ * float; uint8 uses the fixed point arithmetic of the naive reference: the
+ * kernels are quantized by FIXED_POINT_BITS, accumulated in int32 and
+ * rounded back by 2 * FIXED_POINT_BITS.
+ */
+
+using BorderMode = param::GaussianBlur::BorderMode;
+
+constexpr int FIXED_POINT_BITS = 8;
+
+template <typename T>
+struct SepFilterTrait;
+
+template <>
+struct SepFilterTrait<float> {
+    using Acc = float;
+};
+
+template <>
+struct SepFilterTrait<uint8_t> {
+    using Acc = int;
+};
+
+/*!
+ * \brief one separable filtering pass
+ *
+ * output(y, x) = sum_{i, j} ky[i] * kx[j] * input(y - anchor_y + i,
+ * x - anchor_x + j); pixels outside the input are given by the border mode.
+ */
+template <typename T>
+struct SepFilterStage {
+    using Acc = typename SepFilterTrait<T>::Acc;
+    const Acc* kx;
+    size_t kw;
+    const Acc* ky;
+    size_t kh;
+    size_t anchor_x, anchor_y;
+    size_t out_h, out_w;
+};
+
+/*!
+ * \brief run a chain of stages on one image and write rows [row_begin,
+ * row_end) of the final output
+ *
+ * \param src input image of ih * iw * ch elements
+ * \param dst output image of the last stage; rows outside the range are not
+ *      touched
+ * \param accumulate add the result to dst instead of overwriting it; only
+ *      supported for float
+ */
+template <typename T>
+void sep_filter_chain(
+        const T* src, size_t ih, size_t iw, size_t ch, T* dst,
+        const SepFilterStage<T>* stages, size_t nr_stage, BorderMode bmode,
+        size_t row_begin, size_t row_end, bool accumulate = false);
+
+//! number of row stripes an output of \p out_h rows is split into
+size_t nr_stripe(size_t out_h);
+
+//! row range [begin, end) of stripe \p id
+void get_stripe(size_t out_h, size_t nr, size_t id, size_t& begin, size_t& end);
+
+//! quantize a float kernel for the uint8 fixed point path
+std::vector<int> quantize_kernel(const float* kern, size_t size);
+
+}  // namespace sep_filter_core
+}  // namespace x86
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
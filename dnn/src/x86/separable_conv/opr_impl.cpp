@@ -60,31 +60,62 @@
  */
 
 #include "src/x86/separable_conv/opr_impl.h"
-#include <cstring>
-#include "./sep_conv_filter.h"
+#include <algorithm>
 #include "src/common/utils.h"
 #include "src/x86/handle.h"
-#include "src/x86/utils.h"
+#include "src/x86/sep_filter_core/sep_filter_core.h"
 
 namespace megdnn {
 namespace x86 {
-using namespace sep_conv;
+using namespace sep_filter_core;
 
 void SeparableConvImpl::exec(
         _megdnn_tensor_in src, _megdnn_tensor_in filter_x, _megdnn_tensor_in filter_y,
         _megdnn_tensor_out dst, _megdnn_workspace workspace) {
     check_exec(
             src.layout, filter_x.layout, filter_y.layout, dst.layout, workspace.size);
-    int ih = src.layout.shape[2];
-    int iw = src.layout.shape[3];
-    int oh = dst.layout.shape[2];
-    int ow = dst.layout.shape[3];
+    megdnn_assert(
+            src.layout.dtype == dtype::Float32(),
+            "Unsupported datatype of SeparableConv opr.");
+    auto param = this->param();
+    megdnn_assert(
+            param.stride_h == 1 && param.stride_w == 1,
+            "x86 SeparableConv only supports stride 1");
+    size_t oc = dst.layout.shape[1], oh = dst.layout.shape[2];
+    size_t nr = nr_stripe(oh);
+    auto task = [src, filter_x, filter_y, dst, param, oc, nr](size_t index, size_t) {
+        size_t n = index / (oc * nr), ocpos = index / nr % oc, stripe = index % nr;
+        size_t ic = src.layout.shape[1], ih = src.layout.shape[2],
+               iw = src.layout.shape[3];
+        size_t kw = filter_x.layout.shape[3];
+        size_t oh = dst.layout.shape[2], ow = dst.layout.shape[3];
+        size_t begin, end;
+        get_stripe(oh, nr, stripe, begin, end);
 
-    std::shared_ptr<FilterEngine> filter_engine = std::make_shared<FilterEngine>(
-            ih, iw, oh, ow, param().ksize_h, param().ksize_w, param().anchor_h,
-            param().anchor_w, param().borderMode, param().is_symm_kernel);
-
-    MEGDNN_DISPATCH_CPU_KERN_OPR(filter_engine->exec(src, filter_x, filter_y, dst));
+        std::vector<float> kx(kw), ky(kw);
+        const float* sptr = src.ptr<float>() + n * src.layout.stride[0];
+        float* dptr = dst.ptr<float>() + n * dst.layout.stride[0] +
+                      ocpos * dst.layout.stride[1];
+        // the partial results of all input channels are accumulated into
+        // the output rows of this stripe
+        for (size_t icpos = 0; icpos < ic; ++icpos) {
+            size_t koff = (ocpos * ic + icpos) * kw;
+            std::copy_n(filter_x.ptr<float>() + koff, kw, kx.begin());
+            std::copy_n(filter_y.ptr<float>() + koff, kw, ky.begin());
+            if (param.mode == param::SeparableConv::Mode::CONVOLUTION) {
+                std::reverse(kx.begin(), kx.end());
+                std::reverse(ky.begin(), ky.end());
+            }
+            SepFilterStage<float> stage{
+                    kx.data(), kw, ky.data(), kw, param.pad_w, param.pad_h, oh, ow};
+            sep_filter_chain<float>(
+                    sptr + icpos * src.layout.stride[1], ih, iw, 1, dptr, &stage, 1,
+                    BorderMode::BORDER_CONSTANT, begin, end, icpos > 0);
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+            static_cast<naive::HandleImpl*>(handle()), src.layout.shape[0] * oc * nr,
+            task);
 }
 
 }  // namespace x86
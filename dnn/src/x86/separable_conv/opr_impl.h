@@ -9,11 +9,9 @@
  * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
  */
 #pragma once
-#include "./sep_conv_filter.h"
 #include "megdnn/oprs.h"
 namespace megdnn {
 namespace x86 {
-using namespace sep_conv;
 class SeparableConvImpl : public SeparableConvForward {
 public:
     // SeparableConvForwardImpl(Handle *handle): SeparableConvForward(handle) {}
@@ -26,7 +24,6 @@ public:
     size_t get_workspace_in_bytes(
             const TensorLayout&, const TensorLayout&, const TensorLayout&,
             const TensorLayout&) override {
-        // TODO: deduce the size of ring buffer.
         return 0;
     }
 };
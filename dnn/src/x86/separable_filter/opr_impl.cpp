@@ -9,103 +9,60 @@
  * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
  */
 #include "src/x86/separable_filter/opr_impl.h"
-#include <cstring>
-#include "src/common/cv/common.h"
-#include "src/common/cv/helper.h"
 #include "src/common/utils.h"
 #include "src/x86/handle.h"
-#include "src/x86/separable_filter/filter.h"
-#include "src/x86/utils.h"
+#include "src/x86/sep_filter_core/sep_filter_core.h"
 
 namespace megdnn {
 namespace x86 {
-using namespace megcv;
-using namespace sep_filter;
-using BorderMode = param::SeparableFilter::BorderMode;
+using namespace sep_filter_core;
 
-void SeparableFilterImpl::separable_filter_exec_8u(
-        _megdnn_tensor_in src, _megdnn_tensor_in filter_x, _megdnn_tensor_in filter_y,
-        _megdnn_tensor_out dst, const Param& param) {
-    megdnn_assert(src.layout.dtype == dtype::Uint8());
-
-    Mat<float> kernel_column(
-            1, filter_y.layout.shape[3], 1, static_cast<float*>(filter_y.raw_ptr()));
-    Mat<float> kernel_row(
-            1, filter_x.layout.shape[3], 1, static_cast<float*>(filter_x.raw_ptr()));
-
-    size_t src_channels = src.layout.shape[3];
+namespace {
 
-    constexpr uint8_t bits = 8;
-    //! Shift, make the elements of the kernel int
-    Mat<int> kernel_column_int(1, kernel_column.cols(), 1);
-    Mat<int> kernel_row_int(1, kernel_row.cols(), 1);
-    for (size_t i = 0; i < kernel_row.cols(); i++) {
-        kernel_row_int.at(0, i, 0) =
-                static_cast<int>(kernel_row.at(0, i, 0) * (1 << bits));
-    }
-    for (size_t i = 0; i < kernel_column.cols(); i++) {
-        kernel_column_int.at(0, i, 0) =
-                static_cast<int>(kernel_column.at(0, i, 0) * (1 << bits));
+template <typename T>
+struct KernelCaster {
+    using Acc = typename SepFilterTrait<T>::Acc;
+    static std::vector<Acc> get(const float* ptr, size_t size) {
+        return {ptr, ptr + size};
     }
+};
 
-    uchar border_value[4] = {0, 0, 0, 0};
-
-    using namespace gaussian_blur;
-    BaseRowFilter* rowFilter = nullptr;
-    BaseColumnFilter* columnFilter = nullptr;
-    if (param.is_symm_kernel) {
-        rowFilter = getLinearRowFilter<uchar, int, true>(kernel_row_int);
-        columnFilter =
-                getLinearColumnFilter<int, uchar, true>(kernel_column_int, bits * 2);
-    } else {
-        rowFilter = getLinearRowFilter<uchar, int, false>(kernel_row_int);
-        columnFilter =
-                getLinearColumnFilter<int, uchar, false>(kernel_column_int, bits * 2);
+template <>
+struct KernelCaster<uint8_t> {
+    static std::vector<int> get(const float* ptr, size_t size) {
+        return quantize_kernel(ptr, size);
     }
+};
 
-    FilterEngine<uchar, int> filter(
-            rowFilter, columnFilter, src_channels, border_value, param.borderMode);
-
-    megdnn_assert(param.borderMode != BorderMode::BORDER_ISOLATED);
-    for (size_t i = 0; i < src.layout.shape[0]; ++i) {
-        Mat<uchar> src_mat = TensorND2Mat<uchar>(src, i);
-        Mat<uchar> dst_mat = TensorND2Mat<uchar>(dst, i);
-
-        filter.apply(src_mat, dst_mat);
-    }
-}
+}  // anonymous namespace
 
 template <typename T>
-void SeparableFilterImpl::separable_filter_exec(
+void SeparableFilterImpl::exec_internal(
         _megdnn_tensor_in src, _megdnn_tensor_in filter_x, _megdnn_tensor_in filter_y,
-        _megdnn_tensor_out dst, const Param& param) {
-    Mat<T> kernel_column(
-            1, filter_y.layout.shape[3], 1, static_cast<T*>(filter_y.raw_ptr()));
-    Mat<T> kernel_row(
-            1, filter_x.layout.shape[3], 1, static_cast<T*>(filter_x.raw_ptr()));
-    size_t src_channels = src.layout.shape[3];
-
-    T border_value[4] = {0, 0, 0, 0};
-
-    BaseRowFilter* row_filter = nullptr;
-    BaseColumnFilter* column_filter = nullptr;
-    if (param.is_symm_kernel) {
-        row_filter = getLinearRowFilter<T, T, true>(kernel_row);
-        column_filter = getLinearColumnFilter<T, T, true>(kernel_column, (int)0);
-    } else {
-        row_filter = getLinearRowFilter<T, T, false>(kernel_row);
-        column_filter = getLinearColumnFilter<T, T, false>(kernel_column, (int)0);
-    }
-
-    FilterEngine<T, T> filter(
-            row_filter, column_filter, src_channels, border_value, param.borderMode);
-
+        _megdnn_tensor_out dst) {
+    auto param = this->param();
     megdnn_assert(param.borderMode != BorderMode::BORDER_ISOLATED);
-    for (size_t i = 0; i < src.layout.shape[0]; ++i) {
-        Mat<T> src_mat = TensorND2Mat<T>(src, i);
-        Mat<T> dst_mat = TensorND2Mat<T>(dst, i);
-        filter.apply(src_mat, dst_mat);
-    }
+    size_t nr = nr_stripe(dst.layout.shape[1]);
+    auto task = [src, filter_x, filter_y, dst, param, nr](size_t index, size_t) {
+        size_t n = index / nr, stripe = index % nr;
+        // the filters are read inside the kernel since they may be
+        // produced by the previous kernel in the dispatch queue
+        size_t kw = filter_x.layout.shape[3], kh = filter_y.layout.shape[3];
+        auto kx = KernelCaster<T>::get(filter_x.ptr<float>(), kw);
+        auto ky = KernelCaster<T>::get(filter_y.ptr<float>(), kh);
+        SepFilterStage<T> stage{
+                kx.data(), kw, ky.data(), kh, kw / 2, kh / 2, dst.layout.shape[1],
+                dst.layout.shape[2]};
+        size_t begin, end;
+        get_stripe(stage.out_h, nr, stripe, begin, end);
+        sep_filter_chain<T>(
+                src.ptr<T>() + n * src.layout.stride[0], src.layout.shape[1],
+                src.layout.shape[2], src.layout.shape[3],
+                dst.ptr<T>() + n * dst.layout.stride[0], &stage, 1, param.borderMode,
+                begin, end);
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+            static_cast<naive::HandleImpl*>(handle()), src.layout.shape[0] * nr, task);
 }
 
 void SeparableFilterImpl::exec(
@@ -113,13 +70,10 @@ void SeparableFilterImpl::exec(
         _megdnn_tensor_out dst, _megdnn_workspace workspace) {
     check_exec(
             src.layout, filter_x.layout, filter_y.layout, dst.layout, workspace.size);
-    auto param = this->param();
     if (dst.layout.dtype == dtype::Float32()) {
-        MEGDNN_DISPATCH_CPU_KERN_OPR(
-                separable_filter_exec<float>(src, filter_x, filter_y, dst, param));
+        exec_internal<float>(src, filter_x, filter_y, dst);
     } else if (dst.layout.dtype == dtype::Uint8()) {
-        MEGDNN_DISPATCH_CPU_KERN_OPR(
-                separable_filter_exec_8u(src, filter_x, filter_y, dst, param));
+        exec_internal<uint8_t>(src, filter_x, filter_y, dst);
     } else {
         megdnn_throw("Unsupported datatype of SeparableFilter opr.");
     };
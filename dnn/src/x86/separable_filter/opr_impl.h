@@ -29,12 +29,9 @@ public:
 
 private:
     template <typename T>
-    void separable_filter_exec(
+    void exec_internal(
             _megdnn_tensor_in src, _megdnn_tensor_in filter_x,
-            _megdnn_tensor_in filter_y, _megdnn_tensor_out dst, const Param& param);
-    void separable_filter_exec_8u(
-            _megdnn_tensor_in src, _megdnn_tensor_in filter_x,
-            _megdnn_tensor_in filter_y, _megdnn_tensor_out dst, const Param& param);
+            _megdnn_tensor_in filter_y, _megdnn_tensor_out dst);
 };
 
 }  // namespace x86
@@ -0,0 +1,80 @@
+/**
+ * \file dnn/test/common/embedding_bag.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#pragma once
+#include "megdnn/basic_types.h"
+#include "megdnn/opr_param_defs.h"
+#include "test/common/rng.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace megdnn {
+namespace test {
+namespace embedding_bag {
+
+using Param = param::EmbeddingBag;
+
+//! generate valid offsets or lengths for bags over nr_indices indices
+class BagRNG final : public RNG {
+    size_t m_nr_indices;
+    Param::OffsetMode m_mode;
+    std::mt19937 m_rng{23};
+
+public:
+    BagRNG(size_t nr_indices, Param::OffsetMode mode)
+            : m_nr_indices{nr_indices}, m_mode{mode} {}
+
+    void gen(const TensorND& tensor) override {
+        size_t nr_bags = tensor.layout.total_nr_elems();
+        std::uniform_int_distribution<int> dist(0, m_nr_indices);
+        std::vector<int> cut(nr_bags + 1);
+        for (auto&& i : cut) {
+            i = dist(m_rng);
+        }
+        cut[0] = 0;
+        cut[nr_bags] = m_nr_indices;
+        std::sort(cut.begin(), cut.end());
+        auto ptr = tensor.ptr<dt_int32>();
+        for (size_t i = 0; i < nr_bags; ++i) {
+            ptr[i] = m_mode == Param::OffsetMode::OFFSETS ? cut[i]
+                                                          : cut[i + 1] - cut[i];
+        }
+    }
+};
+
+struct TestArg {
+    Param param;
+    size_t nr_rows, dim, nr_indices, nr_bags;
+    bool with_weights;
+};
+
+inline std::vector<TestArg> get_args() {
+    std::vector<TestArg> args;
+    for (auto mode : {Param::Mode::SUM, Param::Mode::MEAN, Param::Mode::MAX})
+        for (auto offset_mode : {Param::OffsetMode::OFFSETS, Param::OffsetMode::LENGTHS})
+            for (size_t dim : {1, 7, 16, 67})
+                for (size_t nr_bags : {1, 5, 33}) {
+                    Param param{mode, offset_mode};
+                    size_t nr_indices = nr_bags * 3;
+                    args.push_back({param, 50, dim, nr_indices, nr_bags, false});
+                    if (mode != Param::Mode::MAX) {
+                        args.push_back({param, 50, dim, nr_indices, nr_bags, true});
+                    }
+                }
+    return args;
+}
+
+}  // namespace embedding_bag
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
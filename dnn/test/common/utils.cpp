@@ -11,6 +11,7 @@
 #include "test/common/utils.h"
 #include "megcore.h"
 #include "megdnn/basic_types.h"
+#include "src/common/cpu_cache_info.h"
 #include "src/naive/handle.h"
 #include "test/common/memory_manager.h"
 #include "test/common/random_state.h"
@@ -151,6 +152,14 @@ NaivePitchAlignmentScope::~NaivePitchAlignmentScope() {
     megdnn_assert(r == m_new_val);
 }
 
+CpuCacheInfoScope::CpuCacheInfoScope(const CpuCacheInfo& info) {
+    set_cpu_cache_info(&info);
+}
+
+CpuCacheInfoScope::~CpuCacheInfoScope() {
+    set_cpu_cache_info(nullptr);
+}
+
 size_t test::get_cpu_count() {
     return std::max<size_t>(std::thread::hardware_concurrency(), 1_z);
 }
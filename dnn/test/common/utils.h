@@ -392,6 +392,15 @@ public:
     ~NaivePitchAlignmentScope();
 };
 
+struct CpuCacheInfo;
+
+//! override the detected cpu cache sizes in this scope
+class CpuCacheInfoScope {
+public:
+    CpuCacheInfoScope(const CpuCacheInfo& info);
+    ~CpuCacheInfoScope();
+};
+
 }  // namespace megdnn
 
 // vim: syntax=cpp.doxygen
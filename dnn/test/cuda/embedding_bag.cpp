@@ -0,0 +1,57 @@
+/**
+ * \file dnn/test/cuda/embedding_bag.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#include "test/cuda/fixture.h"
+
+#include "test/common/checker.h"
+#include "test/common/embedding_bag.h"
+
+using namespace megdnn;
+using namespace test;
+
+TEST_F(CUDA, EMBEDDING_BAG_FORWARD) {
+    Checker<EmbeddingBagForward> checker(handle_cuda());
+    for (auto&& arg : embedding_bag::get_args()) {
+        UniformIntRNG idx_rng(0, arg.nr_rows - 1);
+        embedding_bag::BagRNG bag_rng(arg.nr_indices, arg.param.offset_mode);
+        TensorShape psw = arg.with_weights ? TensorShape{arg.nr_indices}
+                                           : TensorShape{};
+        checker.set_param(arg.param)
+                .set_dtype(1, dtype::Int32())
+                .set_dtype(2, dtype::Int32())
+                .set_rng(1, &idx_rng)
+                .set_rng(2, &bag_rng)
+                .execs({{arg.nr_rows, arg.dim}, {arg.nr_indices}, {arg.nr_bags}, psw,
+                        {}});
+    }
+}
+
+TEST_F(CUDA, EMBEDDING_BAG_BACKWARD) {
+    Checker<EmbeddingBagBackward> checker(handle_cuda());
+    for (auto&& arg : embedding_bag::get_args()) {
+        UniformIntRNG idx_rng(0, arg.nr_rows - 1);
+        embedding_bag::BagRNG bag_rng(arg.nr_indices, arg.param.offset_mode);
+        TensorShape psw = arg.with_weights ? TensorShape{arg.nr_indices}
+                                           : TensorShape{};
+        checker.set_param(arg.param)
+                .set_dtype(1, dtype::Int32())
+                .set_dtype(2, dtype::Int32())
+                .set_rng(1, &idx_rng)
+                .set_rng(2, &bag_rng)
+                .execs({{arg.nr_rows, arg.dim},
+                        {arg.nr_indices},
+                        {arg.nr_bags},
+                        psw,
+                        {arg.nr_bags, arg.dim},
+                        {}});
+    }
+}
+
+// vim: syntax=cpp.doxygen
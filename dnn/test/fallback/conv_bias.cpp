@@ -12,12 +12,19 @@
 #include "test/common/conv_bias.h"
 #include "megdnn/opr_param_defs.h"
 #include "megdnn/oprs.h"
+#include "src/fallback/conv_bias/tile_dataflow.h"
+#include "src/naive/handle.h"
 #include "test/common/benchmarker.h"
 #include "test/common/checker.h"
 #include "test/common/rng.h"
 #include "test/common/task_record_check.h"
 #include "test/common/tensor.h"
+#include "test/common/utils.h"
+#include "test/common/workspace_wrapper.h"
 #include "test/fallback/fixture.h"
+
+#include <random>
+
 #if MEGDNN_X86
 #include "src/x86/utils.h"
 #endif
@@ -272,6 +279,210 @@ TEST_F(FALLBACK_MULTI_THREADS, CONV_BIAS_FORWARD_QUANTIZED) {
             dtype::QuantizedS8(60.25f), "FALLBACK_NAIVE");
 }
 
+namespace {
+//! exec alternating shapes on the same opr so the cached kern plan is both
+//! reused and replaced
+void check_conv_bias_kern_plan_reuse(Handle* handle) {
+    using namespace conv_bias;
+    using NLMode = param::ConvBias::NonlineMode;
+    std::vector<TestArg> args;
+    param::ConvBias param;
+    param.pad_h = param.pad_w = 1;
+    args.emplace_back(
+            param, TensorShape{1, 8, 7, 7}, TensorShape{16, 8, 3, 3},
+            TensorShape{1, 16, 1, 1});
+    param.nonlineMode = NLMode::RELU;
+    args.emplace_back(
+            param, TensorShape{1, 8, 7, 7}, TensorShape{16, 8, 3, 3},
+            TensorShape{1, 16, 1, 1});
+    param.pad_h = param.pad_w = 0;
+    args.emplace_back(
+            param, TensorShape{2, 16, 5, 5}, TensorShape{32, 16, 1, 1},
+            TensorShape{1, 32, 1, 1});
+    Checker<ConvBias> checker(handle);
+    NormalRNG default_rng;
+    checker.set_rng(0, &default_rng)
+            .set_rng(1, &default_rng)
+            .set_rng(2, &default_rng)
+            .set_epsilon(1e-3);
+    for (size_t i = 0; i < 3; ++i) {
+        for (auto&& arg : args) {
+            checker.set_param(arg.param)
+                    .execs({arg.src, arg.filter, arg.bias, {}, {}})
+                    .execs({arg.src, arg.filter, arg.bias, {}, {}});
+        }
+    }
+}
+}  // namespace
+
+TEST_F(FALLBACK, CONV_BIAS_REUSE_KERN_PLAN) {
+    check_conv_bias_kern_plan_reuse(handle());
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, CONV_BIAS_REUSE_KERN_PLAN) {
+    check_conv_bias_kern_plan_reuse(handle());
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, CONV_BIAS_FUSE_KERNS_BY_TILE) {
+    using NCBKern = fallback::ConvBiasImpl::NCBKern;
+    using NCBKernParam = fallback::ConvBiasImpl::NCBKernParam;
+    using NCBKernIndex = fallback::ConvBiasImpl::NCBKernIndex;
+    constexpr size_t GROUP = 3, OC_BLOCKS = 5, BATCH = 4, RUNS = 20;
+    //! the run in which each producer tile is done last time
+    std::vector<std::atomic<size_t>> packA(GROUP * OC_BLOCKS), packB(BATCH);
+    std::atomic<size_t> nr_producer_tiles{0}, nr_errors{0};
+    size_t run = 0;
+    NCBKern kern_packA{
+            [&](const NCBKernParam&, const NCBKernIndex& ncb_index) {
+                packA[ncb_index.ndrange_id[0] * OC_BLOCKS + ncb_index.ndrange_id[1]] =
+                        run;
+                ++nr_producer_tiles;
+            },
+            {GROUP, OC_BLOCKS}};
+    NCBKern kern_packB{
+            [&](const NCBKernParam&, const NCBKernIndex& ncb_index) {
+                packB[ncb_index.ndrange_id[0]] = run;
+                ++nr_producer_tiles;
+            },
+            {BATCH}};
+    //! a compute tile needs two packA blocks and the packB of its batch
+    NCBKern kern_compute{
+            [&](const NCBKernParam&, const NCBKernIndex& ncb_index) {
+                size_t batch_id = ncb_index.ndrange_id[0],
+                       group_id = ncb_index.ndrange_id[1],
+                       oc_block_id = ncb_index.ndrange_id[2];
+                for (size_t i = oc_block_id; i < std::min(OC_BLOCKS, oc_block_id + 2);
+                     ++i) {
+                    nr_errors += packA[group_id * OC_BLOCKS + i] != run;
+                }
+                nr_errors += packB[batch_id] != run;
+            },
+            {BATCH, GROUP, OC_BLOCKS}};
+    auto deps = [&](const CpuNDRange& ndrange_id) {
+        size_t offset = ndrange_id[1] * OC_BLOCKS + ndrange_id[2];
+        size_t end = ndrange_id[1] * OC_BLOCKS + std::min(OC_BLOCKS, ndrange_id[2] + 2);
+        return SmallVector<fallback::TileRange>{
+                {0, offset, end}, {1, ndrange_id[0], ndrange_id[0] + 1}};
+    };
+    auto fused =
+            fallback::fuse_kerns_by_tile({kern_packA, kern_packB}, kern_compute, deps);
+    NCBKernParam param;
+    for (run = 1; run <= RUNS; ++run) {
+        static_cast<naive::HandleImpl*>(handle())->dispatch_kern(
+                [&](size_t index, size_t thread_id) {
+                    CpuNDRange ndrange_id(fused.global_size, index);
+                    fused.kern(param, {thread_id, ndrange_id});
+                },
+                fused.global_size.total_size());
+        megcoreSynchronize(handle()->megcore_computing_handle());
+    }
+    ASSERT_EQ(0u, nr_errors.load());
+    //! each producer tile runs exactly once in each run
+    ASSERT_EQ(RUNS * (GROUP * OC_BLOCKS + BATCH), nr_producer_tiles.load());
+}
+
+#if MEGDNN_ENABLE_EXCEPTIONS
+TEST_F(FALLBACK, CONV_BIAS_FUSE_KERNS_BY_TILE_PRODUCER_THROW) {
+    using NCBKern = fallback::ConvBiasImpl::NCBKern;
+    using NCBKernParam = fallback::ConvBiasImpl::NCBKernParam;
+    using NCBKernIndex = fallback::ConvBiasImpl::NCBKernIndex;
+    size_t nr_throws = 1, nr_producer_tiles = 0, nr_consumer_tiles = 0;
+    NCBKern producer{
+            [&](const NCBKernParam&, const NCBKernIndex& ncb_index) {
+                if (ncb_index.ndrange_id[0] == 0 && nr_throws) {
+                    --nr_throws;
+                    megdnn_throw("producer failed");
+                }
+                ++nr_producer_tiles;
+            },
+            {2}};
+    NCBKern consumer{
+            [&](const NCBKernParam&, const NCBKernIndex&) { ++nr_consumer_tiles; },
+            {1}};
+    auto fused = fallback::fuse_kerns_by_tile(
+            {producer}, consumer, [](const CpuNDRange&) {
+                return SmallVector<fallback::TileRange>{{0, 0, 2}};
+            });
+    NCBKernParam param;
+    CpuNDRange ndrange_id(fused.global_size, 0);
+    ASSERT_THROW(fused.kern(param, {0, ndrange_id}), MegDNNError);
+    ASSERT_EQ(0u, nr_consumer_tiles);
+    //! the failed tile is released and run again by the next exec
+    fused.kern(param, {0, ndrange_id});
+    ASSERT_EQ(2u, nr_producer_tiles);
+    ASSERT_EQ(1u, nr_consumer_tiles);
+}
+#endif
+
+#if MEGDNN_ENABLE_MULTI_THREADS
+TEST_F(FALLBACK, CONV_BIAS_DETERMINISTIC) {
+    //! small outputs with many channels make im2col, winograd and conv1x1
+    //! split the output channels by the number of threads
+    std::vector<TensorShapeArray> shapes = {
+            {{1, 8, 6, 6}, {256, 8, 3, 3}, {1, 256, 1, 1}},
+            {{2, 16, 7, 7}, {96, 16, 1, 1}, {1, 96, 1, 1}}};
+    TaskExecutorConfig single_thread_config{1, {}}, multi_thread_config{3, {}};
+    auto single_thread_handle = create_cpu_handle(0, true, &single_thread_config);
+    auto multi_thread_handle = create_cpu_handle(0, true, &multi_thread_config);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for (auto&& shape : shapes) {
+        param::ConvBias param;
+        param.pad_h = param.pad_w = shape[1][2] / 2;
+        TensorLayoutArray layouts(5);
+        for (size_t i = 0; i < 3; ++i) {
+            layouts[i] = {shape[i], dtype::Float32()};
+        }
+        layouts[3] = TensorLayout{dtype::Float32()};
+        auto opr = single_thread_handle->create_operator<ConvBias>();
+        opr->param() = param;
+        opr->deduce_layout(layouts[0], layouts[1], layouts[2], layouts[3], layouts[4]);
+        std::vector<std::vector<dt_float32>> inputs(3);
+        for (size_t i = 0; i < 3; ++i) {
+            inputs[i].resize(layouts[i].total_nr_elems());
+            for (auto&& v : inputs[i]) {
+                v = dist(rng);
+            }
+        }
+        auto exec = [&](Handle* handle, const ConvBias::AlgorithmInfo& algo) {
+            auto opr = handle->create_operator<ConvBias>();
+            opr->param() = param;
+            opr->execution_policy().algo = algo.desc;
+            opr->execution_policy().deterministic = true;
+            Tensor<dt_float32> src(handle, layouts[0]), filter(handle, layouts[1]),
+                    bias(handle, layouts[2]), dst(handle, layouts[4]);
+            memcpy(src.ptr(), inputs[0].data(), inputs[0].size() * sizeof(dt_float32));
+            memcpy(filter.ptr(), inputs[1].data(),
+                   inputs[1].size() * sizeof(dt_float32));
+            memcpy(bias.ptr(), inputs[2].data(), inputs[2].size() * sizeof(dt_float32));
+            WorkspaceWrapper workspace(
+                    handle, opr->get_workspace_in_bytes(
+                                    layouts[0], layouts[1], layouts[2], layouts[3],
+                                    layouts[4], nullptr));
+            opr->exec(
+                    src.tensornd(), filter.tensornd(), bias.tensornd(),
+                    {nullptr, layouts[3]}, dst.tensornd(), nullptr,
+                    workspace.workspace());
+            megcoreSynchronize(handle->megcore_computing_handle());
+            return std::vector<dt_float32>(
+                    dst.ptr(), dst.ptr() + layouts[4].total_nr_elems());
+        };
+        for (auto&& algo : opr->get_all_algorithms_info_safe(
+                     layouts[0], layouts[1], layouts[2], layouts[3], layouts[4])) {
+            if (!(algo.attribute & AlgoAttribute::REPRODUCIBLE)) {
+                continue;
+            }
+            auto expected = exec(single_thread_handle.get(), algo);
+            auto got = exec(multi_thread_handle.get(), algo);
+            ASSERT_EQ(0, memcmp(expected.data(), got.data(),
+                                expected.size() * sizeof(dt_float32)))
+                    << "algo " << algo.desc.name << " is not deterministic on "
+                    << layouts[0].to_string() << " " << layouts[1].to_string();
+        }
+    }
+}
+#endif
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(FALLBACK, BENCHMARK_CONVBIAS) {
     constexpr size_t RUNS = 10;
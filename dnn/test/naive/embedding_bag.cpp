@@ -0,0 +1,106 @@
+/**
+ * \file dnn/test/naive/embedding_bag.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+#include "test/naive/fixture.h"
+
+namespace megdnn {
+namespace test {
+
+namespace {
+TensorValue make_weight() {
+    // 4 rows of dim 2
+    return TensorValue({4, 2}, dtype::Float32(), {0, 1, 2, 3, 4, 5, 6, 7});
+}
+}  // anonymous namespace
+
+TEST_F(NAIVE, EMBEDDING_BAG_FORWARD) {
+    Checker<EmbeddingBagForward> checker(handle(), false);
+    using Param = EmbeddingBagForward::Param;
+    auto indices = TensorValue({5}, dtype::Int32(), {3, 0, 1, 1, 2});
+    // bags: {3, 0}, {}, {1, 1, 2}
+    auto offsets = TensorValue({3}, dtype::Int32(), {0, 2, 2});
+    auto lengths = TensorValue({3}, dtype::Int32(), {2, 0, 3});
+
+    checker.set_param({Param::Mode::SUM, Param::OffsetMode::OFFSETS})
+            .exect(Testcase{make_weight(), indices, offsets, {}, {}},
+                   Testcase{
+                           {},
+                           {},
+                           {},
+                           {},
+                           TensorValue({3, 2}, dtype::Float32(), {6, 8, 0, 0, 8, 11})});
+    checker.set_param({Param::Mode::MEAN, Param::OffsetMode::LENGTHS})
+            .exect(Testcase{make_weight(), indices, lengths, {}, {}},
+                   Testcase{
+                           {},
+                           {},
+                           {},
+                           {},
+                           TensorValue(
+                                   {3, 2}, dtype::Float32(),
+                                   {3, 4, 0, 0, 8.f / 3, 11.f / 3})});
+    checker.set_param({Param::Mode::MAX, Param::OffsetMode::OFFSETS})
+            .exect(Testcase{make_weight(), indices, offsets, {}, {}},
+                   Testcase{
+                           {},
+                           {},
+                           {},
+                           {},
+                           TensorValue({3, 2}, dtype::Float32(), {6, 7, 0, 0, 4, 5})});
+    checker.set_param({Param::Mode::SUM, Param::OffsetMode::OFFSETS})
+            .exect(Testcase{make_weight(), indices, offsets,
+                            TensorValue({5}, dtype::Float32(), {1, 2, 1, -1, 0.5}),
+                            {}},
+                   Testcase{
+                           {},
+                           {},
+                           {},
+                           {},
+                           TensorValue({3, 2}, dtype::Float32(), {6, 9, 0, 0, 2, 2.5})});
+}
+
+TEST_F(NAIVE, EMBEDDING_BAG_BACKWARD) {
+    Checker<EmbeddingBagBackward> checker(handle(), false);
+    using Param = EmbeddingBagBackward::Param;
+    auto indices = TensorValue({5}, dtype::Int32(), {3, 0, 1, 1, 2});
+    auto offsets = TensorValue({3}, dtype::Int32(), {0, 2, 2});
+    auto diff = TensorValue({3, 2}, dtype::Float32(), {1, 2, 3, 4, 6, 9});
+
+    checker.set_param({Param::Mode::MEAN, Param::OffsetMode::OFFSETS})
+            .exect(Testcase{make_weight(), indices, offsets, {}, diff, {}},
+                   Testcase{
+                           {},
+                           {},
+                           {},
+                           {},
+                           {},
+                           TensorValue(
+                                   {5, 2}, dtype::Float32(),
+                                   {0.5, 1, 0.5, 1, 2, 3, 2, 3, 2, 3})});
+    // rows 1, 1, 2 are {2, 3}, {2, 3}, {4, 5}: max comes from the last index
+    checker.set_param({Param::Mode::MAX, Param::OffsetMode::OFFSETS})
+            .exect(Testcase{make_weight(), indices, offsets, {}, diff, {}},
+                   Testcase{
+                           {},
+                           {},
+                           {},
+                           {},
+                           {},
+                           TensorValue(
+                                   {5, 2}, dtype::Float32(),
+                                   {1, 2, 0, 0, 0, 0, 0, 0, 6, 9})});
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -9,6 +9,7 @@
  * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or
  * implied.
  */
+#include "src/common/cpu_cache_info.h"
 #include "src/x86/utils.h"
 #include "test/x86/fixture.h"
 
@@ -1592,6 +1593,57 @@ TEST_F(X86_MULTI_THREADS, CONV_BIAS_CONV1X1_S1_FP32_6x16) {
     check_conv_bias(args, handle(), "CONV1x1:X86_F32_6x16:48");
 }
 
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_CACHE_AWARE_TILE_FP32_6x16) {
+    using namespace conv_bias;
+    //! a tiny L2 to split the conv into several oc and ohw tiles
+    CpuCacheInfo cache_info;
+    cache_info.l1d = 4 * 1024;
+    cache_info.l2 = 32 * 1024;
+    cache_info.l3 = 64 * 1024;
+    CpuCacheInfoScope cache_info_scope{cache_info};
+
+    std::vector<TestArg> args;
+    param::ConvBias param;
+    for (size_t kernel : {3, 5})
+        for (size_t ic : {3, 16})
+            for (size_t oc : {4, 300})
+                for (size_t size : {20, 40}) {
+                    param.pad_h = param.pad_w = kernel / 2;
+                    args.emplace_back(
+                            param, TensorShape{1, ic, size, size},
+                            TensorShape{oc, ic, kernel, kernel},
+                            TensorShape{1, oc, 1, 1});
+                }
+    check_conv_bias(args, handle(), "IM2COLMATMUL:X86_F32_6x16:AUTO");
+    check_conv_bias(
+            get_conv_bias_1x1_args(false, false), handle(),
+            "CONV1x1:X86_F32_6x16:AUTO");
+}
+
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_CACHE_AWARE_TILE_REPLAN) {
+    using namespace conv_bias;
+    //! the same opr and shape under different cache sizes, the kern plan must
+    //! not keep the tiles derived from the previous sizes
+    CpuCacheInfo large_cache, small_cache;
+    large_cache.l1d = 32 * 1024;
+    large_cache.l2 = 1024 * 1024;
+    large_cache.l3 = 8 * 1024 * 1024;
+    small_cache.l1d = 4 * 1024;
+    small_cache.l2 = 32 * 1024;
+    small_cache.l3 = 64 * 1024;
+    param::ConvBias param;
+    param.pad_h = param.pad_w = 1;
+    TensorShapeArray shapes{{1, 16, 40, 40}, {300, 16, 3, 3}, {1, 300, 1, 1}, {}, {}};
+    Checker<ConvBias> checker(handle());
+    checker.set_before_exec_callback(
+            ConvBiasAlgoChecker<ConvBias>("IM2COLMATMUL:X86_F32_6x16:AUTO"));
+    checker.set_param(param);
+    for (auto&& cache_info : {large_cache, small_cache, large_cache}) {
+        CpuCacheInfoScope cache_info_scope{cache_info};
+        checker.execs(shapes);
+    }
+}
+
 TEST_F(X86_MULTI_THREADS, CONV_BIAS_IM2COLMATMUL_QINT8) {
     using namespace conv_bias;
     std::vector<TestArg> args;
@@ -1733,6 +1785,244 @@ TEST_F(X86_MULTI_THREADS, CONV_BIAS_IM2COLMATMUL_QINT8_FILTER_PREPROCESS) {
 #undef cb
 }
 
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_IM2COL_AVX2_INT4) {
+    if (!x86::is_supported(x86::SIMDType::AVX2))
+        return;
+    using namespace conv_bias;
+    std::vector<TestArg> args;
+
+    auto run = [&](size_t oc, size_t ic, size_t w, size_t h, size_t kernel, size_t p,
+                   size_t stride, size_t group, NonlineMode nonline_mode) {
+        if (w + 2 * p < kernel || h + 2 * p < kernel)
+            return;
+        param::ConvBias param;
+        param.stride_h = stride;
+        param.stride_w = stride;
+        param.pad_h = p;
+        param.pad_w = p;
+        param.nonlineMode = nonline_mode;
+        TensorShape filter{oc, ic, kernel, kernel};
+        if (group > 1) {
+            param.sparse = param::ConvBias::Sparse::GROUP;
+            filter = {group, oc / group, ic / group, kernel, kernel};
+        }
+
+        //! no bias
+        args.emplace_back(param, TensorShape{1, ic, h, w}, filter, TensorShape{});
+        //! bias channel
+        args.emplace_back(
+                param, TensorShape{2, ic, h, w}, filter, TensorShape{1, oc, 1, 1});
+    };
+
+    for (size_t kernel : {1, 2, 3, 5})
+        for (size_t ic : {2, 8, 16})
+            for (size_t oc : {2, 8})
+                for (size_t p : {0, 1})
+                    for (size_t stride : {1, 2})
+                        for (size_t size : {7, 20})
+                            for (NonlineMode nonline_mode :
+                                 {NonlineMode::IDENTITY, NonlineMode::RELU}) {
+                                run(oc, ic, size, size, kernel, p, stride, 1,
+                                    nonline_mode);
+                            }
+    run(8, 8, 12, 12, 3, 1, 1, 2, NonlineMode::IDENTITY);
+    run(16, 16, 9, 9, 3, 1, 2, 4, NonlineMode::RELU);
+
+    auto check = [&](auto&& checker, DType src_dtype, DType dst_dtype) {
+        float bias_scale = get_scale(src_dtype) * 0.5f;
+        checker.set_before_exec_callback(
+                conv_bias::ConvBiasAlgoChecker<ConvBias>(
+                        "X86_CONV_BIAS_IM2COL_AVX2_INT4"));
+        UniformIntRNG bias_rng{-50, 50};
+        checker.set_dtype(0, src_dtype)
+                .set_dtype(1, dtype::QuantizedS4(0.5f))
+                .set_dtype(2, dtype::QuantizedS32(bias_scale))
+                .set_dtype(4, dst_dtype)
+                .set_rng(2, &bias_rng)
+                .set_epsilon(
+                        dst_dtype.enumv() == DTypeEnum::QuantizedS32 ? 1e-3
+                                                                       : 1 + 1e-3);
+        for (auto&& arg : args) {
+            checker.set_param(arg.param).execs(
+                    {arg.src, arg.filter, arg.bias, {}, {}});
+        }
+    };
+
+    Checker<ConvBias> checker(handle());
+    check(checker, dtype::QuantizedS4(1.2f), dtype::QuantizedS32(0.6f));
+    check(checker, dtype::QuantizedS4(1.2f), dtype::QuantizedS8(2.5f));
+    check(checker, dtype::QuantizedS4(1.2f), dtype::QuantizedS4(8.f));
+    check(checker, dtype::Quantized4Asymm(1.2f, 3), dtype::QuantizedS32(0.6f));
+    check(checker, dtype::Quantized4Asymm(1.2f, 3), dtype::Quantized4Asymm(8.f, 5));
+
+    Checker<ConvBiasForward, OprWeightPreprocessProxy<ConvBiasForward>>
+            preprocess_checker(handle());
+    check(preprocess_checker, dtype::QuantizedS4(1.2f), dtype::QuantizedS8(2.5f));
+}
+
+#if MEGDNN_X86_WITH_VNNI
+namespace {
+void check_conv_bias_vnni_nchw88(
+        Handle* handle, const std::vector<conv_bias::TestArg>& args,
+        const char* algo_name) {
+    Checker<ConvBias> checker(handle);
+    checker.set_before_exec_callback(
+            conv_bias::ConvBiasAlgoChecker<ConvBias>(algo_name));
+    UniformIntRNG rng{-50, 50};
+    checker.set_dtype(0, dtype::QuantizedS8(2.5f))
+            .set_dtype(1, dtype::QuantizedS8(2.5f))
+            .set_dtype(2, dtype::QuantizedS32(6.25f))
+            .set_rng(0, &rng)
+            .set_rng(1, &rng)
+            .set_rng(2, &rng);
+    for (auto&& arg : args) {
+        //! qint8 dst may differ by one because of rounding
+        checker.set_dtype(4, dtype::QuantizedS8(60.25f))
+                .set_epsilon(1 + 1e-3)
+                .set_param(arg.param)
+                .execs({arg.src, arg.filter, arg.bias, {}, {}});
+        if (arg.param.nonlineMode != param::ConvBias::NonlineMode::H_SWISH) {
+            checker.set_dtype(4, dtype::QuantizedS32(6.25f))
+                    .set_epsilon(1e-3)
+                    .execs({arg.src, arg.filter, arg.bias, {}, {}});
+        }
+    }
+}
+}  // namespace
+
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_DIRECT_VNNI_INT8_NCHW88) {
+    if (!x86::is_supported(x86::SIMDType::VNNI))
+        return;
+    using namespace conv_bias;
+    std::vector<TestArg> args;
+
+    auto run = [&](size_t group, size_t oc, size_t ic, size_t size, size_t kernel,
+                   size_t p, size_t stride, NonlineMode nonline_mode) {
+        if (size + 2 * p < kernel)
+            return;
+        param::ConvBias param;
+        param.format = param::ConvBias::Format::NCHW88;
+        param.stride_h = stride;
+        param.stride_w = stride;
+        param.pad_h = p;
+        param.pad_w = p;
+        param.nonlineMode = nonline_mode;
+        size_t out = (size + 2 * p - kernel) / stride + 1;
+        TensorShape src{2, group * ic / 8, size, size, 8};
+        TensorShape filter{oc / 8, ic / 8, kernel, kernel, 8, 8};
+        if (group > 1) {
+            param.sparse = param::ConvBias::Sparse::GROUP;
+            filter = {group, oc / 8, ic / 8, kernel, kernel, 8, 8};
+        }
+        //! no bias
+        args.emplace_back(param, src, filter, TensorShape{});
+        //! bias channel
+        args.emplace_back(param, src, filter, TensorShape{1, group * oc / 8, 1, 1, 8});
+        //! bias
+        args.emplace_back(
+                param, src, filter, TensorShape{2, group * oc / 8, out, out, 8});
+    };
+
+    for (size_t kernel : {1, 2, 3, 5, 7})
+        for (size_t ic : {8, 16})
+            for (size_t oc : {8, 24})
+                for (size_t stride : {1, 2})
+                    for (size_t size : {7, 13})
+                        for (NonlineMode nonline_mode :
+                             {NonlineMode::IDENTITY, NonlineMode::RELU,
+                              NonlineMode::H_SWISH}) {
+                            run(1, oc, ic, size, kernel, kernel / 2, stride,
+                                nonline_mode);
+                        }
+    run(2, 8, 16, 11, 3, 0, 1, NonlineMode::RELU);
+    run(3, 16, 8, 10, 5, 2, 2, NonlineMode::IDENTITY);
+    check_conv_bias_vnni_nchw88(
+            handle(), args, "X86_CONV_BIAS_DIRECT_VNNI_INT8_NCHW88");
+}
+
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_DIRECT_VNNI_INT8_NCHW_NCHW88) {
+    if (!x86::is_supported(x86::SIMDType::VNNI))
+        return;
+    using namespace conv_bias;
+    std::vector<TestArg> args;
+
+    auto run = [&](size_t oc, size_t ic, size_t size, size_t kernel, size_t p,
+                   size_t stride, NonlineMode nonline_mode) {
+        if (size + 2 * p < kernel)
+            return;
+        param::ConvBias param;
+        param.format = param::ConvBias::Format::NCHW88;
+        param.stride_h = stride;
+        param.stride_w = stride;
+        param.pad_h = p;
+        param.pad_w = p;
+        param.nonlineMode = nonline_mode;
+        TensorShape src{2, ic, size, size};
+        TensorShape filter{oc / 8, kernel, kernel, ic, 8};
+        //! no bias
+        args.emplace_back(param, src, filter, TensorShape{});
+        //! bias channel
+        args.emplace_back(param, src, filter, TensorShape{1, oc / 8, 1, 1, 8});
+    };
+
+    for (size_t kernel : {1, 2, 3, 5, 7})
+        for (size_t ic : {1, 3, 7})
+            for (size_t oc : {8, 16})
+                for (size_t stride : {1, 2})
+                    for (size_t size : {7, 22})
+                        for (NonlineMode nonline_mode :
+                             {NonlineMode::IDENTITY, NonlineMode::RELU,
+                              NonlineMode::H_SWISH}) {
+                            run(oc, ic, size, kernel, kernel / 2, stride, nonline_mode);
+                        }
+    check_conv_bias_vnni_nchw88(
+            handle(), args, "X86_CONV_BIAS_DIRECT_VNNI_INT8_NCHW_NCHW88");
+}
+
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_CHANWISE_VNNI_INT8_NCHW88) {
+    if (!x86::is_supported(x86::SIMDType::VNNI))
+        return;
+    using namespace conv_bias;
+    std::vector<TestArg> args;
+
+    auto run = [&](size_t group, size_t size, size_t kernel, size_t p, size_t stride,
+                   NonlineMode nonline_mode) {
+        if (size + 2 * p < kernel)
+            return;
+        param::ConvBias param;
+        param.format = param::ConvBias::Format::NCHW88;
+        param.sparse = param::ConvBias::Sparse::GROUP;
+        param.stride_h = stride;
+        param.stride_w = stride;
+        param.pad_h = p;
+        param.pad_w = p;
+        param.nonlineMode = nonline_mode;
+        size_t out = (size + 2 * p - kernel) / stride + 1;
+        TensorShape src{2, group / 8, size, size, 8};
+        TensorShape filter{group / 8, 1, 1, kernel, kernel, 8};
+        //! no bias
+        args.emplace_back(param, src, filter, TensorShape{});
+        //! bias channel
+        args.emplace_back(param, src, filter, TensorShape{1, group / 8, 1, 1, 8});
+        //! bias
+        args.emplace_back(param, src, filter, TensorShape{2, group / 8, out, out, 8});
+    };
+
+    for (size_t kernel : {2, 3, 5, 7})
+        for (size_t group : {8, 24})
+            for (size_t p : {0, 1})
+                for (size_t stride : {1, 2})
+                    for (size_t size : {5, 13})
+                        for (NonlineMode nonline_mode :
+                             {NonlineMode::IDENTITY, NonlineMode::RELU,
+                              NonlineMode::H_SWISH}) {
+                            run(group, size, kernel, p, stride, nonline_mode);
+                        }
+    check_conv_bias_vnni_nchw88(
+            handle(), args, "X86_CONV_BIAS_CHANWISE_VNNI_INT8_NCHW88");
+}
+#endif
+
 #if MEGDNN_WITH_BENCHMARK
 #if MEGDNN_X86_WITH_MKL_DNN
 static void x86_benchmark_fp32_mkldnn(Handle* handle) {
@@ -2808,6 +3098,56 @@ TEST_F(X86_BENCHMARK_MULTI_THREADS, BENCHMARK_CONVBIAS_IM2COL_F32_single_thread)
     shapes_and_computation.clear();
 }
 
+//! small spatial layers whose per tile work is small, the packing kerns are
+//! fused into the compute kern by tile with multiple threads, so the speedup
+//! per core shows how much time is lost in waiting between the kerns
+TEST_F(X86_BENCHMARK_MULTI_THREADS, BENCHMARK_CONVBIAS_TILE_DATAFLOW_F32) {
+    constexpr size_t RUNS = 50;
+
+    std::vector<DType> data_type = {
+            dtype::Float32(), dtype::Float32(), dtype::Float32(), dtype::Float32()};
+    std::vector<std::pair<SmallVector<TensorShape>, float>> shapes_and_computation;
+    auto bench_case = [&](size_t N, size_t IC, size_t OC, size_t H, size_t W,
+                          size_t FS) {
+        SmallVector<TensorShape> shapes{
+                {N, IC, H, W}, {OC, IC, FS, FS}, {1, OC, 1, 1}, {}, {N, OC, H, W}};
+        TensorShape dst{N, OC, H, W};
+        float computations =
+                (IC * FS * FS * dst.total_nr_elems() * 2 + dst.total_nr_elems()) *
+                1e-6;
+        shapes_and_computation.push_back(std::make_pair(shapes, computations));
+    };
+    auto run = [&](const param::ConvBias& param, const std::string& algo_name) {
+        printf("Benchmark %s algo\n", algo_name.c_str());
+        benchmark_impl(
+                param, shapes_and_computation, algo_name, RUNS,
+                {8, {0, 1, 2, 3, 4, 5, 6, 7}}, {1, {0}}, data_type);
+        benchmark_impl(
+                param, shapes_and_computation, algo_name, RUNS,
+                {16, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}}, {1, {0}},
+                data_type);
+        shapes_and_computation.clear();
+    };
+
+    param::ConvBias param;
+    param.nonlineMode = param::ConvBias::NonlineMode::RELU;
+    param.pad_h = 1;
+    param.pad_w = 1;
+    for (size_t channel : {64, 128, 256, 512}) {
+        bench_case(1, channel, channel, 7, 7, 3);
+        bench_case(1, channel, channel, 14, 14, 3);
+    }
+    run(param, "IM2COLMATMUL:X86_F32_6x16:192");
+
+    param.pad_h = 0;
+    param.pad_w = 0;
+    for (size_t channel : {64, 128, 256, 512}) {
+        bench_case(1, channel, channel, 7, 7, 1);
+        bench_case(1, channel, channel * 2, 14, 14, 1);
+    }
+    run(param, "CONV1x1:X86_F32_6x16:48");
+}
+
 TEST_F(X86_BENCHMARK_MULTI_THREADS, BENCHMARK_CONVBIAS_IM2COL_F32_6x16) {
     constexpr size_t RUNS = 50;
 
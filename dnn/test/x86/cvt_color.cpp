@@ -34,6 +34,36 @@ TEST_F(X86, CVTCOLOR) {
     }
 }
 
+TEST_F(X86_MULTI_THREADS, CVTCOLOR) {
+    Checker<CvtColor> checker(handle());
+    param::CvtColor param;
+    // tall images so that they are split into several row bands
+    for (auto mode :
+         {Mode::RGB2GRAY, Mode::BGR2GRAY, Mode::RGB2YUV, Mode::RGB2BGR,
+          Mode::YUV2RGB}) {
+        param.mode = mode;
+        checker.set_param(param)
+                .set_dtype(0, dtype::Uint8())
+                .set_dtype(1, dtype::Uint8())
+                .execs({{2, 67, 45, 3}, {}});
+    }
+    param.mode = Mode::RGBA2GRAY;
+    checker.set_param(param).execs({{1, 70, 33, 4}, {}});
+    for (auto mode :
+         {Mode::YUV2GRAY_NV21, Mode::YUV2RGB_NV21, Mode::YUV2BGR_NV12,
+          Mode::YUV2RGB_YV12, Mode::YUV2BGR_YU12, Mode::BT601_YUV2RGB_NV21,
+          Mode::BT601_YUV2BGR_NV12, Mode::BT601_YUV2RGB_YV12,
+          Mode::BT601_YUV2BGR_YU12}) {
+        param.mode = mode;
+        checker.set_param(param).execs({{2, 150, 64, 1}, {}});
+    }
+    param.mode = Mode::RGB2GRAY;
+    checker.set_param(param)
+            .set_dtype(0, dtype::Float32())
+            .set_dtype(1, dtype::Float32())
+            .execs({{2, 67, 45, 3}, {}});
+}
+
 TEST_F(X86, CVTCOLOR_RECORD) {
     using namespace cvt_color;
     std::vector<TestArg> args = get_args();
@@ -0,0 +1,81 @@
+/**
+ * \file dnn/test/x86/embedding_bag.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+#include "test/x86/fixture.h"
+
+#include "test/common/benchmarker.h"
+#include "test/common/checker.h"
+#include "test/common/embedding_bag.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(X86, EMBEDDING_BAG_FORWARD) {
+    Checker<EmbeddingBagForward> checker(handle());
+    for (auto&& arg : embedding_bag::get_args()) {
+        UniformIntRNG idx_rng(0, arg.nr_rows - 1);
+        embedding_bag::BagRNG bag_rng(arg.nr_indices, arg.param.offset_mode);
+        TensorShape psw = arg.with_weights ? TensorShape{arg.nr_indices}
+                                           : TensorShape{};
+        checker.set_param(arg.param)
+                .set_dtype(1, dtype::Int32())
+                .set_dtype(2, dtype::Int32())
+                .set_rng(1, &idx_rng)
+                .set_rng(2, &bag_rng)
+                .execs({{arg.nr_rows, arg.dim}, {arg.nr_indices}, {arg.nr_bags}, psw,
+                        {}});
+    }
+}
+
+TEST_F(X86, EMBEDDING_BAG_BACKWARD) {
+    Checker<EmbeddingBagBackward> checker(handle());
+    for (auto&& arg : embedding_bag::get_args()) {
+        UniformIntRNG idx_rng(0, arg.nr_rows - 1);
+        embedding_bag::BagRNG bag_rng(arg.nr_indices, arg.param.offset_mode);
+        TensorShape psw = arg.with_weights ? TensorShape{arg.nr_indices}
+                                           : TensorShape{};
+        checker.set_param(arg.param)
+                .set_dtype(1, dtype::Int32())
+                .set_dtype(2, dtype::Int32())
+                .set_rng(1, &idx_rng)
+                .set_rng(2, &bag_rng)
+                .execs({{arg.nr_rows, arg.dim},
+                        {arg.nr_indices},
+                        {arg.nr_bags},
+                        psw,
+                        {arg.nr_bags, arg.dim},
+                        {}});
+    }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(X86, BENCHMARK_EMBEDDING_BAG) {
+    constexpr size_t RUNS = 20;
+    size_t nr_rows = 1000000, dim = 64, nr_bags = 2048, nr_indices = nr_bags * 40;
+    Benchmarker<EmbeddingBagForward> benchmarker(handle());
+    UniformIntRNG idx_rng(0, nr_rows - 1);
+    embedding_bag::BagRNG bag_rng(nr_indices, param::EmbeddingBag::OffsetMode::OFFSETS);
+    benchmarker.set_times(RUNS)
+            .set_dtype(1, dtype::Int32())
+            .set_dtype(2, dtype::Int32())
+            .set_rng(1, &idx_rng)
+            .set_rng(2, &bag_rng);
+    auto time_ms =
+            benchmarker.execs({{nr_rows, dim}, {nr_indices}, {nr_bags}, {}, {}}) / RUNS;
+    printf("embedding_bag: %zu bags of %zu rows, dim=%zu: %.3fms %.3fGB/s\n", nr_bags,
+           nr_indices / nr_bags, dim, time_ms,
+           nr_indices * dim * sizeof(float) / (time_ms * 1e6));
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -36,6 +36,37 @@ TEST_F(X86, GAUSSIAN_BLUR) {
     }
 }
 
+TEST_F(X86_MULTI_THREADS, GAUSSIAN_BLUR) {
+    using BorderMode = param::GaussianBlur::BorderMode;
+    Checker<GaussianBlur> checker(handle());
+    param::GaussianBlur param;
+    // tall images so that each of them is split into several row stripes
+    for (auto bmode :
+         {BorderMode::BORDER_REPLICATE, BorderMode::BORDER_REFLECT_101,
+          BorderMode::BORDER_WRAP, BorderMode::BORDER_CONSTANT}) {
+        for (size_t ksize : {3, 7}) {
+            param.border_mode = bmode;
+            param.kernel_height = ksize;
+            param.kernel_width = ksize + 2;
+            param.sigma_x = 1.5;
+            param.sigma_y = 0.8;
+            for (auto&& shape :
+                 {TensorShape{2, 150, 67, 3}, TensorShape{1, 97, 40, 1}}) {
+                checker.set_param(param)
+                        .set_epsilon(1e-3)
+                        .set_dtype(0, dtype::Float32())
+                        .set_dtype(1, dtype::Float32())
+                        .execs({shape, {}});
+                checker.set_param(param)
+                        .set_epsilon(1 + 1e-3)
+                        .set_dtype(0, dtype::Uint8())
+                        .set_dtype(1, dtype::Uint8())
+                        .execs({shape, {}});
+            }
+        }
+    }
+}
+
 TEST_F(X86, GAUSSIAN_BLUR_RECORD) {
     using namespace gaussian_blur;
     std::vector<TestArg> args = get_args();
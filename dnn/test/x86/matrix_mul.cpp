@@ -11,6 +11,7 @@
  */
 #include "test/x86/fixture.h"
 
+#include "src/common/cpu_cache_info.h"
 #include "src/x86/utils.h"
 #include "test/common/benchmarker.h"
 #include "test/common/checker.h"
@@ -98,6 +99,32 @@ TEST_F(X86, MATRIX_MUL_SSE_8X8X32) {
             false);
 }
 
+TEST_F(X86, MATRIX_MUL_AVX2_INT4) {
+    if (!is_supported(SIMDType::AVX2))
+        return;
+    Checker<MatrixMul> checker(handle());
+    checker.set_before_exec_callback(AlgoChecker<MatrixMul>("X86_INT4_AVX2"));
+    auto run = [&](DType A_dtype, DType C_dtype) {
+        checker.set_dtype(0, A_dtype).set_dtype(1, A_dtype).set_dtype(2, C_dtype);
+        for (bool trA : {false, true})
+            for (bool trB : {false, true}) {
+                param::MatrixMul param;
+                param.transposeA = trA;
+                param.transposeB = trB;
+                checker.set_param(param);
+                for (size_t m : {2, 8, 18})
+                    for (size_t n : {2, 16, 30, 66})
+                        for (size_t k : {2, 6, 64, 130}) {
+                            TensorShape A = trA ? TensorShape{k, m} : TensorShape{m, k};
+                            TensorShape B = trB ? TensorShape{n, k} : TensorShape{k, n};
+                            checker.exec({A, B, {}});
+                        }
+            }
+    };
+    run(dtype::QuantizedS4{0.6f}, dtype::QuantizedS16{0.6f * 0.6f});
+    run(dtype::Quantized4Asymm{0.6f, 3}, dtype::QuantizedS32{0.6f * 0.6f});
+}
+
 #if MEGDNN_X86_WITH_MKL && SUPPORT_MKL_PACKED_GEMM
 TEST_F(X86, MATRIX_MUL_MKL_PACKA) {
     matrix_mul::check_matrix_mul(
@@ -118,6 +145,25 @@ TEST_F(X86, MATRIX_MUL_AVX2_6x16) {
             "X86_F32_6x16", param::MatrixMul::Format::DEFAULT, 1, 1e-3, false);
 }
 
+TEST_F(X86, MATRIX_MUL_AVX2_6x16_CACHE_BLOCKING) {
+    //! tiny caches to split the matmul into several blocks on every dim
+    CpuCacheInfo cache_info;
+    cache_info.l1d = 4 * 1024;
+    cache_info.l2 = 16 * 1024;
+    cache_info.l3 = 32 * 1024;
+    CpuCacheInfoScope cache_info_scope{cache_info};
+    std::vector<matrix_mul::TestArg> args;
+    for (size_t m : {7, 37, 130})
+        for (size_t n : {17, 70, 300})
+            for (size_t k : {9, 70, 300})
+                for (size_t mask : {0, 1, 2, 3})
+                    args.emplace_back(m, n, k, mask);
+    matrix_mul::check_matrix_mul(
+            dtype::Float32{}, dtype::Float32{}, dtype::Float32{}, handle(),
+            "X86_F32_6x16", param::MatrixMul::Format::DEFAULT, 1, 1e-3,
+            std::move(args));
+}
+
 #if MEGDNN_WITH_BENCHMARK
 
 TEST_F(X86, BENCHMARK_MATRIX_MUL_AVX2_MK8_8X8) {
@@ -24,6 +24,19 @@ TEST_F(X86, SEPARABLE_CONV) {
         checker.set_param(arg.param).execs({arg.src, arg.filter_x, arg.filter_y, {}});
     }
 }
+TEST_F(X86_MULTI_THREADS, SEPARABLE_CONV) {
+    Checker<SeparableConvForward> checker(handle());
+    param::SeparableConv param;
+    param.is_symm_kernel = false;
+    for (size_t k : {3, 5}) {
+        param.ksize_h = param.ksize_w = k;
+        for (auto&& shape : {TensorShape{2, 3, 70, 45}, TensorShape{1, 1, 131, 17}}) {
+            TensorShape filter{4, shape[1], 1, k};
+            checker.set_param(param).execs({shape, filter, filter, {}});
+        }
+    }
+}
+
 TEST_F(X86, SEPARABLE_CONV_RECORD) {
     using namespace separable_conv;
     std::vector<TestArg> args = get_args();
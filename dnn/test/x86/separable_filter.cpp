@@ -12,6 +12,10 @@
 #include "test/common/checker.h"
 #include "test/common/task_record_check.h"
 #include "test/x86/fixture.h"
+
+#include "src/x86/sep_filter_core/sep_filter_core.h"
+
+#include <random>
 namespace megdnn {
 namespace test {
 
@@ -36,6 +40,67 @@ TEST_F(X86, SEPARABLE_FILTER) {
     }
 }
 
+TEST_F(X86_MULTI_THREADS, SEPARABLE_FILTER) {
+    using BorderMode = param::SeparableFilter::BorderMode;
+    Checker<SeparableFilter> checker(handle());
+    UniformFloatRNG rng(0.f, 0.3f);
+    checker.set_rng(1, &rng).set_rng(2, &rng);
+    param::SeparableFilter param;
+    param.is_symm_kernel = false;
+    for (auto bmode : {BorderMode::BORDER_REFLECT, BorderMode::BORDER_CONSTANT}) {
+        param.borderMode = bmode;
+        for (auto&& shape : {TensorShape{2, 130, 37, 3}, TensorShape{1, 77, 64, 1}}) {
+            TensorShape kx{1, 1, 1, 5}, ky{1, 1, 1, 3};
+            checker.set_param(param)
+                    .set_dtype(0, dtype::Float32())
+                    .set_dtype(3, dtype::Float32())
+                    .set_epsilon(1e-3)
+                    .execs({shape, kx, ky, {}});
+            checker.set_param(param)
+                    .set_dtype(0, dtype::Uint8())
+                    .set_dtype(3, dtype::Uint8())
+                    .set_epsilon(1 + 1e-3)
+                    .execs({shape, kx, ky, {}});
+        }
+    }
+}
+
+TEST_F(X86, SEPARABLE_FILTER_CHAIN) {
+    using namespace x86::sep_filter_core;
+    std::mt19937 rng(233);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    size_t ih = 45, iw = 38, ch = 3;
+    std::vector<float> src(ih * iw * ch), k3(3), k5(5);
+    for (auto v : {&src, &k3, &k5}) {
+        for (auto&& i : *v) {
+            i = dist(rng);
+        }
+    }
+    // a blur followed by a valid 5x5 filter, computed in one pass and stage
+    // by stage
+    SepFilterStage<float> stages[2] = {
+            {k3.data(), 3, k3.data(), 3, 1, 1, ih, iw},
+            {k5.data(), 5, k5.data(), 5, 0, 0, ih - 4, iw - 4}};
+    for (auto bmode : {BorderMode::BORDER_REFLECT_101, BorderMode::BORDER_CONSTANT}) {
+        std::vector<float> mid(ih * iw * ch), expect((ih - 4) * (iw - 4) * ch),
+                got(expect.size());
+        sep_filter_chain(src.data(), ih, iw, ch, mid.data(), stages, 1, bmode, 0, ih);
+        sep_filter_chain(
+                mid.data(), ih, iw, ch, expect.data(), stages + 1, 1, bmode, 0,
+                ih - 4);
+        size_t nr = nr_stripe(ih - 4);
+        for (size_t i = 0; i < nr; ++i) {
+            size_t begin, end;
+            get_stripe(ih - 4, nr, i, begin, end);
+            sep_filter_chain(
+                    src.data(), ih, iw, ch, got.data(), stages, 2, bmode, begin, end);
+        }
+        for (size_t i = 0; i < expect.size(); ++i) {
+            ASSERT_FLOAT_EQ(expect[i], got[i]) << "i=" << i;
+        }
+    }
+}
+
 TEST_F(X86, SEPARABLE_FILTER_RECORD) {
     using namespace separable_filter;
     std::vector<TestArg> args = get_args();
@@ -8,3 +8,4 @@
 # "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 from ..core.autodiff.grad import Function
 from .grad_manager import GradManager
+from .row_sparse import RowSparseGrad
@@ -14,6 +14,7 @@ from ..core.autodiff.grad import Grad
 from ..logger import get_logger
 from ..tensor import Tensor
 from ..utils.future import Future
+from .row_sparse import RowSparseGrad
 
 logger = get_logger(__name__)
 
@@ -25,7 +26,7 @@ def get_backwarding_grad_manager():
 
 
 class AttachSpec:
-    __slots__ = "tensor", "callbacks"
+    __slots__ = "tensor", "callbacks", "row_sparse"
 
 
 _global_priority = 0
@@ -133,7 +134,7 @@ class GradManager:
         r"""Return attached tensor list from :meth:`attach`."""
         return [spec.tensor() for spec in self._attach_specs.values()]
 
-    def attach(self, tensors: Iterable[Tensor], callbacks=None):
+    def attach(self, tensors: Iterable[Tensor], callbacks=None, row_sparse=False):
         r"""Instruct GradManager to track operations on tensors, so that gradients with respect
         to those tensors could be evaluated later.
 
@@ -185,9 +186,16 @@ class GradManager:
             multiple uses of a GradManager, which is unrelated to whether resources is timely
             released within a single use.
 
+        If ``row_sparse`` is True and the gradient of a tensor only comes from gathering its rows,
+        e.g. integer indexing on the first axis or :func:`~.functional.nn.embedding_bag`, the
+        gradient is kept as a :class:`~.RowSparseGrad` instead of being scattered into a dense
+        tensor. Callbacks and optimizers then receive the :class:`~.RowSparseGrad`. Gradients
+        mixing sparse and dense contributions are always dense.
+
         Args:
             tensors: tensor or list of tensors to track
             callbacks: callback or list of callbacks
+            row_sparse: whether to produce row-sparse gradients for tensors
         """
         if callbacks is None:
             callbacks = []
@@ -208,6 +216,7 @@ class GradManager:
             spec = AttachSpec()
             spec.tensor = weakref.ref(tensor, deleter)
             spec.callbacks = []
+            spec.row_sparse = False
             return spec
 
         for x in tensors:
@@ -218,6 +227,7 @@ class GradManager:
                 spec = make_spec(x)
                 self._attach_specs[id(x)] = spec
             spec.callbacks.extend(callbacks)
+            spec.row_sparse = spec.row_sparse or row_sparse
             if new_attach and self._recording:
                 self._do_record(spec)
 
@@ -297,9 +307,17 @@ class GradManager:
                 if tensor is not None:
                     if tensor.grad is None:
                         tensor.grad = grad
+                    elif isinstance(grad, RowSparseGrad) and isinstance(
+                        tensor.grad, RowSparseGrad
+                    ):
+                        tensor.grad = tensor.grad + grad
+                    elif isinstance(grad, RowSparseGrad):
+                        tensor.grad = tensor.grad + grad.to_dense()
+                    elif isinstance(tensor.grad, RowSparseGrad):
+                        tensor.grad = tensor.grad.to_dense() + grad
                     else:
                         tensor.grad += grad
-                    if tensor._isscalar() and tensor.grad is not None:
+                    if tensor._isscalar() and isinstance(tensor.grad, Tensor):
                         tensor.grad._setscalar()
         finally:
             self.release()
@@ -330,13 +348,16 @@ class GradManager:
         if tensor is None:
             return
 
-        def callback(grad, callbacks=spec.callbacks):
+        def callback(grad, values=None, callbacks=spec.callbacks):
+            if values is not None:
+                # row-sparse gradient is passed as (indices, values)
+                grad = RowSparseGrad(grad, values, tensor.shape)
             for cb in callbacks:
                 grad = cb(tensor, grad)
             self._gradients[id(tensor)] = grad
 
         # NOTE: override prev callback wrt when called serval times
-        self._grad.wrt(tensor, callback=callback)
+        self._grad.wrt(tensor, callback=callback, row_sparse=spec.row_sparse)
 
     def release(self):
         r"""Stop recording operations and release resources kept for gradient computation
@@ -0,0 +1,102 @@
+# MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+#
+# Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+import numpy as np
+
+from ..core._imperative_rt.core2 import apply
+from ..core.ops import builtin
+from ..tensor import Tensor
+
+# scatter-add rows along axis 0: (axis, begin, end, step, idx)
+_incr_rows = builtin.IndexingIncrMultiAxisVec(items=[(0, False, False, False, True)])
+
+
+class RowSparseGrad:
+    r"""Gradient of a tensor in which only a subset of rows (slices along axis 0)
+    is nonzero.
+
+    The gradient is ``values[i]`` accumulated to row ``indices[i]`` of a zero tensor
+    of the given ``shape``. Duplicated indices are allowed and are summed up by
+    :meth:`to_dense` and :meth:`coalesce`.
+
+    Such gradients are produced by :class:`~.GradManager` for tensors attached with
+    ``row_sparse=True`` when they are only used through row gathering ops, such as
+    integer indexing on the first axis or :func:`~.functional.nn.embedding_bag`.
+
+    Args:
+        indices: 1-d int32 tensor of row indices.
+        values: tensor of shape ``(len(indices),) + shape[1:]``.
+        shape: shape of the dense gradient.
+    """
+
+    __slots__ = "indices", "values", "shape"
+
+    def __init__(self, indices: Tensor, values: Tensor, shape):
+        self.indices = indices
+        self.values = values
+        self.shape = tuple(shape)
+
+    @property
+    def dtype(self):
+        return self.values.dtype
+
+    @property
+    def device(self):
+        return self.values.device
+
+    def to_dense(self) -> Tensor:
+        r"""Returns the equivalent dense gradient."""
+        zeros = Tensor(
+            np.zeros(self.shape, dtype=self.dtype), device=self.device
+        ).detach()
+        (dense,) = apply(_incr_rows, zeros, self.values, self.indices)
+        return dense
+
+    def coalesce(self) -> "RowSparseGrad":
+        r"""Returns an equivalent gradient with unique, sorted and non-negative
+        indices."""
+        raw = self.indices.numpy()
+        # negative indices count from the end, so -1 and shape[0] - 1 are one row
+        idx = raw % self.shape[0]
+        uniq, inverse = np.unique(idx, return_inverse=True)
+        if uniq.shape[0] == raw.shape[0] and np.all(uniq == raw):
+            return self
+        zeros = Tensor(
+            np.zeros((uniq.shape[0],) + self.shape[1:], dtype=self.dtype),
+            device=self.device,
+        ).detach()
+        inverse = Tensor(inverse.astype(np.int32), device=self.device)
+        (values,) = apply(_incr_rows, zeros, self.values, inverse)
+        return RowSparseGrad(
+            Tensor(uniq.astype(np.int32), device=self.device), values, self.shape
+        )
+
+    def __add__(self, other):
+        if isinstance(other, RowSparseGrad):
+            assert self.shape == other.shape, "shape mismatch: {} vs {}".format(
+                self.shape, other.shape
+            )
+            from ..functional import concat
+
+            return RowSparseGrad(
+                concat([self.indices, other.indices]),
+                concat([self.values, other.values]),
+                self.shape,
+            )
+        return self.to_dense() + other
+
+    __radd__ = __add__
+
+    def __mul__(self, scale):
+        return RowSparseGrad(self.indices, self.values * scale, self.shape)
+
+    __rmul__ = __mul__
+
+    def __repr__(self):
+        return "RowSparseGrad(shape={}, nr_rows={})".format(
+            self.shape, self.indices.shape[0]
+        )
@@ -60,9 +60,9 @@ class Grad:
     def _is_attached_to(self, tensor):
         return self._impl.is_attached_to(tensor)
 
-    def wrt(self, *tensors, callback=None):
+    def wrt(self, *tensors, callback=None, row_sparse=False):
         for x in tensors:
-            self._impl.attach(x, callback)
+            self._impl.attach(x, callback, row_sparse)
         return self
 
     def __call__(self, ys, dys):
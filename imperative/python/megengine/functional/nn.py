@@ -63,6 +63,7 @@ __all__ = [
     "deformable_psroi_pooling",
     "dropout",
     "embedding",
+    "embedding_bag",
     "gelu",
     "hsigmoid",
     "hswish",
@@ -1624,6 +1625,63 @@ def embedding(
     return weight[inp.reshape(-1)].reshape(dest_shp)
 
 
+def embedding_bag(
+    inp: Tensor,
+    weight: Tensor,
+    offsets: Tensor,
+    mode: str = "sum",
+    per_sample_weights: Optional[Tensor] = None,
+    offsets_as_lengths: bool = False,
+) -> Tensor:
+    r"""Computes reductions over bags of embeddings without materializing the
+    gathered rows.
+
+    Args:
+        inp: 1-dimensional tensor with indices of all bags.
+        weight: embedding table with shape `(num_embeddings, dim)`.
+        offsets: 1-dimensional tensor with start position of each bag in ``inp``;
+            the first bag must start at 0.
+        mode: reduction of each bag, one of ``"sum"``, ``"mean"`` and ``"max"``.
+            Default: "sum"
+        per_sample_weights: weight of each index, with the same shape as ``inp``;
+            not supported in ``"max"`` mode. Default: None
+        offsets_as_lengths: whether ``offsets`` gives the length of each bag
+            instead of its start position. Default: False
+
+    Returns:
+        tensor with shape `(num_bags, dim)`; empty bags give zeros.
+
+    Examples:
+
+        .. testcode::
+
+            import numpy as np
+            import megengine.functional as F
+            from megengine import tensor
+
+            weight = tensor(np.arange(6, dtype=np.float32).reshape(3, 2))
+            out = F.nn.embedding_bag(tensor([0, 2, 1]), weight, tensor([0, 2]))
+            print(out.numpy())
+
+        Outputs:
+
+        .. testoutput::
+
+            [[4. 6.]
+             [2. 3.]]
+    """
+    op = builtin.EmbeddingBag(
+        mode=mode.upper(), offset_mode="LENGTHS" if offsets_as_lengths else "OFFSETS"
+    )
+    inp = convert_single_value(inp, dtype="int32", device=weight.device)
+    offsets = convert_single_value(offsets, dtype="int32", device=weight.device)
+    inputs = (weight, inp, offsets)
+    if per_sample_weights is not None:
+        inputs += (per_sample_weights,)
+    (result,) = apply(op, *inputs)
+    return result
+
+
 def indexing_one_hot(
     src: Tensor, index: Tensor, axis: int = 1, keepdims=False
 ) -> Tensor:
@@ -10,6 +10,7 @@ from typing import Iterable, Union
 
 import numpy as np
 
+from ..autodiff.row_sparse import RowSparseGrad
 from ..tensor import Parameter, tensor
 from .optimizer import Optimizer
 
@@ -82,6 +83,21 @@ class Adagrad(Optimizer):
             step = states["step"]
             step += c1
             grad = param.grad
+            if isinstance(grad, RowSparseGrad):
+                grad = grad.coalesce()
+                idx = grad.indices
+                rows = param[idx]
+                grad = grad.values
+                if weight_decay != 0.0:
+                    grad = grad + rows * _weight_decay
+
+                square_avg = states["square_avg"][idx] + grad ** c2
+                states["square_avg"][idx] = square_avg
+                delta = grad / (square_avg + _eps) ** c05
+                clr = _lr / (c1 + (step - c1) * _lr_decay)
+                param[idx] = rows - clr * delta
+                continue
+
             if weight_decay != 0.0:
                 grad = grad + param * _weight_decay
 
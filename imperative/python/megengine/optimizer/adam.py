@@ -9,6 +9,7 @@
 import os
 from typing import Iterable, Tuple, Union
 
+from ..autodiff.row_sparse import RowSparseGrad
 from ..functional.inplace import _inplace_add_
 from ..tensor import Parameter, tensor
 from .optimizer import Optimizer
@@ -25,6 +26,10 @@ class Adam(Optimizer):
             and its square. Default: (0.9, 0.999)
         eps: term added to the denominator to improve numerical stability. Default: 1e-8
         weight_decay: weight decay (L2 penalty). Default: 0
+
+    For a :class:`~.RowSparseGrad` gradient, only the referenced rows of the
+    parameter and of the moment estimates are updated (lazy update), while the
+    step used for bias correction is still counted per parameter.
     """
 
     def __init__(
@@ -84,6 +89,30 @@ class Adam(Optimizer):
                 continue
 
             grad = param.grad
+            if isinstance(grad, RowSparseGrad):
+                grad = grad.coalesce()
+                idx = grad.indices
+                rows = param[idx]
+                grad = grad.values
+                if weight_decay != 0.0:
+                    grad = grad + rows * _weight_decay
+
+                states = self._state[param]
+                step = states["step"]
+                step += c1
+                exp_avg = states["exp_avg"][idx] * _beta0 + grad * (c1 - _beta0)
+                exp_avg_sq = states["exp_avg_sq"][idx] * _beta1 + (c1 - _beta1) * (
+                    grad * grad
+                )
+                states["exp_avg"][idx] = exp_avg
+                states["exp_avg_sq"][idx] = exp_avg_sq
+
+                delta = (exp_avg / (c1 - _beta0 ** step)) / (
+                    (exp_avg_sq / (c1 - _beta1 ** step)) ** c05 + _eps
+                )
+                param[idx] = rows - _lr * delta
+                continue
+
             if weight_decay != 0.0:
                 grad = grad + param * _weight_decay
 
@@ -16,6 +16,7 @@ from typing import Union
 import numpy as np
 
 from ..core._imperative_rt.core2 import pop_scope, push_scope, set_option
+from ..autodiff.row_sparse import RowSparseGrad
 from ..core.tensor.utils import set_convert_inputs
 from ..tensor import Parameter, Tensor
 from ..utils.deprecation import deprecated
@@ -168,7 +169,10 @@ class Optimizer(metaclass=ABCMeta):
     def zero_grad(self):
         for param_group in self.param_groups:
             for param in param_group["params"]:
-                if param.grad is not None:
+                if isinstance(param.grad, RowSparseGrad):
+                    # a zero row-sparse gradient has no rows
+                    param.grad = None
+                elif param.grad is not None:
                     param.grad.reset_zero()
 
     def clear_grad(self):
@@ -9,6 +9,7 @@
 import os
 from typing import Iterable, Union
 
+from ..autodiff.row_sparse import RowSparseGrad
 from ..functional.inplace import _inplace_add_
 from ..tensor import Parameter, tensor
 from .optimizer import Optimizer
@@ -27,6 +28,9 @@ class SGD(Optimizer):
         momentum: momentum factor. Default: 0.0
         nesterov: enables Nesterov momentum. Default: False
         weight_decay: weight decay (L2 penalty). Default: 0.0
+
+    For a :class:`~.RowSparseGrad` gradient, only the referenced rows of the
+    parameter and of the momentum buffer are updated (lazy update).
     """
 
     def __init__(
@@ -76,6 +80,10 @@ class SGD(Optimizer):
                 continue
 
             grad = param.grad
+            if isinstance(grad, RowSparseGrad):
+                self._sparse_update(param, grad.coalesce(), param_group)
+                continue
+
             if weight_decay != 0.0:
                 grad = grad + param * _weight_decay
 
@@ -99,3 +107,25 @@ class SGD(Optimizer):
                 else:
                     grad = v
             param -= _lr * grad
+
+    def _sparse_update(self, param, grad, param_group):
+        lr = tensor(param_group["lr"], dtype="float32")
+        weight_decay = param_group["weight_decay"]
+        momentum = param_group["momentum"]
+
+        idx = grad.indices
+        rows = param[idx]
+        grad = grad.values
+        if weight_decay != 0.0:
+            grad = grad + rows * tensor(weight_decay, dtype="float32")
+
+        if momentum != 0.0:
+            _momentum = tensor(momentum, dtype="float32")
+            v = self._state[param]["momentum_buffer"]
+            v_rows = v[idx] * _momentum + grad
+            v[idx] = v_rows
+            if self.nesterov:
+                grad = grad + v_rows * _momentum
+            else:
+                grad = v_rows
+        param[idx] = rows - lr * grad
@@ -229,6 +229,9 @@ struct GradProducerRecord : intrusive_list::Node<GradProducerRecord> {
 
 struct GradSlot {
     std::shared_ptr<Tensor> grad;
+    //! row-sparse parts of grad; only attached leaf tensors accept them
+    bool accept_row_sparse = false;
+    SmallVector<std::shared_ptr<Tensor>> row_sparse_indices, row_sparse_values;
     py::object callback;
     GradProducerRecord::head_t producer_head;
 };
@@ -481,8 +484,8 @@ void GradKeyWrapper::set_priority(pybind11::handle priority) {
 }
 
 void GradKeyWrapper::attach(PyObject* const* args, size_t nargs) {
-    if (nargs != 2) {
-        throw py::type_error("expect 2 arguments");
+    if (nargs != 2 && nargs != 3) {
+        throw py::type_error("expect 2 or 3 arguments");
     }
     auto* tw = TensorWrapper::try_cast(args[0]);
     if (!tw) {
@@ -493,11 +496,12 @@ void GradKeyWrapper::attach(PyObject* const* args, size_t nargs) {
     if (args[1] != Py_None) {
         callback = py::reinterpret_borrow<py::object>(args[1]);
     }
-    m_key->attach(tensor, std::move(callback));
+    bool row_sparse = nargs == 3 && PyObject_IsTrue(args[2]);
+    m_key->attach(tensor, std::move(callback), row_sparse);
 }
 
 //!  GradKey is weakly refered by tensor->m_grad_info.grad_fn->key after attach
-void GradKey::attach(Tensor* tensor, pybind11::object callback) {
+void GradKey::attach(Tensor* tensor, pybind11::object callback, bool row_sparse) {
     if (!active) {
         throw py::value_error("grad key finalized");
     }
@@ -516,7 +520,12 @@ void GradKey::attach(Tensor* tensor, pybind11::object callback) {
         grad_info.insert_after(free_vars_head);
         tensor->m_flags |= Flags::GRAD;
     }
-    tensor->m_grad_info_dict.at(this).grad_fn->slots[0].callback = std::move(callback);
+    auto&& grad_fn = tensor->m_grad_info_dict.at(this).grad_fn;
+    // grads of non-leaf tensors are passed on to backward of their producers,
+    // which only take dense grads
+    grad_fn->slots[0].accept_row_sparse =
+            row_sparse && std::holds_alternative<std::monostate>(grad_fn->backward);
+    grad_fn->slots[0].callback = std::move(callback);
 }
 
 template <typename T>
@@ -530,6 +539,41 @@ void accum_grad(std::shared_ptr<Tensor>& grad, T&& delta) {
     grad = apply(op, grad, std::forward<T>(delta))[0];
 }
 
+namespace {
+std::shared_ptr<Tensor> concat_rows(const SmallVector<std::shared_ptr<Tensor>>& parts) {
+    if (parts.size() == 1) {
+        return parts[0];
+    }
+    SmallVector<Tensor*> args;
+    for (auto&& i : parts) {
+        args.push_back(i.get());
+    }
+    auto op = Concat::make(0, parts[0]->comp_node());
+    return python::apply(op, args)[0];
+}
+
+void invoke_grad_callback(BackwardContext& bctx, GradSlot& slot) {
+    if (slot.row_sparse_values.empty()) {
+        slot.callback(bctx.wrap_tensor(slot.grad));
+        return;
+    }
+    auto indices = concat_rows(slot.row_sparse_indices),
+         values = concat_rows(slot.row_sparse_values);
+    slot.row_sparse_indices.clear();
+    slot.row_sparse_values.clear();
+    if (!slot.grad) {
+        slot.callback(bctx.wrap_tensor(indices), bctx.wrap_tensor(values));
+        return;
+    }
+    // mixed dense and row-sparse grads: scatter the rows into the dense one
+    static auto op = IndexingIncrMultiAxisVec::make(
+            std::vector<std::tuple<int8_t, bool, bool, bool, bool>>{
+                    {0, false, false, false, true}});
+    slot.grad = python::apply(op, slot.grad, values, indices)[0];
+    slot.callback(bctx.wrap_tensor(slot.grad));
+}
+}  // anonymous namespace
+
 void GradKey::backward(
         std::vector<TensorWrapper*> tensors, std::vector<TensorWrapper*> grads) {
     if (!active) {
@@ -585,6 +629,16 @@ void GradKey::backward(
                 accum_grad(dst->grad, std::forward<decltype(g)>(g));
             }
         };
+        bctx.row_sparse_receiver = [&](size_t i, std::shared_ptr<Tensor> indices,
+                                       std::shared_ptr<Tensor> values) {
+            auto& dst = grad_fn->dsts.at(i);
+            if (!dst || !dst->accept_row_sparse) {
+                return false;
+            }
+            dst->row_sparse_indices.push_back(std::move(indices));
+            dst->row_sparse_values.push_back(std::move(values));
+            return true;
+        };
         std::visit(
                 [&](auto&& backward) {
                     using T = std::decay_t<decltype(backward)>;
@@ -610,9 +664,10 @@ void GradKey::backward(
                 dst.grad_fn->in_ref_keeper = true;
                 ref_keeper.push_back(dst.grad_fn);
             }
-            if (!dst.producer_record.next && dst->callback && dst->grad) {
+            if (!dst.producer_record.next && dst->callback &&
+                (dst->grad || !dst->row_sparse_values.empty())) {
                 // I'm the last grad producer, invoke callback
-                dst->callback(bctx.wrap_tensor(dst->grad));
+                invoke_grad_callback(bctx, *dst);
             }
         }
         grad_fn->clear();
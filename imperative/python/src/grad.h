@@ -31,7 +31,9 @@ struct GradKey : std::enable_shared_from_this<GradKey>, NonCopyableObj {
 
     ~GradKey();
 
-    void attach(Tensor* tensor, pybind11::object callback);
+    //! \param row_sparse whether the callback accepts (indices, values) of
+    //!     row-sparse grads along axis 0
+    void attach(Tensor* tensor, pybind11::object callback, bool row_sparse = false);
     void backward(std::vector<TensorWrapper*>, std::vector<TensorWrapper*>);
     void cleanup();
     bool is_blocked() const { return priority < sm_min_priority; }
@@ -69,6 +71,23 @@ struct BackwardContext {
     }
 
     auto wrap_tensor(Tensor* t) { return wrap_tensor(t->shared_from_this()); }
+
+    /*!
+     * \brief receiver of row-sparse grads for inputs of the op being
+     *      backwarded, set by GradKey::backward
+     *
+     * Given grad rows \p values along axis 0 of input \p i at 1-dim
+     * \p indices, it returns false if the input only accepts dense grads.
+     */
+    std::function<bool(size_t i, std::shared_ptr<Tensor> indices,
+                       std::shared_ptr<Tensor> values)>
+            row_sparse_receiver;
+
+    bool send_row_sparse_grad(
+            size_t i, std::shared_ptr<Tensor> indices, std::shared_ptr<Tensor> values) {
+        return row_sparse_receiver &&
+               row_sparse_receiver(i, std::move(indices), std::move(values));
+    }
 };
 
 struct CustomBackward {
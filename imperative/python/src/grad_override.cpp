@@ -141,6 +141,10 @@ std::optional<apply_result_t> indexingMultiAxisVec_grad_rule(
         ApplyContext& ctx, CustomBackward::Maker& maker) {
     auto&& op = ctx.op->cast_final_safe<IndexingMultiAxisVec>();
     auto&& grad_op = IndexingSetMultiAxisVec::make(op.items);
+    // x[idx] with a single index vector on axis 0 gathers rows of x, so its
+    // grad is row-sparse
+    bool gather_rows = op.items.size() == 1 && std::get<0>(op.items[0]) == 0 &&
+                       std::get<4>(op.items[0]);
     SmallVector<std::shared_ptr<Tensor>> inputs;
     if (input_requires_grad(ctx, 0)) {
         inputs.push_back(get_shape(ctx.args[0]));
@@ -149,11 +153,16 @@ std::optional<apply_result_t> indexingMultiAxisVec_grad_rule(
         }
     }
     maker.output_size(1).output_captured(0, false);
-    maker.backward([inputs = std::move(inputs), grad_op_ = std::move(grad_op)](
-                           BackwardContext&, Tensor* const* grads, size_t ngrads) {
+    maker.backward([inputs = std::move(inputs), grad_op_ = std::move(grad_op),
+                    gather_rows](
+                           BackwardContext& bctx, Tensor* const* grads, size_t ngrads) {
         mgb_assert(ngrads == 1);
         Tensor* grad = grads[0];
         apply_result_t ret(1);
+        if (grad && inputs[0] && gather_rows && inputs[1]->shape().ndim == 1 &&
+            bctx.send_row_sparse_grad(0, inputs[1], grad->shared_from_this())) {
+            return ret;
+        }
         if (grad && inputs[0]) {
             SmallVector<Tensor*> args_(inputs.size() + 1);
             auto&& zeros = make_empty_tensor(
@@ -170,6 +179,49 @@ std::optional<apply_result_t> indexingMultiAxisVec_grad_rule(
     return apply(ctx);
 }
 
+std::optional<apply_result_t> embeddingBag_grad_rule(
+        ApplyContext& ctx, CustomBackward::Maker& maker) {
+    auto&& op = ctx.op->cast_final_safe<EmbeddingBag>();
+    auto&& grad_op = EmbeddingBagBackward::make(op.param());
+    SmallVector<std::shared_ptr<Tensor>> inputs;
+    if (input_requires_grad(ctx, 0)) {
+        for (size_t i = 0; i < ctx.nargs; ++i) {
+            inputs.push_back(ctx.args[i]->copy());
+        }
+    }
+    maker.output_size(1).output_captured(0, false);
+    for (size_t i = 1; i < ctx.nargs; ++i) {
+        maker.input_has_grad(i, false);
+    }
+    maker.backward([inputs = std::move(inputs), grad_op_ = std::move(grad_op)](
+                           BackwardContext& bctx, Tensor* const* grads, size_t ngrads) {
+        mgb_assert(ngrads == 1);
+        Tensor* grad = grads[0];
+        apply_result_t ret(1);
+        if (!grad || inputs.empty()) {
+            return ret;
+        }
+        SmallVector<Tensor*> args_;
+        for (auto&& i : inputs) {
+            args_.push_back(i.get());
+        }
+        args_.push_back(grad);
+        // one grad row for each index
+        auto rows = python::apply(grad_op_, args_)[0];
+        if (bctx.send_row_sparse_grad(0, inputs[1], rows)) {
+            return ret;
+        }
+        static auto incr_op = IndexingIncrMultiAxisVec::make(
+                std::vector<std::tuple<int8_t, bool, bool, bool, bool>>{
+                        {0, false, false, false, true}});
+        auto&& zeros = make_empty_tensor(
+                grad->comp_node(), get_shape(inputs[0].get()).get(), grad->dtype());
+        ret[0] = python::apply(incr_op, zeros, rows, inputs[1])[0];
+        return ret;
+    });
+    return apply(ctx);
+}
+
 std::optional<apply_result_t> reduce_grad_rule(
         ApplyContext& ctx, CustomBackward::Maker& maker) {
     auto& op = ctx.op->cast_final_safe<Reduce>();
@@ -262,6 +314,7 @@ struct Init {
         reg.emplace(Reshape::typeinfo(), reshape_grad_rule);
         reg.emplace(Subtensor::typeinfo(), subtensor_grad_rule);
         reg.emplace(IndexingMultiAxisVec::typeinfo(), indexingMultiAxisVec_grad_rule);
+        reg.emplace(EmbeddingBag::typeinfo(), embeddingBag_grad_rule);
         reg.emplace(Reduce::typeinfo(), reduce_grad_rule);
         reg.emplace(AddAxis::typeinfo(), addAxis_grad_rule);
         reg.emplace(RemoveAxis::typeinfo(), removeAxis_grad_rule);
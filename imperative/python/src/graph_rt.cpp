@@ -481,6 +481,7 @@ void init_graph_rt(py::module m) {
                 DEF_READWRITE(enable_sublinear_memory_opt)
                 DEF_READWRITE(enable_dtr_memory_opt)
                 DEF_READWRITE(no_profiling_on_shape_change)
+                DEF_READWRITE(deterministic)
                 DEF_READWRITE(enable_var_mem_defragment)
                 DEF_READWRITE(enable_grad_var_static_reshape)
                 DEF_READWRITE(enable_memory_swap)
@@ -508,7 +509,9 @@ void init_graph_rt(py::module m) {
     auto PyGraphOpt = py::class_<cg::ComputingGraph::Options::GraphOpt>(
             PyComputingGraphOptions, "GraphOpt") DEF_READWRITE(jit)
             DEF_READWRITE(jit_config)
-            DEF_READWRITE(tensorrt);
+            DEF_READWRITE(tensorrt)
+            DEF_READWRITE(egraph_arith)
+            DEF_READWRITE(pass_cache);
 
 #undef CURRENT_CLASS
 #define CURRENT_CLASS cg::ComputingGraph::Options::GraphOpt::JITConfig
@@ -434,3 +434,89 @@ def test_emulate_forward_mode_with_reverse_mode(target):
 
     np.testing.assert_almost_equal(y.numpy(), y1.numpy(), decimal=5)
     np.testing.assert_almost_equal(dy.numpy(), dy1.numpy(), decimal=3)
+
+
+def test_row_sparse_grad():
+    data = np.random.random((10, 4)).astype("float32")
+    idx = np.array([1, 3, 3, 7], dtype="int32")
+    dy = np.random.random((4, 4)).astype("float32")
+
+    x = mge.Parameter(data)
+    gm = GradManager().attach(x, row_sparse=True)
+    with gm:
+        y = x[mge.tensor(idx)]
+        gm.backward(y, mge.tensor(dy))
+    assert isinstance(x.grad, mge.autodiff.RowSparseGrad)
+    expect = np.zeros_like(data)
+    np.add.at(expect, idx, dy)
+    np.testing.assert_allclose(x.grad.to_dense().numpy(), expect, rtol=1e-6)
+    coalesced = x.grad.coalesce()
+    np.testing.assert_equal(coalesced.indices.numpy(), [1, 3, 7])
+
+    # a negative index refers to the same row as its non-negative counterpart
+    x.grad = None
+    neg_idx = np.array([1, -7, 3, -3], dtype="int32")
+    with gm:
+        y = x[mge.tensor(neg_idx)]
+        gm.backward(y, mge.tensor(dy))
+    coalesced = x.grad.coalesce()
+    np.testing.assert_equal(coalesced.indices.numpy(), [1, 3, 7])
+    np.testing.assert_allclose(coalesced.to_dense().numpy(), expect, rtol=1e-6)
+
+    # dense contribution makes the gradient dense
+    x.grad = None
+    with gm:
+        y = x[mge.tensor(idx)].sum() + (x * 2).sum()
+        gm.backward(y)
+    assert isinstance(x.grad, mge.Tensor)
+    expect = np.full_like(data, 2)
+    np.add.at(expect, idx, 1)
+    np.testing.assert_allclose(x.grad.numpy(), expect, rtol=1e-6)
+
+    # dense grad accumulated onto an existing row-sparse grad, and vice versa
+    gm_dense = GradManager().attach(x)
+    x.grad = None
+    with gm:
+        gm.backward(x[mge.tensor(idx)].sum())
+    with gm_dense:
+        gm_dense.backward((x * 2).sum())
+    assert isinstance(x.grad, mge.Tensor)
+    np.testing.assert_allclose(x.grad.numpy(), expect, rtol=1e-6)
+
+    x.grad = None
+    with gm_dense:
+        gm_dense.backward((x * 2).sum())
+    with gm:
+        gm.backward(x[mge.tensor(idx)].sum())
+    assert isinstance(x.grad, mge.Tensor)
+    np.testing.assert_allclose(x.grad.numpy(), expect, rtol=1e-6)
+
+
+@pytest.mark.parametrize(
+    "opt_cls, kwargs",
+    [
+        (optim.SGD, dict(lr=0.1, momentum=0.9)),
+        (optim.Adam, dict(lr=0.1)),
+        (optim.Adagrad, dict(lr=0.1)),
+    ],
+)
+def test_row_sparse_optimizer(opt_cls, kwargs):
+    data = np.random.random((10, 4)).astype("float32")
+    # -8 is row 2 again, it must not be updated twice
+    idx = np.array([2, 5, -8], dtype="int32")
+    touched = np.unique(idx % 10)
+    untouched = np.setdiff1d(np.arange(10), touched)
+
+    def run(row_sparse):
+        x = mge.Parameter(data)
+        gm = GradManager().attach(x, row_sparse=row_sparse)
+        opt = opt_cls([x], **kwargs)
+        with gm:
+            gm.backward((x[mge.tensor(idx)] ** 2).sum())
+        assert isinstance(x.grad, mge.autodiff.RowSparseGrad) == row_sparse
+        opt.step()
+        return x.numpy()
+
+    dense, sparse = run(False), run(True)
+    np.testing.assert_allclose(sparse[touched], dense[touched], rtol=1e-5)
+    np.testing.assert_equal(sparse[untouched], data[untouched])
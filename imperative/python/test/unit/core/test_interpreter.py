@@ -1,3 +1,4 @@
+import os
 import subprocess
 import sys
 
@@ -9,9 +10,11 @@ import megengine.functional as F
 from megengine.core._imperative_rt.core2 import (
     AsyncError,
     _set_drop_flag,
+    apply,
     config_async_level,
     get_async_level,
 )
+from megengine.core.ops.builtin import InplaceAdd
 
 
 def test_basic():
@@ -116,3 +119,65 @@ def test_async_error():
             F.utils._simulate_error()
     finally:
         mge.core.set_option("async_level", orig_lvl)
+
+
+def test_elemwise_fusion():
+    orig = mge.core.get_option("enable_elemwise_fusion")
+    try:
+        mge.core.set_option("enable_elemwise_fusion", 1)
+        x = np.random.randn(4, 8).astype("float32")
+        s = np.random.randn(4, 8).astype("float32")
+        b = np.random.randn(8).astype("float32")
+        tx, ts, tb = mge.tensor(x), mge.tensor(s), mge.tensor(b)
+        # intermediates are deleted, fused into FUSE_MUL_ADD3 and FUSE_ADD_RELU
+        y = F.relu(tx * ts + tx)
+        z = F.sigmoid(tx + tb)
+        np.testing.assert_allclose(
+            y.numpy(), np.maximum(x * s + x, 0), rtol=1e-5, atol=1e-6
+        )
+        np.testing.assert_allclose(
+            z.numpy(), 1 / (1 + np.exp(-(x + b))), rtol=1e-5, atol=1e-6
+        )
+        # intermediate held by user should still be readable
+        t = tx + tb
+        r = F.relu(t)
+        np.testing.assert_allclose(t.numpy(), x + b, rtol=1e-6)
+        np.testing.assert_allclose(r.numpy(), np.maximum(x + b, 0), rtol=1e-6)
+        # an in-place update of a producer input between the producer and the
+        # consumer is a fusion barrier, the consumer must see the old value
+        ta, td = mge.tensor(x), mge.tensor(s)
+        alpha, beta = mge.tensor(1.0), mge.tensor(1.0)
+        t = ta + tb
+        (ta_new,) = apply(InplaceAdd(), ta, td, alpha, beta)
+        r = F.relu(t)
+        del t
+        np.testing.assert_allclose(r.numpy(), np.maximum(x + b, 0), rtol=1e-6)
+        np.testing.assert_allclose(ta_new.numpy(), x + s, rtol=1e-6)
+    finally:
+        mge.core.set_option("enable_elemwise_fusion", orig)
+
+
+def test_host_only_tensor():
+    a = mge.tensor([1, 2], dtype="int32")
+    # computed on host, no device value until needed
+    b = a * 2 + 1
+    np.testing.assert_equal(b.numpy(), [3, 5])
+    # read by kernel, the deferred put should be sent
+    c = b + F.zeros(64, dtype="int32")[:2]
+    np.testing.assert_equal(c.numpy(), [3, 5])
+    np.testing.assert_equal(b.numpy(), [3, 5])
+
+
+def test_host_only_tensor_profiling(tmp_path):
+    from megengine.utils.profiler import Profiler
+
+    a = mge.tensor([1, 2], dtype="int32")
+    # created before profiling, put when first read by kernel
+    b = a * 2 + 1
+    with Profiler(str(tmp_path), formats=["chrome_timeline.json"]):
+        # host computed but not host-only while profiling
+        c = b * 3
+        d = c + F.zeros(64, dtype="int32")[:2]
+        np.testing.assert_equal(d.numpy(), [9, 15])
+    np.testing.assert_equal(b.numpy(), [3, 5])
+    assert (tmp_path / "{}.chrome_timeline.json".format(os.getpid())).exists()
@@ -21,6 +21,7 @@ import megengine.core.tensor.dtype as dtype
 import megengine.functional as F
 import megengine.jit as jit
 from megengine import Parameter, Tensor, is_cuda_available, tensor
+from megengine.autodiff import GradManager
 from megengine.core._trace_option import use_symbolic_shape
 from megengine.core.autodiff.grad import Grad
 from megengine.core.tensor.utils import make_shape_tuple
@@ -457,6 +458,44 @@ def test_one_hot():
     onehot_high_dimension()
 
 
+@pytest.mark.parametrize("mode", ["sum", "mean", "max"])
+@pytest.mark.parametrize("lengths", [False, True])
+def test_embedding_bag(mode, lengths):
+    weight_np = np.random.randn(10, 5).astype(np.float32)
+    inp_np = np.array([3, 1, 4, 1, 5, 9, 2], dtype=np.int32)
+    offsets_np = np.array([0, 2, 2, 5], dtype=np.int32)
+    bounds = list(offsets_np) + [len(inp_np)]
+    reduce = {"sum": np.sum, "mean": np.mean, "max": np.max}[mode]
+    expect = np.zeros((len(offsets_np), 5), dtype=np.float32)
+    for i in range(len(offsets_np)):
+        rows = weight_np[inp_np[bounds[i] : bounds[i + 1]]]
+        if len(rows):
+            expect[i] = reduce(rows, axis=0)
+    bags = np.diff(bounds).astype(np.int32) if lengths else offsets_np
+
+    weight = tensor(weight_np)
+    gm = GradManager().attach([weight])
+    with gm:
+        out = F.nn.embedding_bag(
+            tensor(inp_np), weight, tensor(bags), mode=mode, offsets_as_lengths=lengths
+        )
+        gm.backward(out.sum())
+    np.testing.assert_allclose(out.numpy(), expect, rtol=1e-6, atol=1e-6)
+
+    expect_grad = np.zeros_like(weight_np)
+    for i in range(len(offsets_np)):
+        idx = inp_np[bounds[i] : bounds[i + 1]]
+        if not len(idx):
+            continue
+        if mode == "max":
+            arg = np.argmax(weight_np[idx], axis=0)
+            expect_grad[idx[arg], np.arange(5)] += 1
+        else:
+            for j in idx:
+                expect_grad[j] += 1 if mode == "sum" else 1 / len(idx)
+    np.testing.assert_allclose(weight.grad.numpy(), expect_grad, rtol=1e-6, atol=1e-6)
+
+
 def test_interpolate_fastpath():
     # check shape
     test_cases = [
@@ -9,9 +9,19 @@
  * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
  */
 
+#pragma once
+
 #include "megbrain/comp_node.h"
 #include "megbrain/comp_node_env.h"
+#include "megbrain/imperative/graph_cache.h"
 #include "megbrain/imperative/physical_tensor.h"
+#include "megbrain/opr/internal/megdnn_opr_wrapper.h"
+#include "megbrain/utils/hash.h"
+#include "megdnn/oprs.h"
+
+#include <list>
+#include <type_traits>
+#include <unordered_map>
 
 using namespace megdnn;
 
@@ -28,13 +38,12 @@ struct DnnOprCaller {
     CompNode cn;
     DeviceTensorND dev_tensor;
     Workspace workspace;
-    std::unique_ptr<Opr> op;
+    opr::intl::PooledMegDNNOpr<Opr> op;
 
     DnnOprCaller(CompNode cn) : cn(cn), op(create_operator(cn)) {}
 
-    static std::unique_ptr<Opr> create_operator(CompNode cn) {
-        auto&& handle = MegDNNHandle::get(CompNodeEnv::from_comp_node(cn)).handle();
-        return handle->create_operator<Opr>();
+    static opr::intl::PooledMegDNNOpr<Opr> create_operator(CompNode cn) {
+        return opr::intl::MegDNNOprPool::inst().acquire<Opr>(cn);
     }
 
     megdnn::Workspace create_workspace(TensorLayout layout) {
@@ -44,15 +53,290 @@ struct DnnOprCaller {
         return workspace;
     }
 
-    ~DnnOprCaller() {
-        using DT = CompNode::DeviceType;
-        if (cn.device_type() == DT::CPU && cn != CompNode::default_cpu()) {
-            CompNodeEnv::from_comp_node(cn).cpu_env().dispatch(
-                    [p = op.release()] { delete p; });
+    ~DnnOprCaller() { opr::intl::MegDNNOprPool::inst().recycle(cn, std::move(op)); }
+};
+
+/*!
+ * \brief a map keeping at most \p capacity items, evicting the least recently
+ *      used one on insertion when full
+ */
+template <typename Key, typename Value, typename Hash, typename Eq = std::equal_to<Key>>
+class LRUCache {
+    using List = std::list<std::pair<Key, Value>>;
+    List m_items;
+    std::unordered_map<Key, typename List::iterator, Hash, Eq> m_index;
+    size_t m_capacity;
+
+public:
+    explicit LRUCache(size_t capacity) : m_capacity{capacity} {}
+
+    //! find the value and mark it as the most recently used; nullptr if absent
+    Value* find(const Key& key) {
+        auto iter = m_index.find(key);
+        if (iter == m_index.end()) {
+            return nullptr;
+        }
+        m_items.splice(m_items.begin(), m_items, iter->second);
+        return &iter->second->second;
+    }
+
+    //! insert a key that is absent
+    Value& insert(Key key, Value value) {
+        if (m_items.size() >= m_capacity) {
+            m_index.erase(m_items.back().first);
+            m_items.pop_back();
+        }
+        m_items.emplace_front(std::move(key), std::move(value));
+        m_index.emplace(m_items.front().first, m_items.begin());
+        return m_items.front().second;
+    }
+
+    size_t size() const { return m_items.size(); }
+
+    void clear() {
+        m_index.clear();
+        m_items.clear();
+    }
+};
+
+/*!
+ * \brief megdnn oprs cached for ops dispatched to megdnn directly
+ *
+ * Applying an op by proxy graph inserts graph oprs and runs static inference
+ * on every call. Hot ops instead call megdnn with oprs cached per (op def,
+ * input comp nodes and dtypes); the algorithm chosen by heuristic and the
+ * workspace size are further cached per input layouts. Both levels keep the
+ * most recently used items only, so that dynamic shapes or many distinct
+ * params do not grow them without bound.
+ */
+template <typename Opr>
+class DnnOprCache {
+    static constexpr bool WITH_ALGO = std::is_base_of<
+            megdnn::detail::MultiAlgoOpr<Opr, Opr::NR_INPUTS + Opr::NR_OUTPUTS>,
+            Opr>::value;
+
+    struct LayoutsHash {
+        size_t operator()(const TensorLayoutArray& layouts) const {
+            XXHash state;
+            for (auto&& i : layouts) {
+                size_t data[2 + TensorLayout::MAX_NDIM * 2];
+                size_t length = 0;
+                data[length++] = static_cast<size_t>(i.dtype.enumv());
+                data[length++] = i.ndim;
+                for (size_t j = 0; j < i.ndim; ++j) {
+                    data[length++] = i.shape[j];
+                    data[length++] = static_cast<size_t>(i.stride[j]);
+                }
+                state.update(data, length * sizeof(size_t));
+            }
+            return state.digest();
+        }
+    };
+
+    struct LayoutsEq {
+        bool operator()(const TensorLayoutArray& a, const TensorLayoutArray& b) const {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (!a[i].eq_layout(b[i]) || a[i].dtype != b[i].dtype) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+public:
+    //! max number of cached oprs per thread, and of plans per opr
+    static constexpr size_t MAX_NR_ENTRIES = 256, MAX_NR_PLANS = 64;
+
+    struct Plan {
+        megdnn::ExecutionPolicy policy;
+        size_t workspace_in_bytes;
+    };
+
+    struct Entry {
+        DnnOprCaller<Opr> caller;
+        LRUCache<TensorLayoutArray, Plan, LayoutsHash, LayoutsEq> plans{MAX_NR_PLANS};
+
+        explicit Entry(CompNode cn) : caller{cn} {}
+    };
+
+private:
+    using Key = OpMethArgs<>;
+
+    //! the oprs hold comp node resources, so they are dropped on finalize
+    struct EntryCache final : CompNodeDepedentObject {
+        LRUCache<Key, std::shared_ptr<Entry>, Key::hash_t> entries{MAX_NR_ENTRIES};
+
+        std::shared_ptr<void> on_comp_node_finalize() override {
+            entries.clear();
+            return {};
+        }
+    };
+
+    static EntryCache& entry_cache() {
+        thread_local EntryCache cache;
+        return cache;
+    }
+
+public:
+    /*!
+     * \brief get cached opr for the op def
+     *
+     * The returned entry is shared since it may be evicted by a later call.
+     *
+     * \param init called to set the param of a newly created opr
+     */
+    template <typename Init>
+    static std::shared_ptr<Entry> get(
+            const OpDef& def, const SmallVector<TensorPtr>& inputs, Init&& init) {
+        auto&& cache = entry_cache().entries;
+        SmallVector<LogicalTensorDesc> descs(inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            descs[i] = {{{}, inputs[i]->dtype()}, inputs[i]->comp_node()};
+        }
+        Key key{const_cast<OpDef&>(def).shared_from_this(), std::move(descs)};
+        if (auto entry = cache.find(key)) {
+            return *entry;
+        }
+        auto entry = std::make_shared<Entry>(inputs[0]->comp_node());
+        init(entry->caller.op.get());
+        return cache.insert(std::move(key), std::move(entry));
+    }
+
+    //! number of oprs cached by the current thread
+    static size_t nr_entries() { return entry_cache().entries.size(); }
+
+    /*!
+     * \brief get the execution plan for given layouts (inputs followed by
+     *      outputs), and set the algorithm into the opr
+     */
+    template <typename... Layouts>
+    static const Plan& get_plan(
+            Entry& entry, const megdnn::param::ExecutionPolicy& policy,
+            const Layouts&... layouts) {
+        auto opr = entry.caller.op.get();
+        if (auto plan = entry.plans.find({layouts...})) {
+            if constexpr (WITH_ALGO) {
+                opr->execution_policy() = plan->policy;
+            }
+            return *plan;
+        }
+        Plan plan;
+        if constexpr (WITH_ALGO) {
+            using Strategy = megdnn::param::ExecutionPolicy::Strategy;
+            auto attr = policy.strategy & Strategy::REPRODUCIBLE
+                              ? megdnn::AlgoAttribute::REPRODUCIBLE
+                              : megdnn::AlgoAttribute::DEFAULT;
+            opr->execution_policy() = {};
+            plan.policy.algo =
+                    opr->get_algorithm_info_heuristic(
+                               layouts..., policy.workspace_limit, attr)
+                            .desc;
+            opr->execution_policy() = plan.policy;
+        }
+        plan.workspace_in_bytes = get_workspace_in_bytes(opr, layouts...);
+        return entry.plans.insert(TensorLayoutArray{layouts...}, plan);
+    }
+
+    template <typename... Layouts>
+    static size_t get_workspace_in_bytes(Opr* opr, const Layouts&... layouts) {
+        if constexpr (std::is_same<Opr, megdnn::ConvolutionForward>::value) {
+            return opr->get_workspace_in_bytes(layouts..., nullptr);
+        } else {
+            return opr->get_workspace_in_bytes(layouts...);
+        }
+    }
+
+    template <typename... Tensors>
+    static void exec(Opr* opr, megdnn::Workspace workspace, const Tensors&... tensors) {
+        if constexpr (std::is_same<Opr, megdnn::ConvolutionForward>::value) {
+            opr->exec(tensors..., nullptr, workspace);
+        } else {
+            opr->exec(tensors..., workspace);
         }
     }
 };
 
+namespace dnn_direct {
+
+//! whether the inputs could be passed to megdnn without relayout
+inline bool inputs_supported(const SmallVector<TensorPtr>& inputs) {
+    for (auto&& i : inputs) {
+        auto&& layout = i->layout();
+        if (layout.is_empty() || !layout.is_contiguous() ||
+            layout.dtype.category() == DTypeCategory::QUANTIZED ||
+            i->comp_node() != inputs[0]->comp_node()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! whether the op could be dispatched to megdnn with given policy
+inline bool policy_supported(const megdnn::param::ExecutionPolicy& policy) {
+    using Strategy = megdnn::param::ExecutionPolicy::Strategy;
+    return !(policy.strategy & Strategy::PROFILE);
+}
+
+//! output memory is allocated in apply_on_physical_tensor instead of planned
+//! by interpreter, so that the proxy graph is not involved
+inline std::tuple<SmallVector<MemoryDesc>, SmallVector<MemoryDesc>>
+infer_output_mem_desc(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs,
+        const SmallVector<MemoryDesc>& inputs_mems) {
+    return {{}, {}};
+}
+
+template <typename Opr, size_t... I>
+TensorPtr apply_impl(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs,
+        const typename Opr::Param& param,
+        const megdnn::param::ExecutionPolicy& policy, std::index_sequence<I...>) {
+    using Cache = DnnOprCache<Opr>;
+    auto entry = Cache::get(def, inputs, [&](Opr* opr) { opr->param() = param; });
+    auto opr = entry->caller.op.get();
+    auto cn = inputs[0]->comp_node();
+
+    TensorLayout out_layout;
+    opr->deduce_layout(inputs[I]->layout()..., out_layout);
+    auto&& plan = Cache::get_plan(*entry, policy, inputs[I]->layout()..., out_layout);
+
+    auto out = Tensor::make(out_layout, cn);
+    TensorPtr workspace;
+    megdnn::Workspace dnn_workspace;
+    if (plan.workspace_in_bytes) {
+        workspace = Tensor::make(
+                TensorLayout{{plan.workspace_in_bytes}, dtype::Byte()}, cn);
+        dnn_workspace = {
+                workspace->dev_tensor().raw_ptr(), plan.workspace_in_bytes};
+    }
+    Cache::exec(
+            opr, dnn_workspace, inputs[I]->dev_tensor().as_megdnn()...,
+            out->dev_tensor().as_megdnn());
+    return out;
+}
+
+/*!
+ * \brief apply op with single output by calling cached megdnn opr directly
+ *
+ * Caller should check inputs_supported() and policy_supported() first.
+ */
+template <typename Opr>
+TensorPtr apply(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs,
+        const typename Opr::Param& param,
+        const megdnn::param::ExecutionPolicy& policy = {}) {
+    static_assert(Opr::NR_OUTPUTS == 1, "only single output opr is supported");
+    mgb_assert(inputs.size() == Opr::NR_INPUTS);
+    return apply_impl<Opr>(
+            def, inputs, param, policy, std::make_index_sequence<Opr::NR_INPUTS>{});
+}
+
+}  // namespace dnn_direct
+
 template <size_t OSize>
 class MegDNNDynOutMallocImpl final : public megdnn::DynOutMallocPolicy {
     using Output = std::array<TensorPtr, OSize>;
@@ -38,6 +38,24 @@ auto tinfo_to_tid(SmallVector<TensorInfo*> tinfo) {
     }
     return tid;
 };
+
+//! results of host compute are mostly shapes and scalars, keep such values in one
+//! allocation with their refcount instead of going through the comp node allocator
+constexpr size_t SMALL_HOST_VALUE_SIZE = 64;
+
+HostTensorND make_small_host_value(CompNode cn, const TensorLayout& layout) {
+    struct alignas(std::max_align_t) Chunk {
+        dt_byte data[SMALL_HOST_VALUE_SIZE];
+    };
+    auto size = layout.span().dist_byte();
+    mgb_assert(size <= SMALL_HOST_VALUE_SIZE);
+    auto chunk = std::make_shared<Chunk>();
+    HostTensorStorage storage;
+    storage.reset(cn, size, {chunk, chunk->data});
+    HostTensorND ret;
+    ret.reset(storage, layout);
+    return ret;
+}
 }  // namespace
 
 namespace mgb {
@@ -182,6 +200,22 @@ TensorInfo* ChannelImpl::put_impl(
     return info;
 }
 
+TensorInfo* ChannelImpl::put_host_only(const HostTensorND& value) {
+    auto info = alloc();
+    init(info, {value.layout(), value.comp_node(), value.proxy_to_default_cpu()});
+    info->mem_desc.id = StorageIdentifier::make(++m_storage_id);
+    info->h_value = value;
+    info->host_only = true;
+    return info;
+}
+
+void ChannelImpl::ensure_device_value(TensorInfo* info) {
+    if (info->host_only) {
+        info->host_only = false;
+        m_buffer.enqueue(Put{info, info->h_value, false});
+    }
+}
+
 void ChannelImpl::del(Handle handle) {
     MGB_LOCK_GUARD(m_spin);
     if (!check_available()) {
@@ -206,6 +240,7 @@ void ChannelImpl::drop(Handle handle) {
                 m_valid_handle.find(handle) != m_valid_handle.end(),
                 "invalid handle: %p", handle);
         auto* info = reinterpret_cast<TensorInfo*>(handle);
+        ensure_device_value(info);
         m_buffer.enqueue(Drop{info});
     }
 }
@@ -247,12 +282,23 @@ void ChannelImpl::dispatch_default_cpu(
         }
     }
 
+    // outputs stay on host until some kernel reads them, see ensure_device_value.
+    // While profiling they are put as usual, so that the profiler sees them
+    // produced; host-only tensors created before are put, with the events, when
+    // their device value is needed
+    bool host_only = state.options.enable_host_only_tensor && !Profiler::is_profiling();
     outputs->reserve(output_descs.size());
     SmallVector<DeviceTensorND> output_tensornds;
     output_tensornds.reserve(output_descs.size());
     for (auto&& desc : output_descs) {
         // TODO: may conflict with condtake, which need alloc inside
         mgb_assert(!desc.layout.is_empty());
+        if (host_only && desc.layout.span().dist_byte() <= SMALL_HOST_VALUE_SIZE) {
+            output_tensornds.emplace_back(
+                    make_small_host_value(output_cn, desc.layout)
+                            .proxy_to_default_cpu());
+            continue;
+        }
         // use HostTensorND alloc_host for cuda pinned memory
         output_tensornds.emplace_back(
                 HostTensorND(output_cn, desc.layout).proxy_to_default_cpu());
@@ -268,7 +314,8 @@ void ChannelImpl::dispatch_default_cpu(
         HostTensorND host_tensornd =
                 HostTensorND::make_proxy(tensornd).proxy_to_comp_node(output_cn);
         // use `put` for consistency
-        auto info = reinterpret_cast<TensorInfo*>(put_impl(host_tensornd, false));
+        auto info = host_only ? put_host_only(host_tensornd)
+                              : put_impl(host_tensornd, false);
         mgb_assert(info->desc.layout.ndim != 0);
         output_infos.push_back(info);
         outputs->push_back(reinterpret_cast<Handle>(info));
@@ -284,6 +331,7 @@ void ChannelImpl::dispatch_default_cpu(
     MGB_RECORD_EVENT(
             OpDispatchEvent, op_id, name, op_info_getter, tinfo_to_tid(input_infos),
             tinfo_to_tid(output_infos), state.stack_manager.dump());
+    MGB_RECORD_EVENT(HostComputeEvent);
 }
 
 void ChannelImpl::dispatch_kernel(
@@ -300,6 +348,10 @@ void ChannelImpl::dispatch_kernel(
             OpDef::infer_output_attrs_fallible(*op, input_descs);
     MGB_RECORD_EVENT(ShapeInferEvent, validated);
 
+    for (auto* info : input_infos) {
+        ensure_device_value(info);
+    }
+
     ApplyOp cmd{Profiler::next_id(), std::move(op)};
     cmd.inputs = std::move(input_infos);
     cmd.outputs.reserve(output_descs.size());
@@ -397,6 +449,10 @@ HostTensorND ChannelImpl::get_value(Handle handle) {
     auto info = reinterpret_cast<TensorInfo*>(handle);
     // donnot use info->value_fetched, it's unsafe
     mgb_assert(!info->invalid, "tensor is unusable due to previous error");
+    if (info->host_only) {
+        MGB_RECORD_EVENT(TensorGetPropEvent, info->id, TensorProp::HostValue);
+        return info->h_value;
+    }
     return wait_tensor(info, TensorProp::HostValue)->get_value();
 }
 
@@ -923,6 +979,7 @@ bool ChannelImpl::check_available() {
 }
 
 TensorPtr ChannelImpl::wait_tensor(TensorInfo* info, TensorProp prop) {
+    ensure_device_value(info);
     m_buffer.flush();
     std::unique_lock<decltype(m_mutex)> lock(m_mutex);
     mgb_assert(!m_waitee, "duplicate waitee");
@@ -1322,6 +1379,105 @@ bool ChannelImpl::CommandBuffer::fuse_del(const Del& cmd) {
         return false;
     }
     std::get<ApplyOp>(apply_iter->data).dels.push_back(dest);
+    fuse_elemwise(apply_iter, dest);
+    return true;
+}
+
+/**
+ * 1. Find elemwise ApplyOp(dest) in buffered commands before pos
+ * 2. Check that inputs of producer would not be written or deleted before pos
+ * 3. Match (producer, consumer) against megdnn fused modes, the same patterns as
+ *    ArithFusePass: relu/sigmoid/tanh/h_swish(a + b) and a * b + c
+ * 4. Rewrite consumer to fused op and drop producer, dest is never computed
+ */
+bool ChannelImpl::CommandBuffer::fuse_elemwise(Handle pos, TensorInfo* dest) {
+    auto& state = m_owner->get_channel_state();
+    // dropped tensors are recomputed from their producers, and profiler expects
+    // every dispatched op to be executed
+    if (!state.options.enable_elemwise_fusion || state.options.enable_drop ||
+        state.options.enable_dtr_auto_drop || Profiler::is_profiling()) {
+        return false;
+    }
+    auto& consumer = std::get<ApplyOp>(pos->data);
+    auto producer_iter = find_produce(dest, {m_commands.begin(), pos});
+    if (producer_iter == pos) {
+        return false;
+    }
+    auto* producer = std::get_if<ApplyOp>(&producer_iter->data);
+    if (!producer || producer->outputs.size() != 1 || consumer.outputs.size() != 1 ||
+        std::count(consumer.inputs.begin(), consumer.inputs.end(), dest) != 1) {
+        return false;
+    }
+    auto* producer_op = producer->op->try_cast_final<Elemwise>();
+    auto* consumer_op = consumer.op->try_cast_final<Elemwise>();
+    if (!producer_op || !consumer_op ||
+        dest->desc.layout.dtype.category() != DTypeCategory::FLOAT) {
+        return false;
+    }
+    // the fused consumer reads the producer inputs at the consumer position, so
+    // any command in between that may write them is a barrier. The outputs of
+    // an op reading them may be views sharing their storage, so they are
+    // tracked as well
+    SmallVector<TensorInfo*> aliases = producer->inputs;
+    auto is_alias = [&aliases](TensorInfo* info) {
+        return std::count(aliases.begin(), aliases.end(), info) > 0;
+    };
+    for (auto iter = producer_iter + 1; iter != pos; ++iter) {
+        auto* apply = std::get_if<ApplyOp>(&iter->data);
+        if (!apply) {
+            return false;
+        }
+        if (std::any_of(apply->inputs.begin(), apply->inputs.end(), is_alias)) {
+            if (apply->op->dyn_typeinfo() == InplaceAdd::typeinfo()) {
+                return false;
+            }
+            aliases.insert(aliases.end(), apply->outputs.begin(), apply->outputs.end());
+        }
+        if (std::any_of(apply->dels.begin(), apply->dels.end(), is_alias)) {
+            return false;
+        }
+    }
+
+    using Mode = Elemwise::Mode;
+    Mode mode;
+    SmallVector<TensorInfo*> inputs;
+    switch (consumer_op->mode) {
+#define cb(m)                                  \
+    case Mode::m:                              \
+        if (producer_op->mode != Mode::ADD) {  \
+            return false;                      \
+        }                                      \
+        mode = Mode::FUSE_ADD_##m;             \
+        inputs = producer->inputs;             \
+        break;
+        cb(RELU) cb(SIGMOID) cb(TANH) cb(H_SWISH)
+#undef cb
+        case Mode::ADD: {
+            if (producer_op->mode != Mode::MUL) {
+                return false;
+            }
+            auto* bias = consumer.inputs[consumer.inputs[0] == dest ? 1 : 0];
+            auto&& bias_layout = bias->desc.layout;
+            // bias should not broadcast the product, see
+            // ArithFusePass::Impl::process_mul_term
+            auto same_shape = [&](TensorInfo* i) {
+                return bias_layout.ndim && i->desc.layout.eq_shape(bias_layout);
+            };
+            if (!same_shape(producer->inputs[0]) && !same_shape(producer->inputs[1])) {
+                return false;
+            }
+            mode = Mode::FUSE_MUL_ADD3;
+            inputs = {producer->inputs[0], producer->inputs[1], bias};
+            break;
+        }
+        default:
+            return false;
+    }
+    consumer.op = Elemwise::make(mode);
+    consumer.inputs = std::move(inputs);
+    consumer.dels.insert(
+            consumer.dels.end(), producer->dels.begin(), producer->dels.end());
+    m_commands.erase(producer_iter);
     return true;
 }
 
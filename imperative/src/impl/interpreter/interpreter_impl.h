@@ -86,6 +86,10 @@ private:
 
     TensorInfo* put_impl(const HostTensorND& value, bool no_cache);
     TensorInfo* put_impl(const DeviceTensorND& value, const HostTensorND& hvalue);
+    //! declare a tensor whose value only lives in h_value, see ensure_device_value
+    TensorInfo* put_host_only(const HostTensorND& value);
+    //! enqueue the deferred Put of a host-only tensor before device access
+    void ensure_device_value(TensorInfo* info);
     void del_impl(Handle);
     void sync_impl();
     SmallVector<Handle> apply_op_impl(
@@ -190,6 +194,16 @@ private:
      *     ---------------------------------------------------------------------
      *     Then the fused Apply may be invoked inplace. see:
      * ChannelImpl::process_one_task
+     *
+     * If enable_elemwise_fusion is set, an elemwise Apply whose only output has
+     * been deleted and is read only by the following elemwise Apply is merged
+     * into it, so the intermediate tensor is never allocated:
+     *     ---------------------------------------------------------------------
+     *     | Apply{ADD, in: (a, b), out: (t)}, Apply{RELU, in: (t), out: (y)}  |
+     *     | + Del{t}                                                          |
+     *     ---------------------------------------------------------------------
+     *     | Apply{FUSE_ADD_RELU, in: (a, b), out: (y), del: (t)}              |
+     *     ---------------------------------------------------------------------
      */
     struct CommandBuffer {
         CommandBuffer(ChannelImpl* owner) : m_owner(owner) {}
@@ -211,6 +225,9 @@ private:
         Handle flush_pos_for(const Command& cmd);
         // Fuse del command into suitable ApplyOp
         bool fuse_del(const Del& cmd);
+        // Merge the elemwise producer of dest into the consumer at pos, which owns
+        // the only usage of dest. Returns whether fused
+        bool fuse_elemwise(Handle pos, TensorInfo* dest);
         // Returns the last handle that dest is used within range. If dest is not used,
         // returns range[1]
         Handle find_last_usage(TensorInfo* dest, Range range);
@@ -47,6 +47,10 @@ public:
             enable_host_compute, "MEGENGINE_HOST_COMPUTE", 1,
             "enable host compute, thus computation may be done in host event if it's "
             "device is gpu.");
+    DEF_OPTION(
+            enable_host_only_tensor, "MEGENGINE_HOST_ONLY_TENSOR", 1,
+            "keep results of host compute on host until their device value is "
+            "needed, so small shape and scalar arithmetic never reaches the worker.");
     DEF_OPTION(enable_dtr_auto_drop, "MEGENGINE_DTR_AUTO_DROP", 0, "");
     DEF_OPTION(enable_dtr_sqrt_sampling, "MEGENGINE_DTR_SQRT_SAMPLING", 0, "");
     DEF_OPTION(
@@ -56,6 +60,10 @@ public:
             dtr_evictee_minimum_size, "MEGENGINE_DTR_EVICTEE_MINIMUM_SIZE", 1048576,
             "the minimum memory value of a tensor added to the candidate set");
     DEF_OPTION(record_computing_path, "MEGENGINE_RECORD_COMPUTING_PATH", 0, "");
+    DEF_OPTION(
+            enable_elemwise_fusion, "MEGENGINE_ELEMWISE_FUSION", 0,
+            "fuse buffered elemwise ops whose intermediate results are deleted into "
+            "megdnn fused modes, e.g. relu(a + b) into FUSE_ADD_RELU.");
 
 #undef DEF_OPTION
 
@@ -75,6 +75,9 @@ struct TensorInfo {
 
     // Used by HostCompute
     HostTensorND h_value;
+    // Value only lives in h_value and Put has not been sent to worker. Only
+    // visited in main thread
+    bool host_only = false;
 
     // reserved for auto drop
     size_t pinned = 0;
@@ -11,7 +11,9 @@
 
 #include "megbrain/opr/dnn/convolution.h"
 #include "megbrain/imperative/ops/autogen.h"
+#include "megbrain/imperative/proxy_graph_detail.h"
 
+#include "../dnn_op_helper.h"
 #include "../op_trait.h"
 
 namespace mgb {
@@ -31,9 +33,22 @@ auto apply_on_var_node(const OpDef& def, const VarNodeArray& inputs) {
             inputs[0], inputs[1], conv.param(), conv.policy(), config);
 }
 
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs) {
+    auto&& conv = def.cast_final_safe<Convolution>();
+    if (!dnn_direct::inputs_supported(inputs) ||
+        !dnn_direct::policy_supported(conv.policy())) {
+        return proxy_graph_detail::apply_on_physical_tensor(def, inputs);
+    }
+    return {dnn_direct::apply<megdnn::ConvolutionForward>(
+            def, inputs, conv.param(), conv.policy())};
+}
+
 OP_TRAIT_REG(Convolution, Convolution, opr::Convolution)
         .make_from_op_node(make_from_op_node)
         .apply_on_var_node(apply_on_var_node)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
+        .infer_output_mem_desc(dnn_direct::infer_output_mem_desc)
         .fallback();
 }  // namespace convolution
 }  // namespace
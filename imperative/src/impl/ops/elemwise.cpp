@@ -105,9 +105,8 @@ void apply_on_device_tensornd(
     mgb_assert(
             inputs.size() == trait.arity, "%s expects %u inputs; got %zu actually",
             trait.name, trait.arity, inputs.size());
-    auto&& dnn_opr =
-            opr::intl::create_megdnn_opr<megdnn::Elemwise>(inputs[0].comp_node());
-    opr::Elemwise::perform(op_def.mode, (*outputs)[0], inputs, dnn_opr);
+    DnnOprCaller<megdnn::Elemwise> dnn_opr(inputs[0].comp_node());
+    opr::Elemwise::perform(op_def.mode, (*outputs)[0], inputs, dnn_opr.op.ptr());
 }
 
 void execute(
@@ -57,6 +57,9 @@ std::tuple<SmallVector<MemoryDesc>, SmallVector<MemoryDesc>> infer_output_mem_de
         return {{{src_desc.layout, 0, src_desc.cn, StorageIdentifier::make(&src_desc)}},
                 {}};
     }
+    if (inputs_tensors.size() == 1) {
+        return dnn_direct::infer_output_mem_desc(def, inputs_tensors, inputs_mems);
+    }
     return proxy_graph_detail::infer_output_mem_desc(def, inputs_tensors, inputs_mems);
 }
 
@@ -69,9 +72,21 @@ void execute(
     return proxy_graph_detail::execute(def, inputs, outputs, workspace);
 }
 
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs) {
+    auto&& reduce = def.cast_final_safe<Reduce>();
+    // reduce to target shape is left to proxy graph
+    if (inputs.size() != 1 || !dnn_direct::inputs_supported(inputs) ||
+        reduce.axis < 0 || size_t(reduce.axis) >= inputs[0]->layout().ndim) {
+        return proxy_graph_detail::apply_on_physical_tensor(def, inputs);
+    }
+    return {dnn_direct::apply<megdnn::ReduceForward>(def, inputs, reduce.param())};
+}
+
 OP_TRAIT_REG(Reduce, Reduce, opr::Reduce)
         .make_from_op_node(make_from_op_node)
         .apply_on_var_node(apply_on_var_node)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
         .infer_output_mem_desc(infer_output_mem_desc)
         .execute(execute)
         .fallback();
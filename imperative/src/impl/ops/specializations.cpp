@@ -13,6 +13,7 @@
 // FIXME: split this file into separate files for each specialized op
 
 #include "megbrain/imperative/ops/autogen.h"
+#include "megbrain/imperative/proxy_graph_detail.h"
 #include "megbrain/opr/basic_arith.h"
 #include "megbrain/opr/blas.h"
 #include "megbrain/opr/dnn/adaptive_pooling.h"
@@ -38,6 +39,7 @@
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/opr/utility.h"
 
+#include "../dnn_op_helper.h"
 #include "../op_trait.h"
 
 namespace mgb::imperative {
@@ -185,7 +187,21 @@ auto apply_on_var_node(const OpDef& def, const VarNodeArray& inputs) {
     OperatorNodeConfig config{pool.make_name()};
     return opr::Pooling::make(inputs[0], pool.param(), pool.policy(), config);
 }
-OP_TRAIT_REG(Pooling, Pooling).apply_on_var_node(apply_on_var_node).fallback();
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs) {
+    auto&& pool = def.cast_final_safe<Pooling>();
+    if (!dnn_direct::inputs_supported(inputs) ||
+        !dnn_direct::policy_supported(pool.policy())) {
+        return proxy_graph_detail::apply_on_physical_tensor(def, inputs);
+    }
+    return {dnn_direct::apply<megdnn::PoolingForward>(
+            def, inputs, pool.param(), pool.policy())};
+}
+OP_TRAIT_REG(Pooling, Pooling)
+        .apply_on_var_node(apply_on_var_node)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
+        .infer_output_mem_desc(dnn_direct::infer_output_mem_desc)
+        .fallback();
 }  // namespace pooling
 }  // namespace
 
@@ -198,7 +214,21 @@ auto apply_on_var_node(const OpDef& def, const VarNodeArray& inputs) {
     return opr::MatrixMul::make(
             inputs[0], inputs[1], matmul.param(), matmul.policy(), config);
 }
-OP_TRAIT_REG(MatrixMul, MatrixMul).apply_on_var_node(apply_on_var_node).fallback();
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs) {
+    auto&& matmul = def.cast_final_safe<MatrixMul>();
+    if (!dnn_direct::inputs_supported(inputs) ||
+        !dnn_direct::policy_supported(matmul.policy())) {
+        return proxy_graph_detail::apply_on_physical_tensor(def, inputs);
+    }
+    return {dnn_direct::apply<megdnn::MatrixMulForward>(
+            def, inputs, matmul.param(), matmul.policy())};
+}
+OP_TRAIT_REG(MatrixMul, MatrixMul)
+        .apply_on_var_node(apply_on_var_node)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
+        .infer_output_mem_desc(dnn_direct::infer_output_mem_desc)
+        .fallback();
 }  // namespace matrix_mul
 }  // namespace
 
@@ -211,8 +241,20 @@ auto apply_on_var_node(const OpDef& def, const VarNodeArray& inputs) {
     return opr::BatchedMatrixMul::make(
             inputs[0], inputs[1], matmul.param(), matmul.policy(), config);
 }
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs) {
+    auto&& matmul = def.cast_final_safe<BatchedMatrixMul>();
+    if (!dnn_direct::inputs_supported(inputs) ||
+        !dnn_direct::policy_supported(matmul.policy())) {
+        return proxy_graph_detail::apply_on_physical_tensor(def, inputs);
+    }
+    return {dnn_direct::apply<megdnn::BatchedMatrixMulForward>(
+            def, inputs, matmul.param(), matmul.policy())};
+}
 OP_TRAIT_REG(BatchedMatrixMul, BatchedMatrixMul)
         .apply_on_var_node(apply_on_var_node)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
+        .infer_output_mem_desc(dnn_direct::infer_output_mem_desc)
         .fallback();
 }  // namespace batched_matrix_mul
 }  // namespace
@@ -307,6 +349,28 @@ OP_TRAIT_REG(IndexingSetOneHot, IndexingSetOneHot)
         .apply_on_var_node(apply_on_var_node)
         .fallback();
 }  // namespace indexing_set_one_hot
+
+namespace embedding_bag {
+auto apply_on_var_node(const OpDef& def, const VarNodeArray& inputs) {
+    auto&& op = static_cast<const EmbeddingBag&>(def);
+    mgb_assert(inputs.size() == 3 || inputs.size() == 4);
+    OperatorNodeConfig config{op.make_name()};
+    return opr::EmbeddingBag::make(inputs, op.param(), config);
+}
+OP_TRAIT_REG(EmbeddingBag, EmbeddingBag).apply_on_var_node(apply_on_var_node).fallback();
+}  // namespace embedding_bag
+
+namespace embedding_bag_backward {
+auto apply_on_var_node(const OpDef& def, const VarNodeArray& inputs) {
+    auto&& op = static_cast<const EmbeddingBagBackward&>(def);
+    mgb_assert(inputs.size() == 4 || inputs.size() == 5);
+    OperatorNodeConfig config{op.make_name()};
+    return opr::EmbeddingBagBackward::make(inputs, op.param(), config);
+}
+OP_TRAIT_REG(EmbeddingBagBackward, EmbeddingBagBackward)
+        .apply_on_var_node(apply_on_var_node)
+        .fallback();
+}  // namespace embedding_bag_backward
 }  // namespace
 
 namespace {
@@ -148,6 +148,9 @@ DEF_EVENT(WorkerException, {});
 
 DEF_EVENT(ShapeInfer, { bool success; });
 
+// op computed on caller thread
+DEF_EVENT(HostCompute, {});
+
 DEF_DUR_EVENT(Scope, { std::string name; });
 
 DEF_DUR_EVENT(Sync, { Trace trace; });
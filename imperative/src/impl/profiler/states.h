@@ -267,11 +267,11 @@ public:
                 TensorReleaseEvent, TensorEraseEvent, TensorGetPropEvent,
                 TensorNotifyPropEvent, TensorWaitPropEvent, TensorWaitPropFinishEvent,
                 SampleDeviceEvent, SampleDeviceFinishEvent, WorkerExceptionEvent,
-                ShapeInferEvent, SyncEvent, SyncFinishEvent, StartProfileEvent,
-                StartProfileFinishEvent, StopProfileEvent, StopProfileFinishEvent,
-                TensorCommandEvent, TensorCommandFinishEvent, AutoEvictEvent,
-                AutoEvictFinishEvent, CustomEvent, CustomFinishEvent, RecordDeviceEvent,
-                ScopeEvent, ScopeFinishEvent, HostToDeviceEvent,
+                ShapeInferEvent, HostComputeEvent, SyncEvent, SyncFinishEvent,
+                StartProfileEvent, StartProfileFinishEvent, StopProfileEvent,
+                StopProfileFinishEvent, TensorCommandEvent, TensorCommandFinishEvent,
+                AutoEvictEvent, AutoEvictFinishEvent, CustomEvent, CustomFinishEvent,
+                RecordDeviceEvent, ScopeEvent, ScopeFinishEvent, HostToDeviceEvent,
                 HostToDeviceFinishEvent>
                 converter;
 
@@ -390,6 +390,10 @@ public:
                 if (!event.success) {
                     inc_counter("nr_shape_infer_failure", 1);
                 }
+            } else if constexpr (std::is_same_v<T, HostComputeEvent>) {
+                // host computed ops would never be executed by worker
+                inc_counter("nr_op_pending", -1);
+                inc_counter("nr_host_compute_op", 1);
             } else if constexpr (std::is_same_v<T, WorkerExceptionEvent>) {
                 inc_counter("nr_exception", 1);
             } else if constexpr (std::is_same_v<T, KernelLaunchFinishEvent>) {
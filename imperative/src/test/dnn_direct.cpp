@@ -0,0 +1,124 @@
+/**
+ * \file imperative/src/test/dnn_direct.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "./helper.h"
+#include "../impl/dnn_op_helper.h"
+#include "megbrain/imperative/ops/autogen.h"
+#include "megbrain/imperative/proxy_graph_detail.h"
+#include "megbrain/utils/timer.h"
+
+using namespace mgb;
+using namespace imperative;
+
+namespace {
+
+using Policy = megdnn::param::ExecutionPolicy;
+
+struct DirectCase {
+    const char* name;
+    std::shared_ptr<OpDef> op;
+    TensorShapeArray shapes;
+};
+
+std::vector<DirectCase> make_cases(size_t n) {
+    megdnn::param::Convolution conv;
+    conv.pad_h = conv.pad_w = 1;
+    megdnn::param::Pooling pool;
+    pool.window_h = pool.window_w = pool.stride_h = pool.stride_w = 2;
+    megdnn::param::MatrixMul matmul;
+    matmul.transposeB = true;
+    megdnn::param::Reduce reduce{megdnn::param::Reduce::Mode::SUM, 1};
+    return {{"Convolution",
+             Convolution::make(conv, Policy{}),
+             {{n, 3, 8, 8}, {4, 3, 3, 3}}},
+            {"Pooling", Pooling::make(pool, Policy{}), {{n, 3, 8, 8}}},
+            {"MatrixMul", MatrixMul::make(matmul, Policy{}), {{n, 16}, {8, 16}}},
+            {"BatchedMatrixMul",
+             BatchedMatrixMul::make(megdnn::param::MatrixMul{}, Policy{}),
+             {{n, 4, 16}, {n, 16, 8}}},
+            {"Reduce", Reduce::make(reduce), {{n, 5, 7}}}};
+}
+
+}  // anonymous namespace
+
+TEST(TestImperative, DnnDirectDispatch) {
+    for (size_t n : {1, 3}) {
+        for (auto&& i : make_cases(n)) {
+            std::vector<OprChecker::InputSpec> inputs(i.shapes.begin(), i.shapes.end());
+            // run twice to check the cached opr and plan
+            OprChecker(i.op).run(inputs);
+            OprChecker(i.op).run(inputs);
+        }
+    }
+}
+
+TEST(TestImperative, DnnDirectCacheBounded) {
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("xpu0");
+
+    // each distinct param gets its own opr, which is evicted when there are
+    // too many
+    using ConvCache = DnnOprCache<megdnn::ConvolutionForward>;
+    SmallVector<TensorPtr> conv_inputs{
+            Tensor::make(*gen({1, 2, 4, 4}, cn)), Tensor::make(*gen({2, 2, 3, 3}, cn))};
+    for (size_t i = 0; i < ConvCache::MAX_NR_ENTRIES + 8; ++i) {
+        megdnn::param::Convolution param;
+        param.pad_h = i;
+        OpDef::apply_on_physical_tensor(
+                *Convolution::make(param, Policy{}), conv_inputs);
+        ASSERT_LE(ConvCache::nr_entries(), ConvCache::MAX_NR_ENTRIES);
+    }
+
+    // each distinct layout gets its own plan in the opr
+    using MatMulCache = DnnOprCache<megdnn::MatrixMulForward>;
+    auto matmul = MatrixMul::make(megdnn::param::MatrixMul{}, Policy{});
+    auto rhs = Tensor::make(*gen({8, 4}, cn));
+    for (size_t n = 1; n <= MatMulCache::MAX_NR_PLANS + 8; ++n) {
+        SmallVector<TensorPtr> inputs{Tensor::make(*gen({n, 8}, cn)), rhs};
+        OpDef::apply_on_physical_tensor(*matmul, inputs);
+        auto entry = MatMulCache::get(*matmul, inputs, [](auto*) {});
+        ASSERT_LE(entry->plans.size(), MatMulCache::MAX_NR_PLANS);
+    }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST(TestImperative, BENCHMARK_DNN_DIRECT_DISPATCH) {
+    constexpr size_t RUNS = 500;
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("xpu0");
+    for (auto&& i : make_cases(2)) {
+        SmallVector<TensorPtr> inputs;
+        for (auto&& shape : i.shapes) {
+            inputs.push_back(Tensor::make(*gen(shape, cn)));
+        }
+        auto bench = [&](auto&& apply) {
+            apply(*i.op, inputs);
+            cn.sync();
+            RealTimer timer;
+            for (size_t j = 0; j < RUNS; ++j) {
+                apply(*i.op, inputs);
+            }
+            cn.sync();
+            return timer.get_msecs() * 1e3 / RUNS;
+        };
+        auto time_proxy = bench([](const OpDef& def, SmallVector<TensorPtr> inputs) {
+            return proxy_graph_detail::apply_on_physical_tensor(def, inputs);
+        });
+        auto time_direct = bench([](const OpDef& def, SmallVector<TensorPtr> inputs) {
+            return OpDef::apply_on_physical_tensor(def, inputs);
+        });
+        mgb_log("%s: proxy_graph=%.2fus direct=%.2fus speedup=%.2f", i.name,
+                time_proxy, time_direct, time_proxy / time_direct);
+    }
+}
+#endif
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -54,9 +54,19 @@ LITE_API inline LiteAlgoSelectStrategy operator|(
  * \param force_output_dynamic_alloc force dynamic memory alloc for output vars
  * which are used as CallbackCaller input when call compile() function
  *
+ * \param output_memory_pool let the network write the host outputs directly
+ * into buffers of a pool owned by lite. Each forward binds new buffers to the
+ * output tensors, and a buffer returns to the pool once the output tensor
+ * holding it is released, so the caller can keep the outputs of several
+ * forwards without copying them. The output tensors have to be got again
+ * after each forward, and the output shapes must be static.
+ *
  * \param no_profiling_on_shape_change do not re-profile to select best impl
  * algo when input shape changes (use previous algo)
  *
+ * \param deterministic make the outputs bitwise identical regardless of the
+ * number of threads, at some cost of throughput
+ *
  * \param jit_level Execute supported operators with JIT (support MLIR,
  * NVRTC). Can only be used on Nvidia GPUs, this value indicates JIT level:
  * 1 for basic elemwise opr;
@@ -94,7 +104,9 @@ struct LITE_API Options {
     bool force_dynamic_alloc = false;
     bool force_output_dynamic_alloc = false;
     bool force_output_use_user_specified_memory = false;
+    bool output_memory_pool = false;
     bool no_profiling_on_shape_change = false;
+    bool deterministic = false;
     uint8_t jit_level = 0;
     uint8_t comp_node_seq_record_level = 0;
     uint8_t graph_opt_level = 2;
@@ -178,6 +190,28 @@ public:
     virtual void free(LiteDeviceType device_type, int device_id, void* ptr) = 0;
 };
 
+/*!
+ * \brief the scheduling statistics of a network, which is used for latency
+ * monitoring when several networks with different priorities run together,
+ * all the time is in milliseconds
+ */
+struct LITE_API ScheduleStats {
+    //! number of finished forward
+    size_t nr_forward = 0;
+    //! number of times paused by networks with higher priority after started
+    size_t nr_preempted = 0;
+    //! number of forward finished later than the deadline
+    size_t nr_deadline_miss = 0;
+    //! total time waiting for networks with higher priority before the
+    //! forward is submitted
+    double queue_time_ms = 0;
+    //! total time paused by networks with higher priority after started
+    double preempted_time_ms = 0;
+    //! total and max time from forward to the end of the forward
+    double total_latency_ms = 0;
+    double max_latency_ms = 0;
+};
+
 /*!
  * \brief the thread affinith callback type
  * \param thread_id thread_id is the a number begin from 0 to (nr_threads - 1),
@@ -362,12 +396,100 @@ public:
     static void enable_io_bin_dump(
             std::shared_ptr<Network> dst_network, std::string io_bin_out_dir);
 
+    //! set the scheduling priority and deadline of the network, after that the
+    //! network yields at operator boundaries to other scheduled networks with
+    //! higher priority, or with the same priority and an earlier deadline.
+    //! It takes effect at the next forward of the network.
+    //! deadline_us: the latency requirement of each forward in microseconds,
+    //!              zero means no deadline
+    static void set_network_schedule_priority(
+            std::shared_ptr<Network> dst_network, int priority,
+            uint32_t deadline_us = 0);
+
+    //! get the scheduling statistics of the network
+    static ScheduleStats get_network_schedule_stats(
+            std::shared_ptr<Network> dst_network);
+
     //! load a new network which will share weights with src network
     static void shared_weight_with_network(
             std::shared_ptr<Network> dst_network,
             const std::shared_ptr<Network> src_network);
 };
 
+/*!
+ * \brief the options used by NetworkSwapper to load and warm up a new network
+ *
+ * \param prepare called with the new network before the model is loaded, it
+ * can be used to set the runtime options, such as threads number, algo policy
+ * or memory allocator, which must be set before loading
+ *
+ * \param warmup_input called to fill the inputs before each warm-up forward,
+ * the inputs are filled with zero if it is not set
+ *
+ * \param nr_warmup number of forward run in the background before the new
+ * network is swapped in, the first forward compiles the graph, selects the algos
+ * and allocates the runtime memory
+ *
+ * \param persistent_cache_path if not empty, the persistent cache is dumped to
+ * the path after warm-up, so that the algos profiled by the new network can be
+ * reused by the next load
+ */
+struct LITE_API SwapOptions {
+    std::function<void(std::shared_ptr<Network>)> prepare;
+    std::function<void(std::shared_ptr<Network>)> warmup_input;
+    size_t nr_warmup = 1;
+    std::string persistent_cache_path;
+};
+
+/*!
+ * \brief hold the serving version of a network and replace it with a new
+ * version without blocking the requests
+ *
+ * The new version is loaded and warmed up in a background thread, then it is
+ * swapped in atomically, requests acquired after the swap use the new version
+ * while the in-flight requests finish on the old one, which is destroyed when
+ * the last request holding it is released. At most one swap is in progress at
+ * the same time.
+ */
+class LITE_API NetworkSwapper {
+public:
+    explicit NetworkSwapper(std::shared_ptr<Network> network);
+    ~NetworkSwapper();
+
+    NetworkSwapper(const NetworkSwapper&) = delete;
+    NetworkSwapper& operator=(const NetworkSwapper&) = delete;
+
+    //! get the current version for a request, the returned network should be
+    //! held until the request finishes
+    std::shared_ptr<Network> acquire() const;
+
+    //! start to load the model and warm it up in the background, return false
+    //! if the previous swap is not finished
+    bool swap_async(
+            const std::string& model_path, const Config& config = {},
+            const NetworkIO& network_io = {}, const SwapOptions& options = {});
+
+    //! wait until the background swap finishes, return whether the swap
+    //! succeeded, if no swap is started, return true
+    bool wait_swap();
+
+    //! whether the background swap is still running
+    bool is_swapping() const;
+
+    //! the number of finished swaps
+    size_t version() const;
+
+    //! the error message of the last failed swap
+    std::string last_error() const;
+
+    //! whether all the requests on the previous versions are finished
+    bool is_old_version_released() const;
+
+private:
+    struct State;
+    std::shared_ptr<State> m_state;
+};
+
 }  // namespace lite
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
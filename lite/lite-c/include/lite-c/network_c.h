@@ -44,9 +44,20 @@ extern "C" {
  * \param force_output_dynamic_alloc force dynamic memory alloc for output vars
  * which are used as CallbackCaller input when call compile() function
  *
+ * \param output_memory_pool let the network write the host outputs directly
+ * into buffers of a pool owned by lite. Each forward binds new buffers to the
+ * output tensors, and a buffer returns to the pool once the output tensor
+ * holding it is released, so the caller can keep the outputs of several
+ * forwards without copying them. The output tensors have to be got again
+ * after each forward, and the output shapes must be static. Every output got
+ * by LITE_get_io_tensor must be released with LITE_destroy_tensor.
+ *
  * \param no_profiling_on_shape_change do not re-profile to select best impl
  * algo when input shape changes (use previous algo)
  *
+ * \param deterministic make the outputs bitwise identical regardless of the
+ * number of threads, at some cost of throughput
+ *
  * \param jit_level Execute supported operators with JIT (support MLIR,
  * NVRTC). Can only be used on Nvidia GPUs, this value indicates JIT level:
  * 1 for basic elemwise opr;
@@ -84,7 +95,9 @@ typedef struct Options {
     int force_dynamic_alloc;
     int force_output_dynamic_alloc;
     int force_output_use_user_specified_memory;
+    int output_memory_pool;
     int no_profiling_on_shape_change;
+    int deterministic;
     int jit_level;
     int comp_node_seq_record_level;
     int graph_opt_level;
@@ -289,6 +302,10 @@ LITE_API int LITE_wait(const LiteNetwork network);
  * \param[in] io_name The input or output name
  * \param[in] phase The tensor phase
  * \param[out] tensor The IO tensor get from the network
+ *
+ * \note when output_memory_pool is set, an output tensor got by this function
+ * owns its buffer and stays valid after later forwards, it must be released by
+ * LITE_destroy_tensor
  */
 LITE_API int LITE_get_io_tensor(
         LiteNetwork network, const char* io_name, LiteTensorPhase phase,
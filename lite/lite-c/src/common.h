@@ -34,6 +34,10 @@ lite::Config convert_to_lite_config(const LiteConfig c_config);
 //! convert C NetworkIO io to lite::NetworkIO
 lite::NetworkIO convert_to_lite_io(const LiteNetworkIO c_network_io);
 
+//! keep the tensor alive until the returned handle is passed to
+//! LITE_destroy_tensor
+LiteTensor hold_tensor(std::shared_ptr<lite::Tensor> tensor);
+
 /*!
  * \brief handle exception
  * \param e the exception
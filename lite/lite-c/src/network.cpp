@@ -16,6 +16,7 @@
 #include "../../src/network_impl_base.h"
 
 #include <string.h>
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -30,7 +31,9 @@ const LiteOptions default_option = {
         .force_dynamic_alloc = false,
         .force_output_dynamic_alloc = false,
         .force_output_use_user_specified_memory = false,
+        .output_memory_pool = false,
         .no_profiling_on_shape_change = false,
+        .deterministic = false,
         .jit_level = 0,
         .comp_node_seq_record_level = 0,
         .graph_opt_level = 2,
@@ -126,10 +129,12 @@ lite::Config convert_to_lite_config(const LiteConfig c_config) {
     lite_config.options.force_dynamic_alloc = c_config.options.force_dynamic_alloc;
     lite_config.options.force_output_use_user_specified_memory =
             c_config.options.force_output_use_user_specified_memory;
+    lite_config.options.output_memory_pool = c_config.options.output_memory_pool;
     lite_config.options.force_output_dynamic_alloc =
             c_config.options.force_output_dynamic_alloc;
     lite_config.options.no_profiling_on_shape_change =
             c_config.options.no_profiling_on_shape_change;
+    lite_config.options.deterministic = c_config.options.deterministic;
     lite_config.options.jit_level = c_config.options.jit_level;
     lite_config.options.comp_node_seq_record_level =
             c_config.options.comp_node_seq_record_level;
@@ -242,9 +247,20 @@ int LITE_get_io_tensor(
         LiteTensor* tensor) {
     LITE_CAPI_BEGIN();
     LITE_ASSERT(network, "The network pass to LITE api is null");
-    auto io_tensor =
-            static_cast<lite::Network*>(network)->get_io_tensor(io_name, phase);
+    auto lite_network = static_cast<lite::Network*>(network);
+    auto io_tensor = lite_network->get_io_tensor(io_name, phase);
     *tensor = io_tensor.get();
+    if (phase != LiteTensorPhase::LITE_INPUT &&
+        lite::NetworkHelper::config(lite_network).options.output_memory_pool) {
+        //! the network drops its pooled outputs at the next forward, so hand
+        //! out a handle owning the output buffer, released by the caller
+        auto names = lite_network->get_all_output_name();
+        if (std::find(names.begin(), names.end(), io_name) != names.end() &&
+            lite_network->get_io_tensor(io_name, LiteTensorPhase::LITE_OUTPUT) ==
+                    io_tensor) {
+            *tensor = hold_tensor(std::make_shared<lite::Tensor>(*io_tensor));
+        }
+    }
     LITE_CAPI_END();
 }
 
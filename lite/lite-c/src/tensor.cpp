@@ -40,6 +40,13 @@ std::unordered_map<std::string, lite::LiteAny>& get_global_tensor_attr_holder()
 }
 }  // namespace
 
+LiteTensor hold_tensor(std::shared_ptr<lite::Tensor> tensor) {
+    LITE_LOCK_GUARD(mtx_tensor);
+    auto handle = tensor.get();
+    get_global_tensor_holder()[handle] = std::move(tensor);
+    return handle;
+}
+
 //! convert the lite::Layout to Layout
 LiteLayout convert_to_clayout(const lite::Layout& layout) {
     LiteLayout clayout;
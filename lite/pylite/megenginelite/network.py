@@ -30,7 +30,9 @@ class LiteOptions(Structure):
         ("force_dynamic_alloc", c_int),
         ("force_output_dynamic_alloc", c_int),
         ("force_output_use_user_specified_memory", c_int),
+        ("output_memory_pool", c_int),
         ("no_profiling_on_shape_change", c_int),
+        ("deterministic", c_int),
         ("jit_level", c_int),
         ("comp_node_seq_record_level", c_int),
         ("graph_opt_level", c_int),
@@ -54,7 +56,9 @@ class LiteOptions(Structure):
         self.force_dynamic_alloc = False
         self.force_output_dynamic_alloc = False
         self.force_output_use_user_specified_memory = False
+        self.output_memory_pool = False
         self.no_profiling_on_shape_change = False
+        self.deterministic = False
         self.jit_level = 0
         self.comp_node_seq_record_level = 0
         self.graph_opt_level = 2
@@ -70,7 +74,9 @@ class LiteOptions(Structure):
             "force_dynamic_alloc": bool(self.force_dynamic_alloc),
             "force_output_dynamic_alloc": bool(self.force_output_dynamic_alloc),
             "force_output_nocopy": bool(self.force_output_nocopy),
+            "output_memory_pool": bool(self.output_memory_pool),
             "no_profiling_on_shape_change": bool(self.no_profiling_on_shape_change),
+            "deterministic": bool(self.deterministic),
             "jit_level": self.jit_level,
             "comp_node_seq_record_level": self.comp_node_seq_record_level,
             "graph_opt_level": self.graph_opt_level,
@@ -205,6 +205,26 @@ class TestNetwork(TestShuffleNet):
 
         self.do_forward(network)
 
+    def test_network_output_memory_pool(self):
+        option = LiteOptions()
+        option.output_memory_pool = 1
+
+        config = LiteConfig(option=option)
+        network = LiteNetwork(config=config)
+        network.load(self.model_path)
+
+        input_tensor = network.get_io_tensor(network.get_input_name(0))
+        input_tensor.set_data_by_copy(self.input_data)
+        output_name = network.get_output_name(0)
+        network.forward()
+        network.wait()
+        prev_output = network.get_io_tensor(output_name)
+        network.forward()
+        network.wait()
+        output = network.get_io_tensor(output_name)
+        self.check_correct(output.to_numpy())
+        self.check_correct(prev_output.to_numpy())
+
     def test_network_reset_io(self):
         option = LiteOptions()
         option.var_sanity_check_first_run = 0
@@ -144,6 +144,25 @@ inline bool call_func<NetworkImplDft, bool>(
     THROW_FUNC_ERROR(func_name);
 }
 
+template <>
+inline ScheduleStats call_func<NetworkImplDft, ScheduleStats>(
+        std::string func_name, Network::NetworkImplBase* network_impl) {
+    if (func_name == "get_schedule_stats") {
+        return CALL_FUNC(get_schedule_stats);
+    }
+    THROW_FUNC_ERROR(func_name);
+}
+
+template <>
+inline void call_func<NetworkImplDft, void>(
+        std::string func_name, Network::NetworkImplBase* network_impl, int priority,
+        uint32_t deadline_us) {
+    if (func_name == "set_schedule_priority") {
+        return CALL_FUNC(set_schedule_priority, priority, deadline_us);
+    }
+    THROW_FUNC_ERROR(func_name);
+}
+
 template <>
 inline void call_func<NetworkImplDft, void>(
         std::string func_name, Network::NetworkImplBase* network_impl,
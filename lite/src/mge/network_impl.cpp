@@ -25,6 +25,7 @@
 #include "megbrain/gopt/inference.h"
 #include "megbrain/graph.h"
 #include "megbrain/graph/cg.h"
+#include "megbrain/graph/event.h"
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/tensor.h"
@@ -88,7 +89,12 @@ void NetworkImplDft::application_config() {
     ConfigOption(
             force_output_use_user_specified_memory,
             force_output_use_user_specified_memory);
+    //! the pooled outputs are written in place like the user specified ones
+    if (m_user_config->options.output_memory_pool) {
+        options.force_output_use_user_specified_memory = true;
+    }
     ConfigOption(no_profiling_on_shape_change, no_profiling_on_shape_change);
+    ConfigOption(deterministic, deterministic);
     LITE_ASSERT(
             m_user_config->options.jit_level == 0 ||
                     (m_user_config->options.jit_level > 0 &&
@@ -251,6 +257,7 @@ void NetworkImplDft::make_output_spec() {
             };
             //! if write to user-specified memory, the CallbackCaller must be nullptr.
             if (m_user_config->options.force_output_use_user_specified_memory ||
+                m_user_config->options.output_memory_pool ||
                 m_user_config->options.force_output_dynamic_alloc) {
                 m_output_spec.emplace_back(load_out, nullptr);
             } else {
@@ -341,7 +348,24 @@ void NetworkImplDft::cross_compnode_model_detect() {
 
 void NetworkImplDft::adapt_option_valid() {
     auto&& options = m_load_config.comp_graph->options();
-    if (m_user_config->options.force_output_use_user_specified_memory) {
+    auto&& user_options = m_user_config->options;
+    if (user_options.output_memory_pool) {
+        LITE_ASSERT(
+                !user_options.force_output_use_user_specified_memory &&
+                        !user_options.force_output_dynamic_alloc,
+                "output_memory_pool can't be used with "
+                "force_output_use_user_specified_memory or "
+                "force_output_dynamic_alloc.");
+        LITE_ASSERT(
+                user_options.comp_node_seq_record_level < 2,
+                "output_memory_pool can't be used when comp_node_seq_record_level "
+                "is 2.");
+    }
+    if (user_options.force_output_use_user_specified_memory ||
+        user_options.output_memory_pool) {
+        const char* option_name = user_options.output_memory_pool
+                                        ? "output_memory_pool"
+                                        : "force_output_use_user_specified_memory";
         for (auto&& out : m_load_result.output_var_list) {
             auto opr = out.node()->owner_opr();
             //! all the dest operator inherit from ReadonlyFwdHelper can't
@@ -351,13 +375,13 @@ void NetworkImplDft::adapt_option_valid() {
                 opr->try_cast_final<mgb::opr::Subtensor>() ||
                 opr->try_cast_final<mgb::opr::AxisAddRemove>() ||
                 opr->try_cast_final<mgb::opr::Dimshuffle>()) {
-                m_user_config->options.force_output_use_user_specified_memory = false;
+                user_options.force_output_use_user_specified_memory = false;
+                user_options.output_memory_pool = false;
                 options.force_output_use_user_specified_memory = false;
                 LITE_WARN(
                         "detect the unsupported dest operator %s when config "
-                        "force_output_use_user_specified_memory, set "
-                        "force_output_use_user_specified_memory to false\n",
-                        opr->cname());
+                        "%s, set %s to false\n",
+                        opr->cname(), option_name, option_name);
                 break;
             }
         }
@@ -418,6 +442,8 @@ void NetworkImplDft::compile_graph() {
     replace_dev_input_pass();
     make_output_spec();
     m_execute_func = m_load_result.graph_compile(m_output_spec);
+    m_schedule_handler.reset();
+    enable_schedule_hook();
 }
 
 void NetworkImplDft::start() const {
@@ -441,17 +467,41 @@ void NetworkImplDft::forward() {
         m_load_config.comp_graph.reset();
     }
     LITE_ASSERT(m_execute_func, "forward must be called after network loaded.");
-    m_execute_func->execute();
+    if (m_output_pool) {
+        bind_pooled_outputs();
+    }
+    if (m_schedule_client) {
+        NetworkScheduler::inst().begin(m_schedule_client.get());
+    }
+    try {
+        NetworkScheduler::SubmitScope submit_scope{m_schedule_client.get()};
+        m_execute_func->execute();
+    } catch (...) {
+        end_schedule();
+        throw;
+    }
 }
 
 void NetworkImplDft::wait() {
     if (!m_async) {
-        m_execute_func->wait();
+        try {
+            m_execute_func->wait();
+        } catch (...) {
+            end_schedule();
+            throw;
+        }
     }
     finish();
 }
 
+void NetworkImplDft::end_schedule() const {
+    if (m_schedule_client) {
+        NetworkScheduler::inst().end(m_schedule_client.get());
+    }
+}
+
 void NetworkImplDft::finish() const {
+    end_schedule();
     if (m_async) {
         LITE_ASSERT(m_async_callback, "The callback func must set when async mode.");
         m_async_callback();
@@ -493,6 +543,10 @@ void NetworkImplDft::try_infer_tensor_layout(std::shared_ptr<Tensor> tensor, Var
                     !m_user_config->options.force_output_use_user_specified_memory,
                     "force_output_use_user_specified_memory can't be used when output "
                     "shape can't be derived.");
+            LITE_ASSERT(
+                    !m_user_config->options.output_memory_pool,
+                    "output_memory_pool can't be used when output shape can't be "
+                    "derived.");
             return;
         }
         Layout layout = to_lite_layout(TensorLayout{*shape, var.dtype()});
@@ -676,6 +730,50 @@ void NetworkImplDft::update_output() {
                     m_user_config->options.comp_node_seq_record_level > 0;
         }
     }
+    if (m_user_config->options.output_memory_pool) {
+        for (auto&& out : m_network_io->outputs) {
+            LITE_ASSERT(
+                    out.is_host,
+                    "output_memory_pool only supports host output, but %s is a "
+                    "device output.",
+                    out.name.c_str());
+        }
+        m_output_pool = OutputMemoryPool::make();
+    }
+}
+
+void NetworkImplDft::bind_pooled_outputs() {
+    auto device_type = m_user_config->device_type;
+    auto device_id = m_compnode_locator.device;
+    auto stream_id = m_compnode_locator.stream;
+    auto&& static_infer_mgr = m_load_config.comp_graph->static_infer_manager();
+    for (auto&& out : m_network_io->outputs) {
+        auto iter = std::find_if(
+                m_load_result.output_var_list.begin(),
+                m_load_result.output_var_list.end(),
+                [&out](const SymbolVar var) { return var.node()->name() == out.name; });
+        LITE_ASSERT(iter != m_load_result.output_var_list.end());
+        Var var = *iter;
+        //! drop the reference held by the network, so the buffer of the last
+        //! forward goes back to the pool once the caller releases it
+        out.lite_tensor.reset();
+        auto shape = static_infer_mgr.infer_shape_fallible(var.node());
+        LITE_ASSERT(
+                shape,
+                "output_memory_pool can't be used when the shape of output %s "
+                "can't be derived.",
+                out.name.c_str());
+        auto tensor = std::make_shared<Tensor>(device_id, stream_id, device_type, true);
+        tensor->set_layout(to_lite_layout(TensorLayout{*shape, var.dtype()}));
+        output_tensor_copy_optimize(var, tensor);
+        auto&& impl = TensorHelper::implement(tensor)->cast_final_safe<TensorImplDft>();
+        auto host_tensor = impl.host_tensor();
+        impl.reset(m_output_pool->alloc(
+                host_tensor->comp_node(), host_tensor->layout().span().dist_byte()));
+        impl.m_record_reset = m_user_config->options.comp_node_seq_record_level > 0;
+        tensor->update_from_implement();
+        out.lite_tensor = std::move(tensor);
+    }
 }
 
 void NetworkImplDft::output_tensor_copy_optimize(
@@ -685,7 +783,8 @@ void NetworkImplDft::output_tensor_copy_optimize(
               m_user_config->options.force_output_dynamic_alloc),
             "Can't set force_output_use_user_specified_memory and "
             "force_output_dynamic_alloc at the same time.");
-    if (m_user_config->options.force_output_use_user_specified_memory) {
+    if (m_user_config->options.force_output_use_user_specified_memory ||
+        m_user_config->options.output_memory_pool) {
         bool in_record = m_user_config->options.comp_node_seq_record_level > 0;
         TensorHelper::implement(tensor)
                 ->cast_final_safe<TensorImplDft>()
@@ -845,6 +944,53 @@ const char* NetworkImplDft::get_input_name(size_t index) const {
 }
 
 //! Plugin part
+void NetworkImplDft::set_schedule_priority(int priority, uint32_t deadline_us) {
+    if (m_schedule_client) {
+        m_schedule_client->set_policy(priority, deadline_us);
+    } else {
+        m_schedule_client =
+                std::make_shared<NetworkScheduler::Client>(priority, deadline_us);
+    }
+    if (m_execute_func) {
+        enable_schedule_hook();
+    }
+}
+
+ScheduleStats NetworkImplDft::get_schedule_stats() const {
+    if (m_schedule_client) {
+        return m_schedule_client->stats();
+    }
+    return {};
+}
+
+void NetworkImplDft::enable_schedule_hook() {
+    if (!m_schedule_client || m_schedule_handler) {
+        return;
+    }
+    //! in cpu inplace mode kernels run in the caller thread, otherwise kernels
+    //! of the networks on the same comp node are serialized by its worker
+    if (!m_is_cpu_inplace_mode) {
+        auto loc = m_compnode_locator;
+        if (m_load_config.comp_node_mapper) {
+            m_load_config.comp_node_mapper(loc);
+        }
+        m_schedule_client->set_worker(mgb::CompNode::load(loc));
+    }
+    //! the yield point is a task of the exec env, so it runs before the kernel
+    //! of the operator is submitted; it only blocks when the tasks are run by
+    //! the thread calling forward()
+    auto on_kern_start = [client = m_schedule_client](
+                                 const mgb::cg::event::OprExecKernelStart& event) {
+        event.env->dispatch_on_comp_node(
+                event.opr->output(0)->comp_node(),
+                [client]() { NetworkScheduler::inst().yield(client.get()); });
+    };
+    m_schedule_handler =
+            m_load_result.graph->event()
+                    .register_receiver<mgb::cg::event::OprExecKernelStart>(
+                            on_kern_start);
+}
+
 void NetworkImplDft::enable_profile_performance(std::string profile_json_file) {
 #if MGB_ENABLE_JSON
 #if MGB_OPENCL
@@ -17,6 +17,8 @@
 #if LITE_BUILD_WITH_MGE
 #include "lite/network.h"
 #include "network_impl_base.h"
+#include "output_memory_pool.h"
+#include "scheduler.h"
 #include "tensor_impl.h"
 
 #include "megbrain/graph/bases.h"
@@ -170,6 +172,12 @@ public:
     void get_static_memory_alloc_info(
             const std::string& log_dir = "logs/test") const override;
 
+    //! set the priority and deadline used by NetworkScheduler
+    void set_schedule_priority(int priority, uint32_t deadline_us);
+
+    //! get the scheduling statistics, all zero if scheduling is not enabled
+    ScheduleStats get_schedule_stats() const;
+
 private:
     //! construct the outputspec according to the m_network_io, and set the
     //! call_back to the outputspec
@@ -217,6 +225,15 @@ private:
     //! adapt option valid, it should call after update_io
     void adapt_option_valid();
 
+    //! bind new buffers from the output pool to the output tensors
+    void bind_pooled_outputs();
+
+    //! register the yield point before each kernel if scheduling is enabled
+    void enable_schedule_hook();
+
+    //! deactivate the network in NetworkScheduler, also on the error path
+    void end_schedule() const;
+
 private:
     bool m_async = false;
     bool m_is_cpu_inplace_mode = false;
@@ -248,6 +265,13 @@ private:
     std::string m_profiler_output_file;
 #endif
     std::unique_ptr<mgb::OprIODumpBase> m_iodump;
+
+    //! buffers of the host outputs, used when output_memory_pool is set
+    std::shared_ptr<OutputMemoryPool> m_output_pool;
+
+    //! scheduling related data
+    std::shared_ptr<NetworkScheduler::Client> m_schedule_client;
+    mgb::SyncEventConnecter::ReceiverHandler m_schedule_handler;
 };
 
 }  // namespace lite
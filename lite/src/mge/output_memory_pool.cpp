@@ -0,0 +1,66 @@
+/**
+ * \file src/mge/output_memory_pool.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "lite_build_config.h"
+
+#if LITE_BUILD_WITH_MGE
+#include "output_memory_pool.h"
+
+#include <algorithm>
+
+using namespace lite;
+
+std::shared_ptr<mgb::dt_byte> OutputMemoryPool::alloc(mgb::CompNode cn, size_t size) {
+    size = std::max<size_t>(size, 1);
+    mgb::HostTensorStorage storage;
+    {
+        MGB_LOCK_GUARD(m_mtx);
+        auto&& free = m_free[cn];
+        auto iter = free.lower_bound(size);
+        //! do not waste a buffer much larger than requested
+        if (iter != free.end() && iter->first <= size * 2) {
+            storage = std::move(iter->second);
+            free.erase(iter);
+        }
+    }
+    if (storage.empty()) {
+        storage = mgb::HostTensorStorage{cn};
+        storage.ensure_size(size);
+    }
+    auto ptr = storage.ptr();
+    auto pool = shared_from_this();
+    return std::shared_ptr<mgb::dt_byte>(
+            ptr, [pool, storage](mgb::dt_byte*) { pool->recycle(storage); });
+}
+
+void OutputMemoryPool::recycle(mgb::HostTensorStorage storage) {
+    MGB_LOCK_GUARD(m_mtx);
+    auto size = storage.size();
+    m_free[storage.comp_node()].emplace(size, std::move(storage));
+}
+
+size_t OutputMemoryPool::nr_free() const {
+    MGB_LOCK_GUARD(m_mtx);
+    size_t ret = 0;
+    for (auto&& i : m_free) {
+        ret += i.second.size();
+    }
+    return ret;
+}
+
+void OutputMemoryPool::clear() {
+    MGB_LOCK_GUARD(m_mtx);
+    m_free.clear();
+}
+
+#endif
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
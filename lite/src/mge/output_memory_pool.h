@@ -0,0 +1,65 @@
+/**
+ * \file src/mge/output_memory_pool.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#pragma once
+
+#include "lite_build_config.h"
+
+#if LITE_BUILD_WITH_MGE
+#include "megbrain/comp_node.h"
+#include "megbrain/tensor.h"
+#include "megbrain/utils/metahelper.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace lite {
+
+/*!
+ * \brief recyclable host buffers for the network outputs
+ *
+ * The buffers are allocated on the host comp node of the output tensors, so
+ * they are pinned memory when the network runs on a device. A buffer returned
+ * by alloc() goes back to the pool when the last reference to it is released,
+ * and it may be handed out again by a later alloc() on the same comp node.
+ */
+class OutputMemoryPool final : public std::enable_shared_from_this<OutputMemoryPool>,
+                               public mgb::NonCopyableObj {
+public:
+    static std::shared_ptr<OutputMemoryPool> make() {
+        return std::shared_ptr<OutputMemoryPool>(new OutputMemoryPool);
+    }
+
+    //! get a buffer of at least \p size bytes on \p cn
+    std::shared_ptr<mgb::dt_byte> alloc(mgb::CompNode cn, size_t size);
+
+    //! number of buffers currently held by the pool
+    size_t nr_free() const;
+
+    //! release all the buffers held by the pool
+    void clear();
+
+private:
+    OutputMemoryPool() = default;
+
+    void recycle(mgb::HostTensorStorage storage);
+
+    mutable std::mutex m_mtx;
+    //! comp node => (buffer size => buffer)
+    mgb::CompNode::UnorderedMap<std::multimap<size_t, mgb::HostTensorStorage>> m_free;
+};
+
+}  // namespace lite
+
+#endif
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
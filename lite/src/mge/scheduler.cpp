@@ -0,0 +1,153 @@
+/**
+ * \file src/mge/scheduler.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "lite_build_config.h"
+
+#if LITE_BUILD_WITH_MGE
+#include "scheduler.h"
+#include "../misc.h"
+
+#include <algorithm>
+
+using namespace lite;
+
+namespace {
+double to_ms(NetworkScheduler::Clock::duration dur) {
+    return std::chrono::duration<double, std::milli>(dur).count();
+}
+
+//! the client whose kernels are being submitted by the current thread
+thread_local const NetworkScheduler::Client* tls_submit_client = nullptr;
+}  // anonymous namespace
+
+/* ======================= NetworkScheduler::Client ======================= */
+
+NetworkScheduler::Client::~Client() {
+    NetworkScheduler::inst().end(this);
+}
+
+void NetworkScheduler::Client::set_policy(int priority, uint32_t deadline_us) {
+    LITE_LOCK_GUARD(NetworkScheduler::inst().m_mtx);
+    m_next_priority = priority;
+    m_next_deadline_us = deadline_us;
+}
+
+void NetworkScheduler::Client::set_worker(mgb::CompNode worker) {
+    LITE_LOCK_GUARD(NetworkScheduler::inst().m_mtx);
+    m_worker = worker;
+}
+
+ScheduleStats NetworkScheduler::Client::stats() const {
+    LITE_LOCK_GUARD(NetworkScheduler::inst().m_mtx);
+    return m_stats;
+}
+
+/* ===================== NetworkScheduler::SubmitScope ===================== */
+
+NetworkScheduler::SubmitScope::SubmitScope(const Client* client)
+        : m_prev{tls_submit_client} {
+    tls_submit_client = client;
+}
+
+NetworkScheduler::SubmitScope::~SubmitScope() {
+    tls_submit_client = m_prev;
+}
+
+/* ======================= NetworkScheduler ======================= */
+
+NetworkScheduler& NetworkScheduler::inst() {
+    static NetworkScheduler scheduler;
+    return scheduler;
+}
+
+bool NetworkScheduler::outranked(const Client* client) const {
+    for (auto other : m_active) {
+        if (other == client || other->m_caller == client->m_caller ||
+            (other->m_worker.valid() && other->m_worker == client->m_worker)) {
+            continue;
+        }
+        if (other->m_priority != client->m_priority) {
+            if (other->m_priority > client->m_priority) {
+                return true;
+            }
+            continue;
+        }
+        if (other->m_deadline_us &&
+            (!client->m_deadline_us ||
+             other->m_abs_deadline < client->m_abs_deadline)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void NetworkScheduler::begin(Client* client) {
+    std::unique_lock<std::mutex> lock{m_mtx};
+    LITE_ASSERT(!client->m_active, "network forward again before finished");
+    client->m_active = true;
+    client->m_priority = client->m_next_priority;
+    client->m_deadline_us = client->m_next_deadline_us;
+    client->m_caller = std::this_thread::get_id();
+    client->m_begin_time = Clock::now();
+    client->m_abs_deadline =
+            client->m_begin_time + std::chrono::microseconds(client->m_deadline_us);
+    m_active.push_back(client);
+    m_nr_active.store(m_active.size());
+    // clients that are now outranked wait at their next yield point, and
+    // clients outranking nobody are not affected, so no need to notify
+    if (outranked(client)) {
+        m_cv.wait(lock, [this, client]() { return !outranked(client); });
+        client->m_stats.queue_time_ms += to_ms(Clock::now() - client->m_begin_time);
+    }
+}
+
+void NetworkScheduler::yield(Client* client) {
+    //! the client itself is counted as active during its forward
+    if (tls_submit_client != client ||
+        m_nr_active.load(std::memory_order_relaxed) <= 1) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock{m_mtx};
+    if (!client->m_active || !outranked(client)) {
+        return;
+    }
+    auto start = Clock::now();
+    ++client->m_stats.nr_preempted;
+    m_cv.wait(lock, [this, client]() { return !outranked(client); });
+    client->m_stats.preempted_time_ms += to_ms(Clock::now() - start);
+}
+
+void NetworkScheduler::end(Client* client) {
+    {
+        LITE_LOCK_GUARD(m_mtx);
+        if (!client->m_active) {
+            return;
+        }
+        client->m_active = false;
+        m_active.erase(std::find(m_active.begin(), m_active.end(), client));
+        m_nr_active.store(m_active.size());
+
+        auto now = Clock::now();
+        auto latency = to_ms(now - client->m_begin_time);
+        auto&& stats = client->m_stats;
+        ++stats.nr_forward;
+        stats.total_latency_ms += latency;
+        stats.max_latency_ms = std::max(stats.max_latency_ms, latency);
+        if (client->m_deadline_us && now > client->m_abs_deadline) {
+            ++stats.nr_deadline_miss;
+        }
+    }
+    m_cv.notify_all();
+}
+
+#endif
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
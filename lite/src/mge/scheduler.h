@@ -0,0 +1,132 @@
+/**
+ * \file src/mge/scheduler.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#pragma once
+
+#include "lite_build_config.h"
+
+#if LITE_BUILD_WITH_MGE
+#include "lite/network.h"
+
+#include "megbrain/comp_node.h"
+#include "megbrain/utils/metahelper.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lite {
+
+/*!
+ * \brief priority based scheduler shared by all the networks in the process
+ *
+ * A network with scheduling enabled is active from forward() to the end of
+ * the forward (wait() in sync mode, or the async callback). The network only
+ * ever waits in the thread calling forward(), never in a comp node worker, so
+ * a paused network does not hold a worker shared with other networks:
+ *  - begin() blocks while another active network outranks the caller, before
+ *    any kernel of the forward is submitted;
+ *  - yield() is called before each operator kernel is submitted, and blocks
+ *    the same way if it runs in the thread submitting the kernels (inside a
+ *    SubmitScope), so the caller is paused at an operator boundary and resumed
+ *    after the higher-ranked networks finish. It is a no-op in other threads,
+ *    such as the dispatch workers used by multi comp node graphs, and it is
+ *    not replayed by a recorded comp node sequence.
+ *
+ * A network outranks another one if it has higher priority, or the same
+ * priority and an earlier absolute deadline. Networks sharing the same comp
+ * node worker never wait for each other since their kernels are serialized
+ * in the same queue anyway, and neither do networks whose forward was started
+ * in the same thread, which would deadlock.
+ */
+class NetworkScheduler : public mgb::NonCopyableObj {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class Client {
+        friend class NetworkScheduler;
+
+        //! the policy of the current forward
+        int m_priority = 0;
+        uint32_t m_deadline_us = 0;
+        //! the policy set by set_policy(), taken by the next begin()
+        int m_next_priority = 0;
+        uint32_t m_next_deadline_us = 0;
+        //! comp node whose worker runs the kernels; invalid if kernels are
+        //! executed in the caller thread
+        mgb::CompNode m_worker;
+        //! the thread that began the current forward
+        std::thread::id m_caller;
+
+        bool m_active = false;
+        Clock::time_point m_begin_time, m_abs_deadline;
+        ScheduleStats m_stats;
+
+    public:
+        Client(int priority, uint32_t deadline_us)
+                : m_priority{priority},
+                  m_deadline_us{deadline_us},
+                  m_next_priority{priority},
+                  m_next_deadline_us{deadline_us} {}
+        ~Client();
+
+        //! update priority and deadline; take effect at next forward, a
+        //! forward in progress keeps its policy
+        void set_policy(int priority, uint32_t deadline_us);
+
+        void set_worker(mgb::CompNode worker);
+
+        ScheduleStats stats() const;
+    };
+
+    //! mark the current thread as the one submitting the kernels of a client,
+    //! only the yield points run in it may block
+    class SubmitScope : public mgb::NonCopyableObj {
+        const Client* m_prev;
+
+    public:
+        explicit SubmitScope(const Client* client);
+        ~SubmitScope();
+    };
+
+    static NetworkScheduler& inst();
+
+    //! called in the caller thread when a forward of the client begins; wait
+    //! until no other active client outranks it
+    void begin(Client* client);
+
+    //! called at operator boundaries of the client
+    void yield(Client* client);
+
+    //! called when a forward of the client finishes, whether successful or
+    //! not; it is a no-op if the client is not active
+    void end(Client* client);
+
+private:
+    //! whether some other active client outranks \p client
+    bool outranked(const Client* client) const;
+
+    mutable std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::vector<Client*> m_active;
+    //! number of active clients, to skip locking in the common case
+    std::atomic_size_t m_nr_active{0};
+};
+
+}  // namespace lite
+
+#endif
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
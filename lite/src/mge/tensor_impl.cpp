@@ -306,7 +306,10 @@ void TensorImplDft::reshape(const Layout& layout) {
 
 void TensorImplDft::reset(void* prepared_data) {
     auto raw_ptr = static_cast<mgb::dt_byte*>(prepared_data);
-    auto raw_storage = std::shared_ptr<mgb::dt_byte>(raw_ptr, [](void*) {});
+    reset(std::shared_ptr<mgb::dt_byte>(raw_ptr, [](void*) {}));
+}
+
+void TensorImplDft::reset(std::shared_ptr<mgb::dt_byte> raw_storage) {
     bool host = is_host();
     if (host) {
         auto cn = m_host_tensor->comp_node();
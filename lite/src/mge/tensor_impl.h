@@ -72,6 +72,10 @@ public:
     //! the user should delete it.
     void reset(void* prepared_data, const Layout& layout) override;
 
+    //! reset the memory of the tensor with a managed storage, the storage is
+    //! released when the tensor does not use it any more
+    void reset(std::shared_ptr<mgb::dt_byte> raw_storage);
+
     //! get a new tensor slice from the origin tensor
     std::shared_ptr<Tensor> slice(
             const std::vector<size_t>& start, const std::vector<size_t>& end,
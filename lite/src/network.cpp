@@ -157,6 +157,10 @@ Network& Network::set_async_callback(const AsyncCallback& callback) {
             !m_config.options.force_output_use_user_specified_memory,
             "Async mode can't run with force_output_use_user_specified_memory which "
             "output data is written to use specific memory.");
+    LITE_ASSERT(
+            !m_config.options.output_memory_pool,
+            "Async mode can't run with output_memory_pool which output data is "
+            "written to the pooled memory.");
     LITE_CHECK_NON_NULL_POINTER(m_impl);
     m_impl->set_async_callback(std::move(callback));
     return *this;
@@ -484,6 +488,30 @@ void Runtime::enable_io_bin_dump(
     LITE_ERROR_HANDLER_END
 }
 
+void Runtime::set_network_schedule_priority(
+        std::shared_ptr<Network> network, int priority, uint32_t deadline_us) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        call_func<NetworkImplDft, void>(
+                "set_schedule_priority", network_impl, priority, deadline_us);
+        return;
+    }
+    LITE_THROW("set_network_schedule_priority is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
+ScheduleStats Runtime::get_network_schedule_stats(std::shared_ptr<Network> network) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        return call_func<NetworkImplDft, ScheduleStats>(
+                "get_schedule_stats", network_impl);
+    }
+    LITE_THROW("get_network_schedule_stats is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
 void Runtime::shared_weight_with_network(
         std::shared_ptr<Network> dst_network,
         const std::shared_ptr<Network> src_network) {
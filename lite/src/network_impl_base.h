@@ -149,6 +149,10 @@ public:
         LITE_ASSERT(network);
         network->m_loaded = loaded;
     }
+    static const Config& config(const Network* network) {
+        LITE_ASSERT(network);
+        return network->m_config;
+    }
     static Network::NetworkImplBase* implement(const Network* network) {
         LITE_ASSERT(network);
         return network->m_impl.get();
@@ -0,0 +1,208 @@
+/**
+ * \file src/network_swapper.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "lite/global.h"
+#include "lite/network.h"
+#include "misc.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace lite;
+
+struct NetworkSwapper::State {
+    mutable LITE_MUTEX mtx;
+    std::shared_ptr<Network> current;
+    //! versions replaced by swaps which may still be used by requests
+    std::vector<std::weak_ptr<Network>> retired;
+    size_t version = 0;
+    bool swapping = false;
+    std::string error;
+
+    //! guard the worker, as it is joined by both swap_async and wait_swap
+    LITE_MUTEX worker_mtx;
+#if !__DEPLOY_ON_XP_SP2__
+    std::thread worker;
+#endif
+
+    static void load_and_swap(
+            std::shared_ptr<State> state, const std::string& model_path,
+            const Config& config, const NetworkIO& network_io,
+            const SwapOptions& options);
+
+    void join_worker() {
+#if !__DEPLOY_ON_XP_SP2__
+        LITE_LOCK_GUARD(worker_mtx);
+        if (worker.joinable()) {
+            worker.join();
+        }
+#endif
+    }
+};
+
+namespace {
+std::shared_ptr<Network> load_and_warmup(
+        const std::string& model_path, const Config& config,
+        const NetworkIO& network_io, const SwapOptions& options) {
+    auto network = std::make_shared<Network>(config, network_io);
+    if (options.prepare) {
+        options.prepare(network);
+    }
+    network->load_model(model_path);
+    //! the first forward compiles the graph, selects algos from the
+    //! persistent cache (or profiles them) and allocates the runtime memory
+    for (size_t i = 0; i < options.nr_warmup; ++i) {
+        if (options.warmup_input) {
+            options.warmup_input(network);
+        } else {
+            for (auto&& name : network->get_all_input_name()) {
+                auto tensor = network->get_io_tensor(name);
+                if (tensor->get_layout().ndim > 0) {
+                    tensor->fill_zero();
+                }
+            }
+        }
+        network->forward();
+        network->wait();
+    }
+    if (!options.persistent_cache_path.empty()) {
+        dump_persistent_cache(options.persistent_cache_path);
+    }
+    return network;
+}
+}  // namespace
+
+void NetworkSwapper::State::load_and_swap(
+        std::shared_ptr<State> state, const std::string& model_path,
+        const Config& config, const NetworkIO& network_io,
+        const SwapOptions& options) {
+    std::shared_ptr<Network> network;
+    std::string error;
+#if LITE_ENABLE_EXCEPTION
+    try {
+        network = load_and_warmup(model_path, config, network_io, options);
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+#else
+    network = load_and_warmup(model_path, config, network_io, options);
+#endif
+    if (!network) {
+        LITE_WARN("swap network to %s failed: %s", model_path.c_str(), error.c_str());
+    }
+
+    std::shared_ptr<Network> old;
+    {
+        LITE_LOCK_GUARD(state->mtx);
+        if (network) {
+            old = std::move(state->current);
+            state->retired.emplace_back(old);
+            state->current = std::move(network);
+            ++state->version;
+            state->error.clear();
+        } else {
+            state->error = error;
+        }
+        state->swapping = false;
+    }
+    //! if no request holds the old version, it is destroyed here out of the
+    //! lock, so acquire() is never blocked by releasing the old graph
+    old.reset();
+}
+
+NetworkSwapper::NetworkSwapper(std::shared_ptr<Network> network)
+        : m_state{std::make_shared<State>()} {
+    LITE_ASSERT(network, "NetworkSwapper should be constructed with a network.");
+    m_state->current = std::move(network);
+}
+
+NetworkSwapper::~NetworkSwapper() {
+    m_state->join_worker();
+}
+
+std::shared_ptr<Network> NetworkSwapper::acquire() const {
+    LITE_LOCK_GUARD(m_state->mtx);
+    return m_state->current;
+}
+
+bool NetworkSwapper::swap_async(
+        const std::string& model_path, const Config& config,
+        const NetworkIO& network_io, const SwapOptions& options) {
+    LITE_ERROR_HANDLER_BEGIN
+    {
+        LITE_LOCK_GUARD(m_state->mtx);
+        if (m_state->swapping) {
+            return false;
+        }
+        m_state->swapping = true;
+    }
+    //! clear the flag if the swap is not started, e.g. std::thread throws;
+    //! otherwise later swaps would always be rejected
+    struct ResetSwapping {
+        State* state;
+        ~ResetSwapping() {
+            if (state) {
+                LITE_LOCK_GUARD(state->mtx);
+                state->swapping = false;
+            }
+        }
+    } reset_swapping{m_state.get()};
+    //! the previous worker has finished, just release its thread
+    m_state->join_worker();
+#if __DEPLOY_ON_XP_SP2__
+    //! no std::thread on xp sp2, swap in the caller thread
+    reset_swapping.state = nullptr;
+    State::load_and_swap(m_state, model_path, config, network_io, options);
+#else
+    LITE_LOCK_GUARD(m_state->worker_mtx);
+    m_state->worker = std::thread(
+            State::load_and_swap, m_state, model_path, config, network_io, options);
+    //! the worker clears the flag when it is done
+    reset_swapping.state = nullptr;
+#endif
+    return true;
+    LITE_ERROR_HANDLER_END
+}
+
+bool NetworkSwapper::wait_swap() {
+    m_state->join_worker();
+    LITE_LOCK_GUARD(m_state->mtx);
+    return m_state->error.empty();
+}
+
+bool NetworkSwapper::is_swapping() const {
+    LITE_LOCK_GUARD(m_state->mtx);
+    return m_state->swapping;
+}
+
+size_t NetworkSwapper::version() const {
+    LITE_LOCK_GUARD(m_state->mtx);
+    return m_state->version;
+}
+
+std::string NetworkSwapper::last_error() const {
+    LITE_LOCK_GUARD(m_state->mtx);
+    return m_state->error;
+}
+
+bool NetworkSwapper::is_old_version_released() const {
+    LITE_LOCK_GUARD(m_state->mtx);
+    auto&& retired = m_state->retired;
+    retired.erase(
+            std::remove_if(
+                    retired.begin(), retired.end(),
+                    [](const std::weak_ptr<Network>& i) { return i.expired(); }),
+            retired.end());
+    return retired.empty();
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
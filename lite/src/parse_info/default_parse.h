@@ -116,9 +116,13 @@ bool default_parse_info(
         if (options.contains("force_output_dynamic_alloc"))
             config.options.force_output_dynamic_alloc =
                     options["force_output_dynamic_alloc"];
+        if (options.contains("output_memory_pool"))
+            config.options.output_memory_pool = options["output_memory_pool"];
         if (options.contains("no_profiling_on_shape_change"))
             config.options.no_profiling_on_shape_change =
                     options["no_profiling_on_shape_change"];
+        if (options.contains("deterministic"))
+            config.options.deterministic = options["deterministic"];
         if (options.contains("jit_level"))
             config.options.jit_level = options["jit_level"];
         if (options.contains("comp_node_seq_record_level"))
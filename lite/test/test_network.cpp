@@ -12,6 +12,7 @@
 #include "lite_build_config.h"
 
 #if LITE_BUILD_WITH_MGE
+#include "../src/mge/scheduler.h"
 #include "./test_common.h"
 #include "megbrain/tensor.h"
 
@@ -20,9 +21,11 @@
 #include <string.h>
 #endif
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <random>
+#include <thread>
 #include <unordered_map>
 using namespace lite;
 
@@ -461,6 +464,50 @@ void test_output_no_copy(int record) {
     }
 }
 
+void test_output_memory_pool(int record) {
+    Config config;
+    config.options.output_memory_pool = true;
+    config.options.comp_node_seq_record_level = record;
+    auto tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+    std::string input_name = "data";
+    auto result_mgb = mgb_lar(model_path, {}, input_name, tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    network->load_model(model_path);
+    std::shared_ptr<Tensor> input_tensor = network->get_io_tensor(input_name);
+    input_tensor->reset(tensor->get_memory_ptr(), tensor->get_layout());
+
+    //! the outputs of every forward are kept, so they must not share memory
+    size_t times = 3;
+    std::vector<std::shared_ptr<Tensor>> outputs;
+    for (size_t i = 0; i < times; i++) {
+        network->forward();
+        network->wait();
+        auto output = network->get_output_tensor(0);
+        for (auto&& prev : outputs) {
+            ASSERT_NE(prev->get_memory_ptr(), output->get_memory_ptr());
+        }
+        compare_lite_tensor<float>(output, result_mgb);
+        outputs.push_back(output);
+    }
+    for (auto&& output : outputs) {
+        compare_lite_tensor<float>(output, result_mgb);
+    }
+
+    //! the released buffer is reused, the network still holds the last one
+    void* released = outputs[0]->get_memory_ptr();
+    outputs.erase(outputs.begin());
+    network->forward();
+    network->wait();
+    auto output = network->get_output_tensor(0);
+    ASSERT_EQ(released, output->get_memory_ptr());
+    compare_lite_tensor<float>(output, result_mgb);
+    for (auto&& prev : outputs) {
+        compare_lite_tensor<float>(prev, result_mgb);
+    }
+}
+
 void test_input_no_copy(int record) {
     Config config;
     config.options.force_output_use_user_specified_memory = true;
@@ -624,6 +671,14 @@ TEST(TestNetWork, OutputNoCopyRecord) {
     test_output_no_copy(1);
 }
 
+TEST(TestNetWork, OutputMemoryPool) {
+    test_output_memory_pool(0);
+}
+
+TEST(TestNetWork, OutputMemoryPoolRecord) {
+    test_output_memory_pool(1);
+}
+
 TEST(TestNetWork, IONoCopy) {
     test_input_no_copy(0);
 }
@@ -929,6 +984,200 @@ TEST(TestNetWork, GetModelExtraInfo) {
     printf("extra_info %s \n", extra_info.c_str());
 }
 
+TEST(TestNetWork, SchedulePriority) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    //! use different streams so that the two networks run in different workers
+    std::shared_ptr<Network> network_low = std::make_shared<Network>(config);
+    std::shared_ptr<Network> network_high = std::make_shared<Network>(config);
+    network_low->set_stream_id(1);
+    network_high->set_stream_id(2);
+    Runtime::set_network_schedule_priority(network_low, 0);
+    network_low->load_model(model_path);
+    network_high->load_model(model_path);
+    //! a deadline that can never be met
+    Runtime::set_network_schedule_priority(network_high, 1, 1);
+
+    auto src_ptr = lite_tensor->get_memory_ptr();
+    auto src_layout = lite_tensor->get_layout();
+    network_low->get_input_tensor(0)->reset(src_ptr, src_layout);
+    network_high->get_input_tensor(0)->reset(src_ptr, src_layout);
+
+    constexpr size_t nr_run = 5;
+    std::thread worker([&]() {
+        for (size_t i = 0; i < nr_run; i++) {
+            network_low->forward();
+            network_low->wait();
+        }
+    });
+    for (size_t i = 0; i < nr_run; i++) {
+        network_high->forward();
+        network_high->wait();
+    }
+    worker.join();
+
+    compare_lite_tensor<float>(network_low->get_output_tensor(0), result_mgb);
+    compare_lite_tensor<float>(network_high->get_output_tensor(0), result_mgb);
+
+    auto stats_low = Runtime::get_network_schedule_stats(network_low);
+    auto stats_high = Runtime::get_network_schedule_stats(network_high);
+    ASSERT_EQ(nr_run, stats_low.nr_forward);
+    ASSERT_EQ(0u, stats_low.nr_deadline_miss);
+    ASSERT_EQ(nr_run, stats_high.nr_forward);
+    ASSERT_EQ(nr_run, stats_high.nr_deadline_miss);
+    ASSERT_EQ(0u, stats_high.nr_preempted);
+    ASSERT_EQ(0., stats_high.queue_time_ms);
+    ASSERT_EQ(0., stats_high.preempted_time_ms);
+    ASSERT_GE(stats_high.max_latency_ms * nr_run, stats_high.total_latency_ms);
+}
+
+TEST(TestNetWork, SchedulePreempt) {
+    auto&& scheduler = NetworkScheduler::inst();
+    NetworkScheduler::Client low{0, 0}, high{1, 0};
+
+    //! low is running when high begins, so it is paused at its next yield
+    std::atomic_bool low_started{false}, high_begun{false}, low_resumed{false};
+    std::thread worker([&]() {
+        scheduler.begin(&low);
+        NetworkScheduler::SubmitScope submit_scope{&low};
+        scheduler.yield(&low);
+        low_started = true;
+        while (!high_begun) {
+            std::this_thread::yield();
+        }
+        scheduler.yield(&low);
+        low_resumed = true;
+        scheduler.end(&low);
+    });
+    while (!low_started) {
+        std::this_thread::yield();
+    }
+    scheduler.begin(&high);
+    high_begun = true;
+    {
+        //! yield points out of the submitting thread never block
+        scheduler.yield(&low);
+        NetworkScheduler::SubmitScope submit_scope{&high};
+        scheduler.yield(&high);
+    }
+    while (!low.stats().nr_preempted) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    bool resumed_before_end = low_resumed;
+    scheduler.end(&high);
+    worker.join();
+    ASSERT_FALSE(resumed_before_end);
+    ASSERT_TRUE(low_resumed);
+
+    auto stats_low = low.stats(), stats_high = high.stats();
+    ASSERT_EQ(1u, stats_low.nr_forward);
+    ASSERT_EQ(1u, stats_low.nr_preempted);
+    ASSERT_GT(stats_low.preempted_time_ms, 0.);
+    ASSERT_EQ(1u, stats_high.nr_forward);
+    ASSERT_EQ(0u, stats_high.nr_preempted);
+    ASSERT_EQ(0., stats_high.queue_time_ms);
+}
+
+TEST(TestNetWork, ScheduleQueue) {
+    auto&& scheduler = NetworkScheduler::inst();
+    NetworkScheduler::Client low{0, 0}, high{0, 0};
+    high.set_policy(1, 0);
+
+    //! low begins while high is active in another thread, so it waits before
+    //! submitting anything
+    std::atomic_bool high_begun{false}, low_begun{false};
+    bool begun_before_end = true;
+    std::thread worker([&]() {
+        scheduler.begin(&high);
+        high_begun = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        begun_before_end = low_begun;
+        //! the policy set during a forward is taken by the next forward
+        high.set_policy(0, 0);
+        scheduler.end(&high);
+    });
+    while (!high_begun) {
+        std::this_thread::yield();
+    }
+    scheduler.begin(&low);
+    low_begun = true;
+    worker.join();
+    scheduler.end(&low);
+    ASSERT_FALSE(begun_before_end);
+    auto queue_time = low.stats().queue_time_ms;
+    ASSERT_GT(queue_time, 0.);
+    ASSERT_EQ(0., high.stats().queue_time_ms);
+
+    //! high has the same priority as low now, so low does not wait
+    scheduler.begin(&high);
+    std::thread other([&]() {
+        scheduler.begin(&low);
+        scheduler.end(&low);
+    });
+    other.join();
+    scheduler.end(&high);
+    ASSERT_EQ(2u, low.stats().nr_forward);
+    ASSERT_EQ(queue_time, low.stats().queue_time_ms);
+}
+
+TEST(TestNetWork, SwapNetwork) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    network->load_model(model_path);
+    NetworkSwapper swapper(network);
+    network.reset();
+
+    auto src_ptr = lite_tensor->get_memory_ptr();
+    auto src_layout = lite_tensor->get_layout();
+    auto run = [&](std::shared_ptr<Network> net) {
+        net->get_input_tensor(0)->reset(src_ptr, src_layout);
+        net->forward();
+        net->wait();
+        compare_lite_tensor<float>(net->get_output_tensor(0), result_mgb);
+    };
+
+    //! a request in flight on the old version during the swap
+    auto old_version = swapper.acquire();
+    size_t nr_warmup = 0;
+    SwapOptions options;
+    options.nr_warmup = 2;
+    options.warmup_input = [&](std::shared_ptr<Network> net) {
+        nr_warmup++;
+        net->get_input_tensor(0)->reset(src_ptr, src_layout);
+    };
+    ASSERT_TRUE(swapper.swap_async(model_path, config, {}, options));
+    run(old_version);
+    ASSERT_TRUE(swapper.wait_swap());
+    ASSERT_EQ(2u, nr_warmup);
+    ASSERT_EQ(1u, swapper.version());
+    ASSERT_FALSE(swapper.is_swapping());
+
+    auto new_version = swapper.acquire();
+    ASSERT_NE(old_version, new_version);
+    ASSERT_FALSE(swapper.is_old_version_released());
+    run(old_version);
+    old_version.reset();
+    ASSERT_TRUE(swapper.is_old_version_released());
+    run(new_version);
+
+    //! a failed swap keeps the current version
+    ASSERT_TRUE(swapper.swap_async("./not_exist.mge", config));
+    ASSERT_FALSE(swapper.wait_swap());
+    ASSERT_FALSE(swapper.last_error().empty());
+    ASSERT_EQ(1u, swapper.version());
+    ASSERT_EQ(new_version, swapper.acquire());
+}
+
 #ifndef __IN_TEE_ENV__
 #if MGB_ENABLE_JSON
 TEST(TestNetWork, GetMemoryInfo) {
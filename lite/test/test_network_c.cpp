@@ -871,6 +871,33 @@ TEST(TestCapiNetWork, OutputShapeOnly) {
     LITE_CAPI_CHECK(LITE_destroy_network(c_network));
 }
 
+TEST(TestCapiNetWork, OutputMemoryPool) {
+    ForwardMgb;
+    LiteNetwork c_network;
+    LiteConfig c_config = *default_config();
+    c_config.options.output_memory_pool = true;
+    LITE_CAPI_CHECK(LITE_make_network(&c_network, c_config, *default_network_io()));
+    LoadNetwork;
+    SetInput;
+    ForwardNetwork;
+    GetOutput;
+    //! the output got before the next forward owns its buffer
+    LiteTensor c_prev_output = c_output_tensor;
+    void* prev_ptr = output_ptr;
+    ForwardNetwork;
+    LITE_CAPI_CHECK(LITE_get_io_tensor(
+            c_network, output_name, LITE_OUTPUT, &c_output_tensor));
+    LITE_CAPI_CHECK(LITE_get_tensor_memory(c_output_tensor, &output_ptr));
+    ASSERT_NE(prev_ptr, output_ptr);
+    CompareResult;
+    LITE_CAPI_CHECK(LITE_get_tensor_memory(c_prev_output, &output_ptr));
+    ASSERT_EQ(prev_ptr, output_ptr);
+    CompareResult;
+    LITE_CAPI_CHECK(LITE_destroy_tensor(c_prev_output));
+    LITE_CAPI_CHECK(LITE_destroy_tensor(c_output_tensor));
+    LITE_CAPI_CHECK(LITE_destroy_network(c_network));
+}
+
 TEST(TestCapiNetWork, ProfileIOdump) {
     ForwardMgb;
     MakeNetwork;
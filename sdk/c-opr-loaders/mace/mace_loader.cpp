@@ -11,6 +11,7 @@
 
 #include <numeric>
 #include <iostream>
+#include <vector>
 #include <sys/stat.h>
 
 #include "mace/public/mace.h"
@@ -124,7 +125,7 @@ class MGBOprDescImpl {
                         const MGBTensor* output) {
         auto ud = user_data(self);
 
-        // create input and output tensor buffers
+        // wrap input and output tensor buffers without copying
         std::map<std::string, mace::MaceTensor> mace_inputs;
         std::map<std::string, mace::MaceTensor> mace_outputs;
 
@@ -134,48 +135,53 @@ class MGBOprDescImpl {
             mace_data_format = mace::DataFormat::NHWC;
         }
 
+        auto no_delete = [](float*) {};
         for (size_t i = 0; i < ud->nr_inputs; ++i) {
-            // allocate input
             uint32_t ndim = input[i].layout.shape.ndim;
             auto input_shape = std::vector<int64_t>(input[i].layout.shape.shape,
                                                     input[i].layout.shape.shape + ndim);
-
-            int64_t input_size =
-                std::accumulate(input_shape.begin(), input_shape.end(), 1,
-                                std::multiplies<uint64_t>());
-            auto buffer_in = std::shared_ptr<float>(new float[input_size],
-                                                    std::default_delete<float[]>());
-            memcpy(buffer_in.get(), input[i].data, input_size * sizeof(float));
+            auto buffer_in = std::shared_ptr<float>(
+                    static_cast<float*>(input[i].data), no_delete);
             mace_inputs[ud->input_names[i]] =
                 mace::MaceTensor(input_shape, buffer_in, mace_data_format);
         }
 
         for (size_t i = 0; i < ud->nr_outputs; ++i) {
-            // allocate output
             uint32_t ndim = output[i].layout.shape.ndim;
             auto output_shape = std::vector<int64_t>(output[i].layout.shape.shape,
                                                      output[i].layout.shape.shape + ndim);
-
-            int64_t output_size =
-                std::accumulate(output_shape.begin(), output_shape.end(), 1,
-                                std::multiplies<int64_t>());
-            auto buffer_out = std::shared_ptr<float>(new float[output_size],
-                                                     std::default_delete<float[]>());
+            auto buffer_out = std::shared_ptr<float>(
+                    static_cast<float*>(output[i].data), no_delete);
             mace_outputs[ud->output_names[i]] =
                 mace::MaceTensor(output_shape, buffer_out, mace_data_format);
         }
 
-        // run the model
+        // run the model; outputs are written to MGB tensors directly
         auto status = (ud->engine)->Run(mace_inputs, &mace_outputs);
         ASSERT(status == mace::MaceStatus::MACE_SUCCESS,
                "Error in running mace engine");
+    }
 
-        // send computed output to MGB
-        int idx = 0;
-        for (auto it = mace_outputs.begin(); it != mace_outputs.end(); it++) {
-            float* to = &((float *)output[idx++].data)[0];
-            to = (it->second).data().get();
-        }
+    //! kernel arg layout: MGBOprDesc* followed by input and output tensors
+    static void execute_kern(void* arg, size_t, size_t) {
+        auto self = *static_cast<const MGBOprDesc**>(arg);
+        auto tensors = reinterpret_cast<const MGBTensor*>(
+                static_cast<uint8_t*>(arg) + sizeof(MGBOprDesc*));
+        execute(self, tensors, tensors + user_data(self)->nr_inputs);
+    }
+
+    static void execute_v2(const MGBOprDesc* self, const MGBTensor* input,
+                           const MGBTensor* output, const MGBExecEnv* env) {
+        auto ud = user_data(self);
+        size_t inp_size = sizeof(MGBTensor) * ud->nr_inputs,
+               out_size = sizeof(MGBTensor) * ud->nr_outputs;
+        std::vector<uint8_t> arg(sizeof(self) + inp_size + out_size);
+        memcpy(arg.data(), &self, sizeof(self));
+        memcpy(arg.data() + sizeof(self), input, inp_size);
+        memcpy(arg.data() + sizeof(self) + inp_size, output, out_size);
+        // mace runs the whole model in a single task, with its own thread
+        // policy configured by MGB_MACE_NR_THREADS
+        env->dispatch(env, execute_kern, arg.data(), arg.size(), 1);
     }
 
 public:
@@ -295,6 +301,7 @@ public:
 #define a(n) ret->n = &n;
         MGB_OPR_DESC_FOREACH_MEM_FN(a);
         a(infer_dtype);
+        a(execute_v2);
 #undef a
         ret->user_data = ud.release();
         return ret.release();
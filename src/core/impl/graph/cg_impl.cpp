@@ -22,6 +22,7 @@
 #include "megbrain/graph/exc_extra_info.h"
 #include "megbrain/graph/helper.h"
 #include "megbrain/opr/utility.h"
+#include "megbrain/utils/timer.h"
 
 #if MGB_ENABLE_TENSOR_RT
 #include "megbrain/tensorrt/opr_replace.h"
@@ -460,7 +461,11 @@ std::shared_ptr<ComputingGraph> ComputingGraph::make() {
 
 std::unique_ptr<AsyncExecutable> ComputingGraphImpl::compile(
         const OutputSpec& out_spec) {
-    return compile_commit(compile_prepare(out_spec));
+    RealTimer timer;
+    auto ret = compile_commit(compile_prepare(out_spec));
+    event().signal_inplace<event::CompilePhaseFinished>(
+            this, "compile", timer.get_secs());
+    return ret;
 }
 
 SmallVector<std::unique_ptr<AsyncExecutable>> ComputingGraphImpl::compile_multi_part(
@@ -543,6 +548,12 @@ ComputingGraphImpl::CompileState ComputingGraphImpl::compile_prepare(
     mgb_assert(!options().enable_dtr_memory_opt);
 #endif  //   MGB_ENABLE_DTR
 
+    RealTimer phase_timer;
+    auto on_phase_finished = [this, &phase_timer](const char* phase) {
+        event().signal_inplace<event::CompilePhaseFinished>(
+                this, phase, phase_timer.get_secs_reset());
+    };
+
 #if !MGB_BUILD_SLIM_SERVING
     mgb_assert(
             !options().eager_evaluation, "attempt to compile eager_evaluation graph");
@@ -616,6 +627,7 @@ ComputingGraphImpl::CompileState ComputingGraphImpl::compile_prepare(
         opt.add_pass<gopt::RemoveShapeHintPass>();
         opt.apply_inplace(dest_vars);
     }
+    on_phase_finished("graph_opt");
 
     const OprNodeArray* opr_seq = nullptr;
     CompSeqExtraInfo extra_info;
@@ -711,6 +723,7 @@ ComputingGraphImpl::CompileState ComputingGraphImpl::compile_prepare(
     if (!init_flag) {
         init_opr_seq();
     }
+    on_phase_finished("topo_sort");
 
     return {std::move(extra_info), opr_seq, std::move(dest_vars)};
 }
@@ -734,8 +747,13 @@ std::unique_ptr<AsyncExecutable> ComputingGraphImpl::compile_commit(
     comp_seq->attach_to_graph();
 
     MGB_TRY {
+        RealTimer timer;
         var_node_mem_manager().reset_opr_seq(comp_seq->extra_info, opr_seq);
+        event().signal_inplace<event::CompilePhaseFinished>(
+                this, "mem_plan_init", timer.get_secs_reset());
         static_infer_comp_seq_manager().reset_dest(comp_seq->extra_info);
+        event().signal_inplace<event::CompilePhaseFinished>(
+                this, "static_infer_init", timer.get_secs_reset());
         cmpnt.seq_comp_node_opt.init_ready_event(comp_seq->extra_info, *opr_seq);
 
         if (options().allocate_static_mem_after_graph_compile)
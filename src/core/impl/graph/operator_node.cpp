@@ -188,6 +188,13 @@ const VarNodeArray OperatorNodeBase::usable_output() const {
 size_t OperatorNodeBase::hash() const {
     XXHash hstate;
     hstate.update(m_input.data(), sizeof(m_input[0]) * m_input.size());
+    size_t extra = hash_ignore_inputs();
+    hstate.update(&extra, sizeof(extra));
+    return hstate.digest();
+}
+
+size_t OperatorNodeBase::hash_ignore_inputs() const {
+    XXHash hstate;
     size_t extra_size = 2 + m_config.comp_node().size() + m_extra_equiv_comp.size(),
            next = 0, extra[extra_size];
 
@@ -0,0 +1,257 @@
+/**
+ * \file src/core/impl/graph/seq_mem_order.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "./seq_mem_order.h"
+#include "megbrain/common.h"
+#include "megbrain/utils/hash.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+
+using namespace mgb;
+using namespace cg;
+
+namespace {
+
+//! buffers flattened from all the nodes, and the buffers read by each node
+struct BufferIndex {
+    struct Buf {
+        size_t size;
+        const std::vector<size_t>* readers;
+    };
+    std::vector<Buf> bufs;
+    std::vector<std::vector<size_t>> node2read;
+    std::vector<size_t> out_size;
+
+    explicit BufferIndex(const std::vector<SeqMemOrderSearcher::Node>& nodes)
+            : node2read(nodes.size()), out_size(nodes.size()) {
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            for (auto&& buf : nodes[i].outputs) {
+                out_size[i] += buf.size;
+                for (auto reader : buf.readers) {
+                    node2read[reader].push_back(bufs.size());
+                }
+                bufs.push_back({buf.size, &buf.readers});
+            }
+        }
+    }
+};
+
+using Bitset = std::vector<uint64_t>;
+
+bool test_bit(const Bitset& s, size_t i) {
+    return s[i / 64] >> (i % 64) & 1;
+}
+
+void set_bit(Bitset& s, size_t i) {
+    s[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+struct BitsetHash {
+    size_t operator()(const Bitset& s) const {
+        return XXHash{}.update(s.data(), s.size() * sizeof(uint64_t)).digest();
+    }
+};
+
+}  // anonymous namespace
+
+struct SeqMemOrderSearcher::DPState {
+    size_t peak, live;
+    //! index of previous state and the node executed from it
+    size_t prev, node;
+};
+
+std::vector<size_t> SeqMemOrderSearcher::in_degree() const {
+    std::vector<size_t> deg(m_nodes.size());
+    for (auto&& i : m_nodes) {
+        for (auto j : i.succ) {
+            ++deg[j];
+        }
+    }
+    return deg;
+}
+
+size_t SeqMemOrderSearcher::peak(const std::vector<size_t>& order) const {
+    mgb_assert(order.size() == m_nodes.size());
+    BufferIndex index{m_nodes};
+    std::vector<size_t> nr_reader_left(index.bufs.size());
+    for (size_t i = 0; i < index.bufs.size(); ++i) {
+        nr_reader_left[i] = index.bufs[i].readers->size();
+    }
+    size_t live = 0, peak = 0;
+    for (auto node : order) {
+        live += index.out_size[node];
+        peak = std::max(peak, live);
+        for (auto buf : index.node2read[node]) {
+            if (!--nr_reader_left[buf]) {
+                live -= index.bufs[buf].size;
+            }
+        }
+    }
+    return peak;
+}
+
+std::vector<size_t> SeqMemOrderSearcher::search(
+        size_t dp_state_limit, bool* used_dp) const {
+    auto ret = search_dp(dp_state_limit);
+    if (used_dp) {
+        *used_dp = !ret.empty() || m_nodes.empty();
+    }
+    if (ret.empty()) {
+        ret = search_greedy();
+    }
+    return ret;
+}
+
+std::vector<size_t> SeqMemOrderSearcher::search_dp(size_t dp_state_limit) const {
+    size_t nr_node = m_nodes.size();
+    if (!nr_node) {
+        return {};
+    }
+    BufferIndex index{m_nodes};
+    std::vector<std::vector<size_t>> pred(nr_node);
+    for (size_t i = 0; i < nr_node; ++i) {
+        for (auto j : m_nodes[i].succ) {
+            pred[j].push_back(i);
+        }
+    }
+
+    std::vector<DPState> states;
+    std::unordered_map<Bitset, size_t, BitsetHash> cur_layer, next_layer;
+
+    Bitset empty((nr_node + 63) / 64);
+    states.push_back({0, 0, 0, 0});
+    cur_layer[empty] = 0;
+
+    // layer k contains the node sets of size k
+    for (size_t step = 0; step < nr_node; ++step) {
+        next_layer.clear();
+        for (auto&& cur : cur_layer) {
+            auto&& done = cur.first;
+            auto cur_state = states[cur.second];
+            for (size_t v = 0; v < nr_node; ++v) {
+                if (test_bit(done, v)) {
+                    continue;
+                }
+                bool ready = true;
+                for (auto p : pred[v]) {
+                    if (!test_bit(done, p)) {
+                        ready = false;
+                        break;
+                    }
+                }
+                if (!ready) {
+                    continue;
+                }
+                size_t during = cur_state.live + index.out_size[v];
+                size_t freed = 0;
+                for (auto buf : index.node2read[v]) {
+                    bool last = true;
+                    for (auto r : *index.bufs[buf].readers) {
+                        if (r != v && !test_bit(done, r)) {
+                            last = false;
+                            break;
+                        }
+                    }
+                    if (last) {
+                        freed += index.bufs[buf].size;
+                    }
+                }
+                DPState next{
+                        std::max(cur_state.peak, during), during - freed, cur.second,
+                        v};
+                auto key = done;
+                set_bit(key, v);
+                auto iter = next_layer.find(key);
+                if (iter == next_layer.end()) {
+                    if (states.size() >= dp_state_limit) {
+                        return {};
+                    }
+                    next_layer.emplace(std::move(key), states.size());
+                    states.push_back(next);
+                } else if (next.peak < states[iter->second].peak) {
+                    states[iter->second] = next;
+                }
+            }
+        }
+        mgb_assert(!next_layer.empty(), "circular dependency in SeqMemOrderSearcher");
+        std::swap(cur_layer, next_layer);
+    }
+
+    mgb_assert(cur_layer.size() == 1);
+    std::vector<size_t> order;
+    for (size_t i = cur_layer.begin()->second; i; i = states[i].prev) {
+        order.push_back(states[i].node);
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<size_t> SeqMemOrderSearcher::search_greedy() const {
+    size_t nr_node = m_nodes.size();
+    BufferIndex index{m_nodes};
+    auto deg = in_degree();
+    std::vector<size_t> nr_reader_left(index.bufs.size());
+    for (size_t i = 0; i < index.bufs.size(); ++i) {
+        nr_reader_left[i] = index.bufs[i].readers->size();
+    }
+    std::vector<size_t> ready, order;
+    for (size_t i = 0; i < nr_node; ++i) {
+        if (!deg[i]) {
+            ready.push_back(i);
+        }
+    }
+
+    size_t live = 0, peak = 0;
+    while (!ready.empty()) {
+        // prefer the node that does not raise the peak, then the one
+        // releasing most memory, then the one earlier in the original order
+        size_t best = 0;
+        std::tuple<size_t, ptrdiff_t, size_t> best_key{SIZE_MAX, 0, 0};
+        for (size_t i = 0; i < ready.size(); ++i) {
+            auto v = ready[i];
+            ptrdiff_t delta = index.out_size[v];
+            for (auto buf : index.node2read[v]) {
+                if (nr_reader_left[buf] == 1) {
+                    delta -= index.bufs[buf].size;
+                }
+            }
+            std::tuple<size_t, ptrdiff_t, size_t> key{
+                    std::max(peak, live + index.out_size[v]), delta, v};
+            if (key < best_key) {
+                best_key = key;
+                best = i;
+            }
+        }
+        auto v = ready[best];
+        ready.erase(ready.begin() + best);
+        order.push_back(v);
+
+        live += index.out_size[v];
+        peak = std::max(peak, live);
+        for (auto buf : index.node2read[v]) {
+            if (!--nr_reader_left[buf]) {
+                live -= index.bufs[buf].size;
+            }
+        }
+        for (auto s : m_nodes[v].succ) {
+            if (!--deg[s]) {
+                ready.push_back(s);
+            }
+        }
+    }
+    mgb_assert(order.size() == nr_node, "circular dependency in SeqMemOrderSearcher");
+    return order;
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,82 @@
+/**
+ * \file src/core/impl/graph/seq_mem_order.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#pragma once
+
+#include "megbrain/utils/metahelper.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace mgb {
+namespace cg {
+
+/*!
+ * \brief search an execution order of a DAG that minimizes the peak of live
+ *      memory
+ *
+ * Each node produces some buffers, and a buffer is alive from the step its
+ * producer is executed until all its readers are executed; buffers without
+ * readers are alive until the end. The peak is the max of total size of the
+ * live buffers when executing each node, which is a lower bound of the
+ * static memory arena size.
+ *
+ * An exact dynamic programming on the executed node sets is used if the number
+ * of reachable sets is small enough, and a greedy heuristic otherwise.
+ */
+class SeqMemOrderSearcher {
+public:
+    struct Buffer {
+        size_t size;
+        //! nodes reading this buffer
+        std::vector<size_t> readers;
+    };
+
+    struct Node {
+        //! buffers produced by this node
+        std::vector<Buffer> outputs;
+        //! nodes that must be executed after this node
+        std::vector<size_t> succ;
+    };
+
+    //! max number of node sets visited by dynamic programming
+    static constexpr size_t DEFAULT_DP_STATE_LIMIT = 1 << 16;
+
+    explicit SeqMemOrderSearcher(std::vector<Node> nodes)
+            : m_nodes(std::move(nodes)) {}
+
+    //! peak memory of a given order, which must be a topological order
+    size_t peak(const std::vector<size_t>& order) const;
+
+    /*!
+     * \brief search for the order with minimal peak
+     * \param[out] used_dp whether the result is from dynamic programming
+     */
+    std::vector<size_t> search(
+            size_t dp_state_limit = DEFAULT_DP_STATE_LIMIT,
+            bool* used_dp = nullptr) const;
+
+private:
+    struct DPState;
+    std::vector<Node> m_nodes;
+
+    //! return empty array if the limit is exceeded
+    std::vector<size_t> search_dp(size_t dp_state_limit) const;
+    std::vector<size_t> search_greedy() const;
+
+    //! number of predecessors of each node
+    std::vector<size_t> in_degree() const;
+};
+
+}  // namespace cg
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
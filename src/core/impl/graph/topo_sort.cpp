@@ -10,6 +10,7 @@
  */
 
 #include "./cg_impl.h"
+#include "./seq_mem_order.h"
 #include "megbrain/graph/exc_extra_info.h"
 #include "megbrain/graph/execution_mask.h"
 #include "megbrain/graph/helper.h"
@@ -442,6 +443,10 @@ const OprNodeArray* TopoSorter::get_comp_seq(
 
     bfs_make_seq();
 
+    if (!priority_remapper) {
+        mem_aware_reorder();
+    }
+
     m_cur_extra_info = nullptr;
     m_state = nullptr;
     return &m_seq;
@@ -549,6 +554,91 @@ void TopoSorter::bfs_make_seq() {
     }
 }
 
+void TopoSorter::mem_aware_reorder() {
+    auto&& options = m_owner_graph->options();
+    if (!options.seq_opt.enable_mem_aware_order ||
+        options.enable_sublinear_memory_opt || options.enable_dtr_memory_opt ||
+        options.enable_memory_swap) {
+        return;
+    }
+    auto&& opr_trait = m_state->opr_trait;
+    for (auto&& i : opr_trait) {
+        if (i.second.priority) {
+            // user-specified order should be respected
+            return;
+        }
+    }
+
+    using Flag = VarNode::Flag;
+    constexpr auto BAD_VAR_FLAG = Flag::VOLATILE_CONTENT |
+                                  Flag::NO_SYS_STATIC_MEM_ALLOC |
+                                  Flag::NO_SYS_MEM_ALLOC |
+                                  Flag::PERSISTENT_DEVICE_VALUE;
+
+    // vars with static shape are the buffers, and oprs are the nodes, whose
+    // indices are their positions in current sequence
+    auto&& infer_mgr = m_owner_graph->static_infer_manager();
+    std::vector<SeqMemOrderSearcher::Node> nodes(m_seq.size());
+    ThinHashMap<VarNode*, SeqMemOrderSearcher::Buffer*> var2buf;
+    for (size_t i = 0; i < m_seq.size(); ++i) {
+        auto&& node = nodes[i];
+        VarNodeArray buf_vars;
+        for (auto var : m_seq[i]->output()) {
+            if (var->contain_flag(BAD_VAR_FLAG)) {
+                continue;
+            }
+            if (auto shape = infer_mgr.infer_shape_fallible(var)) {
+                node.outputs.push_back(
+                        {var->dtype().size(shape->total_nr_elems()), {}});
+                buf_vars.push_back(var);
+            }
+        }
+        for (size_t j = 0; j < buf_vars.size(); ++j) {
+            var2buf[buf_vars[j]] = &node.outputs[j];
+        }
+        for (auto recv : opr_trait.at(m_seq[i]).receivers) {
+            node.succ.push_back(opr_trait.at(recv).pos);
+        }
+    }
+    for (size_t i = 0; i < m_seq.size(); ++i) {
+        for (auto&& dep : m_seq[i]->node_prop().dep_map()) {
+            if (OprNodeProp::is_device_value_dep(dep.second)) {
+                auto iter = var2buf.find(dep.first);
+                if (iter != var2buf.end()) {
+                    iter->second->readers.push_back(i);
+                }
+            }
+        }
+    }
+
+    SeqMemOrderSearcher searcher{std::move(nodes)};
+    std::vector<size_t> orig_order(m_seq.size());
+    for (size_t i = 0; i < orig_order.size(); ++i) {
+        orig_order[i] = i;
+    }
+    bool used_dp;
+    auto order = searcher.search(SeqMemOrderSearcher::DEFAULT_DP_STATE_LIMIT, &used_dp);
+    auto orig_peak = searcher.peak(orig_order), peak = searcher.peak(order);
+    if (options.log_level) {
+        mgb_log_debug(
+                "mem aware opr order (%s): peak static memory %.3fMiB -> "
+                "%.3fMiB",
+                used_dp ? "dp" : "greedy", orig_peak / 1024.0 / 1024,
+                std::min(orig_peak, peak) / 1024.0 / 1024);
+    }
+    if (peak >= orig_peak) {
+        return;
+    }
+
+    OprNodeArray seq(m_seq.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        auto opr = m_seq[order[i]];
+        seq[i] = opr;
+        opr_trait.at(opr).pos = i;
+    }
+    m_seq.swap(seq);
+}
+
 void TopoSorter::add_extra_comp_order_dep(OperatorNodeBase* opr, VarNode* var) {
     auto&& node_prop = const_cast<OprNodeProp&>(opr->node_prop());
     auto&& dep_map = node_prop.dep_map();
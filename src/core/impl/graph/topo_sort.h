@@ -78,6 +78,12 @@ private:
      */
     void bfs_make_seq();
 
+    /*!
+     * \brief reorder m_seq to minimize the peak of statically allocated
+     *      memory, if enabled by graph option
+     */
+    void mem_aware_reorder();
+
     /*!
      * \brief add computing order requriment on opr that var must finish
      *      before it
@@ -373,6 +373,15 @@ bool VarNodeMemManager::alloc_var_node_mem_static() {
     auto time0 = timer.get_msecs();
     make_static_var_tensor_from_alloc_plan();
 
+    auto&& event = m_owner_graph->event();
+    if (event.has_receiver<cg::event::CompilePhaseFinished>()) {
+        auto time1 = timer.get_msecs();
+        event.signal_inplace<cg::event::CompilePhaseFinished>(
+                m_owner_graph, "mem_plan", time0 * 1e-3);
+        event.signal_inplace<cg::event::CompilePhaseFinished>(
+                m_owner_graph, "mem_alloc", (time1 - time0) * 1e-3);
+    }
+
     MGB_MARK_USED_VAR(time0);
     if (m_owner_graph->options().log_level) {
         auto time1 = timer.get_msecs();
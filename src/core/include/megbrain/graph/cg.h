@@ -326,6 +326,11 @@ public:
             //! whether to enable comp node optimization (e.g. using copy
             //! stream for I/O operators)
             bool enable_seq_comp_node_opt = true;
+
+            //! whether to reorder the operators to minimize the peak of
+            //! statically allocated memory; it is ignored if the opr
+            //! priorities are given by user, sublinear or DTR
+            bool enable_mem_aware_order = false;
         } seq_opt;
 
         //! graph optimization options
@@ -350,6 +355,17 @@ public:
 
             //! whether to enable fine-grained TensorRT opr replace
             bool tensorrt = false;
+
+            //! whether to optimize arith expressions by equality saturation
+            //! (gopt::ArithEGraphPass) instead of the rule-based arith
+            //! pass chain
+            bool egraph_arith = false;
+
+            //! whether to memoize results of deterministic gopt passes (see
+            //! gopt::Pass::cache_key()) and reuse them when the same
+            //! subgraph is optimized again, e.g. on recompiling or when the
+            //! same model is loaded into another graph
+            bool pass_cache = false;
         } graph_opt;
 
         //! get attribute for an operator
@@ -463,6 +479,18 @@ public:
         //! changes (use previous algo)
         bool no_profiling_on_shape_change = false;
 
+        /*!
+         * \brief make the outputs bitwise identical regardless of the
+         * number of threads of the comp nodes
+         *
+         * Only reproducible algorithms are chosen, and the multi-threaded
+         * cpu kernels split their work into a fixed set of tiles so that
+         * the accumulation order does not depend on the thread count. This
+         * costs some throughput, which is reported by the AlgoChosen event
+         * when the algorithm is chosen by profiling.
+         */
+        bool deterministic = false;
+
         //! whether to perform defragmenting when memory allocation for a
         //! dynamic var fails
         bool enable_var_mem_defragment = true;
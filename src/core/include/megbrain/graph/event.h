@@ -224,6 +224,78 @@ struct SubgraphAssociated {
     MGB_TYPEINFO_OBJ_DECL_WITH_EXPORT;
 };
 
+/*!
+ * \brief signaled when a phase of graph compiling finishes
+ *
+ * Phases include "graph_opt", "topo_sort", "mem_plan_init",
+ * "static_infer_init" and "compile" during ComputingGraph::compile(), and
+ * "mem_plan" and "mem_alloc" when static memory is (re)planned.
+ */
+struct CompilePhaseFinished {
+    ComputingGraph* graph;
+
+    //! name of the phase, which must be a string literal
+    const char* phase;
+
+    //! wall time of the phase in seconds
+    double time;
+
+    MGB_TYPEINFO_OBJ_DECL_WITH_EXPORT;
+};
+
+/*!
+ * \brief signaled after a gopt pass has been applied on a subgraph
+ *
+ * The opr and var statistics are only computed if there is a receiver for
+ * this event.
+ */
+struct GraphOptPassApplied {
+    ComputingGraph* graph;
+
+    //! name of the pass
+    const char* pass;
+
+    //! wall time of the pass in seconds
+    double time;
+
+    //! number of oprs and vars in the subgraph after applying the pass
+    size_t nr_opr, nr_var;
+
+    //! number of oprs and vars added and removed by the pass
+    size_t nr_opr_added, nr_opr_removed, nr_var_added, nr_var_removed;
+
+    //! whether the result is reused from the pass cache
+    bool from_cache;
+
+    MGB_TYPEINFO_OBJ_DECL_WITH_EXPORT;
+};
+
+/*!
+ * \brief signaled after AlgoChooser sets up the algorithm of an operator
+ */
+struct AlgoChosen {
+    OperatorNodeBase* opr;
+
+    //! name of the chosen algorithm
+    const char* algo;
+
+    //! wall time of algorithm selection (including profiling) in seconds
+    double time;
+
+    //! whether the algorithm is taken from the heuristic cache
+    bool from_cache;
+
+    /*!
+     * time of the chosen algorithm with deterministic work split divided by
+     * that with the split adapted to the thread count; only measured when
+     * ComputingGraph::Options::deterministic is set and the algorithm is
+     * chosen by profiling, otherwise 0
+     */
+    double deterministic_slowdown = 0;
+
+    MGB_TYPEINFO_OBJ_DECL_WITH_EXPORT;
+};
+
 #if MGB_ENABLE_VAR_DEV_MEM_DEFRAGMENTER
 /*!
  * \brief signaled before graph memory defragementation
@@ -521,6 +521,10 @@ public:
     //! add_equivalence_component calls
     MGE_WIN_DECLSPEC_FUC size_t hash() const override final;
 
+    //! like hash(), but the identity of the inputs is not included, so the
+    //! same opr with the same params in another graph gets the same value
+    MGE_WIN_DECLSPEC_FUC size_t hash_ignore_inputs() const;
+
     /*!
      * \brief get node prop, which is available and constant after node
      *      construction
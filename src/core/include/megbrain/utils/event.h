@@ -103,6 +103,15 @@ public:
         }
     }
 
+    //! whether there is any receiver for events of type T
+    template <typename T>
+    bool has_receiver() const {
+        if (m_is_empty)
+            return false;
+        auto iter = m_receiver_map->find(T::typeinfo());
+        return iter != m_receiver_map->end() && !iter->second.empty();
+    }
+
     //! version of last modification; non-zero if any modification happened
     size_t version() const { return m_version; }
 
@@ -1748,6 +1748,41 @@ TEST(TestGraph, UpdateStaticAllocPlan) {
     func->execute();
 }
 
+TEST(TestGraph, MemAwareOprOrder) {
+    HostTensorGenerator<> gen;
+    auto host_x = gen({1, 8});
+    auto run = [&](bool mem_aware, HostTensorND& host_y) {
+        auto graph = ComputingGraph::make();
+        graph->options().seq_opt.enable_mem_aware_order = mem_aware;
+        graph->options().graph_opt_level = 0;
+        auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+        auto expand = [&](float delta) {
+            return opr::Broadcast::make(x, TensorShape{256, 8}) + delta;
+        };
+        auto reduce = [](SymbolVar var) {
+            return opr::Reduce::make(var, {opr::Reduce::Mode::SUM, 0});
+        };
+        // p is expanded first by the default order since its oprs have larger
+        // ids, and it is kept alive while g is expanded and reduced; reducing
+        // g first keeps only one expanded tensor alive
+        auto g = reduce(expand(2.f));
+        auto p = expand(1.f);
+        auto y = reduce(p + g);
+        auto func = graph->compile({make_callback_copy(y, host_y)});
+        size_t size = 0;
+        for (auto&& i : func->update_static_alloc_plan_and_get_size()) {
+            size += i.second;
+        }
+        func->execute();
+        return size;
+    };
+    HostTensorND host_y, host_y_expect;
+    auto size_expect = run(false, host_y_expect);
+    auto size = run(true, host_y);
+    MGB_ASSERT_TENSOR_EQ(host_y_expect, host_y);
+    ASSERT_LT(size, size_expect);
+}
+
 TEST(TestGraph, CPUGPUHybrid) {
     REQUIRE_GPU(1);
     auto cn_gpu = CompNode::load("gpu0");
@@ -0,0 +1,130 @@
+/**
+ * \file src/core/test/seq_mem_order.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "../impl/graph/seq_mem_order.h"
+#include "megbrain/test/helper.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace mgb;
+using namespace cg;
+
+namespace {
+
+using Node = SeqMemOrderSearcher::Node;
+
+bool is_topo_order(const std::vector<Node>& nodes, const std::vector<size_t>& order) {
+    if (order.size() != nodes.size()) {
+        return false;
+    }
+    std::vector<size_t> pos(order.size(), SIZE_MAX);
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (order[i] >= nodes.size() || pos[order[i]] != SIZE_MAX) {
+            return false;
+        }
+        pos[order[i]] = i;
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        for (auto j : nodes[i].succ) {
+            if (pos[i] > pos[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//! a source feeding several branches, each expands and then shrinks
+std::vector<Node> make_branches(size_t nr_branch) {
+    // node 0 is source, 2i+1 and 2i+2 are the branch, and the last is sink
+    size_t sink = nr_branch * 2 + 1;
+    std::vector<Node> nodes(sink + 1);
+    nodes[0].outputs.push_back({1, {}});
+    for (size_t i = 0; i < nr_branch; ++i) {
+        size_t big = i * 2 + 1, small = i * 2 + 2;
+        nodes[0].outputs[0].readers.push_back(big);
+        nodes[0].succ.push_back(big);
+        nodes[big].outputs.push_back({100, {small}});
+        nodes[big].succ.push_back(small);
+        nodes[small].outputs.push_back({1, {sink}});
+        nodes[small].succ.push_back(sink);
+    }
+    nodes[sink].outputs.push_back({1, {}});
+    return nodes;
+}
+
+}  // anonymous namespace
+
+TEST(TestSeqMemOrder, Branches) {
+    auto nodes = make_branches(3);
+    SeqMemOrderSearcher searcher{nodes};
+
+    // all the big buffers are alive together
+    ASSERT_EQ(301u, searcher.peak({0, 1, 3, 5, 2, 4, 6, 7}));
+
+    bool used_dp = false;
+    auto order = searcher.search(SeqMemOrderSearcher::DEFAULT_DP_STATE_LIMIT, &used_dp);
+    ASSERT_TRUE(used_dp);
+    ASSERT_TRUE(is_topo_order(nodes, order));
+    ASSERT_EQ(103u, searcher.peak(order));
+
+    order = searcher.search(1, &used_dp);
+    ASSERT_FALSE(used_dp);
+    ASSERT_TRUE(is_topo_order(nodes, order));
+    ASSERT_EQ(103u, searcher.peak(order));
+}
+
+TEST(TestSeqMemOrder, RandomDAGBruteForce) {
+    std::mt19937 rng(42);
+    constexpr size_t N = 7;
+    for (size_t iter = 0; iter < 20; ++iter) {
+        std::vector<Node> nodes(N);
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t j = i + 1; j < N; ++j) {
+                if (rng() % 3 == 0) {
+                    nodes[i].succ.push_back(j);
+                }
+            }
+            size_t nr_out = rng() % 3;
+            for (size_t k = 0; k < nr_out; ++k) {
+                SeqMemOrderSearcher::Buffer buf{rng() % 100 + 1, {}};
+                for (auto j : nodes[i].succ) {
+                    if (rng() % 2) {
+                        buf.readers.push_back(j);
+                    }
+                }
+                nodes[i].outputs.push_back(buf);
+            }
+        }
+        SeqMemOrderSearcher searcher{nodes};
+
+        std::vector<size_t> perm(N);
+        std::iota(perm.begin(), perm.end(), 0);
+        size_t best = SIZE_MAX;
+        do {
+            if (is_topo_order(nodes, perm)) {
+                best = std::min(best, searcher.peak(perm));
+            }
+        } while (std::next_permutation(perm.begin(), perm.end()));
+
+        auto order = searcher.search();
+        ASSERT_TRUE(is_topo_order(nodes, order));
+        ASSERT_EQ(best, searcher.peak(order));
+
+        order = searcher.search(1);
+        ASSERT_TRUE(is_topo_order(nodes, order));
+        ASSERT_LE(best, searcher.peak(order));
+    }
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
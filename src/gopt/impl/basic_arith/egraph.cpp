@@ -0,0 +1,626 @@
+/**
+ * \file src/gopt/impl/basic_arith/egraph.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "megbrain/gopt/basic_arith.h"
+#include "megbrain/opr/basic_arith_wrapper.h"
+#include "megbrain/utils/timer.h"
+
+#include <cmath>
+#include <limits>
+
+//! TODO: here has to be know some megdnn::opr when there is produced midout.h
+//! fix it if there is another graceful way.
+#include "megdnn/oprs.h"
+
+#include "megbrain/utils/hash_ct.h"
+#include "midout.h"
+
+MIDOUT_DECL(megbrain_egraph)
+#define MIDOUT_B(tag) MIDOUT_BEGIN(megbrain_egraph, midout_iv(MGB_HASH_STR(tag))) {
+#define MIDOUT_E \
+    }            \
+    MIDOUT_END();
+
+using namespace mgb;
+using namespace gopt;
+using namespace opr;
+
+namespace {
+using Mode = Elemwise::Mode;
+
+//! whether an elemwise mode can be represented by an e-node
+bool is_egraph_mode(Mode mode) {
+    switch (mode) {
+        case Mode::ADD:
+        case Mode::SUB:
+        case Mode::MUL:
+        case Mode::NEGATE:
+        case Mode::FUSE_MUL_ADD3:
+        case Mode::FUSE_MUL_ADD4:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//! return the Elemwise opr if var can be an internal node of an e-graph
+Elemwise* as_egraph_opr(VarNode* var) {
+    auto elem = try_cast_as_op<Elemwise>(var->owner_opr());
+    if (elem && is_egraph_mode(elem->param().mode) && var->shape().ndim &&
+        var->dtype().category() == DTypeCategory::FLOAT) {
+        return elem;
+    }
+    return nullptr;
+}
+}  // anonymous namespace
+
+/* ================ ArithEGraphPass::EGraph ================ */
+
+/*!
+ * \brief a minimal e-graph over elemwise arith expressions
+ *
+ * E-classes are stored in a union-find forest; congruence is restored by
+ * rebuild() after each batch of rewrites, which is affordable since a
+ * single expression is bounded by Config::max_nr_node.
+ */
+class ArithEGraphPass::EGraph {
+public:
+    using ClassId = size_t;
+
+    //! a leaf var, or an elemwise mode applied on e-classes
+    struct ENode {
+        VarNode* leaf = nullptr;
+        Mode mode = Mode::NEGATE;
+        SmallVector<ClassId, 4> children;
+
+        bool operator==(const ENode& rhs) const {
+            if (leaf || rhs.leaf)
+                return leaf == rhs.leaf;
+            return mode == rhs.mode && children == rhs.children;
+        }
+
+        struct Hash {
+            size_t operator()(const ENode& node) const {
+                if (node.leaf)
+                    return mgb::hash(node.leaf);
+                size_t ret = mgb::hash(static_cast<int>(node.mode));
+                for (auto i : node.children)
+                    ret = hash_pair_combine(ret, i);
+                return ret;
+            }
+        };
+    };
+
+    struct EClass {
+        std::vector<ENode> nodes;
+        TensorShape shape;
+    };
+
+    EGraph(const Config& config, DType dtype) : m_config{config}, m_dtype{dtype} {}
+
+    ClassId find(ClassId x) {
+        while (m_uf_parent[x] != x) {
+            x = m_uf_parent[x] = m_uf_parent[m_uf_parent[x]];
+        }
+        return x;
+    }
+
+    ClassId add_leaf(VarNode* var) {
+        ENode node;
+        node.leaf = var;
+        return add(std::move(node));
+    }
+
+    ClassId add(Mode mode, std::initializer_list<ClassId> children) {
+        ENode node;
+        node.mode = mode;
+        node.children.insert(node.children.end(), children.begin(), children.end());
+        return add(std::move(node));
+    }
+
+    ClassId add(ENode node);
+
+    //! merge two e-classes; return whether they were different
+    bool merge(ClassId a, ClassId b);
+
+    //! restore the congruence invariant and deduplicate e-nodes
+    void rebuild();
+
+    /*!
+     * \brief apply rewrite rules until saturation or limits are reached
+     * \return whether the e-graph has been saturated
+     */
+    bool saturate();
+
+    //! cost of evaluating a single e-node in class \p cls, excluding its
+    //! children
+    double node_cost(const ENode& node, ClassId cls);
+
+    /*!
+     * \brief extract the cheapest expression for each e-class
+     * \return the cost of given root e-class
+     */
+    double extract(ClassId root);
+
+    //! build the extracted expression; must be called after extract()
+    VarNode* build(ClassId root);
+
+    size_t nr_node() const { return m_nr_node; }
+
+    size_t nr_iter() const { return m_nr_iter; }
+
+private:
+    //! rules supported by saturate()
+    enum class Rule {
+        COMMUTE,       //!< a op b => b op a
+        ASSOCIATE,     //!< (a op b) op c => a op (b op c)
+        DISTRIBUTE,    //!< (a + b) * c => a * c + b * c
+        FACTOR,        //!< a * c + b * c => (a + b) * c
+        SUB_TO_ADD,    //!< a - b => a + (-b)
+        ADD_TO_SUB,    //!< a + (-b) => a - b
+        NEG_NEG,       //!< -(-a) => a
+        FUSE_FMA3,     //!< a * b + c => fma3(a, b, c)
+        FUSE_FMA4,     //!< a * b + c * d => fma4(a, b, c, d)
+        EXPAND_FMA3,   //!< fma3(a, b, c) => a * b + c
+        EXPAND_FMA4,   //!< fma4(a, b, c, d) => a * b + c * d
+    };
+
+    struct Match {
+        Rule rule;
+        ClassId cls;
+        Mode mode;
+        std::array<ClassId, 4> args;
+    };
+
+    const Config& m_config;
+    const DType m_dtype;
+    size_t m_nr_node = 0, m_nr_iter = 0;
+    std::vector<ClassId> m_uf_parent;
+    std::vector<EClass> m_classes;
+    std::unordered_map<ENode, ClassId, ENode::Hash> m_memo;
+
+    //! best (cost, node) of each e-class computed by extract()
+    std::vector<std::pair<double, const ENode*>> m_best;
+    ThinHashMap<ClassId, VarNode*> m_built;
+
+    const TensorShape& shape(ClassId x) { return m_classes[find(x)].shape; }
+
+    const std::vector<ENode>& nodes(ClassId x) { return m_classes[find(x)].nodes; }
+
+    size_t nr_bytes(ClassId x) {
+        return m_dtype.size(shape(x).total_nr_elems());
+    }
+
+    ENode canonize(ENode node) {
+        for (auto&& i : node.children)
+            i = find(i);
+        return node;
+    }
+
+    //! whether fma3(a, b, c) can be executed without falling back
+    bool check_fma3(ClassId a, ClassId b, ClassId c) {
+        auto&& cshp = shape(c);
+        return cshp.eq_shape(shape(a)) || cshp.eq_shape(shape(b)) ||
+               cshp.is_scalar();
+    }
+
+    //! whether fma4(a, b, c, d) can be executed without falling back
+    bool check_fma4(ClassId a, ClassId b, ClassId c, ClassId d) {
+        return (shape(a).eq_shape(shape(c)) && shape(b).eq_shape(shape(d))) ||
+               (shape(a).eq_shape(shape(d)) && shape(b).eq_shape(shape(c)));
+    }
+
+    void search(std::vector<Match>& matches);
+    bool apply(const Match& match);
+};
+
+ArithEGraphPass::EGraph::ClassId ArithEGraphPass::EGraph::add(ENode node) {
+    node = canonize(std::move(node));
+    auto iter = m_memo.find(node);
+    if (iter != m_memo.end())
+        return find(iter->second);
+
+    ClassId id = m_classes.size();
+    EClass cls;
+    if (node.leaf) {
+        cls.shape = node.leaf->shape();
+    } else {
+        TensorShapeArray inp_shp;
+        for (auto i : node.children)
+            inp_shp.push_back(shape(i));
+        cls.shape = Elemwise::get_output_var_shape(node.mode, inp_shp);
+    }
+    m_uf_parent.push_back(id);
+    m_memo[node] = id;
+    cls.nodes.emplace_back(std::move(node));
+    m_classes.emplace_back(std::move(cls));
+    ++m_nr_node;
+    return id;
+}
+
+bool ArithEGraphPass::EGraph::merge(ClassId a, ClassId b) {
+    a = find(a);
+    b = find(b);
+    if (a == b)
+        return false;
+    if (a > b)
+        std::swap(a, b);
+    auto&& ca = m_classes[a];
+    auto&& cb = m_classes[b];
+    mgb_assert(ca.shape.eq_shape(cb.shape));
+    m_uf_parent[b] = a;
+    ca.nodes.insert(
+            ca.nodes.end(), std::make_move_iterator(cb.nodes.begin()),
+            std::make_move_iterator(cb.nodes.end()));
+    cb.nodes.clear();
+    return true;
+}
+
+void ArithEGraphPass::EGraph::rebuild() {
+    std::vector<std::pair<ClassId, ClassId>> pending;
+    do {
+        for (auto&& i : pending)
+            merge(i.first, i.second);
+        pending.clear();
+        m_memo.clear();
+        m_nr_node = 0;
+        for (ClassId id = 0; id < m_classes.size(); ++id) {
+            if (find(id) != id)
+                continue;
+            auto&& src = m_classes[id].nodes;
+            std::vector<ENode> dst;
+            dst.reserve(src.size());
+            for (auto&& node : src) {
+                auto cnode = canonize(node);
+                auto ins = m_memo.insert({cnode, id});
+                if (ins.second) {
+                    dst.emplace_back(std::move(cnode));
+                } else if (find(ins.first->second) != id) {
+                    // congruent nodes in different classes
+                    pending.emplace_back(ins.first->second, id);
+                }
+            }
+            m_nr_node += dst.size();
+            src = std::move(dst);
+        }
+    } while (!pending.empty());
+}
+
+void ArithEGraphPass::EGraph::search(std::vector<Match>& matches) {
+    auto limit = m_config.max_nr_node;
+    auto emit = [&](Rule rule, ClassId cls, Mode mode,
+                    std::initializer_list<ClassId> args) {
+        Match m{rule, cls, mode, {{0, 0, 0, 0}}};
+        std::copy(args.begin(), args.end(), m.args.begin());
+        matches.push_back(m);
+    };
+    for (ClassId cls = 0; cls < m_classes.size() && matches.size() < limit; ++cls) {
+        if (find(cls) != cls)
+            continue;
+        for (auto&& node : m_classes[cls].nodes) {
+            if (node.leaf)
+                continue;
+            auto&& ch = node.children;
+            switch (node.mode) {
+                case Mode::ADD:
+                case Mode::MUL: {
+                    auto mode = node.mode;
+                    emit(Rule::COMMUTE, cls, mode, {ch[1], ch[0]});
+                    for (auto&& i : nodes(ch[0])) {
+                        if (!i.leaf && i.mode == mode) {
+                            emit(Rule::ASSOCIATE, cls, mode,
+                                 {i.children[0], i.children[1], ch[1]});
+                        }
+                        if (!i.leaf && mode == Mode::MUL && i.mode == Mode::ADD) {
+                            emit(Rule::DISTRIBUTE, cls, mode,
+                                 {i.children[0], i.children[1], ch[1]});
+                        }
+                        if (i.leaf || mode != Mode::ADD || i.mode != Mode::MUL)
+                            continue;
+                        auto a = i.children[0], b = i.children[1];
+                        if (check_fma3(a, b, ch[1])) {
+                            emit(Rule::FUSE_FMA3, cls, mode, {a, b, ch[1]});
+                        }
+                        for (auto&& j : nodes(ch[1])) {
+                            if (j.leaf || j.mode != Mode::MUL)
+                                continue;
+                            auto c = j.children[0], d = j.children[1];
+                            if (find(b) == find(d)) {
+                                emit(Rule::FACTOR, cls, mode, {a, c, b});
+                            }
+                            if (check_fma4(a, b, c, d)) {
+                                emit(Rule::FUSE_FMA4, cls, mode, {a, b, c, d});
+                            }
+                        }
+                    }
+                    if (mode == Mode::ADD) {
+                        for (auto&& i : nodes(ch[1])) {
+                            if (!i.leaf && i.mode == Mode::NEGATE) {
+                                emit(Rule::ADD_TO_SUB, cls, mode,
+                                     {ch[0], i.children[0]});
+                            }
+                        }
+                    }
+                    break;
+                }
+                case Mode::SUB:
+                    emit(Rule::SUB_TO_ADD, cls, node.mode, {ch[0], ch[1]});
+                    break;
+                case Mode::NEGATE:
+                    for (auto&& i : nodes(ch[0])) {
+                        if (!i.leaf && i.mode == Mode::NEGATE) {
+                            emit(Rule::NEG_NEG, cls, node.mode, {i.children[0]});
+                        }
+                    }
+                    break;
+                case Mode::FUSE_MUL_ADD3:
+                    emit(Rule::EXPAND_FMA3, cls, node.mode, {ch[0], ch[1], ch[2]});
+                    break;
+                case Mode::FUSE_MUL_ADD4:
+                    emit(Rule::EXPAND_FMA4, cls, node.mode,
+                         {ch[0], ch[1], ch[2], ch[3]});
+                    break;
+                default:
+                    mgb_assert(0);
+            }
+        }
+    }
+}
+
+bool ArithEGraphPass::EGraph::apply(const Match& m) {
+    auto nr_class = m_classes.size();
+    auto&& a = m.args;
+    ClassId result;
+    switch (m.rule) {
+        case Rule::COMMUTE:
+            result = add(m.mode, {a[0], a[1]});
+            break;
+        case Rule::ASSOCIATE:
+            result = add(m.mode, {a[0], add(m.mode, {a[1], a[2]})});
+            break;
+        case Rule::DISTRIBUTE:
+            result =
+                    add(Mode::ADD,
+                        {add(Mode::MUL, {a[0], a[2]}), add(Mode::MUL, {a[1], a[2]})});
+            break;
+        case Rule::FACTOR:
+            result = add(Mode::MUL, {add(Mode::ADD, {a[0], a[1]}), a[2]});
+            break;
+        case Rule::SUB_TO_ADD:
+            result = add(Mode::ADD, {a[0], add(Mode::NEGATE, {a[1]})});
+            break;
+        case Rule::ADD_TO_SUB:
+            result = add(Mode::SUB, {a[0], a[1]});
+            break;
+        case Rule::NEG_NEG:
+            result = a[0];
+            break;
+        case Rule::FUSE_FMA3:
+            result = add(Mode::FUSE_MUL_ADD3, {a[0], a[1], a[2]});
+            break;
+        case Rule::FUSE_FMA4:
+            result = add(Mode::FUSE_MUL_ADD4, {a[0], a[1], a[2], a[3]});
+            break;
+        case Rule::EXPAND_FMA3:
+            result = add(Mode::ADD, {add(Mode::MUL, {a[0], a[1]}), a[2]});
+            break;
+        case Rule::EXPAND_FMA4:
+            result =
+                    add(Mode::ADD,
+                        {add(Mode::MUL, {a[0], a[1]}), add(Mode::MUL, {a[2], a[3]})});
+            break;
+        default:
+            mgb_assert(0);
+    }
+    bool changed = merge(m.cls, result);
+    return changed || m_classes.size() != nr_class;
+}
+
+bool ArithEGraphPass::EGraph::saturate() {
+    RealTimer timer;
+    std::vector<Match> matches;
+    for (m_nr_iter = 0; m_nr_iter < m_config.max_nr_iter; ++m_nr_iter) {
+        matches.clear();
+        search(matches);
+        bool changed = false;
+        for (auto&& i : matches) {
+            changed |= apply(i);
+            if (m_classes.size() >= m_config.max_nr_node)
+                break;
+        }
+        rebuild();
+        if (!changed)
+            return true;
+        if (m_nr_node >= m_config.max_nr_node ||
+            timer.get_secs() >= m_config.time_limit) {
+            break;
+        }
+    }
+    return false;
+}
+
+double ArithEGraphPass::EGraph::node_cost(const ENode& node, ClassId cls) {
+    if (node.leaf)
+        return 0;
+    // memory traffic of reading all inputs and writing the output; the extra
+    // byte ensures that costs strictly increase along any path
+    double cost = m_config.kern_launch_cost + 1 + nr_bytes(cls);
+    for (auto i : node.children)
+        cost += nr_bytes(i);
+    return cost;
+}
+
+double ArithEGraphPass::EGraph::extract(ClassId root) {
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    m_best.assign(m_classes.size(), {INF, nullptr});
+    m_built.clear();
+    bool changed;
+    do {
+        changed = false;
+        for (ClassId cls = 0; cls < m_classes.size(); ++cls) {
+            if (find(cls) != cls)
+                continue;
+            auto&& best = m_best[cls];
+            for (auto&& node : m_classes[cls].nodes) {
+                double cost = node_cost(node, cls);
+                for (auto i : node.children)
+                    cost += m_best[find(i)].first;
+                if (cost < best.first) {
+                    best = {cost, &node};
+                    changed = true;
+                }
+            }
+        }
+    } while (changed);
+    auto ret = m_best[find(root)].first;
+    mgb_assert(std::isfinite(ret));
+    return ret;
+}
+
+VarNode* ArithEGraphPass::EGraph::build(ClassId root) {
+    root = find(root);
+    auto iter = m_built.find(root);
+    if (iter != m_built.end())
+        return iter->second;
+    auto node = m_best[root].second;
+    mgb_assert(node);
+    VarNode* ret;
+    if (node->leaf) {
+        ret = node->leaf;
+    } else {
+        VarNodeArray inputs;
+        for (auto i : node->children)
+            inputs.push_back(build(i));
+        ret = Elemwise::make(inputs, node->mode).node();
+    }
+    m_built[root] = ret;
+    return ret;
+}
+
+/* ================ ArithEGraphPass::Impl ================ */
+
+class ArithEGraphPass::Impl {
+    using ClassId = EGraph::ClassId;
+
+    const Config& m_config;
+    OptState& m_opt_state;
+    SubGraph::Rewriter m_rewriter;
+    ThinHashMap<VarNode*, size_t> m_var2nr_val_dep;
+    //! vars that are only read by another arith opr in the same expression
+    ThinHashSet<VarNode*> m_internal_vars;
+
+    void find_internal_vars();
+
+    void on_opr(OperatorNodeBase* opr);
+
+    void process_expr(VarNode* endpoint);
+
+public:
+    Impl(const Config& config, OptState& opt_state)
+            : m_config{config},
+              m_opt_state{opt_state},
+              m_rewriter{opt_state.graph().make_rewriter()},
+              m_var2nr_val_dep{opt_state.graph().get_var2nr_val_dep_oprs()} {
+        using namespace std::placeholders;
+        find_internal_vars();
+        opt_state.graph().iter(std::bind(&Impl::on_opr, this, _1));
+        m_rewriter.apply_inplace();
+    }
+};
+
+void ArithEGraphPass::Impl::find_internal_vars() {
+    auto on_opr = [this](OperatorNodeBase* opr) {
+        auto out = get_opr_single_output_var(opr);
+        if (!out || !as_egraph_opr(out))
+            return;
+        for (auto i : opr->input()) {
+            auto iter = m_var2nr_val_dep.find(i);
+            if (iter != m_var2nr_val_dep.end() && iter->second == 1 &&
+                as_egraph_opr(i) && i->comp_node() == out->comp_node() &&
+                i->dtype() == out->dtype()) {
+                m_internal_vars.insert(i);
+            }
+        }
+    };
+    m_opt_state.graph().iter(on_opr);
+}
+
+void ArithEGraphPass::Impl::on_opr(OperatorNodeBase* opr) {
+    m_rewriter.auto_replace_outputs(opr);
+    auto out = get_opr_single_output_var(opr);
+    if (out && as_egraph_opr(out) && !m_internal_vars.count(out)) {
+        process_expr(out);
+    }
+}
+
+void ArithEGraphPass::Impl::process_expr(VarNode* endpoint) {
+    EGraph egraph{m_config, endpoint->dtype()};
+    ThinHashMap<VarNode*, ClassId> var2cls;
+    double orig_cost = 0;
+
+    // insert the original expression tree; leaves are taken from rewriter
+    // since they have been processed in topological order
+    auto insert = [&](VarNode* var, auto&& self) -> ClassId {
+        auto iter = var2cls.find(var);
+        if (iter != var2cls.end())
+            return iter->second;
+        ClassId ret;
+        if (var == endpoint || m_internal_vars.count(var)) {
+            auto elem = as_egraph_opr(var);
+            mgb_assert(elem);
+            EGraph::ENode node;
+            node.mode = elem->param().mode;
+            for (auto i : elem->input())
+                node.children.push_back(self(i, self));
+            ret = egraph.add(node);
+            orig_cost += egraph.node_cost(node, ret);
+        } else {
+            ret = egraph.add_leaf(m_rewriter.get_var(var));
+        }
+        var2cls[var] = ret;
+        return ret;
+    };
+    auto root = insert(endpoint, insert);
+    if (var2cls.size() <= 2) {
+        // a unary opr on a leaf; nothing to optimize
+        return;
+    }
+
+    bool saturated = egraph.saturate();
+    auto cost = egraph.extract(root);
+    // tolerate rounding errors when comparing costs
+    if (cost >= orig_cost * (1 - 1e-6)) {
+        return;
+    }
+
+    auto new_var = egraph.build(root);
+    m_rewriter.replace_var(
+            endpoint, new_var,
+            mgb_ssprintf_log(
+                    "egraph: cost %.0f->%.0f, %zu nodes, %zu iters%s", orig_cost,
+                    cost, egraph.nr_node(), egraph.nr_iter(),
+                    saturated ? "" : ", not saturated")
+                    .c_str());
+}
+
+/* ================ ArithEGraphPass ================ */
+
+const char* ArithEGraphPass::name() const {
+    return mgb_cstr_log("arith_egraph");
+}
+
+void ArithEGraphPass::apply(OptState& opt) const {
+    MIDOUT_B("ArithEGraphPass::apply")
+    Impl{m_config, opt};
+    MIDOUT_E
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -35,6 +35,8 @@
 #include "megbrain/gopt/profiler.h"
 #include "megbrain/gopt/solver.h"
 
+#include <cinttypes>
+
 using namespace mgb;
 using namespace gopt;
 
@@ -552,6 +554,242 @@ public:
 };
 MGB_TYPEINFO_OBJ_IMPL(GraphOptimizer::VarReplaceMapStorage);
 
+/*!
+ * \brief results of cached passes, shared by all graphs
+ *
+ * An entry refers to the vars of the graph in which the pass was applied, and
+ * expires with that graph.
+ */
+class GraphOptimizer::PassCacheStorage {
+public:
+    struct Entry {
+        std::weak_ptr<ComputingGraph> graph;
+        //! outputs of the source oprs of the original subgraph, in the order
+        //! given by SubGraphStructure
+        VarNodeArray leaves;
+        //! optimized endpoint vars
+        VarNodeArray dest;
+    };
+
+    static PassCacheStorage& inst() {
+        static PassCacheStorage storage;
+        return storage;
+    }
+
+    //! get the entry of given key and lock its graph; return false if the
+    //! key is not found or the graph has been destructed
+    bool get(
+            const std::string& key, Entry& entry,
+            std::shared_ptr<ComputingGraph>& graph) {
+        MGB_LOCK_GUARD(m_mtx);
+        auto iter = m_map.find(key);
+        if (iter == m_map.end()) {
+            return false;
+        }
+        graph = iter->second.graph.lock();
+        if (!graph) {
+            m_map.erase(iter);
+            return false;
+        }
+        entry = iter->second;
+        return true;
+    }
+
+    void put(const std::string& key, Entry entry) {
+        MGB_LOCK_GUARD(m_mtx);
+        for (auto iter = m_map.begin(); iter != m_map.end();) {
+            if (iter->second.graph.expired()) {
+                iter = m_map.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+        m_map[key] = std::move(entry);
+    }
+
+private:
+    MGB_MUTEX m_mtx;
+    //! (pass cache key, subgraph hash) => entry
+    std::unordered_map<std::string, Entry> m_map;
+};
+
+namespace {
+//! oprs and vars in a subgraph, used for computing pass statistics
+struct SubGraphContent {
+    ThinHashSet<OperatorNodeBase*> oprs;
+    ThinHashSet<VarNode*> vars;
+
+    explicit SubGraphContent(const SubGraph& graph) {
+        graph.iter([this](OperatorNodeBase* opr) {
+            oprs.insert(opr);
+            for (auto i : opr->output()) {
+                vars.insert(i);
+            }
+        });
+    }
+
+    //! number of items in \p a but not in \p b
+    template <class Set>
+    static size_t nr_diff(const Set& a, const Set& b) {
+        size_t ret = 0;
+        for (auto i : a) {
+            ret += !b.count(i);
+        }
+        return ret;
+    }
+};
+
+uint64_t hash_value(const DeviceTensorND& value) {
+    HostTensorND host;
+    host.copy_from(value).sync();
+    return XXHash{}.update(host.raw_ptr(), host.layout().span().dist_byte()).digest();
+}
+
+//! hash the value of an opr accepted by is_const_var()
+uint64_t hash_const_value(OperatorNodeBase* opr) {
+    if (auto imm = try_cast_as_op<opr::ImmutableTensor>(opr)) {
+        return hash_value(imm->value());
+    }
+    if (auto param = try_cast_as_op<opr::SharedDeviceTensor>(opr)) {
+        return hash_value(param->get_dev_tensor());
+    }
+    uint64_t ret = 0;
+    for (auto&& i : opr->cast_final_safe<opr::MultipleDeviceTensorHolder>().values()) {
+        ret = hash_pair_combine(ret, hash_value(*i));
+    }
+    return ret;
+}
+
+/*!
+ * \brief structural hash of a subgraph, which does not depend on the identity
+ *      of its vars, so the same subgraph in another graph gets the same hash
+ *
+ * Oprs are hashed by their types, params, comp nodes and output shapes and
+ * dtypes. Source oprs are numbered in the order they are reached from the
+ * endpoints, and the values of the const source oprs are hashed as well.
+ */
+struct SubGraphStructure {
+    uint64_t hash;
+    //! outputs of the source oprs in the order they are numbered
+    VarNodeArray leaves;
+
+    SubGraphStructure(const SymbolVarArray& endpoints, ConstVarType value_type) {
+        ThinHashMap<OperatorNodeBase*, uint64_t> opr2hash;
+        auto var_hash = [&opr2hash](VarNode* var) -> uint64_t {
+            auto opr = var->owner_opr();
+            size_t idx = 0;
+            while (opr->output(idx) != var) {
+                ++idx;
+            }
+            return hash_pair_combine(opr2hash.at(opr), idx);
+        };
+        auto on_opr = [&](OperatorNodeBase* opr) {
+            XXHash hstate;
+            auto update = [&hstate](uint64_t val) { hstate.update(&val, sizeof(val)); };
+            if (opr->input().empty()) {
+                // the equivalence components of source oprs refer to their
+                // data, so only the type and config are hashed
+                update(mgb::hash(opr->dyn_typeinfo()));
+                update(opr->config().hash());
+                update(leaves.size());
+                if (is_const_var(value_type, opr)) {
+                    update(hash_const_value(opr));
+                }
+                leaves.insert(leaves.end(), opr->output().begin(), opr->output().end());
+            } else {
+                update(opr->hash_ignore_inputs());
+                for (auto i : opr->input()) {
+                    update(var_hash(i));
+                }
+            }
+            for (auto i : opr->output()) {
+                auto&& shape = i->shape();
+                update(mgb::hash(i->comp_node()));
+                update(mgb::hash(i->dtype().handle()));
+                update(shape.ndim);
+                hstate.update(shape.shape, sizeof(shape.shape[0]) * shape.ndim);
+            }
+            opr2hash[opr] = hstate.digest();
+        };
+
+        // post-order DFS following the order of inputs, so the numbering of
+        // source oprs only depends on the structure
+        ThinHashSet<OperatorNodeBase*> visited;
+        std::vector<std::pair<OperatorNodeBase*, size_t>> stack;
+        auto push = [&](OperatorNodeBase* opr) {
+            if (visited.insert(opr).second) {
+                stack.emplace_back(opr, 0);
+            }
+        };
+        XXHash hstate;
+        for (auto&& i : endpoints) {
+            push(i.node()->owner_opr());
+            while (!stack.empty()) {
+                auto&& top = stack.back();
+                if (top.second < top.first->input().size()) {
+                    auto inp = top.first->input(top.second++);
+                    push(inp->owner_opr());
+                } else {
+                    on_opr(top.first);
+                    stack.pop_back();
+                }
+            }
+            uint64_t val = var_hash(i.node());
+            hstate.update(&val, sizeof(val));
+        }
+        hash = hstate.digest();
+    }
+};
+
+/*!
+ * \brief copy the oprs that \p dest depends on into \p graph, with the vars
+ *      \p src_leaves replaced by \p leaves
+ *
+ * Oprs already in \p graph whose inputs are not replaced are reused.
+ */
+VarNodeArray replay_pass_result(
+        ComputingGraph* graph, const VarNodeArray& src_leaves,
+        const VarNodeArray& dest, const VarNodeArray& leaves) {
+    mgb_assert(src_leaves.size() == leaves.size());
+    ThinHashMap<VarNode*, VarNode*> varmap;
+    for (size_t i = 0; i < leaves.size(); ++i) {
+        varmap[src_leaves[i]] = leaves[i];
+    }
+    VarNodeArray new_inp;
+    cg::DepOprIter iter{[&](OperatorNodeBase* opr) {
+        if (varmap.count(opr->output(0))) {
+            return;
+        }
+        bool changed = opr->owner_graph() != graph;
+        new_inp.clear();
+        for (auto i : opr->input()) {
+            auto var = varmap.at(i);
+            changed |= var != i;
+            new_inp.push_back(var);
+        }
+        auto new_opr = opr;
+        if (changed) {
+            new_opr = serialization::copy_opr_shallow(
+                    *opr, new_inp, opr->config(), {graph});
+            if (opr->owner_graph() != graph) {
+                // the source graph may be destructed before this one
+                new_opr->node_prop().attribute().src_opr = nullptr;
+            }
+        }
+        mgb_assert(new_opr->output().size() == opr->output().size());
+        for (size_t i = 0; i < opr->output().size(); ++i) {
+            varmap[opr->output(i)] = new_opr->output(i);
+        }
+    }};
+    VarNodeArray ret;
+    for (auto i : dest) {
+        iter.add(i->owner_opr());
+        ret.push_back(varmap.at(i));
+    }
+    return ret;
+}
+}  // anonymous namespace
+
 GraphOptimizer& GraphOptimizer::add_pass(std::unique_ptr<Pass> pass) {
     mgb_assert(!pass->m_owner_optimizer);
     pass->m_owner_optimizer = this;
@@ -559,6 +797,52 @@ GraphOptimizer& GraphOptimizer::add_pass(std::unique_ptr<Pass> pass) {
     return *this;
 }
 
+bool GraphOptimizer::apply_pass(const Pass& pass, OptState& state) const {
+    auto&& graph = state.graph();
+    auto comp_graph = graph.comp_graph();
+    std::string key;
+    if (comp_graph->options().graph_opt.pass_cache) {
+        key = pass.cache_key();
+    }
+    if (key.empty()) {
+        pass.apply(state);
+        return false;
+    }
+
+    SubGraphStructure structure{
+            graph.endpoint_vars(), pass.cache_param_values()
+                                           ? ConstVarType::IMMUTABLE_AND_PARAM
+                                           : ConstVarType::IMMUTABLE};
+    key.append(ssprintf(",%016" PRIx64, structure.hash));
+    auto&& storage = PassCacheStorage::inst();
+    PassCacheStorage::Entry entry;
+    std::shared_ptr<ComputingGraph> src_graph;
+    if (storage.get(key, entry, src_graph) &&
+        entry.leaves.size() == structure.leaves.size()) {
+        auto dest = replay_pass_result(
+                comp_graph, entry.leaves, entry.dest, structure.leaves);
+        auto&& src = graph.endpoint_vars();
+        mgb_assert(dest.size() == src.size());
+        auto rewriter = graph.make_rewriter();
+        for (size_t i = 0; i < src.size(); ++i) {
+            rewriter.replace_var(
+                    src[i].node(), dest[i], mgb_cstr_log("reuse cached pass result"));
+        }
+        rewriter.apply_inplace();
+        return true;
+    }
+
+    pass.apply(state);
+    entry.graph = comp_graph->shared_from_this();
+    entry.leaves = std::move(structure.leaves);
+    entry.dest.clear();
+    for (auto&& i : graph.endpoint_vars()) {
+        entry.dest.push_back(i.node());
+    }
+    storage.put(key, std::move(entry));
+    return false;
+}
+
 SubGraph GraphOptimizer::apply(const SubGraph& graph) const {
     RealTimer timer;
     OptState state{this, graph};
@@ -568,8 +852,15 @@ SubGraph GraphOptimizer::apply(const SubGraph& graph) const {
     // first update output var shapes of all oprs
     state.graph().iter(cg::update_output_var_shapes);
 
-    auto&& opt = graph.comp_graph()->options();
+    auto comp_graph = graph.comp_graph();
+    auto&& opt = comp_graph->options();
     auto orig_setting = opt.graph_opt_level;
+    bool need_pass_stat =
+            comp_graph->event().has_receiver<cg::event::GraphOptPassApplied>();
+    std::unique_ptr<SubGraphContent> content;
+    if (need_pass_stat) {
+        content = std::make_unique<SubGraphContent>(state.graph());
+    }
     Pass* cur_pass = nullptr;
     MGB_MARK_USED_VAR(cur_pass);
     MGB_TRY {
@@ -577,9 +868,23 @@ SubGraph GraphOptimizer::apply(const SubGraph& graph) const {
             state.set_var_replace_check_flag(VarReplaceCheckFlag::CHECK_ALL);
             cur_pass = i.get();
             opt.graph_opt_level = 1;
-            i->apply(state);
+            RealTimer pass_timer;
+            bool from_cache = apply_pass(*i, state);
+            auto pass_time = pass_timer.get_secs();
             tot_nr_replace += state.flush_log(
                     mgb_ssprintf_log("apply optimization pass %s:", i->name()).c_str());
+            if (need_pass_stat) {
+                auto new_content = std::make_unique<SubGraphContent>(state.graph());
+                auto&& c0 = *content;
+                auto&& c1 = *new_content;
+                comp_graph->event().signal_inplace<cg::event::GraphOptPassApplied>(
+                        comp_graph, i->name(), pass_time, c1.oprs.size(),
+                        c1.vars.size(), SubGraphContent::nr_diff(c1.oprs, c0.oprs),
+                        SubGraphContent::nr_diff(c0.oprs, c1.oprs),
+                        SubGraphContent::nr_diff(c1.vars, c0.vars),
+                        SubGraphContent::nr_diff(c0.vars, c1.vars), from_cache);
+                content = std::move(new_content);
+            }
         }
     }
     MGB_CATCH(std::exception & exc, {
@@ -628,14 +933,24 @@ GraphOptimizer& GraphOptimizer::add_preset_passes(
         add_pass<RemoveNonComputingOprPass>();
     }
     add_pass<DelayBroadcastPass>();
-    add_pass<ExpandFusedArithPass>();
-    add_pass<NormalizeArithChainPass>();
-    if (inference_opt) {
-        add_pass<ParamRedistributePass>();
-        add_pass<ParamFusePass>();
+    if (comp_graph_opt && comp_graph_opt->graph_opt.egraph_arith) {
+        if (inference_opt) {
+            add_pass<ParamRedistributePass>();
+            add_pass<ParamFusePass>();
+        }
+        // equality saturation covers expanding, normalizing, distributing
+        // and reordering arith chains at once
+        add_pass<ArithEGraphPass>();
+    } else {
+        add_pass<ExpandFusedArithPass>();
+        add_pass<NormalizeArithChainPass>();
+        if (inference_opt) {
+            add_pass<ParamRedistributePass>();
+            add_pass<ParamFusePass>();
+        }
+        add_pass<ArithMulDistributePass>();
+        add_pass<ReorderArithChainPass>(cv_type);
     }
-    add_pass<ArithMulDistributePass>();
-    add_pass<ReorderArithChainPass>(cv_type);
 
     add_pass<ArithFusePass>();
     // reorder again because shapes of fused oprs might change
@@ -643,6 +958,7 @@ GraphOptimizer& GraphOptimizer::add_preset_passes(
     add_pass<FinalArithTransformPass>();
     add_pass<RemoveRedundantTypeCvtPass>();
     add_pass<RemoveRedundantCopyPass>();
+    add_pass<FoldViewChainPass>();
 
     //! Only arm_common implement Fuse TypeCvt and Elemwise optimized kernel
 #if (MEGDNN_AARCH64 || MEGDNN_ARMV7) && !MGB_OPENCL && !MGB_CUDA
@@ -566,4 +566,12 @@ bool DynamicProgrammingSolver::can_solve(const Problem& problem) const {
     return true;
 }
 
+std::string DynamicProgrammingSolver::cache_key() const {
+    auto key = profiling_cache_key();
+    if (key.empty()) {
+        return key;
+    }
+    return "dp_solver:" + key;
+}
+
 // vim: syntax=cpp.doxygen
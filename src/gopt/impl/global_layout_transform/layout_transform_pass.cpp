@@ -194,6 +194,51 @@ void LayoutTransformPass::apply(OptState& opt) const {
     MIDOUT_E
 }
 
+std::string LayoutTransformPass::cache_key() const {
+    auto solver_key = m_solver->cache_key();
+    if (solver_key.empty()) {
+        return {};
+    }
+    auto&& attr = m_ctx->attribute();
+    std::string ret = ssprintf(
+            "%s:%s:%u:%u:%d:%u", name(), solver_key.c_str(),
+            static_cast<uint32_t>(attr.base_config_id),
+            static_cast<uint32_t>(attr.base_tensor_formats),
+            static_cast<int>(attr.target),
+            static_cast<uint32_t>(attr.reformat_attribute));
+    // opr list is a hash set, so sort it to get a stable key
+    std::vector<std::string> oprs;
+    for (auto&& i : m_ctx->opr_list()) {
+        oprs.emplace_back(i->name);
+    }
+    std::sort(oprs.begin(), oprs.end());
+    for (auto&& i : oprs) {
+        ret.append(":").append(i);
+    }
+    for (auto i : m_ctx->available_tensor_formats()) {
+        ret.append(ssprintf(":%u", static_cast<uint32_t>(i)));
+    }
+    // the opr format configs of the problem, sorted as well
+    std::vector<std::string> configs;
+    for (auto&& i : m_ctx->opr_configs()) {
+        std::vector<uint32_t> ids;
+        for (auto&& j : i.second) {
+            ids.push_back(static_cast<uint32_t>(j.first));
+        }
+        std::sort(ids.begin(), ids.end());
+        std::string cfg = i.first->name;
+        for (auto j : ids) {
+            cfg.append(ssprintf(",%u", j));
+        }
+        configs.emplace_back(std::move(cfg));
+    }
+    std::sort(configs.begin(), configs.end());
+    for (auto&& i : configs) {
+        ret.append(":").append(i);
+    }
+    return ret;
+}
+
 std::unique_ptr<LayoutTransformPass> LayoutTransformPass::make(
         GraphTuningOptions::Target target) {
     MIDOUT_B("make")
@@ -677,14 +677,25 @@ struct ConvTensorFormatsDispatcherImpl<Opr, OprFormatConfigID::NCHW88> {
         config.opr_format = OprFormat::NCHW88;
         config.config_id = OprFormatConfigID::NCHW88;
         bool available = true;
+        auto check_dtype = [](DType dt, bool is_bias) {
+            bool f32_config = dt.enumv() == DTypeEnum::Float32;
+            auto i8_dtype = DTypeEnum::QuantizedS8;
+            if (is_bias)
+                i8_dtype = DTypeEnum::QuantizedS32;
+            bool i8_config = dt.enumv() == i8_dtype &&
+                             megdnn::ConvBiasForward::is_nchw88_int8_optimized();
+            return f32_config || i8_config;
+        };
         // setup dtypes
         for (size_t i = 0; i < opr->input().size(); ++i) {
-            available &= opr->input(i)->dtype().enumv() == DTypeEnum::Float32;
+            bool is_bias =
+                    ConvParamTrait<Opr>::has_bias && i == ConvParamTrait<Opr>::bias_idx;
+            available &= check_dtype(opr->input(i)->dtype(), is_bias);
             config.input_dtypes.emplace_back(opr->input(i)->dtype().enumv());
             TensorType tensor_type = i == 1 ? TensorType::WEIGHT : TensorType::FEATURE;
             config.input_tensor_types.emplace_back(tensor_type);
         }
-        available &= opr->output(0)->dtype().enumv() == DTypeEnum::Float32;
+        available &= check_dtype(opr->output(0)->dtype(), false);
         config.output_dtypes.emplace_back(opr->output(0)->dtype().enumv());
         // setup tensor formats
         if (conv.param().sparse == Opr::Param::Sparse::DENSE) {
@@ -719,9 +730,20 @@ struct ConvTensorFormatsDispatcherImpl<Opr, OprFormatConfigID::NCHW88_HYBRID> {
         config.opr_format = OprFormat::NCHW88;
         config.config_id = OprFormatConfigID::NCHW88_HYBRID;
         bool available = true;
+        auto check_dtype = [](DType dt, bool is_bias) {
+            bool f32_config = dt.enumv() == DTypeEnum::Float32;
+            auto i8_dtype = DTypeEnum::QuantizedS8;
+            if (is_bias)
+                i8_dtype = DTypeEnum::QuantizedS32;
+            bool i8_config = dt.enumv() == i8_dtype &&
+                             megdnn::ConvBiasForward::is_nchw88_int8_optimized();
+            return f32_config || i8_config;
+        };
         // setup dtypes
         for (size_t i = 0; i < opr->input().size(); ++i) {
-            available &= opr->input(i)->dtype().enumv() == DTypeEnum::Float32;
+            bool is_bias =
+                    ConvParamTrait<Opr>::has_bias && i == ConvParamTrait<Opr>::bias_idx;
+            available &= check_dtype(opr->input(i)->dtype(), is_bias);
             config.input_dtypes.emplace_back(opr->input(i)->dtype().enumv());
             TensorType tensor_type = i == 1 ? TensorType::WEIGHT : TensorType::FEATURE;
             config.input_tensor_types.emplace_back(tensor_type);
@@ -732,8 +754,7 @@ struct ConvTensorFormatsDispatcherImpl<Opr, OprFormatConfigID::NCHW88_HYBRID> {
                         std::is_same<Opr, opr::ConvBiasForward>::value,
                 "nchw nchw88 hybrid mode only support conv or conv_bias opr");
         size_t in_channel = opr->input(0)->shape()[1];
-        available &= in_channel <= 8_z &&
-                     opr->output(0)->dtype().enumv() == DTypeEnum::Float32;
+        available &= in_channel <= 8_z && check_dtype(opr->output(0)->dtype(), false);
         config.output_dtypes.emplace_back(opr->output(0)->dtype().enumv());
         available &= conv.param().sparse == Opr::Param::Sparse::DENSE;
         // setup tensor formats
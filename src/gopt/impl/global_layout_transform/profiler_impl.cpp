@@ -611,6 +611,14 @@ std::string ProfilerBase::VarNodeRecord::to_string() const {
     return str;
 }
 
+std::string ProfilerImpl::cache_key() const {
+    if (m_custom_filter) {
+        return {};
+    }
+    return ssprintf(
+            "profiler:%d:%g:%g", m_runs, m_opr_threshold, m_var_node_threshold);
+}
+
 std::unique_ptr<ProfilerBase> ProfilerBase::make_profiler() {
     return std::make_unique<ProfilerImpl>();
 }
@@ -635,6 +643,14 @@ CachedProfiler::ProfilingResult CachedProfiler::profile(const Problem& problem)
     return ret;
 }
 
+std::string CachedProfiler::cache_key() const {
+    auto key = ProfilerImpl::cache_key();
+    if (key.empty()) {
+        return key;
+    }
+    return ssprintf("cached_%s:%s", key.c_str(), m_path ? m_path : "");
+}
+
 float CachedProfiler::profile_operator(
         const OperatorNodeBase* opr, TensorFormats base_format,
         TensorFormats tensor_format, ReformatAttribute extra_attribute) const {
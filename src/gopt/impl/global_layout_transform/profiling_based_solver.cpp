@@ -70,4 +70,11 @@ ProfilingBasedSolver::Solution ProfilingBasedSolver::solve(
     return do_solve(problem);
 }
 
+std::string ProfilingBasedSolver::profiling_cache_key() const {
+    if (m_custom_problem_filter) {
+        return {};
+    }
+    return m_profiler->cache_key();
+}
+
 // vim: syntax=cpp.doxygen
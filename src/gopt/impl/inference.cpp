@@ -508,6 +508,10 @@ const char* ParamFusePass::name() const {
     return mgb_cstr_log("param_fuse");
 }
 
+std::string ParamFusePass::cache_key() const {
+    return ssprintf("param_fuse:%zu", m_param_grow_limit);
+}
+
 void ParamFusePass::apply(OptState& state) const {
     MIDOUT_B("ParamFusePass::apply")
     auto rewriter = state.graph().make_rewriter();
@@ -14,6 +14,7 @@
 #include "megbrain/graph/grad_impl.h"
 #include "megbrain/opr/cond.h"
 #include "megbrain/opr/io.h"
+#include "megbrain/opr/indexing.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/opr/utility.h"
 #include "megbrain/serialization/opr_shallow_copy.h"
@@ -22,6 +23,8 @@
 #include "megbrain/utils/hash_ct.h"
 #include "midout.h"
 
+#include <map>
+
 MIDOUT_DECL(megbrain_misc)
 #define MIDOUT_B(tag) MIDOUT_BEGIN(megbrain_misc, midout_iv(MGB_HASH_STR(tag))) {
 #define MIDOUT_E \
@@ -746,6 +749,344 @@ void RemoveRedundantCopyPass::apply(OptState& opt) const {
     MIDOUT_E
 }
 
+/* ======================= FoldViewChainPass ====================== */
+
+class FoldViewChainPass::Impl {
+    using AxisIndexer = opr::Subtensor::AxisIndexer;
+    using AxisDesc = opr::AxisAddRemove::AxisDesc;
+
+    //! output axis i is input axis pattern[i], or a new axis if negative
+    struct AxisPattern {
+        std::vector<int> pattern;
+        size_t inp_ndim = 0;
+    };
+
+    //! interval of a slice; negative value means not given
+    struct Interval {
+        int begin = -1, end = -1, step = -1;
+    };
+
+    OptState& m_opt_state;
+    SubGraph::Rewriter m_rewriter;
+
+    static AxisPattern get_pattern(const opr::Dimshuffle& opr);
+
+    /*!
+     * \brief get pattern of AxisAddRemove with given input ndim
+     * \return false if the descs can not be expressed as a pattern
+     */
+    static bool get_pattern(
+            const opr::AxisAddRemove& opr, size_t inp_ndim, AxisPattern& dest);
+
+    //! get input ndim of AxisAddRemove from its output ndim
+    static size_t get_inp_ndim(const opr::AxisAddRemove& opr, size_t out_ndim);
+
+    static Maybe<int> get_const_int(SymbolVar var);
+
+    //! get interval from a slice-only indexer with const non-negative begin and
+    //! end and a positive step
+    bool get_interval(const AxisIndexer& indexer, Interval& dest);
+
+    //! compose view of \p opr on view of \p inp_opr; return nullptr on failure
+    VarNode* try_fold(OperatorNodeBase* opr, OperatorNodeBase* inp_opr);
+
+    VarNode* fold_axis_manip(OperatorNodeBase* opr, OperatorNodeBase* inp_opr);
+    VarNode* fold_reshape(OperatorNodeBase* opr, OperatorNodeBase* inp_opr);
+    VarNode* fold_subtensor(OperatorNodeBase* opr, OperatorNodeBase* inp_opr);
+
+public:
+    Impl(OptState& opt_state)
+            : m_opt_state{opt_state}, m_rewriter{opt_state.graph().make_rewriter()} {}
+
+    void apply();
+};
+
+FoldViewChainPass::Impl::AxisPattern FoldViewChainPass::Impl::get_pattern(
+        const opr::Dimshuffle& opr) {
+    auto param = opr.param();
+    AxisPattern ret;
+    ret.pattern.assign(param.pattern, param.pattern + param.pattern_len);
+    ret.inp_ndim = param.ndim;
+    if (!ret.inp_ndim) {
+        for (auto i : ret.pattern) {
+            ret.inp_ndim = std::max<size_t>(ret.inp_ndim, i + 1);
+        }
+    }
+    return ret;
+}
+
+size_t FoldViewChainPass::Impl::get_inp_ndim(
+        const opr::AxisAddRemove& opr, size_t out_ndim) {
+    auto param = opr.param();
+    int inp_ndim = out_ndim;
+    for (size_t i = 0; i < param.nr_desc; ++i) {
+        inp_ndim += param.desc[i].method == AxisDesc::Method::REMOVE ? 1 : -1;
+    }
+    return std::max(inp_ndim, 0);
+}
+
+bool FoldViewChainPass::Impl::get_pattern(
+        const opr::AxisAddRemove& opr, size_t inp_ndim, AxisPattern& dest) {
+    if (!inp_ndim) {
+        return false;
+    }
+    auto param = opr.param();
+    auto&& pattern = dest.pattern;
+    pattern.resize(inp_ndim);
+    for (size_t i = 0; i < inp_ndim; ++i) {
+        pattern[i] = i;
+    }
+    for (size_t i = 0; i < param.nr_desc; ++i) {
+        auto&& desc = param.desc[i];
+        if (desc.method == AxisDesc::Method::REMOVE) {
+            // removing the only axis keeps the tensor 1-dim
+            if (pattern.size() == 1) {
+                return false;
+            }
+            pattern.erase(pattern.begin() + desc.axis.get(pattern.size()));
+        } else {
+            pattern.insert(pattern.begin() + desc.axis.get(pattern.size() + 1), -1);
+        }
+    }
+    dest.inp_ndim = inp_ndim;
+    return pattern.size() <= TensorShape::MAX_NDIM;
+}
+
+Maybe<int> FoldViewChainPass::Impl::get_const_int(SymbolVar var) {
+    auto imm = var.node()->owner_opr()->try_cast_final<opr::ImmutableTensor>();
+    if (!imm) {
+        return None;
+    }
+    auto&& val = imm->host_value();
+    if (val.shape().total_nr_elems() != 1 || val.dtype() != dtype::Int32()) {
+        return None;
+    }
+    return val.ptr<int>()[0];
+}
+
+bool FoldViewChainPass::Impl::get_interval(
+        const AxisIndexer& indexer, Interval& dest) {
+    if (indexer.idx.node() || indexer.axis.get_raw() < 0) {
+        return false;
+    }
+    auto get = [this](SymbolVar var, int& dest, int min_val) {
+        if (!var.node()) {
+            return true;
+        }
+        auto val = get_const_int(m_rewriter.get_var(var.node()));
+        if (!val.valid() || val.val() < min_val) {
+            return false;
+        }
+        dest = val.val();
+        return true;
+    };
+    // a negative step walks the axis backwards from begin to end with begin >
+    // end, which the composition in fold_subtensor does not handle, so only
+    // positive steps are accepted; -1 in dest means the value is absent
+    dest = {};
+    return get(indexer.begin, dest.begin, 0) && get(indexer.end, dest.end, 0) &&
+           get(indexer.step, dest.step, 1);
+}
+
+VarNode* FoldViewChainPass::Impl::fold_axis_manip(
+        OperatorNodeBase* opr, OperatorNodeBase* inp_opr) {
+    if (!inp_opr->same_type<opr::Dimshuffle>() &&
+        !inp_opr->same_type<opr::AxisAddRemove>()) {
+        return nullptr;
+    }
+    auto src = m_rewriter.get_var(inp_opr->input(0));
+    if (opr->same_type<opr::AxisAddRemove>() &&
+        inp_opr->same_type<opr::AxisAddRemove>()) {
+        auto p0 = inp_opr->cast_final<opr::AxisAddRemove>().param(),
+             p1 = opr->cast_final<opr::AxisAddRemove>().param();
+        std::vector<AxisDesc> desc(p0.desc, p0.desc + p0.nr_desc);
+        desc.insert(desc.end(), p1.desc, p1.desc + p1.nr_desc);
+        if (desc.size() > opr::AxisAddRemove::Param::MAX_DESC_SIZE) {
+            return nullptr;
+        }
+        return opr::AxisAddRemove::make(src, desc).node();
+    }
+
+    // at least one of them is a Dimshuffle, which determines the ndims
+    AxisPattern outer, inner;
+    if (auto shuffle = opr->try_cast_final<opr::Dimshuffle>()) {
+        outer = get_pattern(*shuffle);
+        if (auto inp_shuffle = inp_opr->try_cast_final<opr::Dimshuffle>()) {
+            inner = get_pattern(*inp_shuffle);
+        } else {
+            auto&& aar = inp_opr->cast_final<opr::AxisAddRemove>();
+            if (!get_pattern(aar, get_inp_ndim(aar, outer.inp_ndim), inner) ||
+                inner.pattern.size() != outer.inp_ndim) {
+                return nullptr;
+            }
+        }
+    } else {
+        inner = get_pattern(inp_opr->cast_final<opr::Dimshuffle>());
+        if (!get_pattern(
+                    opr->cast_final<opr::AxisAddRemove>(), inner.pattern.size(),
+                    outer)) {
+            return nullptr;
+        }
+    }
+    mgb_assert(outer.inp_ndim == inner.pattern.size());
+
+    std::vector<int> pattern(outer.pattern.size());
+    bool is_identity = pattern.size() == inner.inp_ndim;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        auto j = outer.pattern[i];
+        pattern[i] = j < 0 ? -1 : inner.pattern[j];
+        is_identity &= pattern[i] == static_cast<int>(i);
+    }
+    if (is_identity) {
+        return src;
+    }
+    if (pattern.size() > TensorShape::MAX_NDIM) {
+        return nullptr;
+    }
+    return opr::Dimshuffle::make(src, pattern, inner.inp_ndim).node();
+}
+
+VarNode* FoldViewChainPass::Impl::fold_reshape(
+        OperatorNodeBase* opr, OperatorNodeBase* inp_opr) {
+    if (auto shuffle = inp_opr->try_cast_final<opr::Dimshuffle>()) {
+        // a Dimshuffle that keeps the order of input axes only adds or
+        // removes axes with shape 1, so it is a reshape
+        int prev = -1;
+        for (auto i : get_pattern(*shuffle).pattern) {
+            if (i >= 0) {
+                if (i < prev) {
+                    return nullptr;
+                }
+                prev = i;
+            }
+        }
+    } else if (
+            !inp_opr->same_type<opr::Reshape>() &&
+            !inp_opr->same_type<opr::AxisAddRemove>()) {
+        return nullptr;
+    }
+    auto&& reshape = opr->cast_final<opr::Reshape>();
+    return opr::Reshape::make(
+                   m_rewriter.get_var(inp_opr->input(0)),
+                   m_rewriter.get_var(reshape.input(1)), reshape.param(),
+                   reshape.config())
+            .node();
+}
+
+VarNode* FoldViewChainPass::Impl::fold_subtensor(
+        OperatorNodeBase* opr, OperatorNodeBase* inp_opr) {
+    if (!inp_opr->same_type<opr::Subtensor>()) {
+        return nullptr;
+    }
+    auto&& outer = opr->cast_final<opr::Subtensor>().index_desc();
+    auto&& inner = inp_opr->cast_final<opr::Subtensor>().index_desc();
+    std::map<int, Interval> inner_itv, outer_itv;
+    for (auto&& i : inner) {
+        if (!get_interval(i, inner_itv[i.axis.get_raw()])) {
+            return nullptr;
+        }
+    }
+    for (auto&& i : outer) {
+        if (!get_interval(i, outer_itv[i.axis.get_raw()])) {
+            return nullptr;
+        }
+    }
+
+    // slice [b2:e2:s2] on [b1:e1:s1] equals to [b1+b2*s1:min(e1,b1+e2*s1):s1*s2]
+    auto src = m_rewriter.get_var(inp_opr->input(0));
+    auto make = [&](int v) { return SymbolVar{src}.make_scalar(v); };
+    std::map<int, Interval> merged = inner_itv;
+    for (auto&& i : outer_itv) {
+        auto iter = merged.find(i.first);
+        if (iter == merged.end()) {
+            merged.insert(i);
+            continue;
+        }
+        auto in = iter->second, out = i.second;
+        auto s1 = std::max(in.step, 1), b1 = std::max(in.begin, 0);
+        Interval ret;
+        ret.begin = b1 + std::max(out.begin, 0) * s1;
+        ret.step = s1 * std::max(out.step, 1);
+        ret.end = in.end;
+        if (out.end >= 0) {
+            int end = b1 + out.end * s1;
+            ret.end = in.end >= 0 ? std::min(in.end, end) : end;
+        }
+        iter->second = ret;
+    }
+
+    opr::Subtensor::IndexDesc desc;
+    for (auto&& i : merged) {
+        auto&& itv = i.second;
+        Maybe<SymbolVar> begin, end, step;
+        if (itv.begin > 0) {
+            begin = make(itv.begin);
+        }
+        if (itv.end >= 0) {
+            end = make(itv.end);
+        }
+        if (itv.step > 1) {
+            step = make(itv.step);
+        }
+        desc.push_back(AxisIndexer::make_interval(i.first, begin, end, step));
+    }
+    return opr::Subtensor::make(src, desc, opr->config()).node();
+}
+
+VarNode* FoldViewChainPass::Impl::try_fold(
+        OperatorNodeBase* opr, OperatorNodeBase* inp_opr) {
+    if (inp_opr->output(0)->dtype() != opr->output(0)->dtype()) {
+        return nullptr;
+    }
+    if (opr->same_type<opr::Dimshuffle>() || opr->same_type<opr::AxisAddRemove>()) {
+        return fold_axis_manip(opr, inp_opr);
+    }
+    if (opr->same_type<opr::Reshape>()) {
+        return fold_reshape(opr, inp_opr);
+    }
+    if (opr->same_type<opr::Subtensor>()) {
+        return fold_subtensor(opr, inp_opr);
+    }
+    return nullptr;
+}
+
+void FoldViewChainPass::Impl::apply() {
+    auto is_view = [](OperatorNodeBase* opr) {
+        return opr->same_type<opr::Dimshuffle>() ||
+               opr->same_type<opr::AxisAddRemove>() ||
+               opr->same_type<opr::Reshape>() || opr->same_type<opr::Subtensor>();
+    };
+    auto on_opr = [this, &is_view](OperatorNodeBase* opr) {
+        if (opr->input().empty() || !is_view(opr)) {
+            m_rewriter.auto_replace_outputs(opr);
+            return;
+        }
+        auto inp = m_rewriter.get_var(opr->input(0));
+        auto inp_opr = inp->owner_opr();
+        if (inp_opr->output().size() == 1 && opr->output().size() == 1) {
+            if (auto folded = try_fold(opr, inp_opr)) {
+                m_rewriter.replace_var(
+                        opr->output(0), folded,
+                        mgb_cstr_log("fold view chain"));
+                return;
+            }
+        }
+        m_rewriter.auto_replace_outputs(opr);
+    };
+    m_opt_state.graph().iter(on_opr);
+    m_rewriter.apply_inplace();
+}
+
+const char* FoldViewChainPass::name() const {
+    return "fold_view_chain";
+}
+
+void FoldViewChainPass::apply(OptState& opt) const {
+    MIDOUT_B("FoldViewChainPass::apply")
+    Impl{opt}.apply();
+    MIDOUT_E
+}
+
 #if MGB_ENABLE_OPR_MM
 #include "megbrain/opr/collective_comm.h"
 
@@ -189,6 +189,45 @@ public:
     void apply(OptState& opt) const override;
 };
 
+/*!
+ * \brief optimize arith expressions by equality saturation
+ *
+ * Each maximal expression of ADD/SUB/MUL/NEGATE/FUSE_MUL_ADD3/FUSE_MUL_ADD4
+ * oprs (whose internal vars have a unique reader) is inserted into an
+ * e-graph, which is then saturated with commutative, associative and
+ * distributive rules (the elemwise subset of BinaryTrans20) as well as fma
+ * fusion rules. The cheapest equivalent expression under a memory-traffic
+ * cost model is extracted to replace the original one.
+ *
+ * This pass can be used in place of the chain from ExpandFusedArithPass to
+ * ReorderArithChainPass; see GraphOpt::egraph_arith.
+ */
+class ArithEGraphPass final : public Pass {
+public:
+    struct Config {
+        //! max number of e-nodes for a single expression
+        size_t max_nr_node = 4096;
+        //! max number of rewrite iterations for a single expression
+        size_t max_nr_iter = 16;
+        //! max time in seconds spent on saturating a single expression
+        double time_limit = 0.05;
+        //! cost of launching a kernel, measured in bytes of memory traffic
+        size_t kern_launch_cost = 256;
+    };
+
+    ArithEGraphPass() = default;
+    explicit ArithEGraphPass(const Config& config) : m_config{config} {}
+
+    const char* name() const override;
+    void apply(OptState& opt) const override;
+
+private:
+    class EGraph;
+    class Impl;
+
+    Config m_config;
+};
+
 }  // namespace gopt
 }  // namespace mgb
 
@@ -285,6 +285,29 @@ public:
      * state of \p opt.
      */
     virtual void apply(OptState& opt) const = 0;
+
+    /*!
+     * \brief key to identify the result of this pass in the pass cache
+     *
+     * A pass whose result only depends on the input subgraph and its own
+     * configuration can return a non-empty string that encodes its name and
+     * configuration. Its result would then be memoized by GraphOptimizer and
+     * reused when a structurally identical subgraph (same opr types, params,
+     * shapes, dtypes and comp nodes) is optimized again, in the same or in
+     * another graph, if GraphOpt::pass_cache is enabled.
+     *
+     * An empty string (the default) disables caching for this pass.
+     */
+    virtual std::string cache_key() const { return {}; }
+
+    /*!
+     * \brief whether the result of this pass depends on the values of the
+     *      params (SharedDeviceTensor and MultipleDeviceTensorHolder), so
+     *      their values must be hashed into the cache key
+     *
+     * The values of ImmutableTensor are always hashed.
+     */
+    virtual bool cache_param_values() const { return false; }
 };
 
 /*!
@@ -370,6 +393,13 @@ class GraphOptimizer {
     std::vector<std::unique_ptr<Pass>> m_passes;
 
     class VarReplaceMapStorage;
+    class PassCacheStorage;
+
+    /*!
+     * \brief apply a single pass, possibly reusing its cached result
+     * \return whether the result is taken from the pass cache
+     */
+    bool apply_pass(const Pass& pass, OptState& state) const;
 
 public:
     ~GraphOptimizer() noexcept;
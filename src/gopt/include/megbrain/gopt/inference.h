@@ -74,6 +74,10 @@ public:
     const char* name() const override;
 
     void apply(OptState& opt) const override;
+
+    std::string cache_key() const override;
+
+    bool cache_param_values() const override { return true; }
 };
 
 /*!
@@ -28,6 +28,7 @@ class LayoutTransformPass final : public Pass {
 public:
     const char* name() const override { return "layout assignment pass"; }
     void apply(OptState& opt) const override;
+    std::string cache_key() const override;
     LayoutTransformPass(
             std::unique_ptr<LayoutTransformContext> ctx,
             std::unique_ptr<SolverBase> solver)
@@ -97,6 +97,24 @@ public:
     void apply(OptState& opt) const override;
 };
 
+/*!
+ * \brief fold chains of view oprs into a single view opr
+ *
+ * Dimshuffle and AxisAddRemove chains are composed into one Dimshuffle (or
+ * removed if the result is identity), Reshape absorbs preceding Reshape,
+ * AxisAddRemove and order-preserving Dimshuffle, and nested Subtensor with
+ * constant non-negative slices is merged into one Subtensor. Intermediate
+ * views are thus never materialized when a consumer requires a contiguous
+ * layout.
+ */
+class FoldViewChainPass final : public Pass {
+    class Impl;
+
+public:
+    const char* name() const override;
+    void apply(OptState& opt) const override;
+};
+
 //! remove execution mask for const PPVs in conditional execution
 class CondExecConstPredicateFolding final : public Pass {
 public:
@@ -84,13 +84,23 @@ public:
 
     virtual ProfilingResult profile(const Problem& problem) const = 0;
 
+    /*!
+     * \brief key of the profiler configuration, see SolverBase::cache_key()
+     *
+     * An empty key (the default) means the profiling results must not be
+     * reused.
+     */
+    virtual std::string cache_key() const { return {}; }
+
     ProfilerBase& set_opr_filter(const OprFilter& opr_filter) {
         m_opr_filter = opr_filter;
+        m_custom_filter = true;
         return *this;
     }
 
     ProfilerBase& set_var_node_filter(const VarNodeFilter& var_node_filter) {
         m_var_node_filter = var_node_filter;
+        m_custom_filter = true;
         return *this;
     }
 
@@ -101,6 +111,8 @@ public:
 protected:
     OprFilter m_opr_filter;
     VarNodeFilter m_var_node_filter;
+    //! whether the filters are set by the user, which can not be keyed
+    bool m_custom_filter = false;
 };
 
 /*! \brief A default profiler impl
@@ -111,6 +123,7 @@ public:
             int runs = 10, float opr_threshold = 2.f, float var_node_threshold = 2.f);
     ~ProfilerImpl() = default;
     ProfilingResult profile(const Problem& problem) const override;
+    std::string cache_key() const override;
 
 protected:
     static constexpr float PROFILE_TIME_OUT = 1e7;
@@ -315,6 +328,7 @@ public:
             const char* path = nullptr, int runs = 10, float opr_threshold = 2.f,
             float var_node_threshold = 2.f);
     ProfilingResult profile(const Problem& problem) const override;
+    std::string cache_key() const override;
 
 private:
     float profile_operator(
@@ -41,6 +41,12 @@ public:
      * algorithm(i.e. solver).
      */
     virtual bool can_solve(const Problem& problem) const = 0;
+    /*!
+     * \brief key of the solver configuration, which is a part of the cache
+     * key of LayoutTransformPass. An empty key (the default) means the
+     * solutions must not be reused.
+     */
+    virtual std::string cache_key() const { return {}; }
 };
 
 /*!
@@ -59,7 +65,8 @@ public:
     ProfilingBasedSolver(
             std::unique_ptr<ProfilerBase> profiler, ProblemFilter problem_filter)
             : m_profiler{std::move(profiler)},
-              m_problem_filter{std::move(problem_filter)} {}
+              m_problem_filter{std::move(problem_filter)},
+              m_custom_problem_filter{true} {}
     virtual ~ProfilingBasedSolver() = default;
     Solution solve(const Problem& problem) const override;
     virtual Solution do_solve(const Problem& problem) const = 0;
@@ -67,8 +74,13 @@ public:
 protected:
     std::unique_ptr<ProfilerBase> m_profiler;
 
+    //! key of the profiler and the problem filter, empty if either of them
+    //! can not be keyed
+    std::string profiling_cache_key() const;
+
 private:
     ProblemFilter m_problem_filter;
+    bool m_custom_problem_filter = false;
 };
 
 /*!
@@ -85,6 +97,7 @@ public:
     ~DynamicProgrammingSolver() noexcept = default;
     Solution do_solve(const Problem& problem) const override;
     bool can_solve(const Problem& problem) const override;
+    std::string cache_key() const override;
 
 private:
     class Impl;
@@ -60,6 +60,27 @@ SymbolVar fma4(SymbolVar a, SymbolVar b, SymbolVar c, SymbolVar d) {
     return Elemwise::make({a, b, c, d}, Mode::FUSE_MUL_ADD4);
 }
 
+//! number of Elemwise oprs of each mode that \p endpoint depends on
+std::map<Mode, size_t> count_elem_modes(SymbolVar endpoint) {
+    std::map<Mode, size_t> ret;
+    auto cb = [&](cg::OperatorNodeBase* opr) {
+        if (opr->same_type<Elemwise>()) {
+            ++ret[opr->cast_final<Elemwise>().param().mode];
+        }
+    };
+    cg::DepOprIter{cb}.add(endpoint.node()->owner_opr());
+    return ret;
+}
+
+//! check that \p y0 and \p y1 compute the same values
+void check_same_value(SymbolVar y0, SymbolVar y1) {
+    HostTensorND host_y0, host_y1;
+    auto func = y0.node()->owner_graph()->compile(
+            {make_callback_copy(y0, host_y0), make_callback_copy(y1, host_y1)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_y0, host_y1, 1e-5);
+}
+
 }  // anonymous namespace
 
 TEST(TestGoptBasicArithInplace, EqToUnit) {
@@ -636,6 +657,117 @@ TEST_PASS(ArithMulDistributePass, 0) {
     check<false>(u + a * b, u + a * b);
 }
 
+TEST_PASS(ArithEGraphPass, FuseBroadcast) {
+    graph->options().graph_opt_level = 0;
+    auto a = mkvar("a", {4, 5}), b = mkvar("b", {4, 5}), k = mkvar("k", {1, 5});
+    // factoring is found but fma4 is cheaper in memory traffic
+    auto y = a * k + b * k;
+    SymbolVar y_opt;
+    unpack_vector(run_opt({y}), y_opt);
+    auto modes = count_elem_modes(y_opt);
+    ASSERT_EQ(1u, modes.size());
+    ASSERT_EQ(1u, modes[Mode::FUSE_MUL_ADD4]);
+    check_same_value(y, y_opt);
+}
+
+TEST_PASS(ArithEGraphPass, FuseAfterFactor) {
+    graph->options().graph_opt_level = 0;
+    auto a = mkvar("a", {3, 4}), b = mkvar("b", {3, 4}), c = mkvar("c", {3, 4}),
+         d = mkvar("d", {3, 4});
+    auto y = a * c + b * c + d;
+    SymbolVar y_opt;
+    unpack_vector(run_opt({y}), y_opt);
+    auto modes = count_elem_modes(y_opt);
+    ASSERT_EQ(2u, modes.size());
+    ASSERT_EQ(1u, modes[Mode::ADD]);
+    ASSERT_EQ(1u, modes[Mode::FUSE_MUL_ADD3]);
+    check_same_value(y, y_opt);
+}
+
+TEST_PASS(ArithEGraphPass, NegSub) {
+    graph->options().graph_opt_level = 0;
+    auto a = mkvar("a", {2, 3}), b = mkvar("b", {2, 3});
+    auto y = a - (-b);
+    SymbolVar y_opt;
+    unpack_vector(run_opt({y}), y_opt);
+    auto modes = count_elem_modes(y_opt);
+    ASSERT_EQ(1u, modes.size());
+    ASSERT_EQ(1u, modes[Mode::ADD]);
+    check_same_value(y, y_opt);
+}
+
+TEST_PASS(ArithEGraphPass, MultipleReaders) {
+    graph->options().graph_opt_level = 0;
+    auto a = mkvar("a", {2, 3}), b = mkvar("b", {2, 3}), c = mkvar("c", {2, 3});
+    // p is read by two oprs, so it must not be fused into either of them
+    auto p = a * b, y = p + c, z = opr::relu(p);
+    SymbolVar y_opt, z_opt;
+    unpack_vector(run_opt({y, z}), y_opt, z_opt);
+    ASSERT_EQ(y, y_opt);
+    ASSERT_EQ(z, z_opt);
+}
+
+TEST_PASS(ArithEGraphPass, NodeLimit) {
+    graph->options().graph_opt_level = 0;
+    gopt::ArithEGraphPass::Config config;
+    config.max_nr_node = 16;
+    SymbolVarArray xs;
+    for (int i = 0; i < 8; ++i) {
+        xs.push_back(mkvar(ssprintf("x%d", i).c_str(), {2, 3}));
+    }
+    auto y = xs[0];
+    for (int i = 1; i < 8; ++i) {
+        y = (y + xs[i]) * xs[i - 1];
+    }
+    SymbolVar y_opt;
+    unpack_vector(run_opt({y}, config), y_opt);
+    check_same_value(y, y_opt);
+}
+
+TEST(TestGoptBasicArith, EGraphPreset) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    graph->options().graph_opt.egraph_arith = true;
+    auto mkvar = [&](const TensorShape& shp) {
+        return opr::Host2DeviceCopy::make(*graph, gen(shp));
+    };
+    auto a = mkvar({8, 16}), b = mkvar({8, 16}), c = mkvar({1, 16}),
+         d = mkvar({8, 16});
+    auto y = opr::relu((a - b) * c + a * d - (-b));
+    SymbolVar y_opt;
+    unpack_vector(
+            gopt::GraphOptimizer{}
+                    .add_preset_passes(false, nullptr, &graph->options())
+                    .apply({{y}})
+                    .endpoint_vars(),
+            y_opt);
+    ASSERT_NE(y.node(), y_opt.node());
+    check_same_value(y, y_opt);
+}
+
+TEST(TestGoptBasicArith, EGraphPresetFuseAdd) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    graph->options().graph_opt.egraph_arith = true;
+    auto a = opr::Host2DeviceCopy::make(*graph, gen({8, 16})),
+         b = opr::Host2DeviceCopy::make(*graph, gen({8, 16}));
+    auto y = opr::sigmoid(a + b);
+    SymbolVar y_opt;
+    unpack_vector(
+            gopt::GraphOptimizer{}
+                    .add_preset_passes(false, nullptr, &graph->options())
+                    .apply({{y}})
+                    .endpoint_vars(),
+            y_opt);
+    // ArithFusePass still runs after ArithEGraphPass
+    ASSERT_EQ(
+            opr::Elemwise::Mode::FUSE_ADD_SIGMOID,
+            y_opt.node()->owner_opr()->cast_final_safe<opr::Elemwise>().param().mode);
+    check_same_value(y, y_opt);
+}
+
 TEST(TestGoptBasicArithPassFinalArithTransform, MergeNeg) {
     HostTensorGenerator<> gen;
     auto graph = ComputingGraph::make();
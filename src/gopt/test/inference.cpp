@@ -223,6 +223,130 @@ TEST(TestGoptInference, ParamFuse) {
     }
 }
 
+TEST(TestGoptInference, PassCache) {
+    //! replace the endpoint var by var + 1, and count the calls of apply()
+    class AddOnePass final : public gopt::Pass {
+        size_t* m_nr_apply;
+
+    public:
+        explicit AddOnePass(size_t* nr_apply) : m_nr_apply{nr_apply} {}
+        const char* name() const override { return "add_one"; }
+        std::string cache_key() const override { return name(); }
+        void apply(gopt::OptState& opt) const override {
+            ++*m_nr_apply;
+            auto var = opt.graph().endpoint_vars()[0];
+            auto rewriter = opt.graph().make_rewriter();
+            rewriter.replace_var(var.node(), (var + 1).node(), nullptr);
+            rewriter.apply_inplace();
+        }
+    };
+
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    graph->options().graph_opt.pass_cache = true;
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({23}));
+
+    std::vector<bool> from_cache;
+    auto conn = graph->event().register_receiver<cg::event::GraphOptPassApplied>(
+            [&](const cg::event::GraphOptPassApplied& ev) {
+                from_cache.push_back(ev.from_cache);
+            });
+    size_t nr_apply = 0;
+    auto run = [&](SymbolVar var) {
+        return gopt::GraphOptimizer{}
+                .add_pass(std::make_unique<AddOnePass>(&nr_apply))
+                .apply({{var}})
+                .endpoint_vars()[0];
+    };
+    auto y0 = run(x), y1 = run(x);
+    ASSERT_NE(x.node(), y0.node());
+    ASSERT_EQ(y0.node(), y1.node());
+    ASSERT_EQ(1u, nr_apply);
+
+    // other endpoints must not hit the cache
+    auto z = run(x * 2);
+    ASSERT_NE(y0.node(), z.node());
+    ASSERT_EQ(2u, nr_apply);
+    ASSERT_EQ(std::vector<bool>({false, true, false}), from_cache);
+
+    // the same subgraph in another graph hits the cache, and the result is
+    // copied into that graph
+    auto host_x2 = gen({23});
+    auto graph2 = ComputingGraph::make();
+    graph2->options().graph_opt_level = 0;
+    graph2->options().graph_opt.pass_cache = true;
+    auto x2 = opr::Host2DeviceCopy::make(*graph2, host_x2);
+    auto y2 = run(x2);
+    ASSERT_EQ(2u, nr_apply);
+    ASSERT_EQ(graph2.get(), y2.node()->owner_graph());
+    HostTensorND host_y2;
+    auto func = graph2->compile({make_callback_copy(y2, host_y2)});
+    func->execute();
+    auto px = host_x2->ptr<float>(), py = host_y2.ptr<float>();
+    for (size_t i = 0; i < 23; ++i) {
+        MGB_ASSERT_FLOAT_EQ(px[i] + 1, py[i]);
+    }
+
+    // a different shape must not hit the cache
+    run(opr::Host2DeviceCopy::make(*graph2, gen({24})));
+    ASSERT_EQ(3u, nr_apply);
+}
+
+TEST(TestGoptInference, ParamFusePassCache) {
+    constexpr size_t SIZE = 23;
+    HostTensorGenerator<> gen;
+    auto host_x = gen({SIZE}), host_y = gen({1}), host_p = gen({1});
+
+    std::vector<bool> from_cache;
+    auto make_graph = [&](SymbolVar& y, SymbolVar& q) {
+        auto graph = ComputingGraph::make();
+        graph->options().graph_opt_level = 0;
+        graph->options().graph_opt.pass_cache = true;
+        auto x = opr::SharedDeviceTensor::make(*graph, *host_x),
+             p = opr::Host2DeviceCopy::make(*graph, host_p);
+        y = opr::SharedDeviceTensor::make(*graph, *host_y);
+        q = x * y + p;
+        graph->event().register_receiver_permanent<cg::event::GraphOptPassApplied>(
+                [&](const cg::event::GraphOptPassApplied& ev) {
+                    from_cache.push_back(ev.from_cache);
+                });
+        return graph;
+    };
+    auto run_and_check = [&](SymbolVar q) {
+        auto q1 = gopt::GraphOptimizer{}
+                          .add_pass<gopt::ParamFusePass>()
+                          .apply({{q}})
+                          .endpoint_vars()[0];
+        ASSERT_NE(q.node(), q1.node());
+        HostTensorND host_q;
+        auto func = q.node()->owner_graph()->compile({make_callback_copy(q1, host_q)});
+        func->execute();
+        auto px = host_x->ptr<float>(), pq = host_q.ptr<float>();
+        auto yv = host_y->ptr<float>()[0], pv = host_p->ptr<float>()[0];
+        for (size_t i = 0; i < SIZE; ++i) {
+            MGB_ASSERT_FLOAT_EQ(px[i] * yv + pv, pq[i]);
+        }
+    };
+    SymbolVar y, q;
+    auto graph = make_graph(y, q);
+    run_and_check(q);
+    run_and_check(q);
+
+    // the same model loaded into another graph hits the cache
+    SymbolVar y2, q2;
+    auto graph2 = make_graph(y2, q2);
+    run_and_check(q2);
+    ASSERT_EQ(std::vector<bool>({false, true, true}), from_cache);
+
+    // the folded value must follow the updated param
+    *host_y = *gen({1});
+    auto&& y_opr = y.node()->owner_opr()->cast_final_safe<opr::SharedDeviceTensor>();
+    y_opr.dev_data()->copy_from(*host_y);
+    run_and_check(q);
+    ASSERT_EQ(std::vector<bool>({false, true, true, false}), from_cache);
+}
+
 TEST(TestGoptInference, ParamFuseMultiDeviceTensorHolder) {
     constexpr size_t SIZE = 23;
     HostTensorGenerator<> gen;
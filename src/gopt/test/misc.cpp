@@ -16,6 +16,7 @@
 #include "megbrain/opr/basic_arith_wrapper.h"
 #include "megbrain/opr/blas.h"
 #include "megbrain/opr/cond.h"
+#include "megbrain/opr/indexing.h"
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/opr/utility.h"
@@ -493,6 +494,102 @@ TEST_PASS(RemoveRedundantCopyPass, Basic) {
 #endif
 }
 
+TEST_PASS(FoldViewChainPass, Dimshuffle) {
+    auto x = mkvar("x", {2, 3, 4});
+    auto y = opr::Dimshuffle::make(opr::Dimshuffle::make(x, {1, 0, 2}), {2, 0, 1});
+    check(opr::Dimshuffle::make(x, {2, 1, 0}, 3), y);
+
+    // identity chain is removed
+    auto z = opr::Dimshuffle::make(opr::Dimshuffle::make(x, {1, 2, 0}), {2, 0, 1});
+    check(x, z);
+}
+
+TEST_PASS(FoldViewChainPass, NonViewOprs) {
+    // source oprs and non-view oprs are kept as they are
+    auto x = mkvar("x", {2, 3});
+    auto y = opr::Dimshuffle::make(x + x.make_scalar(1.f), {1, 0});
+    check<false>(y, y);
+}
+
+TEST_PASS(FoldViewChainPass, AxisAddRemove) {
+    using AD = opr::AxisAddRemove::AxisDesc;
+    auto x = mkvar("x", {2, 3});
+    auto y = opr::Dimshuffle::make(x.add_axis(0), {2, 1, 0});
+    check(opr::Dimshuffle::make(x, {1, 0, -1}, 2), y);
+
+    auto z = opr::AxisAddRemove::make(
+            opr::Dimshuffle::make(x, {-1, 1, 0}), {AD::make_remove(0)});
+    check(opr::Dimshuffle::make(x, {1, 0}, 2), z);
+
+    auto w = opr::AxisAddRemove::make(
+            x.add_axis(2), {AD::make_remove(2), AD::make_add(0)});
+    check(opr::AxisAddRemove::make(
+                  x, {AD::make_add(2), AD::make_remove(2), AD::make_add(0)}),
+          w);
+}
+
+TEST_PASS(FoldViewChainPass, Reshape) {
+    auto x = mkvar("x", {2, 3, 4});
+    auto tshp = cg::var_from_tensor_shape(x, {4, 6});
+    auto y = opr::Reshape::make(x.reshape({6, 4}), tshp);
+    check(opr::Reshape::make(x, tshp), y);
+
+    auto z = opr::Reshape::make(opr::Dimshuffle::make(x, {0, -1, 1, 2}), tshp);
+    check(opr::Reshape::make(x, tshp), z);
+
+    // reshape after a real transpose must be kept
+    auto w = opr::Reshape::make(opr::Dimshuffle::make(x, {1, 0, 2}), tshp);
+    check<false>(w, w);
+}
+
+TEST_PASS(FoldViewChainPass, Subtensor) {
+    using AIdx = opr::Subtensor::AxisIndexer;
+    auto host_x = gen({10, 8});
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+    auto cv = [&](int v) { return x.make_scalar(v); };
+    auto y0 = opr::Subtensor::make(
+            x, {AIdx::make_interval(0, cv(1), None, cv(2)),
+                AIdx::make_interval(1, None, cv(6), None)});
+    auto y = opr::Subtensor::make(
+            y0, {AIdx::make_interval(0, cv(1), cv(4), None),
+                 AIdx::make_interval(1, cv(2), None, cv(3))});
+
+    SymbolVar y_opt;
+    unpack_vector(run_opt({y}), y_opt);
+    ASSERT_TRUE(y_opt.node()->owner_opr()->same_type<opr::Subtensor>());
+    ASSERT_EQ(x.node(), y_opt.node()->owner_opr()->input(0));
+
+    HostTensorND host_y, host_y_opt;
+    auto func = graph->compile(
+            {make_callback_copy(y, host_y), make_callback_copy(y_opt, host_y_opt)});
+    func->execute();
+    ASSERT_EQ(TensorShape({3, 2}), host_y.shape());
+    MGB_ASSERT_TENSOR_EQ(host_y, host_y_opt);
+}
+
+TEST_PASS(FoldViewChainPass, SubtensorNegativeStep) {
+    using AIdx = opr::Subtensor::AxisIndexer;
+    auto host_x = gen({10, 8});
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+    auto cv = [&](int v) { return x.make_scalar(v); };
+    // a reversed slice is not folded with the slice on it
+    auto y0 = opr::Subtensor::make(
+            x, {AIdx::make_interval(0, cv(8), cv(1), cv(-2))});
+    auto y = opr::Subtensor::make(y0, {AIdx::make_interval(0, cv(1), cv(3), None)});
+
+    SymbolVar y_opt;
+    unpack_vector(run_opt({y}), y_opt);
+    ASSERT_TRUE(y_opt.node()->owner_opr()->same_type<opr::Subtensor>());
+    ASSERT_NE(x.node(), y_opt.node()->owner_opr()->input(0));
+
+    HostTensorND host_y, host_y_opt;
+    auto func = graph->compile(
+            {make_callback_copy(y, host_y), make_callback_copy(y_opt, host_y_opt)});
+    func->execute();
+    ASSERT_EQ(TensorShape({2, 8}), host_y.shape());
+    MGB_ASSERT_TENSOR_EQ(host_y, host_y_opt);
+}
+
 #if MGB_ENABLE_OPR_MM
 #include "../../opr-mm/test/mock_client.h"
 #include "megbrain/opr/collective_comm.h"
@@ -263,7 +263,24 @@ void JITExecutor::update_args() {
 
     //  update layout info
     auto prop = m_compiler->property();
-    if (prop.contain_flag(CPFlag::BIND_NDIM | CPFlag::BIND_SHAPE)) {
+    m_args.const_shape = prop.contain_flag(CPFlag::SPECIALIZE_CONST_SHAPE) &&
+                         is_const_shape();
+    if (m_args.const_shape) {
+        std::vector<ptrdiff_t> buf;
+        buf.reserve(1024);
+        buf.push_back(m_args.inputs.size());
+        for (auto&& i : {&m_args.inputs, &m_args.outputs}) {
+            for (auto&& j : *i) {
+                buf.push_back(j.layout.ndim);
+                for (size_t k = 0; k < j.layout.ndim; ++k) {
+                    buf.push_back(j.layout[k]);
+                    // stride of shape-1 axis is ignored by eq_layout
+                    buf.push_back(j.layout[k] == 1 ? 0 : j.layout.stride[k]);
+                }
+            }
+        }
+        hstate.update(buf.data(), sizeof(buf[0]) * buf.size());
+    } else if (prop.contain_flag(CPFlag::BIND_NDIM | CPFlag::BIND_SHAPE)) {
         mgb_assert(
                 prop.contain_flag(CPFlag::BIND_NDIM),
                 "BIND_NDIM must be set if bind_shape is set");
@@ -389,7 +406,22 @@ bool JITExecutor::Args::operator==(const Args& rhs) const {
 
     auto prop = owner->m_compiler->property();
 
-    if (prop.contain_flag(CPFlag::BIND_NDIM | CPFlag::BIND_SHAPE)) {
+    if (lhs.const_shape != rhs.const_shape) {
+        return false;
+    }
+    if (lhs.const_shape) {
+        auto eq_layout = [](const TensorLayout& lhs, const TensorLayout& rhs) {
+            return lhs.dtype == rhs.dtype && lhs.eq_layout(rhs);
+        };
+        for (size_t i = 0; i < lhs.inputs.size(); i++) {
+            if (!eq_layout(lhs.inputs[i].layout, rhs.inputs[i].layout))
+                return false;
+        }
+        for (size_t i = 0; i < lhs.outputs.size(); i++) {
+            if (!eq_layout(lhs.outputs[i].layout, rhs.outputs[i].layout))
+                return false;
+        }
+    } else if (prop.contain_flag(CPFlag::BIND_NDIM | CPFlag::BIND_SHAPE)) {
         bool (*chk_layout)(const TensorLayout&, const TensorLayout&);
         if (prop.contain_flag(CPFlag::BIND_SHAPE)) {
             chk_layout = [](const TensorLayout& lhs, const TensorLayout& rhs) {
@@ -416,6 +448,21 @@ bool JITExecutor::Args::operator==(const Args& rhs) const {
     return true;
 }
 
+bool JITExecutor::is_const_shape() const {
+    if (!cg::is_const_var_shape(output(0))) {
+        return false;
+    }
+    auto&& placeholders = m_internal_graph->placeholders();
+    for (size_t i = 0; i < input().size(); ++i) {
+        // host value inputs only affect the output shape, which is checked
+        if (!placeholders[i]->is_host_value_shape_input() &&
+            !cg::is_const_var_shape(input(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 JITExecutor::NodeProp* JITExecutor::do_make_node_prop() const {
     auto ret = Super::do_make_node_prop();
     using DepType = NodeProp::DepType;
@@ -78,6 +78,41 @@ std::string gen_fastdiv_offset(size_t nr_inps) {
     return res;
 }
 
+/*!
+ * like gen_fastdiv_offset, but the shapes and strides are embedded as
+ * constants, so nvrtc could strength-reduce the divisions and drop the
+ * broadcasted axes
+ */
+std::string gen_const_offset(const JITExecutor::Args& args) {
+    std::string res;
+    int ndim = args.outputs[0].layout.ndim;
+    for (size_t i = 0; i < args.inputs.size(); ++i) {
+        auto&& layout = args.inputs[i].layout;
+        auto shape = [&](int axis) -> size_t {
+            return axis < static_cast<int>(layout.ndim) ? layout[axis] : 1;
+        };
+        auto stride = [&](int axis) -> ptrdiff_t {
+            return axis < static_cast<int>(layout.ndim) ? layout.stride[axis] : 0;
+        };
+        res += ssprintf("offset_%zu = 0;\ntmp_idx = global_idx;\n", i);
+        for (int j = ndim - 1; j >= 1; --j) {
+            if (shape(j) == 1) {
+                continue;
+            }
+            if (stride(j)) {
+                res += ssprintf(
+                        "offset_%zu += (tmp_idx %% %zuu) * %td;\n", i, shape(j),
+                        stride(j));
+            }
+            res += ssprintf("tmp_idx /= %zuu;\n", shape(j));
+        }
+        if (stride(0)) {
+            res += ssprintf("offset_%zu += tmp_idx * %td;\n", i, stride(0));
+        }
+    }
+    return res;
+}
+
 ASTPtr gen_data_ast(size_t input_id, const JITExecutor::Args::Data& n) {
     auto res = ssprintf(
             "(static_cast<%s*>(data.inputs[%zu]))[offset_%zu]",
@@ -126,7 +161,8 @@ ASTPtr gen_opr_ast(cg::OperatorNodeBase* opr, const VarNode2AST& var2ast) {
 
 std::pair<std::string, std::string> mgb::jit::codegen_cuda(
         const InternalGraph& internal_graph, const JITExecutor::Args& args,
-        bool copy_param_to_dev) {
+        bool copy_param_to_dev, bool const_shape) {
+    mgb_assert(!(copy_param_to_dev && const_shape));
     std::string cuda_kernel =
             R"(
 #include <cuda_fp16.h>
@@ -165,14 +201,21 @@ static __forceinline__ __device__ T mgb_log_sum_exp(T x, T y) {
 
 )";
 
-    cuda_kernel += copy_param_to_dev ? R"(
+    if (const_shape) {
+        cuda_kernel += R"(
+extern "C" __global__ void {{KERNEL_NAME}} (Data data) {
+    const unsigned int num_elements = {{NR_ELEMS}};
+)";
+    } else {
+        cuda_kernel += copy_param_to_dev ? R"(
 extern "C" __global__ void {{KERNEL_NAME}} (Data* data_ptr, size_t num_elements, PEVisitors* visitors_ptr) {
     Data data = *data_ptr;
     PEVisitors visitors = *visitors_ptr;
 )"
-                                     : R"(
+                                         : R"(
 extern "C" __global__ void {{KERNEL_NAME}} (Data data, size_t num_elements,
  PEVisitors visitors) { )";
+    }
 
     cuda_kernel += R"(
     unsigned int global_idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -235,7 +278,11 @@ extern "C" __global__ void {{KERNEL_NAME}} (Data data, size_t num_elements,
             source_replace_map,
             {{"{{NR_INPS}}", std::to_string(args.inputs.size())},
              {"{{NDIM}}", std::to_string(args.outputs[0].layout.ndim)},
-             {"{{fastdiv_offset}}", gen_fastdiv_offset(args.inputs.size())},
+             {"{{fastdiv_offset}}", const_shape
+                                            ? gen_const_offset(args)
+                                            : gen_fastdiv_offset(args.inputs.size())},
+             {"{{NR_ELEMS}}",
+              std::to_string(args.outputs[0].layout.total_nr_elems()) + "u"},
              {"{{INTERNAL_DECL_EXPRS}}", internal_decl_exps_str},
              {"{{INTERNAL_ASSIGN_EXPRS}}", internal_assign_exps_str},
              {"{{EXP}}", var2ast.at(internal_graph.output())->code_gen()},
@@ -21,11 +21,14 @@ namespace mgb {
 namespace jit {
 /*!
  * \brief generate cuda kernel source code
+ * \param const_shape whether to specialize the kernel with the layouts in
+ *      args, see JITExecutor::Args::const_shape; the generated kernel only
+ *      takes the Data param
  * \return (kernel name, kernel source)
  */
 std::pair<std::string, std::string> codegen_cuda(
         const InternalGraph& internal_graph, const JITExecutor::Args& args,
-        bool copy_param_to_dev);
+        bool copy_param_to_dev, bool const_shape = false);
 
 }  // namespace jit
 }  // namespace mgb
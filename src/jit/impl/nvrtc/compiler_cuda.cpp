@@ -169,6 +169,30 @@ void setup_and_launch(const JITExecutor* fusion_opr, CUfunction func, int block_
             func, num_block, 1, 1, block_size, 1, 1, 0, env.cuda_env().stream,
             exec_args, 0));
 }
+
+//! launch kernel generated with const shape, whose only param is the data ptrs
+void launch_const_shape(const JITExecutor* fusion_opr, CUfunction func, int block_size) {
+    auto&& args = fusion_opr->args();
+    size_t nr_inps = args.inputs.size();
+    SmallVector<CUdeviceptr> datum(nr_inps + 1);
+    for (size_t i = 0; i < nr_inps; i++) {
+        datum[i] = reinterpret_cast<CUdeviceptr>(
+                args.inputs[i].from->dev_tensor().raw_ptr());
+    }
+    datum[nr_inps] = reinterpret_cast<CUdeviceptr>(
+            args.outputs[0].from->dev_tensor().as_megdnn().raw_ptr());
+    size_t num_elements = args.outputs[0].layout.total_nr_elems();
+    mgb_assert(
+            num_elements <= UINT32_MAX,
+            "Currently JIT only supports 32 bit of elememt size for better "
+            "performance");
+    int num_block = (num_elements - 1) / (block_size * 3) + 1;
+    void* exec_args[1] = {datum.data()};
+    MGB_CUDA_CU_CHECK(cuLaunchKernel(
+            func, num_block, 1, 1, block_size, 1, 1, 0,
+            CompNodeEnv::from_comp_node(fusion_opr->comp_node()).cuda_env().stream,
+            exec_args, 0));
+}
 }  // namespace
 
 void mgb::jit::_on_nvrtc_error(
@@ -181,8 +205,10 @@ void mgb::jit::_on_nvrtc_error(
 
 /* =================== CudaExecutable ==================== */
 
-CudaExecutable::CudaExecutable(std::string source, std::string name)
-        : m_source{std::move(source)}, m_name{std::move(name)} {}
+CudaExecutable::CudaExecutable(std::string source, std::string name, bool const_shape)
+        : m_source{std::move(source)},
+          m_name{std::move(name)},
+          m_const_shape{const_shape} {}
 
 void CudaExecutable::execute(JITExecutor* fusion_opr) {
     FuncCache* func;
@@ -240,6 +266,11 @@ void CudaExecutable::FuncCache::exec(
         }
     }
 
+    if (cuda_exe->m_const_shape) {
+        launch_const_shape(fusion_opr, func->func, func->block_size);
+        return;
+    }
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-value"
     int out_dim = fusion_opr->args().outputs[0].layout.ndim;
@@ -280,10 +311,14 @@ std::unique_ptr<Executable> CudaCompiler::do_compile(
                 "put in GPU global memory.",
                 graph.placeholders().size(), MAX_CUDA_NR_INPUT);
     }
+    // kernels of const-shape graphs are specialized with the exact layouts,
+    // which are also bound to the Executable by Args::operator==
+    bool const_shape = args.const_shape && !copy_param_to_dev;
     std::string source, kernel_name;
-    std::tie(kernel_name, source) = codegen_cuda(graph, args, copy_param_to_dev);
-    auto ret =
-            std::make_unique<CudaExecutable>(std::move(source), std::move(kernel_name));
+    std::tie(kernel_name, source) =
+            codegen_cuda(graph, args, copy_param_to_dev, const_shape);
+    auto ret = std::make_unique<CudaExecutable>(
+            std::move(source), std::move(kernel_name), const_shape);
     return ret;
 }
 
@@ -40,7 +40,7 @@ namespace jit {
  */
 class CudaExecutable final : public Executable {
 public:
-    CudaExecutable(std::string source, std::string name);
+    CudaExecutable(std::string source, std::string name, bool const_shape = false);
     ~CudaExecutable();
 
     /*!
@@ -70,6 +70,9 @@ private:
 
     const std::string m_source;
     const std::string m_name;
+    //! whether the kernel is specialized with constant layouts, so no
+    //! ParamElemVisitor is needed at runtime
+    const bool m_const_shape;
     std::mutex m_mtx;
     //! (cuda_major, cuda_minor) => func
     ThinHashMap<std::pair<uint32_t, uint32_t>, FuncCache> m_func_cache;
@@ -95,7 +98,8 @@ public:
     Property property() const override {
         using F = Property::Flag;
         return Property{
-                F::NEED_INPUT_COLLAPSE | F::BIND_NDIM, JITFeatureBits::NONE, 64};
+                F::NEED_INPUT_COLLAPSE | F::BIND_NDIM | F::SPECIALIZE_CONST_SHAPE,
+                JITFeatureBits::NONE, 64};
     }
 
     size_t get_nr_workspace_outputs(JITExecutor* opr) const override;
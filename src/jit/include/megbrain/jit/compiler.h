@@ -61,7 +61,12 @@ public:
 
             //! if true, input would be contiguous; otherwise it is only
             //! monotone contiguous
-            NEED_INPUT_CONTIG = 1u << 3
+            NEED_INPUT_CONTIG = 1u << 3,
+
+            //! whether Executable could be specialized with the exact layouts
+            //! when all shapes of the JITExecutor are constant; see
+            //! JITExecutor::Args::const_shape
+            SPECIALIZE_CONST_SHAPE = 1u << 4
         };
 
         //! flags that indicate requirements of this Compiler for the
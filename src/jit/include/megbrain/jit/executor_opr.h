@@ -84,6 +84,13 @@ public:
         bool need_update = true;
         std::vector<Data> inputs, outputs;
 
+        //! whether shapes of all inputs and outputs are constant (e.g. the
+        //! graph is loaded with GraphLoadConfig::const_var_shape) and the
+        //! compiler supports SPECIALIZE_CONST_SHAPE; if true, Args are equal
+        //! only if all the layouts are identical, so the Executable could use
+        //! the shapes and strides as compile-time constants
+        bool const_shape = false;
+
         size_t hash;
 
         //! version from a global counter for fast equality test;
@@ -125,6 +132,9 @@ public:
     //! get broadcasted shape of inputs
     megdnn::TensorShape broadcasted_input_shape() const;
 
+    //! whether shapes of the output and all the tensor inputs are constant
+    bool is_const_shape() const;
+
     //! the Compiler associated with this JIT subgraph
     Compiler* compiler() const { return m_compiler; }
 
@@ -15,6 +15,7 @@
 #include "megbrain/jit/executor_opr.h"
 #include "megbrain/opr/basic_arith.h"
 #include "megbrain/opr/basic_arith_wrapper.h"
+#include "megbrain/opr/io.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/test/helper.h"
 #include "megdnn/dtype.h"
@@ -23,7 +24,7 @@
 using namespace mgb;
 using namespace jit;
 
-#define FOREACH_CASE(cb) cb(simple) cb(grad)
+#define FOREACH_CASE(cb) cb(simple) cb(grad) cb(const_shape)
 
 namespace {
 #define def_tag(x) \
@@ -119,6 +120,44 @@ void run<grad>(Backend backend, CompNode cn) {
     ASSERT_NE(nullptr, grad(c));
 };
 
+template <>
+void run<const_shape>(Backend backend, CompNode cn) {
+    set_backend(backend);
+    auto graph = ComputingGraph::make();
+    HostTensorGenerator<> gen;
+    auto host_x0 = gen({23, 42}, cn), host_x1 = gen({23, 1}, cn),
+         host_x2 = gen({1, 42}, cn);
+
+    // shapes of SharedDeviceTensor are constant
+    auto a = opr::SharedDeviceTensor::make(*graph, *host_x0),
+         b = opr::SharedDeviceTensor::make(*graph, *host_x1),
+         c = opr::SharedDeviceTensor::make(*graph, *host_x2);
+
+    auto y = opr::exp(a) * b + c;
+
+    auto ig_gen = std::make_unique<InternalGraphGenerator>(y.node()->owner_opr());
+
+    for (auto i : get_rev_topo_order(y)) {
+        if (!i->same_type<opr::SharedDeviceTensor>()) {
+            ig_gen->add_opr(i);
+        }
+    }
+
+    auto igraph = ig_gen->generate();
+    auto y_jit = JITExecutor::make(igraph, ig_gen->orig_inps());
+
+    HostTensorND host_y, host_y_jit;
+    auto func = graph->compile(
+            {make_callback_copy(y, host_y), make_callback_copy(y_jit, host_y_jit)});
+    func->execute();
+
+    MGB_ASSERT_TENSOR_NEAR(host_y, host_y_jit, 1e-5);
+
+    auto&& jit_opr = y_jit.node()->owner_opr()->cast_final_safe<JITExecutor>();
+    ASSERT_TRUE(jit_opr.is_const_shape());
+    ASSERT_EQ(backend == Backend::NVRTC, jit_opr.args().const_shape);
+};
+
 template <>
 void run<void>(Backend, CompNode) {}
 
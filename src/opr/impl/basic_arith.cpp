@@ -389,6 +389,12 @@ void Elemwise::get_output_var_shape(
 }
 
 void Elemwise::add_input_layout_constraint() {
+    //! elemwise kernels on cuda visit each input by its own strides, so
+    //! arbitrary strided views (e.g. from Dimshuffle or Subtensor) can be
+    //! consumed without a relayout copy
+    if (comp_node().device_type() == CompNode::DeviceType::CUDA) {
+        return;
+    }
     for (auto i : input()) {
         i->add_layout_constraint_monotone();
     }
@@ -182,6 +182,182 @@ MGB_IMPL_OPR_GRAD(IndexingRemap) {
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(IndexingRemapBackward);
 MEGDNN_OPR_INIT3(IndexingRemapBackward, "indexing_remap_bwd", 2, false);
 
+/* ==================== EmbeddingBag ==================== */
+namespace {
+SymbolVar cvt_to_int32(SymbolVar var, const char* name) {
+    if (var.dtype() != dtype::Int32()) {
+        mgb_log_warn(
+                "dtype of %s in EmbeddingBag must be Int32, got %s for variable %s; "
+                "convert to Int32 implicitly",
+                name, var.dtype().name(), var.node()->cname());
+        return opr::TypeCvt::make(var, dtype::Int32());
+    }
+    return var;
+}
+
+//! layout of per_sample_weights, or an empty layout if it is not given
+TensorLayout embedding_bag_psw_layout(
+        const cg::OperatorNodeBase& opr, const TensorShapeArray& shapes,
+        size_t nr_inp_no_psw) {
+    if (shapes.size() == nr_inp_no_psw) {
+        return TensorLayout{opr.input(0)->dtype()};
+    }
+    return {shapes[3], opr.input(3)->dtype()};
+}
+
+megdnn::TensorND embedding_bag_psw_tensor(
+        const cg::OperatorNodeBase& opr, size_t nr_inp_no_psw) {
+    if (opr.input().size() == nr_inp_no_psw) {
+        return {nullptr, TensorLayout{opr.input(0)->dtype()}};
+    }
+    return opr.input(3)->dev_tensor().as_megdnn();
+}
+}  // anonymous namespace
+
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(EmbeddingBag);
+
+EmbeddingBag::EmbeddingBag(
+        const VarNodeArrayView& inputs, const Param& param,
+        const OperatorNodeConfig& config)
+        : Super(OperatorNodeBaseCtorParam{
+                  inputs[0]->owner_graph(), config, "embedding_bag", {inputs[0]}}) {
+    mgb_assert(
+            inputs.size() == 3 || inputs.size() == 4,
+            "EmbeddingBag expects 3 or 4 inputs, got %zu", inputs.size());
+    init_megdnn_opr(*this, param);
+    for (auto i : inputs) {
+        add_input({i});
+    }
+}
+
+SymbolVar EmbeddingBag::make(
+        SymbolVar weight, SymbolVar indices, SymbolVar bags, const Param& param,
+        const OperatorNodeConfig& config) {
+    return make({weight, indices, bags}, param, config);
+}
+
+SymbolVar EmbeddingBag::make(
+        SymbolVar weight, SymbolVar indices, SymbolVar bags,
+        SymbolVar per_sample_weights, const Param& param,
+        const OperatorNodeConfig& config) {
+    return make({weight, indices, bags, per_sample_weights}, param, config);
+}
+
+SymbolVar EmbeddingBag::make(
+        const VarNodeArrayView& inputs, const Param& param,
+        const OperatorNodeConfig& config) {
+    mgb_assert(inputs.size() >= 3);
+    VarNodeArray inp(inputs.begin(), inputs.end());
+    inp[1] = cvt_to_int32(inp[1], "indices").node();
+    inp[2] = cvt_to_int32(inp[2], "bags").node();
+    return SymbolVar{inp[0]}.insert_single_output_opr<EmbeddingBag>(
+            inp, param, config);
+}
+
+void EmbeddingBag::get_output_var_shape(
+        const TensorShapeArray& inp_shape, TensorShapeArray& out_shape) const {
+    TensorLayout dst;
+    megdnn_opr()->deduce_layout(
+            {inp_shape[0], input(0)->dtype()}, {inp_shape[1], input(1)->dtype()},
+            {inp_shape[2], input(2)->dtype()},
+            embedding_bag_psw_layout(*this, inp_shape, 3), dst);
+    out_shape[0] = dst;
+}
+
+size_t EmbeddingBag::get_workspace_size_bytes(
+        const TensorShapeArray& input_shapes,
+        const TensorShapeArray& output_shapes) const {
+    return megdnn_opr()->get_workspace_in_bytes(
+            {input_shapes[0], input(0)->dtype()}, {input_shapes[1], input(1)->dtype()},
+            {input_shapes[2], input(2)->dtype()},
+            embedding_bag_psw_layout(*this, input_shapes, 3),
+            {output_shapes[0], output(0)->dtype()});
+}
+
+void EmbeddingBag::scn_do_execute() {
+    megdnn_opr()->exec(
+            input(0)->dev_tensor().as_megdnn(), input(1)->dev_tensor().as_megdnn(),
+            input(2)->dev_tensor().as_megdnn(), embedding_bag_psw_tensor(*this, 3),
+            output(0)->dev_tensor().as_megdnn(),
+            intl::get_megdnn_workspace_from_var(output(1)));
+}
+
+#if MGB_ENABLE_GRAD
+MGB_IMPL_OPR_GRAD(EmbeddingBag) {
+    if (wrt_idx != 0) {
+        return InvalidGrad::make(opr, wrt_idx);
+    }
+    VarNodeArray inp(opr.input().begin(), opr.input().end());
+    inp.push_back(out_grad.at(0));
+    auto rows = EmbeddingBagBackward::make(inp, opr.param());
+    // a graph var can only hold a dense grad, so the rows are scattered into
+    // a zero table here; imperative grads attached with row_sparse keep the
+    // (indices, rows) pair instead and never build the table
+    SymbolVar weight{opr.input(0)};
+    return IndexingIncrMultiAxisVec::make(
+                   weight.fill_retain_dtype(0), rows,
+                   {indexing::AxisIndexer::make_index(0, opr.input(1))})
+            .node();
+}
+#endif
+
+/* ==================== EmbeddingBagBackward ==================== */
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(EmbeddingBagBackward);
+
+EmbeddingBagBackward::EmbeddingBagBackward(
+        const VarNodeArrayView& inputs, const Param& param,
+        const OperatorNodeConfig& config)
+        : Super(OperatorNodeBaseCtorParam{
+                  inputs[0]->owner_graph(), config, "embedding_bag_bwd",
+                  {inputs[0]}}) {
+    mgb_assert(
+            inputs.size() == 4 || inputs.size() == 5,
+            "EmbeddingBagBackward expects 4 or 5 inputs, got %zu", inputs.size());
+    init_megdnn_opr(*this, param);
+    for (auto i : inputs) {
+        add_input({i});
+    }
+}
+
+SymbolVar EmbeddingBagBackward::make(
+        const VarNodeArrayView& inputs, const Param& param,
+        const OperatorNodeConfig& config) {
+    mgb_assert(!inputs.empty());
+    return SymbolVar{inputs[0]}.insert_single_output_opr<EmbeddingBagBackward>(
+            inputs, param, config);
+}
+
+void EmbeddingBagBackward::get_output_var_shape(
+        const TensorShapeArray& inp_shape, TensorShapeArray& out_shape) const {
+    TensorLayout grad;
+    megdnn_opr()->deduce_layout(
+            {inp_shape[0], input(0)->dtype()}, {inp_shape[1], input(1)->dtype()},
+            {inp_shape[2], input(2)->dtype()},
+            embedding_bag_psw_layout(*this, inp_shape, 4),
+            {inp_shape.back(), input().back()->dtype()}, grad);
+    out_shape[0] = grad;
+}
+
+size_t EmbeddingBagBackward::get_workspace_size_bytes(
+        const TensorShapeArray& input_shapes,
+        const TensorShapeArray& output_shapes) const {
+    return megdnn_opr()->get_workspace_in_bytes(
+            {input_shapes[0], input(0)->dtype()}, {input_shapes[1], input(1)->dtype()},
+            {input_shapes[2], input(2)->dtype()},
+            embedding_bag_psw_layout(*this, input_shapes, 4),
+            {input_shapes.back(), input().back()->dtype()},
+            {output_shapes[0], output(0)->dtype()});
+}
+
+void EmbeddingBagBackward::scn_do_execute() {
+    megdnn_opr()->exec(
+            input(0)->dev_tensor().as_megdnn(), input(1)->dev_tensor().as_megdnn(),
+            input(2)->dev_tensor().as_megdnn(), embedding_bag_psw_tensor(*this, 4),
+            input().back()->dev_tensor().as_megdnn(),
+            output(0)->dev_tensor().as_megdnn(),
+            intl::get_megdnn_workspace_from_var(output(1)));
+}
+
 /* ================= IndexingMultiAxisVecMegDNNOprHolder ================= */
 template <class Opr>
 Opr& mixin::IndexingMultiAxisVecMegDNNOprHolder<Opr>::megdnn_opr(
@@ -359,6 +535,62 @@ void IndexingMultiAxisVecBase<Opr>::init_output_static_infer_desc() {
         }
     }
     this->register_workspace_infer(index_desc(), *this, input(0), output(0), idx_arr);
+
+    // value infer; vector indexing into a shape (e.g. gathering dims from
+    // GetVarShape) is common in converted models, and without it every shape
+    // computed from the gathered dims would become dynamic
+    for (auto&& i : deps) {
+        i.type = DepType::VALUE;
+    }
+    auto infer_value = [this, inp_interval_start](
+                               DeviceTensorND& dest, const InpVal& inp) {
+        auto&& iv = inp.val[0].value();
+        auto src = const_cast<DeviceTensorND&>(iv).sub(
+                fancy_indexing_make_sub_spec(iv.layout(), inp, inp_interval_start));
+        typename Opr::IndexDesc index;
+        typename Opr::IndexDescLayoutOnly index_layout;
+        SmallVector<DeviceTensorND> idx_storage;
+        size_t axes[TensorShape::MAX_NDIM], nr_axes = 0, idx_ndim = 0;
+        size_t indexer_pos = 1;
+        for (auto i : reverse_adaptor(m_input2idxonly_axis_indexer)) {
+            if (i) {
+                auto idx = inp.val.at(indexer_pos++).value();
+                if (!idx.layout().is_contiguous()) {
+                    DeviceTensorND tmp;
+                    tmp.copy_from(idx);
+                    idx = tmp;
+                }
+                idx_storage.push_back(idx);
+                size_t axis = i->axis.get(src.layout().ndim);
+                index.push_back({axis, idx.as_megdnn()});
+                index_layout.push_back({axis, idx.layout()});
+                axes[nr_axes++] = axis;
+                idx_ndim = std::max(idx_ndim, idx.shape().ndim);
+            }
+        }
+        mgb_assert(indexer_pos == inp_interval_start);
+        if (index.empty()) {
+            dest = src;
+            return true;
+        }
+        TensorLayout olayout;
+        Opr::deduce_layout(src.layout(), index_layout, olayout);
+        dest.resize(olayout);
+        if (olayout.is_empty()) {
+            return true;
+        }
+        auto cpu = CompNode::default_cpu();
+        auto dnn_opr = intl::MegDNNOprPool::inst().acquire<Opr>(cpu);
+        DeviceTensorND workspace{cpu, dtype::Byte()};
+        workspace.resize({dnn_opr->get_workspace_in_bytes(
+                olayout, axes, nr_axes, idx_ndim)});
+        dnn_opr->exec(
+                src.as_megdnn(), index, dest.as_megdnn(),
+                {workspace.raw_ptr(), workspace.shape(0)});
+        return true;
+    };
+    owner_graph()->static_infer_manager().register_value_infer(
+            output(0), {SourceType::DEP, deps, infer_value});
 }
 
 template <class Opr>
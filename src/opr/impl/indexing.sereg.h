@@ -24,11 +24,36 @@ MGB_SEREG_MODIFY_SUBTENSOR_OPR(SetMeshIndexing);
 MGB_SEREG_MODIFY_SUBTENSOR_OPR(BatchedSetMeshIndexing);
 
 namespace mgb {
+
+namespace serialization {
+//! EmbeddingBag and its backward take an optional per_sample_weights input
+template <class Opr>
+struct EmbeddingBagOprMaker {
+    using Param = typename Opr::Param;
+    static cg::OperatorNodeBase* make(
+            const Param& param, const cg::VarNodeArray& inputs, ComputingGraph& graph,
+            const OperatorNodeConfig& config) {
+        MGB_MARK_USED_VAR(graph);
+        return Opr::make(inputs, param, config).node()->owner_opr();
+    }
+};
+
+template <>
+struct OprMaker<opr::EmbeddingBag, 0> : public EmbeddingBagOprMaker<opr::EmbeddingBag> {
+};
+
+template <>
+struct OprMaker<opr::EmbeddingBagBackward, 0>
+        : public EmbeddingBagOprMaker<opr::EmbeddingBagBackward> {};
+}  // namespace serialization
+
 namespace opr {
 MGB_SEREG_OPR(IndexingOneHot, 2);
 MGB_SEREG_OPR(IndexingRemap, 2);
 MGB_SEREG_OPR(IndexingRemapBackward, 3);
 MGB_SEREG_OPR(IndexingSetOneHot, 3);
+MGB_SEREG_OPR(EmbeddingBag, 0);
+MGB_SEREG_OPR(EmbeddingBagBackward, 0);
 }  // namespace opr
 }  // namespace mgb
 
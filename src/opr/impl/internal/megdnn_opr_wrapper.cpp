@@ -71,6 +71,91 @@ Opr* intl::get_megdnn_global_opr(CompNode comp_node) {
     return CompNodeEnv::from_comp_node(comp_node).get_user_data<T>(maker).get();
 }
 
+/* ================== MegDNNOprPool ================== */
+
+class MegDNNOprPool::FinalizeGuard final : public CompNodeDepedentObject {
+    MegDNNOprPool* const m_pool;
+
+    std::shared_ptr<void> on_comp_node_finalize() override {
+        return m_pool->on_comp_node_finalize();
+    }
+
+public:
+    explicit FinalizeGuard(MegDNNOprPool* pool) : m_pool{pool} {}
+};
+
+MegDNNOprPool& MegDNNOprPool::inst() {
+    // never destructed, so oprs are not released after their handles
+    static MegDNNOprPool* inst = new MegDNNOprPool;
+    return *inst;
+}
+
+std::unique_ptr<megdnn::OperatorBase> MegDNNOprPool::do_acquire(
+        megdnn::Handle* handle, std::type_index type, Creator creator,
+        size_t* epoch) {
+    {
+        MGB_LOCK_GUARD(m_mtx);
+        if (!m_guard) {
+            m_guard = std::make_unique<FinalizeGuard>(this);
+        }
+        *epoch = m_epoch;
+        auto iter = m_idle.find({handle, type});
+        if (iter != m_idle.end() && !iter->second.empty()) {
+            auto opr = std::move(iter->second.back());
+            iter->second.pop_back();
+            return opr;
+        }
+    }
+    return creator(handle);
+}
+
+void MegDNNOprPool::give_back(
+        std::unique_ptr<megdnn::OperatorBase> opr, MegDNNOprPoolKey key) {
+    if (!opr || !key.type) {
+        return;
+    }
+    MGB_LOCK_GUARD(m_mtx);
+    if (key.epoch != m_epoch) {
+        return;
+    }
+    auto&& idle = m_idle[{opr->handle(), std::type_index{*key.type}}];
+    if (idle.size() < MAX_IDLE_PER_KEY) {
+        opr->set_error_tracker(nullptr);
+        idle.emplace_back(std::move(opr));
+    }
+}
+
+void MegDNNOprPool::recycle(
+        CompNode comp_node, std::unique_ptr<megdnn::OperatorBase> opr,
+        MegDNNOprPoolKey key) {
+    if (comp_node.valid() && comp_node.device_type() == CompNode::DeviceType::CPU &&
+        comp_node != CompNode::default_cpu()) {
+        CompNodeEnv::from_comp_node(comp_node).cpu_env().dispatch(
+                [this, p = opr.release(), key] {
+                    give_back(std::unique_ptr<megdnn::OperatorBase>{p}, key);
+                });
+        return;
+    }
+    give_back(std::move(opr), key);
+}
+
+size_t MegDNNOprPool::nr_idle() const {
+    MGB_LOCK_GUARD(m_mtx);
+    size_t ret = 0;
+    for (auto&& i : m_idle) {
+        ret += i.second.size();
+    }
+    return ret;
+}
+
+std::shared_ptr<void> MegDNNOprPool::on_comp_node_finalize() {
+    MGB_LOCK_GUARD(m_mtx);
+    m_idle.clear();
+    ++m_epoch;
+    // the guard is destructed by the caller after the callback returns
+    return std::shared_ptr<FinalizeGuard>{std::move(m_guard)};
+}
+
 namespace mgb {
 namespace opr {
 namespace intl {
@@ -300,7 +385,7 @@ void MegDNNDynOutMallocImpl::free_workspace(void* ptr, void* /*user_data*/) {
 }
 
 /* ================== MegDNNGraphDep ================== */
-MegDNNGraphDep::MegDNNGraphDep(std::unique_ptr<megdnn::OperatorBase> opr) noexcept
+MegDNNGraphDep::MegDNNGraphDep(PooledMegDNNOpr<megdnn::OperatorBase> opr) noexcept
         : m_opr{std::move(opr)} {}
 
 MegDNNGraphDep::~MegDNNGraphDep() noexcept = default;
@@ -366,12 +451,12 @@ void MegDNNOprHolder::mixin_on_output_comp_node_stream_changed(OperatorNodeBase&
     m_dnn_opr->set_error_tracker(&self);
 }
 
-void MegDNNOprHolder::set_megdnn_opr(std::unique_ptr<megdnn::OperatorBase> self) {
+void MegDNNOprHolder::set_megdnn_opr(PooledMegDNNOpr<megdnn::OperatorBase> self) {
     m_dnn_opr = std::move(self);
 }
 
 void MegDNNOprHolder::record_megdnn_opr(
-        std::unique_ptr<megdnn::OperatorBase> opr,
+        PooledMegDNNOpr<megdnn::OperatorBase> opr,
         cg::GraphExecutable::ExecDependencyArray& deps) {
     deps.emplace_back(std::make_unique<MegDNNGraphDep>(std::move(opr)));
 }
@@ -13,10 +13,12 @@
 #include "megbrain/opr/search_policy/algo_chooser.h"
 #include <limits>
 #include <unordered_set>
+#include "megbrain/graph/event.h"
 #include "megbrain/opr/dnn/convolution.h"
 #include "megbrain/opr/internal/megdnn_opr_wrapper.h"
 #include "megbrain/opr/search_policy/algo_chooser_helper.h"
 #include "megbrain/opr/search_policy/profiler.h"
+#include "megbrain/utils/timer.h"
 
 #include "../internal/invoke.h"
 #include "../internal/megdnn_opr_wrapper.inl"
@@ -892,6 +894,7 @@ void AlgoChooser<Opr>::AlgoChooserHelper::profile(
 
         ImplExecutionPolicy policy;
         policy.algo = algo.desc;
+        policy.deterministic = deterministic();
 
         //! check negative attribute : skip negative attribute
         auto palgo = m_dnn_opr->get_algorithm_from_desc(policy.algo);
@@ -964,6 +967,32 @@ void AlgoChooser<Opr>::AlgoChooserHelper::profile(
     MIDOUT_E
 }
 
+template <typename Opr>
+double AlgoChooser<Opr>::AlgoChooserHelper::profile_deterministic_slowdown(
+        const ImplExecutionPolicy& policy) const {
+    MIDOUT_B(Opr, midout_iv(MGB_HASH_STR("profile_deterministic_slowdown")))
+    mgb_assert(policy.deterministic);
+    auto adaptive_policy = policy;
+    adaptive_policy.deterministic = false;
+    double timeout = 0, adaptive_timeout = 0;
+    Maybe<AlgoChooserProfileCache::ResultEntry> rst, adaptive_rst;
+    MGB_TRY {
+        rst = profile_single_algo(policy, timeout);
+        adaptive_rst = profile_single_algo(adaptive_policy, adaptive_timeout);
+    }
+    MGB_CATCH(std::exception & exc, {
+        mgb_log_warn(
+                "caught exception when profiling deterministic %s: %s",
+                m_base_mgb_opr->dyn_typeinfo()->name, exc.what());
+        return 0;
+    })
+    if (!rst.valid() || !adaptive_rst.valid() || adaptive_rst->time <= 0) {
+        return 0;
+    }
+    return rst->time / adaptive_rst->time;
+    MIDOUT_E
+}
+
 template <typename Opr>
 Maybe<PreprocessFilter<Opr>> AlgoChooser<Opr>::AlgoChooserHelper::
         construct_fake_preprocess_filter(const FixedTensorLayouts& layouts) const {
@@ -1030,6 +1059,10 @@ std::pair<AlgoAttribute, AlgoAttribute> AlgoChooser<Opr>::AlgoChooserHelper::
         ret.second |= AlgoAttribute::ACCURACY_DEPEND_ON_BATCH;
     }
 
+    if (owner_graph()->options().deterministic) {
+        ret.first |= AlgoAttribute::REPRODUCIBLE;
+    }
+
     return ret;
 }
 
@@ -1070,7 +1103,11 @@ std::pair<AlgoAttribute, AlgoAttribute> AlgoChooser<Opr>::AlgoChooserHelper::
     AlgoChooser<megdnn::Opr>::AlgoChooserHelper::extract_algo_attribute(          \
             const ExecutionStrategy& strategy) const;                             \
     template void AlgoChooser<megdnn::Opr>::AlgoChooserHelper::profile(           \
-            const ExecutionStrategy& selected_strategy) const;
+            const ExecutionStrategy& selected_strategy) const;                    \
+    template double                                                               \
+    AlgoChooser<megdnn::Opr>::AlgoChooserHelper::profile_deterministic_slowdown(  \
+            const typename AlgoChooser<megdnn::Opr>::ImplExecutionPolicy& policy) \
+            const;
 
 MGB_FOREACH_FASTRUN_OPR(INST)
 #undef INST
@@ -1124,19 +1161,41 @@ template <typename Opr>
 size_t AlgoChooser<Opr>::setup_algo(
         const FixedTensorLayouts& layouts, Opr* megdnn_opr, const MGBOpr* mgb_opr,
         bool allow_weight_preprocess) {
+    RealTimer timer;
+    auto on_algo_chosen = [&](const ImplExecutionPolicy& policy, bool from_cache,
+                              double deterministic_slowdown = 0) {
+        auto&& event = mgb_opr->owner_graph()->event();
+        if (!event.template has_receiver<cg::event::AlgoChosen>()) {
+            return;
+        }
+        Algorithm* palgo = megdnn_opr->get_algorithm_from_desc(policy.algo);
+        event.template signal_inplace<cg::event::AlgoChosen>(
+                const_cast<MGBOpr*>(mgb_opr), palgo ? palgo->name() : "",
+                timer.get_secs(), from_cache, deterministic_slowdown);
+    };
+
+    //! the heuristic cache is shared by all graphs and does not record the
+    //! deterministic requirement, so it is bypassed in deterministic mode
+    bool deterministic = mgb_opr->owner_graph()->options().deterministic;
     HeuristicCache::Key cache_key(
             megdnn_opr->handle(), megdnn_opr->get_opr_type(), layouts.data(),
             layouts.size(), &megdnn_opr->param(), sizeof(megdnn_opr->param()));
-    auto rst = HeuristicCache::instance().get(cache_key);
-    if (rst.policy.algo.valid()) {
-        megdnn_opr->execution_policy() = rst.policy;
-        return rst.workspace;
+    if (!deterministic) {
+        auto rst = HeuristicCache::instance().get(cache_key);
+        if (rst.policy.algo.valid()) {
+            megdnn_opr->execution_policy() = rst.policy;
+            on_algo_chosen(rst.policy, true);
+            return rst.workspace;
+        }
     }
 
     if (WorkspaceLimitGetter::is_prealloc_run(mgb_opr->owner_graph())) {
         return 0;
     }
 
+    //! the heuristic of megdnn must see the requirement as well, since it
+    //! changes the workspace of the candidates
+    megdnn_opr->execution_policy().deterministic = deterministic;
     std::string param_str;
     Algorithm::serialize_write_pod(megdnn_opr->param(), param_str);
     AlgoChooserHelper helper(
@@ -1153,6 +1212,7 @@ size_t AlgoChooser<Opr>::setup_algo(
     if (!policy.algo.valid()) {
         policy = get_policy(helper);
     }
+    policy.deterministic = deterministic;
     size_t workspace = helper.get_workspace_size_bytes(policy, layouts);
 
     std::string ret;
@@ -1167,12 +1227,25 @@ size_t AlgoChooser<Opr>::setup_algo(
             static_cast<uint32_t>(palgo->attribute())));
     mgb_log_debug("%s", ret.c_str());
 
+    double deterministic_slowdown = 0;
+#if MGB_ENABLE_FASTRUN
+    if (deterministic &&
+        (mgb_opr->execution_policy().strategy & ExecutionStrategy::PROFILE)) {
+        deterministic_slowdown = helper.profile_deterministic_slowdown(policy);
+        mgb_log_debug(
+                "%s: deterministic algo=%s slowdown=%.3f", mgb_opr->cname(),
+                palgo->name(), deterministic_slowdown);
+    }
+#endif
+
     megdnn_opr->execution_policy() = policy;
 
-    if (mgb_opr->execution_policy().strategy & ExecutionStrategy::HEURISTIC) {
+    if (!deterministic &&
+        (mgb_opr->execution_policy().strategy & ExecutionStrategy::HEURISTIC)) {
         HeuristicCache::Result cache_result{policy, workspace};
         HeuristicCache::instance().put(cache_key, cache_result);
     }
+    on_algo_chosen(policy, false, deterministic_slowdown);
     return workspace;
 }
 
@@ -46,6 +46,7 @@ std::string serialize_policy(const megdnn::ExecutionPolicy& policy) {
     megdnn::Algorithm::serialize_write_pod<uint32_t>(name_size, ret);
     ret += policy.algo.param;
     ret += policy.algo.name;
+    megdnn::Algorithm::serialize_write_pod<uint8_t>(policy.deterministic, ret);
 
     //! serialize sub_policy
     uint32_t size = policy.sub_policy.size();
@@ -78,6 +79,9 @@ megdnn::ExecutionPolicy deserialize_policy(
         ret.algo.name = std::string(buf + offset, name_size);
         offset += name_size;
     }
+    uint8_t deterministic = 0;
+    cb(deterministic, uint8_t);
+    ret.deterministic = deterministic;
 
     uint32_t nr_policy = 0;
     cb(nr_policy, uint32_t);
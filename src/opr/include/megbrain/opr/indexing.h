@@ -85,6 +85,66 @@ public:
             const Param& param, const OperatorNodeConfig& config = {});
 };
 
+/*!
+ * \brief gather rows of weight by indices and reduce them in bags
+ *
+ * Inputs are (weight, indices, bags) or (weight, indices, bags,
+ * per_sample_weights); see megdnn::EmbeddingBagForward for details.
+ */
+MGB_DEFINE_OPR_CLASS(
+        EmbeddingBag, intl::MegDNNOprWrapperFwd<megdnn::EmbeddingBagForward>) // {
+    void get_output_var_shape(
+            const TensorShapeArray& inp_shape,
+            TensorShapeArray& out_shape) const override;
+    size_t get_workspace_size_bytes(
+            const TensorShapeArray& input_shapes,
+            const TensorShapeArray& output_shapes) const override;
+    void scn_do_execute() override;
+
+public:
+    MGE_WIN_DECLSPEC_FUC EmbeddingBag(
+            const VarNodeArrayView& inputs, const Param& param,
+            const OperatorNodeConfig& config);
+    MGE_WIN_DECLSPEC_FUC static SymbolVar make(
+            SymbolVar weight, SymbolVar indices, SymbolVar bags, const Param& param,
+            const OperatorNodeConfig& config = {});
+    MGE_WIN_DECLSPEC_FUC static SymbolVar make(
+            SymbolVar weight, SymbolVar indices, SymbolVar bags,
+            SymbolVar per_sample_weights, const Param& param,
+            const OperatorNodeConfig& config = {});
+    static SymbolVar make(
+            const VarNodeArrayView& inputs, const Param& param,
+            const OperatorNodeConfig& config = {});
+};
+
+/*!
+ * \brief rows of the gradient of EmbeddingBag w.r.t. weight, one row for each
+ *      index
+ *
+ * Inputs are (weight, indices, bags, diff) or (weight, indices, bags,
+ * per_sample_weights, diff). The output together with indices forms a
+ * row-sparse gradient of weight.
+ */
+MGB_DEFINE_OPR_CLASS(
+        EmbeddingBagBackward,
+        intl::MegDNNOprWrapperFwd<megdnn::EmbeddingBagBackward>) // {
+    void get_output_var_shape(
+            const TensorShapeArray& inp_shape,
+            TensorShapeArray& out_shape) const override;
+    size_t get_workspace_size_bytes(
+            const TensorShapeArray& input_shapes,
+            const TensorShapeArray& output_shapes) const override;
+    void scn_do_execute() override;
+
+public:
+    MGE_WIN_DECLSPEC_FUC EmbeddingBagBackward(
+            const VarNodeArrayView& inputs, const Param& param,
+            const OperatorNodeConfig& config);
+    MGE_WIN_DECLSPEC_FUC static SymbolVar make(
+            const VarNodeArrayView& inputs, const Param& param,
+            const OperatorNodeConfig& config = {});
+};
+
 namespace mixin {
 
 template <class Opr>
@@ -15,6 +15,11 @@
 #include "megbrain/opr/internal/mixin_base.h"
 
 #include "megdnn/handle.h"
+#include "megdnn/oprs/base.h"
+
+#include <map>
+#include <typeindex>
+#include <typeinfo>
 
 namespace mgb {
 namespace opr {
@@ -58,6 +63,194 @@ UniqPtrWithCN<Opr> create_megdnn_opr(CompNode comp_node) {
     return {get_megdnn_handle(comp_node)->create_operator<Opr>(), comp_node};
 }
 
+class MegDNNOprPool;
+
+//! where a pooled opr should be given back
+struct MegDNNOprPoolKey {
+    //! the type the opr is acquired as; nullptr if it is not from the pool
+    const std::type_info* type = nullptr;
+    //! comp node finalize count when the opr is acquired; oprs acquired
+    //! before a finalize are not given back, as their handles are destroyed
+    size_t epoch = 0;
+};
+
+/*!
+ * \brief a megdnn opr borrowed from MegDNNOprPool, given back to the pool
+ *      when destructed
+ *
+ * The pool key (the opr type it was acquired as) is carried by the handle,
+ * so an opr can only be given back under its own type. Oprs not taken from
+ * the pool, or taken before the last comp node finalize, are destroyed.
+ */
+template <class Opr>
+class PooledMegDNNOpr {
+    template <class>
+    friend class PooledMegDNNOpr;
+    friend class MegDNNOprPool;
+
+    UniqPtrWithCN<Opr> m_opr;
+    MegDNNOprPoolKey m_key;
+
+    PooledMegDNNOpr(UniqPtrWithCN<Opr> opr, MegDNNOprPoolKey key)
+            : m_opr{std::move(opr)}, m_key{key} {}
+
+    //! release the ownership without giving back the opr
+    std::pair<Opr*, MegDNNOprPoolKey> release() {
+        auto key = m_key;
+        m_key = {};
+        return {m_opr.release(), key};
+    }
+
+public:
+    PooledMegDNNOpr() = default;
+
+    //! take an opr not from the pool
+    template <class RObj>
+    PooledMegDNNOpr(UniqPtrWithCN<RObj>&& opr) : m_opr{std::move(opr)} {}
+
+    //! take an opr not from the pool, without comp node
+    template <class RObj>
+    PooledMegDNNOpr(std::unique_ptr<RObj>&& opr)
+            : m_opr{std::unique_ptr<Opr>{std::move(opr)}, CompNode{}} {}
+
+    PooledMegDNNOpr(PooledMegDNNOpr&& rhs) noexcept
+            : m_opr{std::move(rhs.m_opr)}, m_key{rhs.m_key} {
+        rhs.m_key = {};
+    }
+
+    template <class RObj>
+    PooledMegDNNOpr(PooledMegDNNOpr<RObj>&& rhs) noexcept
+            : m_opr{std::move(rhs.m_opr)}, m_key{rhs.m_key} {
+        rhs.m_key = {};
+    }
+
+    PooledMegDNNOpr& operator=(PooledMegDNNOpr&& rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+            m_opr = std::move(rhs.m_opr);
+            m_key = rhs.m_key;
+            rhs.m_key = {};
+        }
+        return *this;
+    }
+
+    ~PooledMegDNNOpr() { reset(); }
+
+    //! give back the opr now
+    void reset();
+
+    Opr* get() const { return m_opr.get(); }
+    Opr* operator->() const { return m_opr.get(); }
+    Opr& operator*() const { return *m_opr; }
+    explicit operator bool() const { return static_cast<bool>(m_opr); }
+    CompNode comp_node() const { return m_opr.comp_node(); }
+
+    //! the underlying pointer, for the functions taking UniqPtrWithCN
+    UniqPtrWithCN<Opr>& ptr() { return m_opr; }
+};
+
+/*!
+ * \brief pool of idle megdnn oprs shared by graph oprs and imperative runtime
+ *
+ * Many megdnn oprs are short-lived, e.g. those created for proxy graph or
+ * for each imperative apply, and creating them is not free on some handles.
+ * Oprs are pooled per (megdnn handle, opr type); the param should be set by
+ * the borrower and the execution policy is reset on each acquire(). It is
+ * thread safe to acquire and give back oprs.
+ *
+ * Idle oprs are dropped on comp node finalize, and the pool keeps working
+ * for the comp nodes loaded after that.
+ */
+class MegDNNOprPool final : NonCopyableObj {
+public:
+    //! max number of idle oprs kept for each (handle, opr type)
+    static constexpr size_t MAX_IDLE_PER_KEY = 16;
+
+    MGE_WIN_DECLSPEC_FUC static MegDNNOprPool& inst();
+
+    //! get an idle opr or create a new one
+    template <class Opr>
+    PooledMegDNNOpr<Opr> acquire(CompNode comp_node) {
+        auto creator = [](megdnn::Handle* handle) {
+            return std::unique_ptr<megdnn::OperatorBase>{
+                    handle->create_operator<Opr>()};
+        };
+        size_t epoch;
+        std::unique_ptr<Opr> opr{static_cast<Opr*>(
+                do_acquire(get_megdnn_handle(comp_node), typeid(Opr), creator, &epoch)
+                        .release())};
+        reset_execution_policy<Opr>(opr.get());
+        return {{std::move(opr), comp_node}, {&typeid(Opr), epoch}};
+    }
+
+    /*!
+     * \brief give back an opr that may be used by kernels pending on the
+     *      comp node
+     *
+     * Kernels on cpu comp nodes other than default_cpu are dispatched to a
+     * worker, so the opr is given back in the worker after those kernels.
+     */
+    template <class Opr>
+    void recycle(CompNode comp_node, PooledMegDNNOpr<Opr> opr) {
+        auto released = opr.release();
+        recycle(comp_node, std::unique_ptr<megdnn::OperatorBase>{released.first},
+                released.second);
+    }
+
+    //! number of idle oprs in the pool
+    MGE_WIN_DECLSPEC_FUC size_t nr_idle() const;
+
+private:
+    template <class>
+    friend class PooledMegDNNOpr;
+
+    using Creator = std::unique_ptr<megdnn::OperatorBase> (*)(megdnn::Handle*);
+    using Key = std::pair<megdnn::Handle*, std::type_index>;
+
+    //! notifies the pool of comp node finalize; a new one is registered on
+    //! the next acquire(), as a finalized object would not be notified again
+    class FinalizeGuard;
+
+    mutable MGB_MUTEX m_mtx;
+    std::map<Key, std::vector<std::unique_ptr<megdnn::OperatorBase>>> m_idle;
+    std::unique_ptr<FinalizeGuard> m_guard;
+    size_t m_epoch = 0;
+
+    MegDNNOprPool() = default;
+
+    MGE_WIN_DECLSPEC_FUC std::unique_ptr<megdnn::OperatorBase> do_acquire(
+            megdnn::Handle* handle, std::type_index type, Creator creator,
+            size_t* epoch);
+
+    //! give back \p opr acquired with \p key; destroyed if key.type is nullptr
+    MGE_WIN_DECLSPEC_FUC void give_back(
+            std::unique_ptr<megdnn::OperatorBase> opr, MegDNNOprPoolKey key);
+
+    MGE_WIN_DECLSPEC_FUC void recycle(
+            CompNode comp_node, std::unique_ptr<megdnn::OperatorBase> opr,
+            MegDNNOprPoolKey key);
+
+    std::shared_ptr<void> on_comp_node_finalize();
+
+    template <class Opr>
+    static void reset_execution_policy(megdnn::detail::MultiAlgoOpr<Opr, -1>* opr) {
+        opr->execution_policy() = {};
+    }
+
+    template <class Opr>
+    static void reset_execution_policy(void*) {}
+};
+
+template <class Opr>
+void PooledMegDNNOpr<Opr>::reset() {
+    auto released = release();
+    if (released.first) {
+        MegDNNOprPool::inst().give_back(
+                std::unique_ptr<megdnn::OperatorBase>{released.first},
+                released.second);
+    }
+}
+
 /*!
  * \brief get temporary storage for oprs
  *
@@ -120,7 +313,7 @@ public:
             OperatorNodeBase& self);
 
     MGE_WIN_DECLSPEC_FUC static void record_megdnn_opr(
-            std::unique_ptr<megdnn::OperatorBase> opr,
+            intl::PooledMegDNNOpr<megdnn::OperatorBase> opr,
             cg::GraphExecutable::ExecDependencyArray& deps);
 
 protected:
@@ -131,14 +324,15 @@ protected:
 
     megdnn::OperatorBase* megdnn_opr() const { return m_dnn_opr.get(); }
 
-    MGE_WIN_DECLSPEC_FUC void set_megdnn_opr(std::unique_ptr<megdnn::OperatorBase> opr);
+    MGE_WIN_DECLSPEC_FUC void set_megdnn_opr(
+            intl::PooledMegDNNOpr<megdnn::OperatorBase> opr);
 
     //! record the megdnn opr owned by this opr to ExecDependencyArray
     MGE_WIN_DECLSPEC_FUC void record_megdnn_opr(
             cg::GraphExecutable::ExecDependencyArray& deps);
 
 private:
-    std::unique_ptr<megdnn::OperatorBase> m_dnn_opr;
+    intl::PooledMegDNNOpr<megdnn::OperatorBase> m_dnn_opr;
 };
 
 class MegDNNOprHolderBwdStaticInfer : public MegDNNOprHolder {
@@ -202,10 +396,10 @@ public:
 protected:
     ~MegDNNOprHolderImpl() = default;
 
-    //! default impl calls megdnn::handle::create_operator()
+    //! default impl takes an opr from intl::MegDNNOprPool
     void create_megdnn_opr() override {
-        auto opr = intl::get_megdnn_handle(this->mixin_comp_node())
-                           ->template create_operator<MegDNNOpr>();
+        auto opr = intl::MegDNNOprPool::inst().template acquire<MegDNNOpr>(
+                this->mixin_comp_node());
         opr->param() = m_param;
         MegDNNOprHolder::set_megdnn_opr(std::move(opr));
     }
@@ -222,10 +416,10 @@ private:
 
 namespace intl {
 class MegDNNGraphDep final : public cg::GraphExecutable::ExecDependency {
-    std::unique_ptr<megdnn::OperatorBase> m_opr;
+    PooledMegDNNOpr<megdnn::OperatorBase> m_opr;
 
 public:
-    MegDNNGraphDep(std::unique_ptr<megdnn::OperatorBase> opr) noexcept;
+    MegDNNGraphDep(PooledMegDNNOpr<megdnn::OperatorBase> opr) noexcept;
     ~MegDNNGraphDep() noexcept;
 };
 
@@ -106,6 +106,9 @@ public:
 
         bool allow_weight_preprocess() const { return m_allow_weight_preprocess; }
 
+        //! whether the owner graph requires deterministic execution
+        bool deterministic() const { return owner_graph()->options().deterministic; }
+
         megdnn::Algorithm* get_algorithm_from_desc(
                 const megdnn::Algorithm::Info::Desc& desc) const {
             return m_dnn_opr->get_algorithm_from_desc(desc);
@@ -162,6 +165,14 @@ public:
         Maybe<AlgoChooserProfileCache::ResultEntry> profile_single_algo(
                 const ImplExecutionPolicy& policy, double& timeout) const;
 
+        /*!
+         * \brief profile a deterministic policy against the same policy with
+         *      the work split adapted to the thread count
+         *
+         * \return ratio of the time of the two, or 0 if profiling fails
+         */
+        double profile_deterministic_slowdown(const ImplExecutionPolicy& policy) const;
+
         //! profile and save to cache
         void profile(const ExecutionStrategy& selected_strategy) const;
 
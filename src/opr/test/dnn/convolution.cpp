@@ -13,6 +13,7 @@
 #include "megbrain/comp_node_env.h"
 
 #include "megbrain/gopt/inference.h"
+#include "megbrain/graph/event.h"
 #include "megbrain/opr/basic_arith.h"
 #include "megbrain/opr/dnn/convolution.h"
 #include "megbrain/opr/tensor_manip.h"
@@ -383,6 +384,56 @@ TEST(TestOprDNN, ConvBiasExePolicy) {
     PersistentCache::set_impl(orig_impl);
 }
 
+TEST(TestOprDNN, ConvBiasDeterministic) {
+    using Policy = opr::ConvBias::ExecutionPolicy;
+    using S = Policy::Strategy;
+    HostTensorGenerator<> gen;
+    //! few output pixels and many channels make the cpu kernels split the
+    //! output channels by the number of threads unless deterministic
+    auto host_x = gen({2, 8, 6, 6}), host_w = gen({256, 8, 3, 3}),
+         host_b = gen({1, 256, 1, 1});
+
+    auto orig_impl =
+            PersistentCache::set_impl(std::make_shared<InMemoryPersistentCache>());
+    auto run = [&](const char* cn_name, HostTensorND& host_y) {
+        auto cn = CompNode::load(cn_name);
+        auto graph = ComputingGraph::make();
+        graph->options().deterministic = true;
+        double slowdown = 0;
+        auto handle = graph->event().register_receiver<cg::event::AlgoChosen>(
+                [&](const cg::event::AlgoChosen& ev) {
+                    slowdown = ev.deterministic_slowdown;
+                });
+        auto x = opr::Host2DeviceCopy::make(*graph, host_x, cn),
+             w = opr::Host2DeviceCopy::make(*graph, host_w, cn),
+             b = opr::Host2DeviceCopy::make(*graph, host_b, cn);
+        opr::ConvBias::Param param;
+        param.pad_h = param.pad_w = 1;
+        Policy policy;
+#if MGB_ENABLE_FASTRUN
+        policy.strategy = S::PROFILE;
+#else
+        policy.strategy = S::HEURISTIC;
+#endif
+        auto y = opr::ConvBias::make(x, w, b, param, policy);
+        auto func = graph->compile({make_callback_copy(y, host_y)});
+        func->execute();
+#if MGB_ENABLE_FASTRUN
+        ASSERT_GT(slowdown, 0);
+#else
+        ASSERT_EQ(0, slowdown);
+#endif
+    };
+    HostTensorND y_single, y_multi;
+    run("cpu0", y_single);
+    run("multithread4:0", y_multi);
+    ASSERT_EQ(y_single.shape(), y_multi.shape());
+    ASSERT_EQ(
+            0, memcmp(y_single.raw_ptr(), y_multi.raw_ptr(),
+                      y_single.layout().span().dist_byte()));
+    PersistentCache::set_impl(orig_impl);
+}
+
 TEST(TestOprDNN, ConvBiasExePolicy_Quantized8Asym) {
     using Param = opr::ConvBias::Param;
     Param param;
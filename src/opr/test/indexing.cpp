@@ -14,6 +14,7 @@
 #include "megbrain/opr/basic_arith.h"
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/misc.h"
+#include "megbrain/opr/tensor_manip.h"
 #include "megbrain/opr/utility.h"
 #include "megbrain/test/autocheck.h"
 #include "megbrain/test/helper.h"
@@ -218,6 +219,73 @@ TEST(TestOprIndexing, Remap) {
     }
 }
 
+TEST(TestOprIndexing, EmbeddingBag) {
+    using Checker = AutoOprChecker<4, 1>;
+    using Param = opr::EmbeddingBag::Param;
+    Param param;
+
+    std::mt19937 rng{static_cast<std::mt19937::result_type>(next_rand_seed())};
+    size_t nr_rows = 0;
+    auto gen_index = [&](HostTensorND& dest) {
+        auto ptr = dest.ptr<float>();
+        for (size_t i = 0, it = dest.shape().total_nr_elems(); i < it; ++i) {
+            ptr[i] = rng() % nr_rows;
+        }
+    };
+    //! bags are the lengths; also used as offsets by the forward impl below
+    auto gen_bags = [&](HostTensorND& dest) {
+        auto ptr = dest.ptr<float>();
+        for (size_t i = 0, it = dest.shape().total_nr_elems(); i < it; ++i) {
+            ptr[i] = 2;
+        }
+    };
+    auto make_graph = [&](const Checker::SymInpArray& inputs) -> Checker::SymOutArray {
+        auto indices = opr::TypeCvt::make(inputs[1], dtype::Int32()),
+             bags = opr::TypeCvt::make(inputs[2], dtype::Int32());
+        if (param.mode == Param::Mode::MAX) {
+            return {opr::EmbeddingBag::make(inputs[0], indices, bags, param)};
+        }
+        return {opr::EmbeddingBag::make(inputs[0], indices, bags, inputs[3], param)};
+    };
+    auto fwd = [&](Checker::NumOutArray& dest, Checker::NumInpArray inp) {
+        size_t dim = inp[0]->shape(1), nr_bags = inp[2]->shape(0);
+        dest[0].resize({nr_bags, dim});
+        auto wptr = inp[0]->ptr<float>(), iptr = inp[1]->ptr<float>(),
+             sptr = inp[3]->ptr<float>(), optr = dest[0].ptr<float>();
+        for (size_t b = 0; b < nr_bags; ++b) {
+            for (size_t d = 0; d < dim; ++d) {
+                float r0 = wptr[static_cast<int>(iptr[b * 2]) * dim + d],
+                      r1 = wptr[static_cast<int>(iptr[b * 2 + 1]) * dim + d];
+                if (param.mode == Param::Mode::MAX) {
+                    optr[b * dim + d] = std::max(r0, r1);
+                } else {
+                    float sum = r0 * sptr[b * 2] + r1 * sptr[b * 2 + 1];
+                    optr[b * dim + d] = param.mode == Param::Mode::MEAN ? sum / 2 : sum;
+                }
+            }
+        }
+    };
+
+    for (auto mode : {Param::Mode::SUM, Param::Mode::MEAN, Param::Mode::MAX}) {
+        param = {mode, Param::OffsetMode::LENGTHS};
+        Checker checker{make_graph, fwd};
+        checker.set_input_generator(1, gen_index)
+                .set_input_generator(2, gen_bags)
+                .set_input_allow_grad(1, false)
+                .set_input_allow_grad(2, false)
+                .set_input_allow_grad(3, false);
+        Checker::RunOptions opt;
+        // the max of two random rows is not differentiable when they are close
+        opt.numdiff_max_err = 2e-2;
+        for (size_t rows : {3, 20}) {
+            nr_rows = rows;
+            checker.run({TensorShape{rows, 5}, {8}, {4}, {8}}, opt)
+                    .run({TensorShape{rows, 1}, {2}, {1}, {2}}, opt)
+                    .run({TensorShape{rows, 17}, {14}, {7}, {14}}, opt);
+        }
+    }
+}
+
 TEST(TestOprIndexing, MultiAxisVecFwdOnly) {
     HostTensorGenerator<> gen;
     auto host_x = gen({5, 8, 8});
@@ -530,6 +598,45 @@ TEST(TestOprIndexing, MultiAxisVecModifyDegenerate) {
     }
 }
 
+TEST(TestOprIndexing, MultiAxisVecStaticValueInfer) {
+    HostTensorGenerator<> gen;
+    auto host_x = gen({2, 3, 4, 5});
+    HostTensorND host_idx{host_x->comp_node(), {4}, dtype::Int32()};
+    auto pidx = host_idx.ptr<int>();
+    pidx[0] = 1;
+    pidx[1] = 0;
+    pidx[2] = 3;
+    pidx[3] = 2;
+
+    auto graph = ComputingGraph::make();
+    using AIdx = opr::indexing::AxisIndexer;
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x),
+         idx = opr::ImmutableTensor::make(*graph, host_idx),
+         tshp = opr::IndexingMultiAxisVec::make(
+                 opr::GetVarShape::make(x), {AIdx::make_index(0, idx)}),
+         y = opr::Reshape::make(x, tshp);
+
+    // gathered dims keep the reshape output statically inferable
+    auto&& mgr = graph->static_infer_manager();
+    ASSERT_EQ(
+            cg::static_infer::InferType::RT_STATIC, mgr.get_infer_type(tshp.node()).value);
+    ASSERT_TRUE(cg::is_static_var_shape(y.node()));
+    ASSERT_EQ(TensorShape({3, 2, 5, 4}), mgr.infer_shape(y.node()));
+
+    HostTensorND host_y;
+    auto func = graph->compile({make_callback_copy(y, host_y)});
+    func->execute();
+    ASSERT_EQ(TensorShape({3, 2, 5, 4}), host_y.shape());
+    ASSERT_FALSE(y.node()->contain_flag(VarNode::Flag::RT_FORCE_DYNAMIC_MEM_ALLOC));
+
+    *host_x = *gen({4, 3, 2, 1});
+    func->execute();
+    ASSERT_EQ(TensorShape({3, 4, 1, 2}), host_y.shape());
+    ASSERT_EQ(0, memcmp(
+                         host_x->raw_ptr(), host_y.raw_ptr(),
+                         host_x->layout().span().dist_byte()));
+}
+
 TEST(TestOprIndexing, ZeroSize) {
     auto graph = ComputingGraph::make();
     HostTensorGenerator<> gen;
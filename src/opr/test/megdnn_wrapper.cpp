@@ -13,10 +13,13 @@
 
 #include "megbrain/opr/basic_arith_wrapper.h"
 #include "megbrain/opr/dnn/convolution.h"
+#include "megbrain/opr/internal/megdnn_opr_wrapper.h"
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/utility.h"
 #include "megbrain/tensor.h"
 
+#include "megdnn/oprs.h"
+
 using namespace mgb;
 
 TEST(TestOprMegDNNWrapper, Stream) {
@@ -71,4 +74,93 @@ TEST(TestOprMegDNNWrapper, ShapeDep) {
     ASSERT_EQ(NP::DepType::SHAPE, dt);
 }
 
+TEST(TestOprMegDNNWrapper, OprPool) {
+    using Pool = opr::intl::MegDNNOprPool;
+    auto&& pool = Pool::inst();
+    auto cn = CompNode::load("xpu0");
+
+    auto opr = pool.acquire<megdnn::ConvolutionForward>(cn);
+    auto ptr = opr.get();
+    opr->execution_policy().algo.type = 0;
+    ASSERT_TRUE(opr->execution_policy().algo.valid());
+    opr.reset();
+    ASSERT_FALSE(opr);
+    auto nr_idle = pool.nr_idle();
+    ASSERT_GE(nr_idle, 1u);
+
+    // the idle opr is reused with reset execution policy
+    opr = pool.acquire<megdnn::ConvolutionForward>(cn);
+    ASSERT_EQ(ptr, opr.get());
+    ASSERT_FALSE(opr->execution_policy().algo.valid());
+    ASSERT_EQ(nr_idle - 1, pool.nr_idle());
+
+    // oprs not from the pool are not kept
+    {
+        opr::intl::PooledMegDNNOpr<megdnn::OperatorBase> other{
+                opr::intl::create_megdnn_opr<megdnn::ConvolutionForward>(cn)};
+    }
+    ASSERT_EQ(nr_idle - 1, pool.nr_idle());
+    opr.reset();
+    ASSERT_EQ(nr_idle, pool.nr_idle());
+
+    // oprs are given back when the borrower throws
+    ASSERT_THROW(
+            {
+                auto borrowed = pool.acquire<megdnn::ConvolutionForward>(cn);
+                mgb_throw(MegBrainError, "exec failed");
+            },
+            MegBrainError);
+    ASSERT_EQ(nr_idle, pool.nr_idle());
+    opr = pool.acquire<megdnn::ConvolutionForward>(cn);
+    ASSERT_EQ(ptr, opr.get());
+    opr.reset();
+
+    // oprs of released graphs are reused by later graphs
+    using Param = opr::Convolution::Param;
+    HostTensorGenerator<> gen;
+    auto host_x = gen({2, 1, 8, 8}), host_kern = gen({3, 1, 3, 3});
+    auto run = [&](HostTensorND& host_y) {
+        auto graph = ComputingGraph::make();
+        auto x = opr::Host2DeviceCopy::make(*graph, host_x),
+             kern = opr::Host2DeviceCopy::make(*graph, host_kern),
+             y = opr::Convolution::make(x, kern, Param{});
+        auto func = graph->compile({make_callback_copy(y, host_y)});
+        func->execute();
+    };
+    HostTensorND host_y0, host_y1;
+    run(host_y0);
+    nr_idle = pool.nr_idle();
+    run(host_y1);
+    ASSERT_EQ(nr_idle, pool.nr_idle());
+    MGB_ASSERT_TENSOR_EQ(host_y0, host_y1);
+}
+
+TEST(TestOprMegDNNWrapper, OprPoolFinalize) {
+    using Pool = opr::intl::MegDNNOprPool;
+    auto&& pool = Pool::inst();
+    auto cn = CompNode::load("xpu0");
+
+    // idle oprs are dropped on finalize, and borrowed oprs are not given back
+    auto opr = pool.acquire<megdnn::ConvolutionForward>(cn);
+    pool.acquire<megdnn::ConvolutionForward>(cn).reset();
+    CompNode::finalize();
+    ASSERT_EQ(0u, pool.nr_idle());
+    opr.reset();
+    ASSERT_EQ(0u, pool.nr_idle());
+
+    // the pool works for comp nodes loaded after finalize
+    for (int i = 0; i < 2; ++i) {
+        cn = CompNode::load("xpu0");
+        opr = pool.acquire<megdnn::ConvolutionForward>(cn);
+        auto ptr = opr.get();
+        opr.reset();
+        ASSERT_EQ(1u, pool.nr_idle());
+        opr = pool.acquire<megdnn::ConvolutionForward>(cn);
+        ASSERT_EQ(ptr, opr.get());
+        opr.reset();
+        CompNode::finalize();
+        ASSERT_EQ(0u, pool.nr_idle());
+    }
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
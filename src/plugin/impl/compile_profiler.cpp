@@ -0,0 +1,148 @@
+/**
+ * \file src/plugin/impl/compile_profiler.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "megbrain/plugin/compile_profiler.h"
+#include "megbrain/graph/operator_node.h"
+
+using namespace mgb;
+
+namespace {
+const char* record_type_name(CompileProfiler::RecordType type) {
+    using RecordType = CompileProfiler::RecordType;
+    switch (type) {
+        case RecordType::PHASE:
+            return "phase";
+        case RecordType::PASS:
+            return "pass";
+        case RecordType::ALGO:
+            return "algo";
+    }
+    mgb_throw(MegBrainError, "bad record type: %d", static_cast<int>(type));
+}
+}  // anonymous namespace
+
+CompileProfiler::CompileProfiler(cg::ComputingGraph* graph) : PluginBase(graph) {
+    add_member_func_as_event_handler(&CompileProfiler::on_phase_finished);
+    add_member_func_as_event_handler(&CompileProfiler::on_pass_applied);
+    add_member_func_as_event_handler(&CompileProfiler::on_algo_chosen);
+}
+
+CompileProfiler::Record& CompileProfiler::add_record(
+        RecordType type, std::string name, double time) {
+    auto end = m_timer.get_secs();
+    m_records.push_back({type, std::move(name), std::max(end - time, 0.), end});
+    return m_records.back();
+}
+
+void CompileProfiler::on_phase_finished(const cg::event::CompilePhaseFinished& event) {
+    add_record(RecordType::PHASE, event.phase, event.time);
+}
+
+void CompileProfiler::on_pass_applied(const cg::event::GraphOptPassApplied& event) {
+    auto&& rec = add_record(RecordType::PASS, event.pass, event.time);
+    rec.nr_opr = event.nr_opr;
+    rec.nr_opr_added = event.nr_opr_added;
+    rec.nr_opr_removed = event.nr_opr_removed;
+    rec.nr_var_added = event.nr_var_added;
+    rec.nr_var_removed = event.nr_var_removed;
+    rec.from_cache = event.from_cache;
+}
+
+void CompileProfiler::on_algo_chosen(const cg::event::AlgoChosen& event) {
+    auto&& rec = add_record(RecordType::ALGO, event.algo, event.time);
+    rec.from_cache = event.from_cache;
+    rec.opr = event.opr->id_str();
+    rec.deterministic_slowdown = event.deterministic_slowdown;
+}
+
+double CompileProfiler::total_time(RecordType type, const std::string& name) const {
+    double ret = 0;
+    for (auto&& i : m_records) {
+        if (i.type == type && i.name == name) {
+            ret += i.end - i.start;
+        }
+    }
+    return ret;
+}
+
+#if MGB_ENABLE_JSON
+
+std::shared_ptr<json::Object> CompileProfiler::to_json() const {
+    using namespace json;
+    auto ret = Object::make();
+    for (auto type : {RecordType::PHASE, RecordType::PASS, RecordType::ALGO}) {
+        (*ret)[record_type_name(type)] = Array::make();
+    }
+    for (auto&& i : m_records) {
+        auto obj = Object::make(
+                {{"name", String::make(i.name)},
+                 {"start", Number::make(i.start)},
+                 {"time", Number::make(i.end - i.start)}});
+        auto&& o = *obj;
+        if (i.type == RecordType::PASS) {
+            o["nr_opr"] = NumberInt::make(i.nr_opr);
+            o["nr_opr_added"] = NumberInt::make(i.nr_opr_added);
+            o["nr_opr_removed"] = NumberInt::make(i.nr_opr_removed);
+            o["nr_var_added"] = NumberInt::make(i.nr_var_added);
+            o["nr_var_removed"] = NumberInt::make(i.nr_var_removed);
+        }
+        if (i.type == RecordType::ALGO) {
+            o["opr"] = String::make(i.opr);
+            if (i.deterministic_slowdown > 0) {
+                o["deterministic_slowdown"] = Number::make(i.deterministic_slowdown);
+            }
+        }
+        if (i.type != RecordType::PHASE) {
+            o["from_cache"] = Bool::make(i.from_cache);
+        }
+        static_cast<Array*>((*ret)[record_type_name(i.type)].get())->add(obj);
+    }
+    return ret;
+}
+
+std::shared_ptr<json::Object> CompileProfiler::to_chrome_trace() const {
+    using namespace json;
+    auto events = Array::make();
+    for (auto&& i : m_records) {
+        // put each record type in its own row so that nested intervals
+        // (pass inside graph_opt, algo inside mem_plan_init) stay readable
+        auto args = Object::make();
+        if (i.type == RecordType::PASS) {
+            (*args)["nr_opr"] = NumberInt::make(i.nr_opr);
+            (*args)["nr_opr_added"] = NumberInt::make(i.nr_opr_added);
+            (*args)["nr_opr_removed"] = NumberInt::make(i.nr_opr_removed);
+        } else if (i.type == RecordType::ALGO) {
+            (*args)["opr"] = String::make(i.opr);
+            if (i.deterministic_slowdown > 0) {
+                (*args)["deterministic_slowdown"] =
+                        Number::make(i.deterministic_slowdown);
+            }
+        }
+        if (i.type != RecordType::PHASE) {
+            (*args)["from_cache"] = Bool::make(i.from_cache);
+        }
+        events->add(Object::make(
+                {{"name", String::make(i.name)},
+                 {"cat", String::make(record_type_name(i.type))},
+                 {"ph", String::make("X")},
+                 {"ts", Number::make(i.start * 1e6)},
+                 {"dur", Number::make((i.end - i.start) * 1e6)},
+                 {"pid", NumberInt::make(0)},
+                 {"tid", NumberInt::make(static_cast<int>(i.type))},
+                 {"args", args}}));
+    }
+    return Object::make(
+            {{"traceEvents", events}, {"displayTimeUnit", String::make("ms")}});
+}
+
+#endif  // MGB_ENABLE_JSON
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
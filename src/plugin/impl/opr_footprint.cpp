@@ -31,6 +31,7 @@
 #include "megbrain/opr/standalone/nms_opr.h"
 #include "megbrain/opr/tensor_gen.h"
 #include "megbrain/opr/tensor_manip.h"
+#include "megbrain/serialization/extern_c_opr_io.h"
 #if MGB_ENABLE_JSON
 #include "megdnn/opr_param_json.h"
 #endif
@@ -494,6 +495,12 @@ uint64_t opr_footprint_func<opr::Host2DeviceCopy>(cg::OperatorNodeBase* opr) {
     return out_shape.total_nr_elems();
 }
 
+// ExternCOprRunner
+template <>
+uint64_t opr_footprint_func<opr::ExternCOprRunner>(cg::OperatorNodeBase* opr) {
+    return opr->cast_final_safe<opr::ExternCOprRunner>().flops();
+}
+
 /******************* Registe Param Json Functions *************************/
 #if MGB_ENABLE_JSON
 template <class T>
@@ -710,6 +717,7 @@ void OprFootprint::init_all_footprints() {
     add_single_comp_footprint<opr::DeformableConvBackwardFilter>();
     add_single_comp_footprint<opr::DeformableConvBackwardData>();
     add_single_comp_footprint<opr::BatchConvBiasForward>();
+    add_single_comp_footprint<opr::ExternCOprRunner>();
 
 #if MGB_ENABLE_JSON
     add_single_param_json<opr::Elemwise>();
@@ -0,0 +1,87 @@
+/**
+ * \file src/plugin/include/megbrain/plugin/compile_profiler.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#pragma once
+
+#include "megbrain/graph/event.h"
+#include "megbrain/plugin/base.h"
+#include "megbrain/utils/json.h"
+#include "megbrain/utils/timer.h"
+
+namespace mgb {
+
+/*!
+ * \brief profile graph compilation: time spent in each compile phase, each
+ *      graph optimization pass and each algorithm selection
+ *
+ * Records are collected for every compile() call on the graph during the
+ * lifetime of this plugin. The result can be dumped as a plain json object
+ * or in the chrome trace event format (chrome://tracing, perfetto).
+ */
+class CompileProfiler final : public PluginBase {
+public:
+    enum class RecordType { PHASE, PASS, ALGO };
+
+    struct Record {
+        RecordType type;
+        std::string name;
+        //! start and end time in seconds, relative to plugin construction
+        double start, end;
+        //! number of oprs in the graph after a pass; for PASS only
+        size_t nr_opr = 0;
+        //! opr/var changes made by a pass; for PASS only
+        size_t nr_opr_added = 0, nr_opr_removed = 0, nr_var_added = 0,
+               nr_var_removed = 0;
+        //! whether the result is reused from cache; for PASS and ALGO
+        bool from_cache = false;
+        //! id_str of the operator; for ALGO only
+        std::string opr;
+        //! see cg::event::AlgoChosen::deterministic_slowdown; for ALGO only
+        double deterministic_slowdown = 0;
+    };
+
+    MGE_WIN_DECLSPEC_FUC CompileProfiler(cg::ComputingGraph* graph);
+
+    //! all records in the order of their completion
+    const std::vector<Record>& records() const { return m_records; }
+
+    //! total time in seconds of all records of given type and name
+    MGE_WIN_DECLSPEC_FUC double total_time(
+            RecordType type, const std::string& name) const;
+
+    void clear() { m_records.clear(); }
+
+#if MGB_ENABLE_JSON
+    /*!
+     * \brief get records as json object
+     *
+     * keys: phase, pass, algo; each is an array of records
+     */
+    MGE_WIN_DECLSPEC_FUC std::shared_ptr<json::Object> to_json() const;
+
+    //! get records as chrome trace events, with timestamps in microseconds
+    MGE_WIN_DECLSPEC_FUC std::shared_ptr<json::Object> to_chrome_trace() const;
+#endif
+
+private:
+    RealTimer m_timer;
+    std::vector<Record> m_records;
+
+    Record& add_record(RecordType type, std::string name, double time);
+
+    void on_phase_finished(const cg::event::CompilePhaseFinished& event);
+    void on_pass_applied(const cg::event::GraphOptPassApplied& event);
+    void on_algo_chosen(const cg::event::AlgoChosen& event);
+};
+
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,77 @@
+/**
+ * \file src/plugin/test/compile_profiler.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "megbrain/plugin/compile_profiler.h"
+#include "megbrain/opr/basic_arith_wrapper.h"
+#include "megbrain/opr/dnn/convolution.h"
+#include "megbrain/opr/io.h"
+#include "megbrain/test/helper.h"
+
+using namespace mgb;
+
+namespace {
+size_t count_records(
+        const CompileProfiler& profiler, CompileProfiler::RecordType type,
+        const std::string& name = {}) {
+    size_t ret = 0;
+    for (auto&& i : profiler.records()) {
+        ret += i.type == type && (name.empty() || i.name == name);
+    }
+    return ret;
+}
+}  // anonymous namespace
+
+TEST(TestCompileProfiler, Simple) {
+    using RecordType = CompileProfiler::RecordType;
+    HostTensorGenerator<> gen;
+    auto host_x = gen({2, 3, 16, 16}), host_w = gen({4, 3, 3, 3});
+    auto graph = ComputingGraph::make();
+    CompileProfiler profiler{graph.get()};
+
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x),
+         w = opr::SharedDeviceTensor::make(*graph, *host_w),
+         y = opr::Convolution::make(x, w) * 2 + 1;
+    HostTensorND host_y;
+    auto func = graph->compile({make_callback_copy(y, host_y)});
+    func->execute();
+
+    for (auto phase :
+         {"graph_opt", "topo_sort", "mem_plan_init", "static_infer_init",
+          "compile"}) {
+        ASSERT_EQ(1u, count_records(profiler, RecordType::PHASE, phase)) << phase;
+    }
+    ASSERT_GE(count_records(profiler, RecordType::PHASE, "mem_plan"), 1u);
+    ASSERT_GT(count_records(profiler, RecordType::PASS), 0u);
+    ASSERT_GE(count_records(profiler, RecordType::ALGO), 1u);
+
+    for (auto&& i : profiler.records()) {
+        ASSERT_LE(i.start, i.end);
+    }
+    auto tot = profiler.total_time(RecordType::PHASE, "compile");
+    ASSERT_GE(tot, profiler.total_time(RecordType::PHASE, "graph_opt"));
+    ASSERT_GE(tot, profiler.total_time(RecordType::PHASE, "topo_sort"));
+
+#if MGB_ENABLE_JSON
+    auto trace = profiler.to_chrome_trace();
+    auto&& events =
+            static_cast<json::Array*>((*trace)["traceEvents"].get())->get_impl();
+    ASSERT_EQ(profiler.records().size(), events.size());
+    profiler.to_json()->writeto_fpath(output_file("TestCompileProfiler.Simple.json"));
+    trace->writeto_fpath(output_file("TestCompileProfiler.Simple.trace.json"));
+#endif
+
+    profiler.clear();
+    func = graph->compile({make_callback_copy(y, host_y)});
+    func->execute();
+    ASSERT_EQ(1u, count_records(profiler, RecordType::PHASE, "compile"));
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -15,6 +15,7 @@
 #include "megbrain/serialization/extern_c_opr_io.h"
 #include "megbrain/serialization/opr_load_dump.h"
 
+#include <cstddef>
 #include <cstdlib>
 
 using namespace mgb;
@@ -102,6 +103,31 @@ MGBTensor tensor_to_c(const TensorND<S>& src) {
     return ret;
 }
 
+/*!
+ * \brief impl for MGBExecEnv::dispatch
+ *
+ * MGBExecEnv::impl is the CpuEnv to dispatch to, or nullptr to run the
+ * kernel on the caller thread
+ */
+void dispatch_extern_kern(
+        const MGBExecEnv* env, MGBKernFunc kern, const void* arg, size_t arg_size,
+        size_t nr_task) {
+    auto arg_ptr = static_cast<const uint8_t*>(arg);
+    auto buf = std::make_shared<std::vector<uint8_t>>(arg_ptr, arg_ptr + arg_size);
+    auto cpu_env = static_cast<const CompNodeEnv::CpuEnv*>(env->impl);
+    if (!cpu_env) {
+        for (size_t i = 0; i < nr_task; ++i) {
+            kern(buf->data(), i, 0);
+        }
+        return;
+    }
+    cpu_env->dispatch(
+            [kern, buf](size_t task_id, size_t thread_id) {
+                kern(buf->data(), task_id, thread_id);
+            },
+            nr_task);
+}
+
 struct MGBOprDescV23 {
     size_t nr_input, nr_output;
 
@@ -283,15 +309,20 @@ ExternCOprRunner::ExternCOprRunner(
           m_desc{std::move(desc)},
           m_dump_name{name},
           m_param{nullptr} {
-    auto size_diff = sizeof(MGBOprDesc) - m_desc->size;
-    is_loader_support_dynamic_param = (0 == size_diff) ? true : false;
+    //! sizes of MGBOprDesc in version 0x24, with and without dynamic_param
+    constexpr size_t size_v24 = offsetof(MGBOprDesc, execute_v2),
+                     size_v24_no_param = offsetof(MGBOprDesc, dynamic_param);
+    auto desc_size = m_desc->size;
     mgb_assert(
-            0 == size_diff || sizeof(ExternCOprParam*) == size_diff,
+            desc_size == sizeof(MGBOprDesc) || desc_size == size_v24 ||
+                    desc_size == size_v24_no_param,
             "invalid OprDesc size: expect=%zu got=%u, may caused by "
             "extern_c_opr.h mismatch, please confirm that the "
             "extern_c_opr.h used when compiling the loader is consistent "
             "with the runtime caller build used",
-            sizeof(MGBOprDesc), m_desc->size);
+            sizeof(MGBOprDesc), desc_size);
+    is_loader_support_dynamic_param = desc_size > size_v24_no_param;
+    m_desc_v2 = desc_size == sizeof(MGBOprDesc);
     for (auto i : inputs) {
         add_input({i});
     }
@@ -305,19 +336,40 @@ ExternCOprRunner::ExternCOprRunner(
                 cname());
         add_output(None);
     }
+    if (m_desc_v2 && m_desc->get_workspace_size) {
+        mgb_assert(
+                m_desc->execute_v2, "get_workspace_size requires execute_v2: %s",
+                cname());
+        m_has_workspace = true;
+        cg::add_workspace_output(this);
+    }
     add_equivalence_component<MGBOprDescHash>(m_desc.get());
 }
 
 void ExternCOprRunner::get_output_var_shape(
         const TensorShapeArray& inp_shape, TensorShapeArray& out_shape) const {
-    SmallVector<MGBTensorShape> c_inp(inp_shape.size()), c_out(out_shape.size());
+    auto nr_out = m_desc->nr_output;
+    SmallVector<MGBTensorShape> c_inp(inp_shape.size()), c_out(nr_out);
     for (size_t i = 0; i < inp_shape.size(); ++i) {
         c_inp[i] = tensor_shape_to_c(inp_shape[i]);
     }
     m_desc->infer_shape(m_desc.get(), c_inp.data(), c_out.data());
-    for (size_t i = 0; i < out_shape.size(); ++i) {
+    for (size_t i = 0; i < nr_out; ++i) {
         out_shape[i] = tensor_shape_from_c(c_out[i]);
     }
+    if (m_has_workspace) {
+        SmallVector<MGBTensorLayout> inp_layout(c_inp.size()), out_layout(nr_out);
+        for (size_t i = 0; i < c_inp.size(); ++i) {
+            inp_layout[i].dtype = dtype_cpp2c(input(i)->dtype());
+            inp_layout[i].shape = c_inp[i];
+        }
+        for (size_t i = 0; i < nr_out; ++i) {
+            out_layout[i].dtype = dtype_cpp2c(output(i)->dtype());
+            out_layout[i].shape = c_out[i];
+        }
+        out_shape[nr_out] = {m_desc->get_workspace_size(
+                m_desc.get(), inp_layout.data(), out_layout.data())};
+    }
 }
 
 void ExternCOprRunner::init_output_dtype() {
@@ -325,7 +377,7 @@ void ExternCOprRunner::init_output_dtype() {
         Super::init_output_dtype();
         return;
     }
-    SmallVector<MGBDType> inp_dtypes, out_dtypes(output().size());
+    SmallVector<MGBDType> inp_dtypes, out_dtypes(m_desc->nr_output);
     inp_dtypes.reserve(input().size());
     for (auto i : input()) {
         inp_dtypes.push_back(dtype_cpp2c(i->dtype()));
@@ -385,22 +437,75 @@ void ExternCOprRunner::check_param() {
         check(m_param->nr_input, input().size(), m_param->input, input(), "input");
     }
 
+    //! the workspace var appended for v2 descs is not visible to users
     if (m_param && m_param->nr_output > 0) {
-        check(m_param->nr_output, output().size(), m_param->output, output(), "output");
+        check(
+                m_param->nr_output, m_desc->nr_output, m_param->output, output(),
+                "output");
+    }
+}
+
+void ExternCOprRunner::mem_plan_fwd_in2out_writable() {
+    if (!m_desc_v2 || !m_desc->get_inplace_input) {
+        return;
+    }
+    for (uint32_t i = 0; i < m_desc->nr_output; ++i) {
+        auto idx = m_desc->get_inplace_input(m_desc.get(), i);
+        if (idx < 0) {
+            continue;
+        }
+        mgb_assert(
+                static_cast<size_t>(idx) < input().size(),
+                "%s: bad inplace input %d for output %u", cname(), idx, i);
+        auto inp = input(idx), out = output(i);
+        if (inp->dtype() == out->dtype() && inp->shape().eq_shape(out->shape())) {
+            out->set_fwd_in2out_writable(inp);
+        }
     }
 }
 
+void ExternCOprRunner::execute_v2(
+        const MGBTensor* inp, const MGBTensor* out, bool need_copy) {
+    MGBExecEnv env;
+    memset(&env, 0, sizeof(env));
+    env.dispatch = &dispatch_extern_kern;
+
+    std::unique_ptr<uint8_t[]> host_workspace;
+    if (m_has_workspace) {
+        auto&& ws = output().back()->dev_tensor();
+        env.workspace_size = ws.shape()[0];
+        if (need_copy) {
+            host_workspace.reset(new uint8_t[env.workspace_size]);
+            env.workspace = host_workspace.get();
+        } else {
+            env.workspace = ws.raw_ptr();
+        }
+    }
+
+    if (need_copy) {
+        // kernels are run on the caller thread with host copies of tensors
+        env.nr_threads = 1;
+    } else {
+        auto&& cpu_env = CompNodeEnv::from_comp_node(comp_node()).cpu_env();
+        env.nr_threads = cpu_env.dispatcher->nr_threads();
+        env.impl = const_cast<CompNodeEnv::CpuEnv*>(&cpu_env);
+    }
+    m_desc->execute_v2(m_desc.get(), inp, out, &env);
+}
+
 void ExternCOprRunner::scn_do_execute() {
-    SmallVector<MGBTensor> c_inp(input().size()), c_out(output().size());
+    auto nr_out = m_desc->nr_output;
+    SmallVector<MGBTensor> c_inp(input().size()), c_out(nr_out);
     SmallVector<HostTensorND> cpu_inp, cpu_out;
     check_param();
 
     bool need_copy = false;
+    bool use_v2 = m_desc_v2 && m_desc->execute_v2;
     if (comp_node().device_type() == CompNode::DeviceType::CPU) {
         for (size_t i = 0; i < input().size(); ++i) {
             c_inp[i] = tensor_to_c(input(i)->dev_tensor());
         }
-        for (size_t i = 0; i < output().size(); ++i) {
+        for (size_t i = 0; i < nr_out; ++i) {
             c_out[i] = tensor_to_c(output(i)->dev_tensor());
         }
     } else {
@@ -410,12 +515,12 @@ void ExternCOprRunner::scn_do_execute() {
                 "opr `%s' on comp node `%s'",
                 cname(), comp_node().to_string().c_str());
         cpu_inp.resize(input().size());
-        cpu_out.resize(output().size());
+        cpu_out.resize(nr_out);
         for (size_t i = 0; i < input().size(); ++i) {
             cpu_inp[i].copy_from(input(i)->dev_tensor());
             c_inp[i] = tensor_to_c(cpu_inp[i]);
         }
-        for (size_t i = 0; i < output().size(); ++i) {
+        for (size_t i = 0; i < nr_out; ++i) {
             cpu_out[i]
                     .comp_node(comp_node())
                     .dtype(output(i)->dtype())
@@ -426,10 +531,16 @@ void ExternCOprRunner::scn_do_execute() {
 
     if (need_copy) {
         comp_node().sync();
-        m_desc->execute(m_desc.get(), c_inp.data(), c_out.data());
+        if (use_v2) {
+            execute_v2(c_inp.data(), c_out.data(), true);
+        } else {
+            m_desc->execute(m_desc.get(), c_inp.data(), c_out.data());
+        }
 
-        for (size_t i = 0; i < output().size(); ++i)
+        for (size_t i = 0; i < nr_out; ++i)
             output(i)->dev_tensor().copy_from_fixlayout(cpu_out[i]);
+    } else if (use_v2) {
+        execute_v2(c_inp.data(), c_out.data(), false);
     } else {
         CompNodeEnv::from_comp_node(comp_node())
                 .cpu_env()
@@ -472,7 +583,12 @@ cg::OperatorNodeBase* ExternCOprRunner::make_from_desc_shared(
         const OperatorNodeConfig& config) {
     mgb_assert(!inputs.empty() && desc->nr_output);
 
-#define CHECK(name) mgb_assert(desc->name, #name " is not given");
+    // execute is not needed if execute_v2 is given
+    bool has_execute_v2 = desc->size == sizeof(MGBOprDesc) && desc->execute_v2;
+#define CHECK(name)                                                        \
+    mgb_assert(                                                            \
+            desc->name || (has_execute_v2 && !strcmp(#name, "execute")), \
+            #name " is not given");
     MGB_OPR_DESC_FOREACH_MEM_FN(CHECK);
 #undef CHECK
 
@@ -529,6 +645,20 @@ cg::OperatorNodeBase* ExternCOprRunner::shallow_copy(
     return make_from_desc_shared(dump_name, inputs, opr.m_desc, config);
 }
 
+uint64_t ExternCOprRunner::flops() const {
+    if (!m_desc_v2 || !m_desc->get_flops) {
+        return 0;
+    }
+    SmallVector<MGBTensorShape> c_inp, c_out;
+    for (auto i : input()) {
+        c_inp.push_back(tensor_shape_to_c(i->shape()));
+    }
+    for (size_t i = 0; i < m_desc->nr_output; ++i) {
+        c_out.push_back(tensor_shape_to_c(output(i)->shape()));
+    }
+    return m_desc->get_flops(m_desc.get(), c_inp.data(), c_out.data());
+}
+
 MGBTensorShape ExternCOprRunner::tensor_shape_to_c(const TensorShape& shape) {
     mgb_throw_if(
             shape.ndim > MGB_TENSOR_MAX_NDIM, MegBrainError,
@@ -596,7 +726,9 @@ const MGBExternCOprApi* mgb_get_extern_c_opr_api_versioned(int version) {
         static const MGBExternCOprApi ret = {reg23, unreg};
         return &ret;
     }
-    if (version != MGB_EXTERN_C_OPR_VERSION)
+    // the v2 fields of MGBOprDesc are detected by its size, so loaders built
+    // with the 0x24 header can share the same registration
+    if (version != MGB_EXTERN_C_OPR_VERSION && version != 0x24)
         return nullptr;
 
     auto reg = [](const MGBOprLoader* loader) -> int {
@@ -34,7 +34,7 @@ extern "C" {
 #define INIT_FUNC(s)            INIT_FUNCS(s)
 #define MGB_C_OPR_INIT_FUNC_STR INIT_FUNC(MGB_C_OPR_INIT_FUNC)
 
-#define MGB_EXTERN_C_OPR_VERSION 0x24
+#define MGB_EXTERN_C_OPR_VERSION 0x25
 #define MGB_TENSOR_MAX_NDIM      8
 
 //! data types
@@ -107,6 +107,42 @@ typedef struct ExternCOprParam {
     size_t extra_info_size;
 } ExternCOprParam;
 
+/*!
+ * \brief a kernel to be run on the computing threads of a comp node
+ *
+ * \param arg copy of the argument buffer given to MGBExecEnv::dispatch
+ * \param task_id index of current task, in range [0, nr_task)
+ * \param thread_id index of the thread running this task, in range
+ *      [0, MGBExecEnv::nr_threads)
+ */
+typedef void (*MGBKernFunc)(void* arg, size_t task_id, size_t thread_id);
+
+//! runtime environment passed to MGBOprDesc::execute_v2
+typedef struct MGBExecEnv {
+    //! workspace requested by MGBOprDesc::get_workspace_size; it is valid
+    //! until all the kernels dispatched in this execution finish
+    void* workspace;
+    size_t workspace_size;
+
+    //! number of threads that would run the dispatched kernels
+    size_t nr_threads;
+
+    /*!
+     * \brief dispatch a kernel to the thread pool of the comp node
+     *
+     * The kernel would be invoked \p nr_task times, possibly concurrently,
+     * after all previously dispatched kernels on the comp node finish.
+     * Kernels may run asynchronously, so the \p arg_size bytes at \p arg
+     * are copied and \p arg can be placed on stack.
+     */
+    void (*dispatch)(
+            const struct MGBExecEnv* env, MGBKernFunc kern, const void* arg,
+            size_t arg_size, size_t nr_task);
+
+    //! private data used by megbrain
+    void* impl;
+} MGBExecEnv;
+
 /*!
  * \brief operator descriptor
  *
@@ -151,6 +187,45 @@ typedef struct MGBOprDesc {
 
     //! dynamic extern c opr param
     ExternCOprParam* dynamic_param;
+
+    /* ============ fields below are added in version 0x25 ============ */
+    /*
+     * They are only accessed if the size field covers them, so loaders
+     * built with earlier headers keep working.
+     */
+
+    /*!
+     * \brief optional: perform the computation using the thread pool and
+     *      workspace provided by megbrain; execute would not be called if
+     *      this is given
+     *
+     * This function is called on the caller thread when the operator is
+     * scheduled, and the data of input and output tensors must only be
+     * accessed in kernels dispatched by MGBExecEnv::dispatch.
+     */
+    void (*execute_v2)(
+            const struct MGBOprDesc* self, const MGBTensor* input,
+            const MGBTensor* output, const MGBExecEnv* env);
+
+    //! optional: size of workspace in bytes needed by execute_v2
+    size_t (*get_workspace_size)(
+            const struct MGBOprDesc* self, const MGBTensorLayout* input,
+            const MGBTensorLayout* output);
+
+    /*!
+     * \brief optional: index of the input whose storage may be reused by
+     *      given output, or -1 if there is none
+     *
+     * The forwarding is only a hint: the output shares storage with the
+     * input only if they have the same layout and the input is not used
+     * elsewhere, so execute_v2 must handle both cases.
+     */
+    int32_t (*get_inplace_input)(const struct MGBOprDesc* self, uint32_t output_idx);
+
+    //! optional: estimated number of arithmetic operations, for profiling
+    uint64_t (*get_flops)(
+            const struct MGBOprDesc* self, const MGBTensorShape* input,
+            const MGBTensorShape* output);
 } MGBOprDesc;
 
 //! foreach member function of MGBOprDesc to help initialization
@@ -33,8 +33,15 @@ MGB_DEFINE_OPR_CLASS_WITH_EXPORT(
     void scn_do_execute() override;
     void add_input_layout_constraint() override;
     void init_output_dtype() override;
+    void mem_plan_fwd_in2out_writable() override;
     void check_param();
     bool is_loader_support_dynamic_param;
+    //! whether m_desc contains the fields added in version 0x25
+    bool m_desc_v2 = false;
+    //! whether a workspace var is appended to the outputs
+    bool m_has_workspace = false;
+
+    void execute_v2(const MGBTensor* inp, const MGBTensor* out, bool need_copy);
 
     static cg::OperatorNodeBase* make_from_desc_shared(
             std::string& name, const VarNodeArray& inputs,
@@ -97,6 +104,9 @@ public:
     MGE_WIN_DECLSPEC_FUC static TensorShape tensor_shape_from_c(
             const MGBTensorShape& shape);
 
+    //! estimated number of arithmetic operations; 0 if not provided
+    MGE_WIN_DECLSPEC_FUC uint64_t flops() const;
+
     const std::string& get_dump_name() { return m_dump_name; }
 
     void set_param(const std::shared_ptr<ExternCOprParam>& param) {
@@ -191,6 +191,74 @@ MGBOprLoaderReg<MGB_DTYPE_INT32> loader_reg_i32;
 MGBOprLoaderReg<MGB_DTYPE_FLOAT16> loader_reg_f16;
 #endif
 
+//! a custom opr using the v2 API to compute x * 2 + 1 in-place, with
+//! x * 2 stored in workspace
+class MGBOprDescV2Impl {
+    struct KernArg {
+        const float* inp;
+        float* out;
+        float* workspace;
+        size_t size, nr_task;
+    };
+
+    static void kern(void* arg_, size_t task_id, size_t) {
+        auto arg = static_cast<KernArg*>(arg_);
+        size_t step = (arg->size + arg->nr_task - 1) / arg->nr_task,
+               begin = task_id * step, end = std::min(arg->size, begin + step);
+        for (size_t i = begin; i < end; ++i) {
+            arg->workspace[i] = arg->inp[i] * 2;
+            arg->out[i] = arg->workspace[i] + 1;
+        }
+    }
+
+    static void release(MGBOprDesc* self) { delete self; }
+
+    static size_t hash(const MGBOprDesc*) { return 0; }
+
+    static int is_same(const MGBOprDesc*, const MGBOprDesc*) { return 1; }
+
+    static void infer_shape(
+            const MGBOprDesc*, const MGBTensorShape* input, MGBTensorShape* output) {
+        output[0] = input[0];
+    }
+
+    static void execute_v2(
+            const MGBOprDesc*, const MGBTensor* input, const MGBTensor* output,
+            const MGBExecEnv* env) {
+        KernArg arg;
+        arg.inp = static_cast<const float*>(input[0].data);
+        arg.out = static_cast<float*>(output[0].data);
+        arg.workspace = static_cast<float*>(env->workspace);
+        arg.size = input[0].layout.shape.shape[0];
+        arg.nr_task = env->nr_threads;
+        mgb_assert(env->workspace_size == arg.size * sizeof(float));
+        env->dispatch(env, kern, &arg, sizeof(arg), arg.nr_task);
+    }
+
+    static size_t get_workspace_size(
+            const MGBOprDesc*, const MGBTensorLayout* input, const MGBTensorLayout*) {
+        return input[0].shape.shape[0] * sizeof(float);
+    }
+
+    static int32_t get_inplace_input(const MGBOprDesc*, uint32_t) { return 0; }
+
+    static uint64_t get_flops(
+            const MGBOprDesc*, const MGBTensorShape* input, const MGBTensorShape*) {
+        return input[0].shape[0] * 2;
+    }
+
+public:
+    static MGBOprDesc* make() {
+        auto desc = std::make_unique<MGBOprDesc>();
+        mgb_init_opr_desc(desc.get(), 1, "mul2_add1");
+#define s(n) desc->n = &MGBOprDescV2Impl::n;
+        s(release) s(hash) s(is_same) s(infer_shape) s(execute_v2);
+        s(get_workspace_size) s(get_inplace_input) s(get_flops);
+#undef s
+        return desc.release();
+    }
+};
+
 std::vector<uint8_t> create_graph_dump(
         float bias, float extra_scale, float sleep, MGBDType dtype) {
     HostTensorGenerator<> gen;
@@ -492,4 +560,78 @@ TEST(TestExternCOpr, Dedup) {
     ASSERT_EQ(0, MGBOprDescImpl<>::nr_inst);
 }
 
+TEST(TestExternCOpr, V2API) {
+    for (auto cn_name : {"cpux", "multithread2:0"}) {
+        auto cn = CompNode::load(cn_name);
+        HostTensorGenerator<> gen;
+        auto host_x = gen({23}, cn);
+        auto graph = ComputingGraph::make();
+        auto x = opr::Host2DeviceCopy::make(*graph, host_x), x1 = x + 0.5f;
+        std::string name = "mul2_add1";
+        auto opr = opr::ExternCOprRunner::make_from_desc(
+                name, {x1.node()}, MGBOprDescV2Impl::make());
+        // the workspace var is appended to outputs
+        ASSERT_EQ(2u, opr->output().size());
+        ASSERT_EQ(1u, opr->usable_output().size());
+        SymbolVar y = opr->output(0);
+
+        HostTensorND host_y;
+        auto func = graph->compile({make_callback_copy(y, host_y)});
+        func->execute();
+        ASSERT_EQ(23u * sizeof(float), opr->output(1)->shape().total_nr_elems());
+        ASSERT_EQ(46u, opr->cast_final_safe<opr::ExternCOprRunner>().flops());
+        ASSERT_EQ(prev_dev_ptr(x1), prev_dev_ptr(y));
+
+        auto px = host_x->ptr<float>(), py = host_y.ptr<float>();
+        for (size_t i = 0; i < 23; ++i) {
+            MGB_ASSERT_FLOAT_EQ((px[i] + 0.5f) * 2 + 1, py[i]);
+        }
+    }
+}
+
+TEST(TestExternCOpr, V2APIDynamicParam) {
+    constexpr size_t SIZE = 23;
+    auto cn = CompNode::load("cpux");
+    HostTensorGenerator<> gen;
+    auto host_x = gen({SIZE}, cn);
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+    std::string name = "mul2_add1";
+    auto opr = opr::ExternCOprRunner::make_from_desc(
+            name, {x.node()}, MGBOprDescV2Impl::make());
+    ASSERT_EQ(2u, opr->output().size());
+    SymbolVar y = opr->output(0);
+
+    HostTensorND host_y;
+    auto func = graph->compile({make_callback_copy(y, host_y)});
+
+    // only the user-visible output is configured, not the workspace
+    std::vector<float> inp_buf(SIZE), out_buf(SIZE);
+    ExternDeviceTensor inp, out;
+    memset(&inp, 0, sizeof(inp));
+    memset(&out, 0, sizeof(out));
+    inp.layout.shape = {1, {SIZE}};
+    inp.device_ptr = inp_buf.data();
+    out.layout.shape = {1, {SIZE}};
+    out.device_ptr = out_buf.data();
+    auto param = std::make_shared<ExternCOprParam>();
+    memset(param.get(), 0, sizeof(ExternCOprParam));
+    param->nr_input = 1;
+    param->input = &inp;
+    param->nr_output = 1;
+    param->output = &out;
+    config_extern_c_opr_dynamic_param(func, param);
+    func->execute();
+
+    auto px = host_x->ptr<float>(), py = host_y.ptr<float>();
+    for (size_t i = 0; i < SIZE; ++i) {
+        MGB_ASSERT_FLOAT_EQ(px[i] * 2 + 1, py[i]);
+    }
+
+    // a param covering the workspace var as well is rejected
+    param->nr_output = 2;
+    config_extern_c_opr_dynamic_param(func, param);
+    ASSERT_THROW(func->execute().wait(), MegBrainError);
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
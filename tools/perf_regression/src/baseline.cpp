@@ -0,0 +1,137 @@
+/**
+ * \file tools/perf_regression/src/baseline.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "./baseline.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+using namespace mgb;
+using namespace perf_regression;
+
+namespace {
+constexpr const char* METRIC_STATIC_MEM = "static_mem_bytes";
+constexpr const char* RECORD_CONFIG = "config";
+
+/*!
+ * standard error of the sample median, which is about 1.2533 times that of
+ * the mean for normally distributed samples
+ */
+double median_stderr(const std::vector<double>& samples) {
+    return 1.2533 * robust_stddev(samples) / std::sqrt(double(samples.size()));
+}
+}  // anonymous namespace
+
+bool Metric::is_memory() const {
+    return name == METRIC_STATIC_MEM;
+}
+
+std::vector<Metric> perf_regression::collect_metrics(const ModelResult& result) {
+    auto&& lat = result.latency_ms;
+    auto&& cold = result.cold_start_ms;
+    // tail percentiles have no cheap error estimate; the sample spread is
+    // used as a conservative bound
+    double lat_std = robust_stddev(lat);
+    return {
+            {result.model, "cold_start_ms", percentile(cold, 50), median_stderr(cold)},
+            {result.model, "latency_p50_ms", percentile(lat, 50), median_stderr(lat)},
+            {result.model, "latency_p90_ms", percentile(lat, 90), lat_std},
+            {result.model, "latency_p99_ms", percentile(lat, 99), lat_std},
+            {result.model, METRIC_STATIC_MEM, double(result.static_mem_bytes), 0},
+    };
+}
+
+Baseline perf_regression::load_baseline(const std::string& path) {
+    std::ifstream fin{path};
+    mgb_throw_if(!fin, MegBrainError, "failed to open baseline file %s", path.c_str());
+    Baseline ret;
+    std::string line;
+    for (size_t lineno = 1; std::getline(fin, line); ++lineno) {
+        auto pos = line.find_first_not_of(" \t");
+        if (pos == std::string::npos || line[pos] == '#') {
+            continue;
+        }
+        std::istringstream iss{line};
+        if (ret.device.empty()) {
+            std::string key;
+            mgb_throw_if(
+                    !(iss >> key >> ret.device >> ret.batch) || key != RECORD_CONFIG,
+                    MegBrainError, "%s:%zu: expect `%s device batch`, got: %s",
+                    path.c_str(), lineno, RECORD_CONFIG, line.c_str());
+            continue;
+        }
+        Metric m;
+        mgb_throw_if(
+                !(iss >> m.model >> m.name >> m.value >> m.noise), MegBrainError,
+                "%s:%zu: malformed baseline record: %s", path.c_str(), lineno,
+                line.c_str());
+        ret.metrics[{m.model, m.name}] = m;
+    }
+    mgb_throw_if(
+            ret.device.empty(), MegBrainError, "%s: no `%s` record", path.c_str(),
+            RECORD_CONFIG);
+    return ret;
+}
+
+void perf_regression::save_baseline(
+        const std::string& path, const std::string& comment, const RunConfig& run,
+        const std::vector<Metric>& metrics) {
+    std::ofstream fout{path};
+    mgb_throw_if(
+            !fout, MegBrainError, "failed to open baseline file %s for writing",
+            path.c_str());
+    fout << "# " << comment << '\n'
+         << RECORD_CONFIG << ' ' << run.device << ' ' << run.batch << '\n'
+         << "# model metric value noise\n";
+    fout.precision(6);
+    for (auto&& m : metrics) {
+        fout << m.model << ' ' << m.name << ' ' << m.value << ' ' << m.noise
+             << '\n';
+    }
+    mgb_throw_if(
+            !fout, MegBrainError, "failed to write baseline file %s", path.c_str());
+}
+
+std::vector<Comparison> perf_regression::compare_with_baseline(
+        const Baseline& baseline, const std::vector<Metric>& metrics,
+        const CompareConfig& config) {
+    std::vector<Comparison> ret;
+    for (auto&& cur : metrics) {
+        Comparison cmp;
+        cmp.cur = cur;
+        auto iter = baseline.metrics.find({cur.model, cur.name});
+        if (iter == baseline.metrics.end()) {
+            ret.push_back(cmp);
+            continue;
+        }
+        auto&& base = iter->second;
+        cmp.base = base.value;
+        if (cur.is_memory()) {
+            cmp.threshold = base.value * config.mem_rel_tol;
+        } else {
+            cmp.threshold = base.value * config.rel_tol +
+                            config.noise_k * std::max(base.noise, cur.noise);
+        }
+        double diff = cur.value - base.value;
+        if (diff > cmp.threshold) {
+            cmp.status = Comparison::Status::REGRESSION;
+        } else if (-diff > cmp.threshold) {
+            cmp.status = Comparison::Status::IMPROVEMENT;
+        } else {
+            cmp.status = Comparison::Status::OK;
+        }
+        ret.push_back(cmp);
+    }
+    return ret;
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
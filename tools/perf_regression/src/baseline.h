@@ -0,0 +1,91 @@
+/**
+ * \file tools/perf_regression/src/baseline.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#pragma once
+
+#include "./runner.h"
+
+#include <map>
+
+namespace mgb {
+namespace perf_regression {
+
+/*!
+ * \brief a scalar metric of a model run, where larger is worse
+ *
+ * noise is the estimated standard deviation of value itself (not of the
+ * individual samples), so that it could be directly compared between runs.
+ */
+struct Metric {
+    std::string model, name;
+    double value = 0, noise = 0;
+
+    bool is_memory() const;
+};
+
+//! summarize a run into the metrics stored in the baseline
+std::vector<Metric> collect_metrics(const ModelResult& result);
+
+struct Baseline {
+    //! comp node and batch size the metrics are measured with
+    std::string device;
+    size_t batch = 0;
+    //! (model, metric name) => metric
+    std::map<std::pair<std::string, std::string>, Metric> metrics;
+};
+
+/*!
+ * \brief read a baseline file
+ *
+ * The file is plain text. The first record is `config device batch`, and it
+ * is followed by one `model metric value noise` record per line; empty lines
+ * and lines starting with '#' are ignored.
+ */
+Baseline load_baseline(const std::string& path);
+
+void save_baseline(
+        const std::string& path, const std::string& comment, const RunConfig& run,
+        const std::vector<Metric>& metrics);
+
+struct CompareConfig {
+    //! relative slowdown that is always tolerated
+    double rel_tol = 0.05;
+    //! number of noise standard deviations tolerated on top of rel_tol
+    double noise_k = 3;
+    //! relative growth tolerated for memory metrics, which are not noisy
+    double mem_rel_tol = 0.01;
+};
+
+struct Comparison {
+    enum class Status { OK, REGRESSION, IMPROVEMENT, NEW };
+
+    Metric cur;
+    //! baseline value; undefined when status is NEW
+    double base = 0;
+    //! maximal tolerated difference between cur and base
+    double threshold = 0;
+    Status status = Status::NEW;
+};
+
+/*!
+ * \brief compare current metrics against a baseline
+ *
+ * A metric regresses if cur - base > base * rel_tol + k * max(noise_base,
+ * noise_cur); it improves if base - cur exceeds the same threshold.
+ */
+std::vector<Comparison> compare_with_baseline(
+        const Baseline& baseline, const std::vector<Metric>& metrics,
+        const CompareConfig& config);
+
+}  // namespace perf_regression
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,265 @@
+/**
+ * \file tools/perf_regression/src/main.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "./baseline.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace mgb;
+using namespace perf_regression;
+
+namespace {
+
+const char* USAGE = R"(usage: %s [options]
+
+Build the reference models, run them like load_and_run and optionally compare
+the results with a stored baseline.
+
+options:
+  --models A,B,...         models to run (default: all)
+  --list                   list the reference models and exit
+  --device NAME            comp node to run on (default: cpu0)
+  --batch N                batch size (default: 1)
+  --warmup N               warmup iterations (default: 5)
+  --iters N                timed iterations (default: 50)
+  --cold-runs N            load + compile + first run repetitions (default: 3)
+  --profile-oprs N         report the N slowest oprs of each model
+  --baseline FILE          compare with FILE; exit with 1 on regression
+  --update-baseline FILE   write the current results to FILE
+  --rel-tol X              tolerated relative slowdown (default: 0.05)
+  --noise-k X              tolerated noise standard deviations (default: 3)
+  --mem-rel-tol X          tolerated relative memory growth (default: 0.01)
+)";
+
+struct Args {
+    std::vector<std::string> models;
+    RunConfig run;
+    CompareConfig compare;
+    std::string baseline, update_baseline;
+    bool list = false;
+};
+
+std::vector<std::string> split(const std::string& str, char sep) {
+    std::vector<std::string> ret;
+    size_t begin = 0;
+    while (begin <= str.size()) {
+        auto end = str.find(sep, begin);
+        if (end == std::string::npos) {
+            end = str.size();
+        }
+        if (end > begin) {
+            ret.push_back(str.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+    return ret;
+}
+
+bool parse_value(const std::string& key, const char* val, size_t& dest) {
+    char* end;
+    errno = 0;
+    auto ret = strtoull(val, &end, 10);
+    // strtoull accepts a minus sign and negates the result
+    if (errno || end == val || *end || strchr(val, '-')) {
+        fprintf(stderr, "invalid value for %s: %s\n", key.c_str(), val);
+        return false;
+    }
+    dest = ret;
+    return true;
+}
+
+bool parse_value(const std::string& key, const char* val, double& dest) {
+    char* end;
+    errno = 0;
+    auto ret = strtod(val, &end);
+    if (errno || end == val || *end || !(ret >= 0)) {
+        fprintf(stderr, "invalid value for %s: %s\n", key.c_str(), val);
+        return false;
+    }
+    dest = ret;
+    return true;
+}
+
+bool parse_args(int argc, char** argv, Args& args) {
+    for (int i = 1; i < argc; ++i) {
+        std::string key = argv[i];
+        if (key == "--list") {
+            args.list = true;
+            continue;
+        }
+        if (key == "-h" || key == "--help" || i + 1 >= argc) {
+            return false;
+        }
+        const char* val = argv[++i];
+        bool ok = true;
+        if (key == "--models") {
+            args.models = split(val, ',');
+        } else if (key == "--device") {
+            args.run.device = val;
+        } else if (key == "--batch") {
+            ok = parse_value(key, val, args.run.batch);
+        } else if (key == "--warmup") {
+            ok = parse_value(key, val, args.run.warmup);
+        } else if (key == "--iters") {
+            ok = parse_value(key, val, args.run.iters);
+        } else if (key == "--cold-runs") {
+            ok = parse_value(key, val, args.run.cold_runs);
+        } else if (key == "--profile-oprs") {
+            ok = parse_value(key, val, args.run.profile_oprs);
+        } else if (key == "--baseline") {
+            args.baseline = val;
+        } else if (key == "--update-baseline") {
+            args.update_baseline = val;
+        } else if (key == "--rel-tol") {
+            ok = parse_value(key, val, args.compare.rel_tol);
+        } else if (key == "--noise-k") {
+            ok = parse_value(key, val, args.compare.noise_k);
+        } else if (key == "--mem-rel-tol") {
+            ok = parse_value(key, val, args.compare.mem_rel_tol);
+        } else {
+            fprintf(stderr, "unknown option: %s\n", key.c_str());
+            return false;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return args.run.iters > 0 && args.run.batch > 0;
+}
+
+void print_result(const ModelResult& ret) {
+    auto&& lat = ret.latency_ms;
+    printf("%s:\n", ret.model.c_str());
+    printf("  cold start   median %.3f ms over %zu runs\n",
+           percentile(ret.cold_start_ms, 50), ret.cold_start_ms.size());
+    printf("  latency      p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, "
+           "min %.3f ms, sigma %.3f ms\n",
+           percentile(lat, 50), percentile(lat, 90), percentile(lat, 99),
+           percentile(lat, 0), robust_stddev(lat));
+    printf("  static mem   %.2f MiB\n", ret.static_mem_bytes / 1024.0 / 1024.0);
+    if (ret.peak_rss_bytes) {
+        printf("  peak rss     %.2f MiB (process wide)\n",
+               ret.peak_rss_bytes / 1024.0 / 1024.0);
+    }
+    if (!ret.opr_breakdown.empty()) {
+        double tot = percentile(lat, 50);
+        printf("  slowest oprs:\n");
+        for (auto&& i : ret.opr_breakdown) {
+            printf("    %8.3f ms %5.1f%%  %-20s %s\n", i.msecs,
+                   tot > 0 ? i.msecs / tot * 100 : 0., i.type.c_str(),
+                   i.name.c_str());
+        }
+    }
+}
+
+const char* status_str(Comparison::Status status) {
+    switch (status) {
+        case Comparison::Status::OK:
+            return "ok";
+        case Comparison::Status::REGRESSION:
+            return "REGRESSION";
+        case Comparison::Status::IMPROVEMENT:
+            return "improvement";
+        case Comparison::Status::NEW:
+            return "new";
+    }
+    return "unknown";
+}
+
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+    Args args;
+    if (!parse_args(argc, argv, args)) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+    if (args.list) {
+        for (auto&& i : reference_models()) {
+            printf("%-16s %s\n", i.name.c_str(), i.desc.c_str());
+        }
+        return 0;
+    }
+
+    std::vector<const ModelDesc*> models;
+    if (args.models.empty()) {
+        for (auto&& i : reference_models()) {
+            models.push_back(&i);
+        }
+    } else {
+        for (auto&& name : args.models) {
+            auto model = find_reference_model(name);
+            if (!model) {
+                fprintf(stderr, "unknown model: %s; use --list to show all\n",
+                        name.c_str());
+                return 2;
+            }
+            models.push_back(model);
+        }
+    }
+
+    //! load the baseline before the run, so that a bad file fails fast
+    Baseline baseline;
+    if (!args.baseline.empty()) {
+        baseline = load_baseline(args.baseline);
+        if (baseline.device != args.run.device || baseline.batch != args.run.batch) {
+            fprintf(stderr,
+                    "baseline %s is measured with --device %s --batch %zu, "
+                    "not comparable with --device %s --batch %zu\n",
+                    args.baseline.c_str(), baseline.device.c_str(), baseline.batch,
+                    args.run.device.c_str(), args.run.batch);
+            return 2;
+        }
+    }
+
+    std::vector<Metric> metrics;
+    for (auto model : models) {
+        auto ret = run_model(*model, args.run);
+        print_result(ret);
+        auto cur = collect_metrics(ret);
+        metrics.insert(metrics.end(), cur.begin(), cur.end());
+    }
+
+    int exit_code = 0;
+    if (!args.baseline.empty()) {
+        auto result = compare_with_baseline(baseline, metrics, args.compare);
+        printf("\ncompared with %s:\n", args.baseline.c_str());
+        for (auto&& i : result) {
+            if (i.status == Comparison::Status::NEW) {
+                printf("  %-14s %-18s %12.3f  %s\n", i.cur.model.c_str(),
+                       i.cur.name.c_str(), i.cur.value, status_str(i.status));
+                continue;
+            }
+            printf("  %-14s %-18s %12.3f -> %12.3f (%+6.2f%%, tol %.3f)  %s\n",
+                   i.cur.model.c_str(), i.cur.name.c_str(), i.base, i.cur.value,
+                   i.base > 0 ? (i.cur.value - i.base) / i.base * 100 : 0.,
+                   i.threshold, status_str(i.status));
+            if (i.status == Comparison::Status::REGRESSION) {
+                exit_code = 1;
+            }
+        }
+    }
+
+    if (!args.update_baseline.empty()) {
+        auto comment = ssprintf(
+                "device=%s batch=%zu iters=%zu cold_runs=%zu",
+                args.run.device.c_str(), args.run.batch, args.run.iters,
+                args.run.cold_runs);
+        save_baseline(args.update_baseline, comment, args.run, metrics);
+        printf("baseline written to %s\n", args.update_baseline.c_str());
+    }
+    return exit_code;
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
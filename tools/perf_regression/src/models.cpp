@@ -0,0 +1,293 @@
+/**
+ * \file tools/perf_regression/src/models.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "./models.h"
+
+#include "megbrain/opr/basic_arith_wrapper.h"
+#include "megbrain/opr/blas.h"
+#include "megbrain/opr/dnn/convolution.h"
+#include "megbrain/opr/dnn/pooling.h"
+#include "megbrain/opr/imgproc.h"
+#include "megbrain/opr/io.h"
+#include "megbrain/opr/tensor_manip.h"
+
+#include <cmath>
+#include <random>
+
+using namespace mgb;
+using namespace perf_regression;
+
+namespace {
+
+void fill_normal(HostTensorND& dest, std::mt19937& rng, float stddev) {
+    std::normal_distribution<float> dist{0.f, stddev};
+    auto ptr = dest.ptr<float>();
+    for (size_t i = 0, it = dest.shape().total_nr_elems(); i < it; ++i) {
+        ptr[i] = dist(rng);
+    }
+}
+
+/*!
+ * \brief helper for building the reference networks
+ *
+ * All weights are float32 constants drawn from a fixed seed, so that the
+ * same model is generated on every run and results are comparable across
+ * builds.
+ */
+class NetBuilder {
+    std::shared_ptr<ComputingGraph> m_graph;
+    CompNode m_cn;
+    std::mt19937 m_rng{42};
+    std::shared_ptr<HostTensorND> m_input;
+
+public:
+    explicit NetBuilder(CompNode cn) : m_graph{ComputingGraph::make()}, m_cn{cn} {}
+
+    SymbolVar input(const TensorShape& shape) {
+        mgb_assert(!m_input, "only a single model input is supported");
+        m_input = std::make_shared<HostTensorND>(m_cn, shape, dtype::Float32());
+        fill_normal(*m_input, m_rng, 1.f);
+        return opr::Host2DeviceCopy::make(*m_graph, m_input).rename("data");
+    }
+
+    SymbolVar param(const TensorShape& shape, float stddev) {
+        HostTensorND val{m_cn, shape, dtype::Float32()};
+        fill_normal(val, m_rng, stddev);
+        return opr::SharedDeviceTensor::make_const(*m_graph, val);
+    }
+
+    SymbolVar conv(
+            SymbolVar x, size_t ic, size_t oc, size_t kern, size_t stride,
+            bool relu = true, size_t group = 1) {
+        using Param = opr::ConvBias::Param;
+        Param param;
+        param.format = Param::Format::NCHW;
+        param.pad_h = param.pad_w = kern / 2;
+        param.stride_h = param.stride_w = stride;
+        param.nonlineMode =
+                relu ? Param::NonlineMode::RELU : Param::NonlineMode::IDENTITY;
+        TensorShape wshp;
+        if (group == 1) {
+            param.sparse = Param::Sparse::DENSE;
+            wshp = {oc, ic, kern, kern};
+        } else {
+            mgb_assert(ic % group == 0 && oc % group == 0);
+            param.sparse = Param::Sparse::GROUP;
+            wshp = {group, oc / group, ic / group, kern, kern};
+        }
+        float stddev = std::sqrt(2.f / (ic / group * kern * kern));
+        auto w = this->param(wshp, stddev), b = this->param({1, oc, 1, 1}, 0.01f);
+        return opr::ConvBias::make(x, w, b, param);
+    }
+
+    SymbolVar pool(
+            SymbolVar x, opr::Pooling::Param::Mode mode, size_t window,
+            size_t stride, size_t pad) {
+        opr::Pooling::Param param;
+        param.mode = mode;
+        param.format = opr::Pooling::Param::Format::NCHW;
+        param.window_h = param.window_w = window;
+        param.stride_h = param.stride_w = stride;
+        param.pad_h = param.pad_w = pad;
+        return opr::Pooling::make(x, param);
+    }
+
+    //! x: (n, ic) -> (n, oc)
+    SymbolVar fc(SymbolVar x, size_t ic, size_t oc) {
+        auto w = param({ic, oc}, std::sqrt(1.f / ic)), b = param({1, oc}, 0.01f);
+        return opr::MatrixMul::make(x, w) + b;
+    }
+
+    //! layer norm over the last axis of a (n, c) tensor
+    SymbolVar layer_norm(SymbolVar x, size_t c) {
+        using Mode = opr::Reduce::Mode;
+        auto mean = opr::Reduce::make(x, {Mode::MEAN, 1});
+        auto xc = x - mean;
+        auto var = opr::Reduce::make(xc * xc, {Mode::MEAN, 1});
+        auto gamma = param({1, c}, 0.02f) + 1.f, beta = param({1, c}, 0.02f);
+        return xc / opr::powf(var + 1e-5f, 0.5f) * gamma + beta;
+    }
+
+    SymbolVar softmax(SymbolVar x, int axis) {
+        using Mode = opr::Reduce::Mode;
+        auto e = opr::exp(x - opr::Reduce::make(x, {Mode::MAX, axis}));
+        return e / opr::Reduce::make(e, {Mode::SUM, axis});
+    }
+
+    BuiltModel finish(SymbolVarArray outputs) {
+        mgb_assert(m_input, "model has no input");
+        return {m_graph, m_input, std::move(outputs)};
+    }
+};
+
+SymbolVar resnet_basic_block(
+        NetBuilder& nb, SymbolVar x, size_t ic, size_t oc, size_t stride) {
+    auto y = nb.conv(x, ic, oc, 3, stride);
+    y = nb.conv(y, oc, oc, 3, 1, false);
+    auto shortcut = x;
+    if (stride != 1 || ic != oc) {
+        shortcut = nb.conv(x, ic, oc, 1, stride, false);
+    }
+    return opr::Elemwise::make({y, shortcut}, opr::Elemwise::Mode::FUSE_ADD_RELU);
+}
+
+BuiltModel make_resnet18(CompNode cn, size_t batch) {
+    using PoolMode = opr::Pooling::Param::Mode;
+    NetBuilder nb{cn};
+    auto x = nb.input({batch, 3, 224, 224});
+    x = nb.conv(x, 3, 64, 7, 2);
+    x = nb.pool(x, PoolMode::MAX, 3, 2, 1);
+    size_t ic = 64;
+    for (size_t oc : {64, 128, 256, 512}) {
+        size_t stride = oc == 64 ? 1 : 2;
+        x = resnet_basic_block(nb, x, ic, oc, stride);
+        x = resnet_basic_block(nb, x, oc, oc, 1);
+        ic = oc;
+    }
+    x = nb.pool(x, PoolMode::AVERAGE, 7, 7, 0);
+    x = opr::Reshape::make(x, TensorShape{batch, ic});
+    return nb.finish({nb.fc(x, ic, 1000)});
+}
+
+BuiltModel make_mobilenet_v1(CompNode cn, size_t batch) {
+    using PoolMode = opr::Pooling::Param::Mode;
+    NetBuilder nb{cn};
+    auto x = nb.input({batch, 3, 224, 224});
+    x = nb.conv(x, 3, 32, 3, 2);
+    size_t ic = 32;
+    static const std::pair<size_t, size_t> blocks[] = {
+            {64, 1},  {128, 2}, {128, 1}, {256, 2}, {256, 1}, {512, 2},  {512, 1},
+            {512, 1}, {512, 1}, {512, 1}, {512, 1}, {1024, 2}, {1024, 1}};
+    for (auto&& blk : blocks) {
+        x = nb.conv(x, ic, ic, 3, blk.second, true, ic);
+        x = nb.conv(x, ic, blk.first, 1, 1);
+        ic = blk.first;
+    }
+    x = nb.pool(x, PoolMode::AVERAGE, 7, 7, 0);
+    x = opr::Reshape::make(x, TensorShape{batch, ic});
+    return nb.finish({nb.fc(x, ic, 1000)});
+}
+
+BuiltModel make_bert_encoder(CompNode cn, size_t batch) {
+    constexpr size_t S = 128, H = 256, NR_HEAD = 4, HEAD = H / NR_HEAD, FFN = 1024,
+                     NR_LAYER = 4;
+    NetBuilder nb{cn};
+    auto x = nb.input({batch, S, H});
+    x = opr::Reshape::make(x, TensorShape{batch * S, H});
+
+    auto split_heads = [&](SymbolVar t) {
+        t = opr::Reshape::make(t, TensorShape{batch, S, NR_HEAD, HEAD});
+        t = opr::Dimshuffle::make(t, {0, 2, 1, 3});
+        return opr::Reshape::make(t, TensorShape{batch * NR_HEAD, S, HEAD});
+    };
+    auto merge_heads = [&](SymbolVar t) {
+        t = opr::Reshape::make(t, TensorShape{batch, NR_HEAD, S, HEAD});
+        t = opr::Dimshuffle::make(t, {0, 2, 1, 3});
+        return opr::Reshape::make(t, TensorShape{batch * S, H});
+    };
+
+    for (size_t i = 0; i < NR_LAYER; ++i) {
+        auto q = split_heads(nb.fc(x, H, H)), k = split_heads(nb.fc(x, H, H)),
+             v = split_heads(nb.fc(x, H, H));
+        opr::BatchedMatrixMul::Param qk_param;
+        qk_param.transposeB = true;
+        auto score = opr::BatchedMatrixMul::make(q, k, qk_param) *
+                     (1.f / std::sqrt(static_cast<float>(HEAD)));
+        auto ctx = merge_heads(
+                opr::BatchedMatrixMul::make(nb.softmax(score, 2), v));
+        x = nb.layer_norm(x + nb.fc(ctx, H, H), H);
+
+        auto ffn = opr::Elemwise::make(
+                {nb.fc(x, H, FFN)}, opr::Elemwise::Mode::GELU);
+        x = nb.layer_norm(x + nb.fc(ffn, FFN, H), H);
+    }
+    x = opr::Reshape::make(x, TensorShape{batch, S, H});
+    return nb.finish({x});
+}
+
+BuiltModel make_fpn_detector(CompNode cn, size_t batch) {
+    constexpr size_t IMG = 320, FPN_CH = 128, NR_ANCHOR = 3, NR_CLASS = 80;
+    NetBuilder nb{cn};
+    auto x = nb.input({batch, 3, IMG, IMG});
+
+    // backbone: five stride-2 stages; C3, C4, C5 feed the FPN
+    SymbolVarArray feats;
+    size_t ic = 3;
+    for (size_t oc : {32, 64, 128, 256, 512}) {
+        x = nb.conv(x, ic, oc, 3, 2);
+        x = nb.conv(x, oc, oc, 3, 1);
+        ic = oc;
+        if (oc >= 128) {
+            feats.push_back(x);
+        }
+    }
+
+    opr::Resize::Param resize_param;
+    resize_param.format = opr::Resize::Param::Format::NCHW;
+    resize_param.imode = opr::Resize::Param::InterpolationMode::LINEAR;
+
+    // top-down pathway; levels[0] is the finest
+    const size_t feat_ch[] = {128, 256, 512};
+    SymbolVarArray levels(3);
+    for (int i = 2; i >= 0; --i) {
+        auto lat = nb.conv(feats[i], feat_ch[i], FPN_CH, 1, 1, false);
+        if (i < 2) {
+            size_t size = IMG >> (3 + i);
+            lat = lat + opr::Resize::make(
+                                levels[i + 1], TensorShape{size, size},
+                                resize_param);
+        }
+        levels[i] = lat;
+    }
+
+    SymbolVarArray cls, box;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        size_t size = IMG >> (3 + i);
+        auto feat = nb.conv(levels[i], FPN_CH, FPN_CH, 3, 1);
+        auto head = nb.conv(feat, FPN_CH, FPN_CH, 3, 1);
+        auto c = nb.conv(head, FPN_CH, NR_ANCHOR * NR_CLASS, 3, 1, false);
+        auto b = nb.conv(head, FPN_CH, NR_ANCHOR * 4, 3, 1, false);
+        cls.push_back(opr::Reshape::make(
+                opr::sigmoid(c), TensorShape{batch, NR_ANCHOR * NR_CLASS, size * size}));
+        box.push_back(
+                opr::Reshape::make(b, TensorShape{batch, NR_ANCHOR * 4, size * size}));
+    }
+    return nb.finish({opr::Concat::make(cls, 2), opr::Concat::make(box, 2)});
+}
+
+}  // anonymous namespace
+
+const std::vector<ModelDesc>& perf_regression::reference_models() {
+    static const std::vector<ModelDesc> models = {
+            {"resnet18", "ResNet-18 style residual CNN, 224x224 input",
+             make_resnet18},
+            {"mobilenet_v1", "MobileNet-v1 style depthwise separable CNN, 224x224 input",
+             make_mobilenet_v1},
+            {"bert_encoder",
+             "BERT style transformer encoder: 4 layers, seq 128, hidden 256",
+             make_bert_encoder},
+            {"fpn_detector",
+             "single-stage detector with FPN neck and dense heads, 320x320 input",
+             make_fpn_detector},
+    };
+    return models;
+}
+
+const ModelDesc* perf_regression::find_reference_model(const std::string& name) {
+    for (auto&& i : reference_models()) {
+        if (i.name == name) {
+            return &i;
+        }
+    }
+    return nullptr;
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
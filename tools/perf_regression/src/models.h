@@ -0,0 +1,52 @@
+/**
+ * \file tools/perf_regression/src/models.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#pragma once
+
+#include "megbrain/graph.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace mgb {
+namespace perf_regression {
+
+/*!
+ * \brief a reference model built directly with the graph API
+ *
+ * The model graph owns randomly initialized weights; the only graph input
+ * is a Host2DeviceCopy named "data" whose host tensor is returned in \p input
+ * so that the runner could refill it between iterations.
+ */
+struct BuiltModel {
+    std::shared_ptr<ComputingGraph> graph;
+    std::shared_ptr<HostTensorND> input;
+    SymbolVarArray outputs;
+};
+
+struct ModelDesc {
+    //! stable name used as the key in the baseline file
+    std::string name;
+    std::string desc;
+    thin_function<BuiltModel(CompNode cn, size_t batch)> make;
+};
+
+//! all registered reference models, in a fixed order
+const std::vector<ModelDesc>& reference_models();
+
+//! find a reference model by name; return nullptr if not found
+const ModelDesc* find_reference_model(const std::string& name);
+
+}  // namespace perf_regression
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
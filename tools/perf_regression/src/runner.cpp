@@ -0,0 +1,257 @@
+/**
+ * \file tools/perf_regression/src/runner.cpp
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#include "./runner.h"
+
+#include "megbrain/graph/event.h"
+#include "megbrain/serialization/serializer.h"
+#include "megbrain/utils/timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define PERF_REGRESSION_HAS_RUSAGE 1
+#else
+#define PERF_REGRESSION_HAS_RUSAGE 0
+#endif
+
+using namespace mgb;
+using namespace perf_regression;
+
+namespace {
+
+//! a loaded and compiled model, ready to be executed
+struct CompiledModel {
+    std::shared_ptr<ComputingGraph> graph;
+    std::unique_ptr<cg::AsyncExecutable> func;
+    std::vector<HostTensorND> outputs;
+
+    void run() { func->execute().wait(); }
+};
+
+/*!
+ * \brief deserialize and compile a dumped model
+ *
+ * \param static_mem if not null, the total size of statically allocated
+ *      memory on all comp nodes would be written to it
+ */
+std::unique_ptr<CompiledModel> load_and_compile(
+        const std::vector<uint8_t>& dump, const HostTensorND& input,
+        size_t* static_mem) {
+    using namespace serialization;
+    auto loader =
+            GraphLoader::make(InputFile::make_mem_proxy(dump.data(), dump.size()));
+    auto load_ret = loader->load();
+
+    auto iter = load_ret.tensor_map.find("data");
+    mgb_assert(iter != load_ret.tensor_map.end(), "model input not found");
+    iter->second->copy_from(input);
+
+    CompNode::UnorderedMap<size_t> mem_size;
+    SyncEventConnecter::ReceiverHandler mem_handler;
+    if (static_mem) {
+        mem_handler = load_ret.graph->event().register_receiver<cg::event::StaticMemAlloc>(
+                [&mem_size](const cg::event::StaticMemAlloc& ev) {
+                    // the final event carries an invalid comp node to mark
+                    // the end of allocation
+                    if (ev.comp_node.valid()) {
+                        mem_size[ev.comp_node] = ev.alloc_size;
+                    }
+                });
+    }
+
+    auto ret = std::make_unique<CompiledModel>();
+    ret->outputs.resize(load_ret.output_var_list.size());
+    ComputingGraph::OutputSpec out_spec;
+    for (size_t i = 0; i < ret->outputs.size(); ++i) {
+        auto dst = &ret->outputs[i];
+        out_spec.emplace_back(
+                load_ret.output_var_list[i],
+                [dst](DeviceTensorND& val) { dst->copy_from(val); });
+    }
+    ret->func = load_ret.graph_compile(out_spec);
+    ret->graph = load_ret.graph;
+
+    if (static_mem) {
+        // static memory is allocated lazily on the first execution
+        ret->run();
+        *static_mem = 0;
+        for (auto&& i : mem_size) {
+            *static_mem += i.second;
+        }
+    }
+    return ret;
+}
+
+/*!
+ * \brief measure per-opr kernel time with comp node events
+ *
+ * Events are recorded from tasks dispatched to the opr's comp node, so the
+ * result reflects device execution time rather than host dispatch time.
+ */
+std::vector<OprTime> profile_oprs(
+        CompiledModel& model, size_t iters, size_t nr_report) {
+    struct Record {
+        std::unique_ptr<CompNode::Event> start, end;
+        bool executed = false;
+        double secs = 0;
+    };
+    std::unordered_map<cg::OperatorNodeBase*, Record> records;
+    std::vector<cg::OperatorNodeBase*> oprs;
+    model.func->iter_opr_seq([&](cg::OperatorNodeBase* opr) {
+        auto cn = opr->output(0)->comp_node();
+        auto&& rec = records[opr];
+        rec.start = cn.create_event(CompNode::Event::NEED_TIMER);
+        rec.end = cn.create_event(CompNode::Event::NEED_TIMER);
+        oprs.push_back(opr);
+        return true;
+    });
+
+    // records is not modified during execution, so the handlers need no lock
+    using namespace cg::event;
+    auto&& ev = model.graph->event();
+    auto on_start = ev.register_receiver<OprExecKernelStart>(
+            [&records](const OprExecKernelStart& event) {
+                auto iter = records.find(event.opr);
+                if (iter == records.end())
+                    return;
+                auto rec = &iter->second;
+                rec->executed = true;
+                event.env->dispatch_on_comp_node(
+                        event.opr->output(0)->comp_node(),
+                        [rec]() { rec->start->record(); });
+            });
+    auto on_end = ev.register_receiver<OprExecKernelEnd>(
+            [&records](const OprExecKernelEnd& event) {
+                auto iter = records.find(event.opr);
+                if (iter == records.end())
+                    return;
+                auto rec = &iter->second;
+                event.env->dispatch_on_comp_node(
+                        event.opr->output(0)->comp_node(),
+                        [rec]() { rec->end->record(); });
+            });
+
+    for (size_t i = 0; i < iters; ++i) {
+        model.run();
+        for (auto&& it : records) {
+            auto&& rec = it.second;
+            if (rec.executed) {
+                rec.secs += rec.start->elapsed_time_until(*rec.end);
+                rec.executed = false;
+            }
+        }
+    }
+
+    std::vector<OprTime> ret;
+    for (auto opr : oprs) {
+        ret.push_back(
+                {opr->name(), opr->dyn_typeinfo()->name,
+                 records.at(opr).secs * 1e3 / iters});
+    }
+    std::stable_sort(ret.begin(), ret.end(), [](const OprTime& a, const OprTime& b) {
+        return a.msecs > b.msecs;
+    });
+    if (ret.size() > nr_report) {
+        ret.resize(nr_report);
+    }
+    return ret;
+}
+
+size_t get_peak_rss_bytes() {
+#if PERF_REGRESSION_HAS_RUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return usage.ru_maxrss;
+#else
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+    return 0;
+}
+
+}  // anonymous namespace
+
+ModelResult perf_regression::run_model(const ModelDesc& model, const RunConfig& config) {
+    mgb_assert(config.iters > 0, "iters must be positive");
+    auto cn = CompNode::load(config.device);
+
+    std::vector<uint8_t> dump;
+    std::shared_ptr<HostTensorND> input;
+    {
+        auto built = model.make(cn, config.batch);
+        using namespace serialization;
+        GraphDumper::make(OutputFile::make_vector_proxy(&dump))->dump(built.outputs);
+        input = built.input;
+    }
+
+    ModelResult ret;
+    ret.model = model.name;
+
+    std::unique_ptr<CompiledModel> compiled;
+    for (size_t i = 0; i < std::max<size_t>(config.cold_runs, 1); ++i) {
+        // release the previous graph outside of the timed region
+        compiled.reset();
+        cn.sync();
+        RealTimer timer;
+        compiled = load_and_compile(dump, *input, i ? nullptr : &ret.static_mem_bytes);
+        if (i) {
+            compiled->run();
+        }
+        ret.cold_start_ms.push_back(timer.get_msecs());
+    }
+
+    for (size_t i = 0; i < config.warmup; ++i) {
+        compiled->run();
+    }
+    ret.latency_ms.reserve(config.iters);
+    RealTimer timer;
+    for (size_t i = 0; i < config.iters; ++i) {
+        compiled->run();
+        ret.latency_ms.push_back(timer.get_msecs_reset());
+    }
+
+    if (config.profile_oprs) {
+        ret.opr_breakdown = profile_oprs(
+                *compiled, std::min<size_t>(config.iters, 10), config.profile_oprs);
+    }
+    ret.peak_rss_bytes = get_peak_rss_bytes();
+    return ret;
+}
+
+double perf_regression::percentile(std::vector<double> samples, double p) {
+    mgb_assert(!samples.empty() && p >= 0 && p <= 100);
+    std::sort(samples.begin(), samples.end());
+    double rank = p / 100 * (samples.size() - 1);
+    size_t lo = static_cast<size_t>(std::floor(rank)),
+           hi = std::min(lo + 1, samples.size() - 1);
+    return samples[lo] + (samples[hi] - samples[lo]) * (rank - lo);
+}
+
+double perf_regression::robust_stddev(const std::vector<double>& samples) {
+    if (samples.size() < 2) {
+        return 0;
+    }
+    double med = percentile(samples, 50);
+    std::vector<double> dev;
+    dev.reserve(samples.size());
+    for (double i : samples) {
+        dev.push_back(std::abs(i - med));
+    }
+    return 1.4826 * percentile(std::move(dev), 50);
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
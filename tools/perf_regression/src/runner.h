@@ -0,0 +1,81 @@
+/**
+ * \file tools/perf_regression/src/runner.h
+ * MegEngine is Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * Copyright (c) 2014-2021 Megvii Inc. All rights reserved.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT ARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ */
+
+#pragma once
+
+#include "./models.h"
+
+namespace mgb {
+namespace perf_regression {
+
+struct RunConfig {
+    std::string device = "cpu0";
+    size_t batch = 1;
+    size_t warmup = 5;
+    size_t iters = 50;
+
+    //! number of times to repeat the load + compile + first run sequence
+    size_t cold_runs = 3;
+
+    //! number of slowest oprs to report; 0 disables the breakdown pass
+    size_t profile_oprs = 0;
+};
+
+struct OprTime {
+    std::string name, type;
+    //! average kernel time per iteration, measured by comp node events
+    double msecs;
+};
+
+struct ModelResult {
+    std::string model;
+
+    //! load + compile + first execution, one sample per cold run
+    std::vector<double> cold_start_ms;
+
+    //! steady state latency, one sample per timed iteration
+    std::vector<double> latency_ms;
+
+    //! statically allocated device memory of the compiled graph
+    size_t static_mem_bytes = 0;
+
+    //! peak resident set size of the process after this model; 0 if the
+    //! platform does not report it. This is cumulative over models run in
+    //! the same process and only used for display.
+    size_t peak_rss_bytes = 0;
+
+    //! slowest oprs, sorted by decreasing time
+    std::vector<OprTime> opr_breakdown;
+};
+
+/*!
+ * \brief run a reference model the same way load_and_run does
+ *
+ * The model is built, dumped to an in-memory buffer and then loaded again so
+ * that the measured cold start covers deserialization, graph optimization,
+ * compiling and the first execution.
+ */
+ModelResult run_model(const ModelDesc& model, const RunConfig& config);
+
+//! p in [0, 100]; linear interpolation between closest ranks
+double percentile(std::vector<double> samples, double p);
+
+/*!
+ * \brief robust standard deviation estimate: 1.4826 * median absolute
+ *      deviation, which is consistent with stddev for normal samples but
+ *      insensitive to the occasional scheduling outlier
+ */
+double robust_stddev(const std::vector<double>& samples);
+
+}  // namespace perf_regression
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}